@@ -10,6 +10,7 @@
 #include "TableModel.h"
 #include "Mdt/ItemModel/StlHelpers.h"
 #include <QString>
+#include <utility>
 #include <cassert>
 
 using namespace Mdt::ItemModel;
@@ -27,6 +28,11 @@ void TableModel::setTable(const Table & table)
   endResetModel();
 }
 
+void TableModel::replaceTable(Table && table)
+{
+  AbstractTableModel::replaceTable( mTable, std::move(table), mReclaimer );
+}
+
 int TableModel::rowCountWithoutParentIndex() const noexcept
 {
   return static_cast<int>( mTable.size() );
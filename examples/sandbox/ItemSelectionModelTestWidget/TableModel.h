@@ -11,6 +11,7 @@
 #define TABLE_MODEL_H
 
 #include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemModel/TableReclaimer.h"
 #include <QObject>
 #include <QVariant>
 #include <string>
@@ -40,6 +41,12 @@ class TableModel : public Mdt::ItemModel::AbstractTableModel
 
   void setTable(const Table & table);
 
+  /*
+   * Moves table to the model during a single reset,
+   * the previous one is destroyed in the thread of the reclaimer
+   */
+  void replaceTable(Table && table);
+
  private:
 
   int rowCountWithoutParentIndex() const noexcept override;
@@ -51,6 +58,7 @@ class TableModel : public Mdt::ItemModel::AbstractTableModel
   void doRemoveRows(int row, int count) noexcept override;
 
   Table mTable;
+  Mdt::ItemModel::TableReclaimer mReclaimer;
 };
 
 #endif // #ifndef TABLE_MODEL_H
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "DeviceListSortFilterProxyModel.h"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include <QRegularExpression>
+#include <QChar>
+#include <utility>
+#include <cassert>
+
+using namespace Mdt::ItemModel;
+
+
+DeviceListSortFilterProxyModel::DeviceListSortFilterProxyModel(QObject *parent)
+ : QSortFilterProxyModel(parent)
+{
+  setFilterKeyColumn( DeviceListTableModel::descriptionColumn() );
+}
+
+void DeviceListSortFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+  if(mDeviceListModel != nullptr){
+    disconnect(mDeviceListModel, &DeviceListTableModel::rowsInserted, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+    disconnect(mDeviceListModel, &DeviceListTableModel::rowsRemoved, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+    disconnect(mDeviceListModel, &DeviceListTableModel::rowsMoved, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+    disconnect(mDeviceListModel, &DeviceListTableModel::dataChanged, this, &DeviceListSortFilterProxyModel::updateCandidatesOnDataChanged);
+    disconnect(mDeviceListModel, &DeviceListTableModel::modelReset, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+    disconnect(mDeviceListModel, &DeviceListTableModel::layoutChanged, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+  }
+
+  mDeviceListModel = qobject_cast<DeviceListTableModel*>(sourceModel);
+  assert( (sourceModel == nullptr) || (mDeviceListModel != nullptr) );
+  invalidateCandidates();
+
+  /*
+   * The candidates must be invalidated before QSortFilterProxyModel
+   * filters the changed rows, so we connect before it does
+   */
+  if(mDeviceListModel != nullptr){
+    connect(mDeviceListModel, &DeviceListTableModel::rowsInserted, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+    connect(mDeviceListModel, &DeviceListTableModel::rowsRemoved, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+    connect(mDeviceListModel, &DeviceListTableModel::rowsMoved, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+    connect(mDeviceListModel, &DeviceListTableModel::dataChanged, this, &DeviceListSortFilterProxyModel::updateCandidatesOnDataChanged);
+    connect(mDeviceListModel, &DeviceListTableModel::modelReset, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+    connect(mDeviceListModel, &DeviceListTableModel::layoutChanged, this, &DeviceListSortFilterProxyModel::invalidateCandidates);
+  }
+
+  QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
+bool DeviceListSortFilterProxyModel::setWildcardFilter(const QString & wildcard)
+{
+  const QRegularExpression regularExpression( QRegularExpression::wildcardToRegularExpression(wildcard) );
+
+  if( !regularExpression.isValid() ){
+    mLiteralParts.clear();
+    invalidateCandidates();
+    setFilterRegularExpression( QRegularExpression() );
+    return false;
+  }
+
+  mLiteralParts = literalPartsOfWildcard(wildcard);
+  invalidateCandidates();
+  setFilterRegularExpression(regularExpression);
+
+  return true;
+}
+
+QStringList DeviceListSortFilterProxyModel::literalPartsOfWildcard(const QString & wildcard)
+{
+  QStringList parts;
+  QString part;
+  bool inCharacterSet = false;
+
+  const auto appendPart = [&parts, &part](){
+    if( !part.isEmpty() ){
+      parts.append(part);
+      part.clear();
+    }
+  };
+
+  for(const QChar c : wildcard){
+    if(inCharacterSet){
+      if( c == QLatin1Char(']') ){
+        inCharacterSet = false;
+      }
+    }else if( (c == QLatin1Char('*')) || (c == QLatin1Char('?')) ){
+      appendPart();
+    }else if( c == QLatin1Char('[') ){
+      appendPart();
+      inCharacterSet = true;
+    }else{
+      part.append(c);
+    }
+  }
+  appendPart();
+
+  return parts;
+}
+
+bool DeviceListSortFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex & sourceParent) const
+{
+  updateCandidates();
+
+  if(mHasCandidates){
+    const auto row = static_cast<size_t>(sourceRow);
+    if( (row >= mRowIsCandidate.size()) || !mRowIsCandidate[row] ){
+      return false;
+    }
+  }
+
+  return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+}
+
+void DeviceListSortFilterProxyModel::invalidateCandidates() noexcept
+{
+  mCandidatesAreStale = true;
+}
+
+/*
+ * Only the changed rows have to be checked again.
+ * A row that contains each literal part is a candidate,
+ * which is what the trigram index would tell, without its false positives.
+ */
+void DeviceListSortFilterProxyModel::updateCandidatesOnDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight)
+{
+  if( mCandidatesAreStale || !mHasCandidates ){
+    return;
+  }
+  if( !topLeft.isValid() || !bottomRight.isValid() ){
+    invalidateCandidates();
+    return;
+  }
+
+  const int column = DeviceListTableModel::descriptionColumn();
+  if( (column < topLeft.column()) || (column > bottomRight.column()) ){
+    return;
+  }
+
+  for(int row = topLeft.row(); row <= bottomRight.row(); ++row){
+    const auto candidateRow = static_cast<size_t>(row);
+    if( candidateRow >= mRowIsCandidate.size() ){
+      invalidateCandidates();
+      return;
+    }
+    const QString description = mDeviceListModel->index(row, column).data().toString();
+    bool isCandidate = true;
+    for(const QString & part : mLiteralParts){
+      if( (part.size() >= 3) && !description.contains(part, Qt::CaseInsensitive) ){
+        isCandidate = false;
+        break;
+      }
+    }
+    mRowIsCandidate[candidateRow] = isCandidate;
+  }
+}
+
+void DeviceListSortFilterProxyModel::updateCandidates() const
+{
+  if(!mCandidatesAreStale){
+    return;
+  }
+  mCandidatesAreStale = false;
+  mHasCandidates = false;
+  mRowIsCandidate.clear();
+
+  if(mDeviceListModel == nullptr){
+    return;
+  }
+
+  const int column = DeviceListTableModel::descriptionColumn();
+  const auto rowCount = static_cast<size_t>( mDeviceListModel->rowCount() );
+
+  /*
+   * Each literal part must be contained in the description,
+   * so a candidate row is a candidate for each part.
+   * Parts shorter than a trigram give all rows, we skip them.
+   */
+  for(const QString & part : mLiteralParts){
+    if(part.size() < 3){
+      continue;
+    }
+    std::vector<bool> rowIsCandidateForPart(rowCount, false);
+    for( const RowRange & range : mDeviceListModel->rowsThatMayContain(column, part) ){
+      for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+        rowIsCandidateForPart[static_cast<size_t>(row)] = true;
+      }
+    }
+    if(mHasCandidates){
+      for(size_t row = 0; row < rowCount; ++row){
+        mRowIsCandidate[row] = mRowIsCandidate[row] && rowIsCandidateForPart[row];
+      }
+    }else{
+      mRowIsCandidate = std::move(rowIsCandidateForPart);
+      mHasCandidates = true;
+    }
+  }
+}
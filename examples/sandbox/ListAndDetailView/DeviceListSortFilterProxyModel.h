@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef DEVICE_LIST_SORT_FILTER_PROXY_MODEL_H
+#define DEVICE_LIST_SORT_FILTER_PROXY_MODEL_H
+
+#include "DeviceListTableModel.h"
+#include <QSortFilterProxyModel>
+#include <QAbstractItemModel>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+/*
+ * Filters the device list on the description with a wildcard pattern.
+ *
+ * The literal parts of the pattern must be contained in the description,
+ * so the trigram index of the source model gives the candidate rows.
+ * filterAcceptsRow() rejects the other rows without reading their data,
+ * and only checks the candidates with the regular expression.
+ */
+class DeviceListSortFilterProxyModel : public QSortFilterProxyModel
+{
+  Q_OBJECT
+
+ public:
+
+  explicit
+  DeviceListSortFilterProxyModel(QObject *parent = nullptr);
+
+  /*
+   * Must be a DeviceListTableModel
+   */
+  void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+  /*
+   * Returns false if wildcard is not a valid pattern,
+   * in which case the filter is removed
+   */
+  bool setWildcardFilter(const QString & wildcard);
+
+  static
+  QStringList literalPartsOfWildcard(const QString & wildcard);
+
+ protected:
+
+  bool filterAcceptsRow(int sourceRow, const QModelIndex & sourceParent) const override;
+
+ private:
+
+  void invalidateCandidates() noexcept;
+  void updateCandidatesOnDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight);
+  void updateCandidates() const;
+
+  DeviceListTableModel *mDeviceListModel = nullptr;
+  QStringList mLiteralParts;
+  mutable bool mCandidatesAreStale = true;
+  mutable bool mHasCandidates = false;
+  mutable std::vector<bool> mRowIsCandidate;
+};
+
+#endif // #ifndef DEVICE_LIST_SORT_FILTER_PROXY_MODEL_H
@@ -19,6 +19,12 @@ struct DeviceListRecord
   std::string description;
 };
 
+inline
+bool operator==(const DeviceListRecord & a, const DeviceListRecord & b) noexcept
+{
+  return (a.id == b.id) && (a.description == b.description);
+}
+
 using DeviceListTable = std::vector<DeviceListRecord>;
 
 #endif // #ifndef DEVICE_LIST_TABLE_H
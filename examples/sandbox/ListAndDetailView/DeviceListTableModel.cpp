@@ -8,8 +8,9 @@
  **
  *****************************************************************************************/
 #include "DeviceListTableModel.h"
-#include "Mdt/ItemModel/StlHelpers.h"
 #include <QString>
+#include <iterator>
+#include <utility>
 #include <cassert>
 
 using namespace Mdt::ItemModel;
@@ -18,6 +19,7 @@ using namespace Mdt::ItemModel;
 DeviceListTableModel::DeviceListTableModel(QObject *parent)
  : AbstractTableModel(parent)
 {
+  addColumnTrigramIndex( descriptionColumn() );
 }
 
 void DeviceListTableModel::setRecord(int row, const DeviceListRecord & record) noexcept
@@ -25,16 +27,19 @@ void DeviceListTableModel::setRecord(int row, const DeviceListRecord & record) n
   assert( rowIndexIsInRange(row) );
 
   const auto sRow = static_cast<size_t>(row);
-  mTable[sRow] = record;
+  mTable.mutableAt(sRow) = record;
 
   emitRowDataChanged(row);
 }
 
-void DeviceListTableModel::setTable(const DeviceListTable & table)
+void DeviceListTableModel::setTable(DeviceListTable && table)
 {
-  beginResetModel();
-  mTable = table;
-  endResetModel();
+  ChunkedTable<DeviceListRecord> newTable( std::make_move_iterator( table.begin() ), std::make_move_iterator( table.end() ) );
+  table.clear();
+
+  replaceTableByKey(mTable, std::move(newTable), mReclaimer, [](const DeviceListRecord & record){
+    return record.id;
+  });
 }
 
 int DeviceListTableModel::rowCountWithoutParentIndex() const noexcept
@@ -89,10 +94,10 @@ bool DeviceListTableModel::setEditRoleData(const QModelIndex & index, const QVar
 
   switch(column){
     case Column::Id:
-      mTable[row].id = value.toInt();
+      mTable.mutableAt(row).id = value.toInt();
       return true;
     case Column::Description:
-      mTable[row].description = value.toString().toStdString();
+      mTable.mutableAt(row).description = value.toString().toStdString();
       return true;
   };
 
@@ -108,7 +113,7 @@ void DeviceListTableModel::doInsertRows(int row, int count) noexcept
 {
   assert( rowAndCountIsValidForInsertRows(row, count) );
 
-  insertToStlContainer( mTable, row, count, DeviceListRecord() );
+  mTable.insert( static_cast<size_t>(row), static_cast<size_t>(count), DeviceListRecord() );
 }
 
 bool DeviceListTableModel::doSupportsRemoveRows() const noexcept
@@ -120,5 +125,5 @@ void DeviceListTableModel::doRemoveRows(int row, int count) noexcept
 {
   assert( rowAndCountIsValidForRemoveRows(row, count) );
 
-  removeFromStlContainer(mTable, row, count);
+  mTable.erase( static_cast<size_t>(row), static_cast<size_t>(count) );
 }
@@ -12,6 +12,9 @@
 
 #include "DeviceListTable.h"
 #include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemModel/ChunkedTable.h"
+#include "Mdt/ItemModel/ChunkedTableSnapshot.h"
+#include "Mdt/ItemModel/TableReclaimer.h"
 #include <QObject>
 #include <QVariant>
 #include <string>
@@ -36,11 +39,30 @@ class DeviceListTableModel : public Mdt::ItemModel::AbstractTableModel
     return static_cast<int>(Column::Id);
   }
 
+  static
+  constexpr
+  int descriptionColumn()
+  {
+    return static_cast<int>(Column::Description);
+  }
+
+  using Snapshot = Mdt::ItemModel::ChunkedTableSnapshot<DeviceListRecord>;
+
   DeviceListTableModel(QObject *parent = nullptr);
 
   void setRecord(int row, const DeviceListRecord & record) noexcept;
 
-  void setTable(const DeviceListTable & table);
+  /*
+   * Only the differences with the current records are notified,
+   * so a refresh keeps the selection and the scroll position.
+   * The replaced records are destroyed in the thread of the reclaimer
+   */
+  void setTable(DeviceListTable && table);
+
+  Snapshot snapshot() const noexcept
+  {
+    return mTable.snapshot();
+  }
 
  private:
 
@@ -54,7 +76,8 @@ class DeviceListTableModel : public Mdt::ItemModel::AbstractTableModel
   bool doSupportsRemoveRows() const noexcept override;
   void doRemoveRows(int row, int count) noexcept override;
 
-  DeviceListTable mTable;
+  Mdt::ItemModel::ChunkedTable<DeviceListRecord> mTable;
+  Mdt::ItemModel::TableReclaimer mReclaimer;
 };
 
 #endif // #ifndef DEVICE_LIST_TABLE_MODEL_H
@@ -35,7 +35,6 @@ ListAndDetailViewWidget::ListAndDetailViewWidget(std::shared_ptr<DeviceLibrary>
   mUi.setupUi(this);
 
   mListViewSortFilterModel.setSourceModel(&mListViewModel);
-  mListViewSortFilterModel.setFilterKeyColumn(1);
 
   mUi.tableView->setModel(&mListViewSortFilterModel);
   mUi.tableView->setSortingEnabled(true);
@@ -189,16 +188,11 @@ void ListAndDetailViewWidget::applyFilter() noexcept
   QLineEdit *lineEdit = mUi.filterCriteria;
   assert(lineEdit != nullptr);
 
-  const QString pattern = QRegularExpression::wildcardToRegularExpression( lineEdit->text() );
-
-  QRegularExpression regularExpression(pattern);
-
-  if( regularExpression.isValid() ){
+  if( mListViewSortFilterModel.setWildcardFilter( lineEdit->text() ) ){
     lineEdit->setToolTip( QString() );
-    mListViewSortFilterModel.setFilterRegularExpression(regularExpression);
   }else{
+    const QRegularExpression regularExpression( QRegularExpression::wildcardToRegularExpression( lineEdit->text() ) );
     lineEdit->setToolTip( regularExpression.errorString() );
-    mListViewSortFilterModel.setFilterRegularExpression( QRegularExpression() );
   }
 }
 
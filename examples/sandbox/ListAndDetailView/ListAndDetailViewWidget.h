@@ -13,12 +13,12 @@
 #include "Editor.h"
 #include "DeviceLibrary.h"
 #include "DeviceListTableModel.h"
+#include "DeviceListSortFilterProxyModel.h"
 #include "Mdt/ItemModel/ItemSelectionModel.h"
 #include "ui_ListAndDetailViewWidget.h"
 #include <QItemSelectionModel>
 #include <QWidget>
 #include <QModelIndex>
-#include <QSortFilterProxyModel>
 #include <QTimer>
 #include <memory>
 
@@ -69,7 +69,7 @@ class ListAndDetailViewWidget : public QWidget
   Ui::ListAndDetailViewWidget mUi;
   Editor mEditor;
   DeviceListTableModel mListViewModel;
-  QSortFilterProxyModel mListViewSortFilterModel;
+  DeviceListSortFilterProxyModel mListViewSortFilterModel;
   std::shared_ptr<DeviceLibrary> mDeviceLibrary;
   QTimer mResetDisplayListViewCurrentChangedEventTimer;
   std::unique_ptr<QItemSelectionModel> mListViewQtSelectionModel;
@@ -0,0 +1,807 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "ReadOnlyTableModel.h"
+#include "EditableTableModel.h"
+#include "InsertAndRemoveRowsTableModel.h"
+#include "Mdt/ItemModel/TableEditCommand.h"
+#include "Mdt/ItemModel/TypedColumnHelpers.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include "Mdt/ItemModel/TableReclaimer.h"
+#include <QStandardItemModel>
+#include <QStandardItem>
+#include <QSortFilterProxyModel>
+#include <QAbstractItemModel>
+#include <QModelIndex>
+#include <QModelIndexList>
+#include <QVariant>
+#include <QString>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+using namespace Mdt::ItemModel;
+
+/*
+ * Row counts used for insert and remove benchmarks
+ */
+constexpr int smallRowCount = 1'000;
+constexpr int mediumRowCount = 100'000;
+constexpr int largeRowCount = 1'000'000;
+
+/*
+ * Row count used for data() and setData() benchmarks
+ */
+constexpr int dataRowCount = 10'000;
+
+
+void populateReadOnlyModelWithRowCount(ReadOnlyTableModel & model, int rowCount)
+{
+  assert( rowCount > 0 );
+
+  ReadOnlyTableModel::Table table;
+  table.reserve( static_cast<size_t>(rowCount) );
+
+  for(int row = 0; row < rowCount; ++row){
+    table.push_back( {row, "A"} );
+  }
+
+  model.setTable(table);
+}
+
+void populateEditableModelWithRowCount(EditableTableModel & model, int rowCount)
+{
+  assert( rowCount > 0 );
+
+  EditableTableModel::Table table;
+  table.reserve( static_cast<size_t>(rowCount) );
+
+  for(int row = 0; row < rowCount; ++row){
+    table.push_back( {row, "A"} );
+  }
+
+  model.setTable(table);
+}
+
+void populateInsertAndRemoveRowsModelWithRowCount(InsertAndRemoveRowsTableModel & model, int rowCount)
+{
+  assert( rowCount > 0 );
+
+  InsertAndRemoveRowsTableModel::Table table( static_cast<size_t>(rowCount) );
+
+  model.setTable(table);
+}
+
+/*
+ * Creates a 2 columns standard item model
+ * that has the same content than populateReadOnlyModelWithRowCount()
+ */
+void populateStandardItemModelWithRowCount(QStandardItemModel & model, int rowCount)
+{
+  assert( rowCount > 0 );
+
+  model.clear();
+  model.setColumnCount(2);
+  model.setRowCount(rowCount);
+
+  for(int row = 0; row < rowCount; ++row){
+    model.setItem( row, 0, new QStandardItem( QString::number(row) ) );
+    model.setItem( row, 1, new QStandardItem( QStringLiteral("A") ) );
+  }
+}
+
+/*
+ * Creates a 2 columns standard item model with empty cells.
+ * Used for structural changes benchmarks,
+ * where allocating a QStandardItem per cell would only measure the setup
+ */
+void populateStandardItemModelWithEmptyRowCount(QStandardItemModel & model, int rowCount)
+{
+  assert( rowCount > 0 );
+
+  model.clear();
+  model.setColumnCount(2);
+  model.setRowCount(rowCount);
+}
+
+/*
+ * Reads the data of each cell of model for given role
+ * and returns a value that depends on it,
+ * so the compiler can not optimize the calls away
+ */
+int readAllData(const QAbstractItemModel & model, int role)
+{
+  int validCount = 0;
+  const int rowCount = model.rowCount();
+  const int columnCount = model.columnCount();
+
+  for(int row = 0; row < rowCount; ++row){
+    for(int column = 0; column < columnCount; ++column){
+      if( model.data(model.index(row, column), role).isValid() ){
+        ++validCount;
+      }
+    }
+  }
+
+  return validCount;
+}
+
+/*
+ * Reads the display role data of the rows a view would show
+ * when its viewport starts at firstRow
+ */
+int readVisibleWindow(const QAbstractItemModel & model, int firstRow, int visibleRowCount)
+{
+  int validCount = 0;
+  const int lastRow = std::min(firstRow + visibleRowCount, model.rowCount()) - 1;
+  const int columnCount = model.columnCount();
+
+  for(int row = firstRow; row <= lastRow; ++row){
+    for(int column = 0; column < columnCount; ++column){
+      if( model.data(model.index(row, column), Qt::DisplayRole).isValid() ){
+        ++validCount;
+      }
+    }
+  }
+
+  return validCount;
+}
+
+/*
+ * Functions that returns the row at which to insert or remove
+ */
+using RowSelector = int(*)(const QAbstractItemModel &);
+
+int firstRow(const QAbstractItemModel &)
+{
+  return 0;
+}
+
+int middleRow(const QAbstractItemModel & model)
+{
+  return model.rowCount() / 2;
+}
+
+int lastRowPlusOne(const QAbstractItemModel & model)
+{
+  return model.rowCount();
+}
+
+int lastRow(const QAbstractItemModel & model)
+{
+  return model.rowCount() - 1;
+}
+
+/*
+ * Inserts 1 row per run at the row returned by rowForInsert.
+ * The inserted rows are removed after each sample,
+ * so that the row count stays stable for all samples
+ */
+void benchmarkInsertRows(Catch::Benchmark::Chronometer & meter, QAbstractItemModel & model, RowSelector rowForInsert)
+{
+  const int initialRowCount = model.rowCount();
+  const int row = rowForInsert(model);
+
+  meter.measure([&model, row]{
+    return model.insertRows(row, 1);
+  });
+
+  model.removeRows( row, model.rowCount() - initialRowCount );
+  assert( model.rowCount() == initialRowCount );
+}
+
+/*
+ * Removes 1 row per run at the row returned by rowForRemove.
+ * Before each sample, the rows that will be removed are inserted,
+ * so that the row count stays stable for all samples
+ */
+void benchmarkRemoveRows(Catch::Benchmark::Chronometer & meter, QAbstractItemModel & model, RowSelector rowForRemove)
+{
+  const int initialRowCount = model.rowCount();
+  model.insertRows( rowForRemove(model), meter.runs() );
+
+  meter.measure([&model, rowForRemove]{
+    return model.removeRows(rowForRemove(model), 1);
+  });
+
+  assert( model.rowCount() == initialRowCount );
+}
+
+
+TEST_CASE("data")
+{
+  SECTION("AbstractTableModel")
+  {
+    ReadOnlyTableModel model;
+    populateReadOnlyModelWithRowCount(model, dataRowCount);
+    int validCount = 0;
+
+    BENCHMARK("DisplayRole")
+    {
+      validCount = readAllData(model, Qt::DisplayRole);
+    };
+    REQUIRE( validCount == 2*dataRowCount );
+
+    BENCHMARK("EditRole")
+    {
+      validCount = readAllData(model, Qt::EditRole);
+    };
+    REQUIRE( validCount == 2*dataRowCount );
+
+    BENCHMARK("ToolTipRole")
+    {
+      validCount = readAllData(model, Qt::ToolTipRole);
+    };
+    REQUIRE( validCount == 0 );
+  }
+
+  /*
+   * A view repaints the same visible cells many times,
+   * for example while the user scrolls slowly
+   */
+  SECTION("AbstractTableModel visible window")
+  {
+    constexpr int visibleRowCount = 50;
+    ReadOnlyTableModel model;
+    populateReadOnlyModelWithRowCount(model, dataRowCount);
+    int validCount = 0;
+
+    BENCHMARK("DisplayRole, without cache")
+    {
+      for(int firstRow = 0; firstRow < 10; ++firstRow){
+        validCount = readVisibleWindow(model, firstRow, visibleRowCount);
+      }
+    };
+    REQUIRE( validCount == 2*visibleRowCount );
+
+    model.setDisplayDataCacheCapacity(4*visibleRowCount);
+
+    BENCHMARK("DisplayRole, with display data cache")
+    {
+      for(int firstRow = 0; firstRow < 10; ++firstRow){
+        validCount = readVisibleWindow(model, firstRow, visibleRowCount);
+      }
+    };
+    REQUIRE( validCount == 2*visibleRowCount );
+  }
+
+  SECTION("QStandardItemModel")
+  {
+    QStandardItemModel model;
+    populateStandardItemModelWithRowCount(model, dataRowCount);
+    int validCount = 0;
+
+    BENCHMARK("DisplayRole")
+    {
+      validCount = readAllData(model, Qt::DisplayRole);
+    };
+    REQUIRE( validCount == 2*dataRowCount );
+
+    BENCHMARK("EditRole")
+    {
+      validCount = readAllData(model, Qt::EditRole);
+    };
+    REQUIRE( validCount == 2*dataRowCount );
+
+    BENCHMARK("ToolTipRole")
+    {
+      validCount = readAllData(model, Qt::ToolTipRole);
+    };
+    REQUIRE( validCount == 0 );
+  }
+}
+
+TEST_CASE("insertRows")
+{
+  const int rowCount = GENERATE(smallRowCount, mediumRowCount, largeRowCount);
+  const std::string rowCountStr = std::to_string(rowCount) + " rows";
+
+  SECTION("AbstractTableModel")
+  {
+    InsertAndRemoveRowsTableModel model;
+    populateInsertAndRemoveRowsModelWithRowCount(model, rowCount);
+
+    BENCHMARK_ADVANCED("front, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkInsertRows(meter, model, firstRow);
+    };
+
+    BENCHMARK_ADVANCED("middle, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkInsertRows(meter, model, middleRow);
+    };
+
+    BENCHMARK_ADVANCED("back, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkInsertRows(meter, model, lastRowPlusOne);
+    };
+
+    REQUIRE( model.rowCount() == rowCount );
+  }
+
+  SECTION("QStandardItemModel")
+  {
+    QStandardItemModel model;
+    populateStandardItemModelWithEmptyRowCount(model, rowCount);
+
+    BENCHMARK_ADVANCED("front, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkInsertRows(meter, model, firstRow);
+    };
+
+    BENCHMARK_ADVANCED("middle, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkInsertRows(meter, model, middleRow);
+    };
+
+    BENCHMARK_ADVANCED("back, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkInsertRows(meter, model, lastRowPlusOne);
+    };
+
+    REQUIRE( model.rowCount() == rowCount );
+  }
+}
+
+TEST_CASE("removeRows")
+{
+  const int rowCount = GENERATE(smallRowCount, mediumRowCount, largeRowCount);
+  const std::string rowCountStr = std::to_string(rowCount) + " rows";
+
+  SECTION("AbstractTableModel")
+  {
+    InsertAndRemoveRowsTableModel model;
+    populateInsertAndRemoveRowsModelWithRowCount(model, rowCount);
+
+    BENCHMARK_ADVANCED("front, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkRemoveRows(meter, model, firstRow);
+    };
+
+    BENCHMARK_ADVANCED("middle, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkRemoveRows(meter, model, middleRow);
+    };
+
+    BENCHMARK_ADVANCED("back, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkRemoveRows(meter, model, lastRow);
+    };
+
+    REQUIRE( model.rowCount() == rowCount );
+  }
+
+  SECTION("QStandardItemModel")
+  {
+    QStandardItemModel model;
+    populateStandardItemModelWithEmptyRowCount(model, rowCount);
+
+    BENCHMARK_ADVANCED("front, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkRemoveRows(meter, model, firstRow);
+    };
+
+    BENCHMARK_ADVANCED("middle, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkRemoveRows(meter, model, middleRow);
+    };
+
+    BENCHMARK_ADVANCED("back, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+    {
+      benchmarkRemoveRows(meter, model, lastRow);
+    };
+
+    REQUIRE( model.rowCount() == rowCount );
+  }
+}
+
+/*
+ * setData() emits dataChanged(),
+ * which is processed by each attached proxy model.
+ *
+ * We edit the name column, on which the proxy sorts and filters,
+ * so the proxy has to re-evaluate the changed row
+ */
+TEST_CASE("setData_proxyFanOut")
+{
+  int value = 0;
+
+  SECTION("AbstractTableModel")
+  {
+    EditableTableModel model;
+    populateEditableModelWithRowCount(model, dataRowCount);
+    const QModelIndex index = model.index( middleRow(model), 1 );
+
+    BENCHMARK("no proxy")
+    {
+      return model.setData( index, QString::number(++value) );
+    };
+
+    QSortFilterProxyModel proxyModel;
+    proxyModel.setSourceModel(&model);
+
+    BENCHMARK("1 proxy")
+    {
+      return model.setData( index, QString::number(++value) );
+    };
+
+    proxyModel.setDynamicSortFilter(true);
+    proxyModel.setFilterKeyColumn(1);
+    proxyModel.setFilterFixedString( QStringLiteral("1") );
+    proxyModel.sort(1);
+
+    BENCHMARK("1 sort and filter proxy")
+    {
+      return model.setData( index, QString::number(++value) );
+    };
+
+    REQUIRE( proxyModel.rowCount() <= dataRowCount );
+  }
+
+  SECTION("QStandardItemModel")
+  {
+    QStandardItemModel model;
+    populateStandardItemModelWithRowCount(model, dataRowCount);
+    const QModelIndex index = model.index( middleRow(model), 1 );
+
+    BENCHMARK("no proxy")
+    {
+      return model.setData( index, QString::number(++value) );
+    };
+
+    QSortFilterProxyModel proxyModel;
+    proxyModel.setSourceModel(&model);
+
+    BENCHMARK("1 proxy")
+    {
+      return model.setData( index, QString::number(++value) );
+    };
+
+    proxyModel.setDynamicSortFilter(true);
+    proxyModel.setFilterKeyColumn(1);
+    proxyModel.setFilterFixedString( QStringLiteral("1") );
+    proxyModel.sort(1);
+
+    BENCHMARK("1 sort and filter proxy")
+    {
+      return model.setData( index, QString::number(++value) );
+    };
+
+    REQUIRE( proxyModel.rowCount() <= dataRowCount );
+  }
+}
+
+/*
+ * Compares editing a block of rows with one setData() per item
+ * (which is what a worker thread does when it marshals each edit)
+ * with applying the same edits in a batch,
+ * as TableEditQueue does when it is drained.
+ *
+ * A sorting proxy model is attached,
+ * so each dataChanged() has a cost.
+ */
+TEST_CASE("applyEditCommands")
+{
+  const int editCount = GENERATE(10, 100, 1'000);
+  const std::string editCountStr = std::to_string(editCount) + " edits";
+  int value = 0;
+
+  EditableTableModel model;
+  populateEditableModelWithRowCount(model, dataRowCount);
+  QSortFilterProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  proxyModel.setDynamicSortFilter(true);
+  proxyModel.sort(1);
+
+  BENCHMARK("setData, " + editCountStr)
+  {
+    ++value;
+    for(int row = 0; row < editCount; ++row){
+      model.setData( model.index(row, 1), QString::number(value) );
+    }
+  };
+
+  std::vector<TableEditCommand> commands;
+  commands.reserve( static_cast<size_t>(editCount) );
+
+  BENCHMARK("applyEditCommands, " + editCountStr)
+  {
+    ++value;
+    commands.clear();
+    for(int row = 0; row < editCount; ++row){
+      commands.push_back( TableEditCommand::setData( row, 1, QString::number(value) ) );
+    }
+    return model.applyEditCommands(commands);
+  };
+
+  REQUIRE( proxyModel.rowCount() == dataRowCount );
+}
+
+/*
+ * Compares refreshing a table, where only a few records changed,
+ * with a model reset and with replaceTableByKey().
+ *
+ * A sorting proxy model is attached,
+ * so a model reset makes it sort all the rows again.
+ */
+TEST_CASE("replaceTable")
+{
+  const int rowCount = mediumRowCount;
+  int value = 0;
+
+  ReadOnlyTableModel::Table resetTable;
+  InsertAndRemoveRowsTableModel::Table keyedTable;
+  resetTable.reserve( static_cast<size_t>(rowCount) );
+  keyedTable.reserve( static_cast<size_t>(rowCount) );
+  for(int row = 0; row < rowCount; ++row){
+    resetTable.push_back( {row, "A"} );
+    keyedTable.push_back( {row, "A"} );
+  }
+
+  SECTION("model reset")
+  {
+    ReadOnlyTableModel model;
+    model.setTable(resetTable);
+    QSortFilterProxyModel proxyModel;
+    proxyModel.setSourceModel(&model);
+    proxyModel.sort(1);
+
+    BENCHMARK("setTable, 10 changes")
+    {
+      ++value;
+      for(int i = 0; i < 10; ++i){
+        resetTable[static_cast<size_t>(i * rowCount / 10)].name = std::to_string(value);
+      }
+      model.setTable(resetTable);
+    };
+
+    REQUIRE( proxyModel.rowCount() == rowCount );
+  }
+
+  SECTION("keyed diff")
+  {
+    InsertAndRemoveRowsTableModel model;
+    model.setTable(keyedTable);
+    QSortFilterProxyModel proxyModel;
+    proxyModel.setSourceModel(&model);
+    proxyModel.sort(1);
+
+    BENCHMARK("replaceTableById, 10 changes")
+    {
+      ++value;
+      for(int i = 0; i < 10; ++i){
+        keyedTable[static_cast<size_t>(i * rowCount / 10)].name = std::to_string(value);
+      }
+      model.replaceTableById(keyedTable);
+    };
+
+    REQUIRE( proxyModel.rowCount() == rowCount );
+  }
+}
+
+/*
+ * Returns a table whose names are too long for the small string optimization,
+ * so destroying it frees each name
+ */
+ReadOnlyTableModel::Table makeTableWithLongNames(int rowCount)
+{
+  ReadOnlyTableModel::Table table;
+  table.reserve( static_cast<size_t>(rowCount) );
+
+  for(int row = 0; row < rowCount; ++row){
+    table.push_back( {row, "Name of the record number " + std::to_string(row)} );
+  }
+
+  return table;
+}
+
+/*
+ * Compares the time spent in the GUI thread to replace a big table:
+ * - copying the new table, the old one being destroyed during the reset
+ * - swapping the tables, the old one being destroyed after the reset
+ * - swapping the tables, the old one being destroyed by a TableReclaimer
+ *
+ * The tables given to the model are prepared before each sample.
+ */
+TEST_CASE("replaceTable_largeTable")
+{
+  const int rowCount = largeRowCount;
+  const std::string rowCountStr = std::to_string(rowCount) + " rows";
+
+  ReadOnlyTableModel model;
+  const ReadOnlyTableModel::Table table = makeTableWithLongNames(rowCount);
+  model.setTable(table);
+
+  BENCHMARK_ADVANCED("setTable (copy), " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&model, &table]{
+      model.setTable(table);
+    });
+  };
+
+  BENCHMARK_ADVANCED("replaceTable, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<ReadOnlyTableModel::Table> newTables( static_cast<size_t>( meter.runs() ), table );
+
+    meter.measure([&model, &newTables](int run){
+      model.replaceTable( std::move( newTables[static_cast<size_t>(run)] ) );
+    });
+  };
+
+  TableReclaimer reclaimer;
+
+  BENCHMARK_ADVANCED("replaceTable with a reclaimer, " + rowCountStr)(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<ReadOnlyTableModel::Table> newTables( static_cast<size_t>( meter.runs() ), table );
+
+    meter.measure([&model, &newTables, &reclaimer](int run){
+      model.replaceTable( std::move( newTables[static_cast<size_t>(run)] ), reclaimer );
+    });
+    reclaimer.waitForReclaimed();
+  };
+
+  REQUIRE( model.rowCount() == rowCount );
+}
+
+/*
+ * Compares finding the row of a id in a big table
+ * with QAbstractItemModel::match(), which reads the data of each row,
+ * and with a column hash index
+ */
+TEST_CASE("match")
+{
+  ReadOnlyTableModel model;
+  populateReadOnlyModelWithRowCount(model, largeRowCount);
+  const QModelIndex start = model.index(0, 0);
+  const int id = largeRowCount - 10;
+  QModelIndexList indexes;
+
+  BENCHMARK("match, no index")
+  {
+    indexes = model.match(start, Qt::DisplayRole, id, 1, Qt::MatchExactly);
+  };
+  REQUIRE( indexes.size() == 1 );
+
+  model.addColumnHashIndex(0);
+  REQUIRE( model.rowForKey(0, id) == id );
+
+  BENCHMARK("match, hash index")
+  {
+    indexes = model.match(start, Qt::DisplayRole, id, 1, Qt::MatchExactly);
+  };
+  REQUIRE( indexes.size() == 1 );
+
+  BENCHMARK("rowForKey")
+  {
+    return model.rowForKey(0, id);
+  };
+}
+
+/*
+ * Keyboard search in a view calls match() with Qt::MatchStartsWith
+ * for each typed character.
+ * Compares it without and with a column prefix index.
+ */
+TEST_CASE("match_startsWith")
+{
+  ReadOnlyTableModel::Table table;
+  table.reserve( static_cast<size_t>(largeRowCount) );
+  for(int row = 0; row < largeRowCount; ++row){
+    table.push_back( {row, "N" + std::to_string(row)} );
+  }
+  ReadOnlyTableModel model;
+  model.setTable(table);
+  const QModelIndex start = model.index(0, 1);
+  const QString prefix = QStringLiteral("N99999");
+  const Qt::MatchFlags flags(Qt::MatchStartsWith | Qt::MatchWrap);
+  QModelIndexList indexes;
+
+  BENCHMARK("match, no index")
+  {
+    indexes = model.match(start, Qt::DisplayRole, prefix, 1, flags);
+  };
+  REQUIRE( indexes.size() == 1 );
+
+  model.addColumnPrefixIndex(1);
+  REQUIRE( !model.rowsStartingWith(1, prefix).isEmpty() );
+
+  BENCHMARK("match, prefix index")
+  {
+    indexes = model.match(start, Qt::DisplayRole, prefix, 1, flags);
+  };
+  REQUIRE( indexes.size() == 1 );
+}
+
+/*
+ * A substring filter has to read the data of each row.
+ * Compares match() with Qt::MatchContains without and with a column trigram index,
+ * which only checks the rows that contain all the trigrams of the searched text.
+ */
+TEST_CASE("match_contains")
+{
+  ReadOnlyTableModel::Table table;
+  table.reserve( static_cast<size_t>(largeRowCount) );
+  for(int row = 0; row < largeRowCount; ++row){
+    table.push_back( {row, "N" + std::to_string(row)} );
+  }
+  ReadOnlyTableModel model;
+  model.setTable(table);
+  const QModelIndex start = model.index(0, 1);
+  const QString text = QStringLiteral("99998");
+  QModelIndexList indexes;
+
+  BENCHMARK("match, no index")
+  {
+    indexes = model.match(start, Qt::DisplayRole, text, -1, Qt::MatchContains);
+  };
+  const int expectedCount = indexes.size();
+  REQUIRE( expectedCount > 0 );
+
+  model.addColumnTrigramIndex(1);
+  REQUIRE( !model.rowsThatMayContain(1, text).isEmpty() );
+
+  BENCHMARK("match, trigram index")
+  {
+    indexes = model.match(start, Qt::DisplayRole, text, -1, Qt::MatchContains);
+  };
+  REQUIRE( indexes.size() == expectedCount );
+}
+
+/*
+ * Sums the values of a column, reading them with data() ,
+ * which boxes each value in a QVariant,
+ * and with the typed column access
+ */
+TEST_CASE("sumColumn")
+{
+  ReadOnlyTableModel model;
+  populateReadOnlyModelWithRowCount(model, largeRowCount);
+  const RowRange rows = RowRange::fromFirstAndLastRow(0, largeRowCount - 1);
+  long long expectedSum = 0;
+  for(int row = 0; row < largeRowCount; ++row){
+    expectedSum += row;
+  }
+
+  BENCHMARK("data()")
+  {
+    long long sum = 0;
+    for(int row = 0; row < largeRowCount; ++row){
+      sum += model.data( model.index(row, 0) ).toInt();
+    }
+    return sum;
+  };
+
+  BENCHMARK("typedColumn()")
+  {
+    long long sum = 0;
+    const TypedColumn<int> values = model.typedColumn<int>(0);
+    for(int row = 0; row < values.rowCount(); ++row){
+      sum += values[row];
+    }
+    return sum;
+  };
+
+  BENCHMARK("forEachColumnValue()")
+  {
+    long long sum = 0;
+    forEachColumnValue<int>(model, 0, rows, [&sum](int, int value){
+      sum += value;
+    });
+    return sum;
+  };
+
+  long long sum = 0;
+  forEachColumnValue<int>(model, 0, rows, [&sum](int, int value){
+    sum += value;
+  });
+  REQUIRE( sum == expectedSum );
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/ChunkedTable.h"
+#include <vector>
+#include <string>
+
+/*
+ * Compares giving a worker a copy of the table (deep copy of a std::vector)
+ * to a snapshot of a ChunkedTable, followed by a edit in the GUI thread
+ */
+
+using namespace Mdt::ItemModel;
+
+struct Record
+{
+  int id = 0;
+  std::string name;
+};
+
+std::vector<Record> makeRecords(int count)
+{
+  std::vector<Record> records;
+  records.reserve( static_cast<size_t>(count) );
+
+  for(int id = 0; id < count; ++id){
+    records.push_back( {id, "Name " + std::to_string(id)} );
+  }
+
+  return records;
+}
+
+
+TEST_CASE("snapshot")
+{
+  const int size = GENERATE(1'000, 100'000, 1'000'000);
+  const std::string suffix = ", " + std::to_string(size) + " rows";
+  const auto records = makeRecords(size);
+  const size_t middle = static_cast<size_t>(size / 2);
+
+  std::vector<Record> vectorTable = records;
+  ChunkedTable<Record> chunkedTable( records.cbegin(), records.cend() );
+
+  BENCHMARK("std::vector copy then edit" + suffix)
+  {
+    const std::vector<Record> copy = vectorTable;
+    vectorTable[middle].id = -1;
+    return copy.size();
+  };
+
+  BENCHMARK("ChunkedTable snapshot then edit" + suffix)
+  {
+    const auto snapshot = chunkedTable.snapshot();
+    chunkedTable.mutableAt(middle).id = -1;
+    return snapshot.size();
+  };
+
+  BENCHMARK("std::vector scan" + suffix)
+  {
+    long long sum = 0;
+    for(const auto & record : vectorTable){
+      sum += record.id;
+    }
+    return sum;
+  };
+
+  BENCHMARK("ChunkedTable snapshot scan" + suffix)
+  {
+    const auto snapshot = chunkedTable.snapshot();
+    long long sum = 0;
+    for(const auto & record : snapshot){
+      sum += record.id;
+    }
+    return sum;
+  };
+}
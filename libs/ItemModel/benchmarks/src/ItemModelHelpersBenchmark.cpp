@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "ReadOnlyTableModel.h"
+#include "InsertAndRemoveRowsTableModel.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include <QStandardItemModel>
+#include <QStandardItem>
+#include <QItemSelectionModel>
+#include <QItemSelection>
+#include <QAbstractItemModel>
+#include <QModelIndex>
+#include <QModelIndexList>
+#include <QVariant>
+#include <QString>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <string>
+#include <cassert>
+
+using namespace Mdt::ItemModel;
+
+constexpr int rowCount = 10'000;
+
+
+void populateReadOnlyModelWithRowCount(ReadOnlyTableModel & model, int rowCount)
+{
+  assert( rowCount > 0 );
+
+  ReadOnlyTableModel::Table table;
+  table.reserve( static_cast<size_t>(rowCount) );
+
+  for(int row = 0; row < rowCount; ++row){
+    table.push_back( {row, "A"} );
+  }
+
+  model.setTable(table);
+}
+
+/*
+ * Selects each rowStep row in selectionModel,
+ * starting from row 0.
+ *
+ * With a rowStep > 1, the selection is scattered,
+ * and removeSelectedRows() has to remove 1 row at a time
+ */
+void selectEachNthRow(QItemSelectionModel & selectionModel, int rowStep)
+{
+  assert( selectionModel.model() != nullptr );
+  assert( rowStep >= 1 );
+
+  const QAbstractItemModel *model = selectionModel.model();
+  const int lastColumn = model->columnCount() - 1;
+  QItemSelection selection;
+
+  for(int row = 0; row < model->rowCount(); row += rowStep){
+    selection.select( model->index(row, 0), model->index(row, lastColumn) );
+  }
+
+  selectionModel.select(selection, QItemSelectionModel::Select);
+}
+
+/*
+ * Naive implementation, as often found in applications:
+ * remove each selected row, starting from the last one
+ */
+bool removeSelectedRowsOneByOne(QItemSelectionModel & selectionModel)
+{
+  assert( selectionModel.model() != nullptr );
+
+  QAbstractItemModel *model = selectionModel.model();
+  QModelIndexList indexList = selectionModel.selectedRows();
+
+  std::sort(indexList.begin(), indexList.end(), [](const QModelIndex & a, const QModelIndex & b){
+    return a.row() > b.row();
+  });
+
+  for(const QModelIndex & index : indexList){
+    if( !model->removeRows(index.row(), 1) ){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Removing rows modifies the model,
+ * so each run needs its own model and selection model.
+ * They are created before the measurement
+ */
+template<typename Model>
+struct RemoveSelectedRowsFixture
+{
+  Model model;
+  QItemSelectionModel selectionModel;
+
+  RemoveSelectedRowsFixture(int rowStep)
+   : selectionModel(&model)
+  {
+    populate(model);
+    selectEachNthRow(selectionModel, rowStep);
+  }
+
+  static void populate(InsertAndRemoveRowsTableModel & model)
+  {
+    model.setTable( InsertAndRemoveRowsTableModel::Table( static_cast<size_t>(rowCount) ) );
+  }
+
+  static void populate(QStandardItemModel & model)
+  {
+    model.setColumnCount(2);
+    model.setRowCount(rowCount);
+  }
+};
+
+template<typename Model>
+using RemoveSelectedRowsFixtureList = std::vector< std::unique_ptr< RemoveSelectedRowsFixture<Model> > >;
+
+template<typename Model>
+RemoveSelectedRowsFixtureList<Model> makeRemoveSelectedRowsFixtureList(int count, int rowStep)
+{
+  RemoveSelectedRowsFixtureList<Model> fixtures;
+
+  for(int i = 0; i < count; ++i){
+    fixtures.push_back( std::make_unique< RemoveSelectedRowsFixture<Model> >(rowStep) );
+  }
+
+  return fixtures;
+}
+
+
+TEST_CASE("getModelData")
+{
+  ReadOnlyTableModel model;
+  populateReadOnlyModelWithRowCount(model, rowCount);
+  int validCount = 0;
+
+  BENCHMARK("getModelData()")
+  {
+    validCount = 0;
+    for(int row = 0; row < rowCount; ++row){
+      if( getModelData(model, row, 1).isValid() ){
+        ++validCount;
+      }
+    }
+  };
+  REQUIRE( validCount == rowCount );
+
+  BENCHMARK("QAbstractItemModel::data()")
+  {
+    validCount = 0;
+    for(int row = 0; row < rowCount; ++row){
+      if( model.data( model.index(row, 1) ).isValid() ){
+        ++validCount;
+      }
+    }
+  };
+  REQUIRE( validCount == rowCount );
+}
+
+TEST_CASE("removeSelectedRows")
+{
+  const int rowStep = GENERATE(1, 2, 10, 100);
+  const std::string rowStepStr = "each " + std::to_string(rowStep) + " row";
+
+  SECTION("AbstractTableModel")
+  {
+    using Model = InsertAndRemoveRowsTableModel;
+
+    BENCHMARK_ADVANCED("removeSelectedRows(), " + rowStepStr)(Catch::Benchmark::Chronometer meter)
+    {
+      auto fixtures = makeRemoveSelectedRowsFixtureList<Model>(meter.runs(), rowStep);
+      meter.measure([&fixtures](int i){
+        return removeSelectedRows( &fixtures[static_cast<size_t>(i)]->selectionModel );
+      });
+    };
+
+    BENCHMARK_ADVANCED("one by one, " + rowStepStr)(Catch::Benchmark::Chronometer meter)
+    {
+      auto fixtures = makeRemoveSelectedRowsFixtureList<Model>(meter.runs(), rowStep);
+      meter.measure([&fixtures](int i){
+        return removeSelectedRowsOneByOne( fixtures[static_cast<size_t>(i)]->selectionModel );
+      });
+    };
+
+    RemoveSelectedRowsFixture<Model> fixture(rowStep);
+    REQUIRE( removeSelectedRows(&fixture.selectionModel) );
+    REQUIRE( fixture.model.rowCount() == rowCount - (rowCount + rowStep - 1) / rowStep );
+  }
+
+  SECTION("QStandardItemModel")
+  {
+    using Model = QStandardItemModel;
+
+    BENCHMARK_ADVANCED("removeSelectedRows(), " + rowStepStr)(Catch::Benchmark::Chronometer meter)
+    {
+      auto fixtures = makeRemoveSelectedRowsFixtureList<Model>(meter.runs(), rowStep);
+      meter.measure([&fixtures](int i){
+        return removeSelectedRows( &fixtures[static_cast<size_t>(i)]->selectionModel );
+      });
+    };
+
+    BENCHMARK_ADVANCED("one by one, " + rowStepStr)(Catch::Benchmark::Chronometer meter)
+    {
+      auto fixtures = makeRemoveSelectedRowsFixtureList<Model>(meter.runs(), rowStep);
+      meter.measure([&fixtures](int i){
+        return removeSelectedRowsOneByOne( fixtures[static_cast<size_t>(i)]->selectionModel );
+      });
+    };
+
+    RemoveSelectedRowsFixture<Model> fixture(rowStep);
+    REQUIRE( removeSelectedRows(&fixture.selectionModel) );
+    REQUIRE( fixture.model.rowCount() == rowCount - (rowCount + rowStep - 1) / rowStep );
+  }
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/StlHelpers.h"
+#include "Mdt/ItemModel/RingBuffer.h"
+#include <vector>
+#include <deque>
+#include <string>
+#include <cassert>
+
+using namespace Mdt::ItemModel;
+
+/*
+ * Similar to the records used in table models
+ */
+struct Record
+{
+  int id = 0;
+  std::string name;
+};
+
+template<typename Container>
+Container makeContainer(int size)
+{
+  assert( size > 0 );
+
+  Container container;
+  for(int i = 0; i < size; ++i){
+    container.push_back( {i, "Some name"} );
+  }
+
+  return container;
+}
+
+/*
+ * Each benchmark inserts then removes elements,
+ * so that the container size stays stable.
+ * Some benchmarks also measure the removal alone,
+ * with a container prepared before the measurement
+ */
+template<typename Container>
+void runStlHelpersBenchmarks(const std::string & containerName, int size)
+{
+  const std::string suffix = ", " + containerName + ", " + std::to_string(size) + " elements";
+  Container container = makeContainer<Container>(size);
+  const int middle = size / 2;
+  const Record record{-1, "New name"};
+
+  BENCHMARK("insert then remove first" + suffix)
+  {
+    insertToStlContainer(container, 0, 1, record);
+    removeFirstFromStlContainer(container);
+  };
+
+  BENCHMARK("insert then remove middle" + suffix)
+  {
+    insertToStlContainer(container, middle, 1, record);
+    removeFromStlContainer(container, middle, 1);
+  };
+
+  BENCHMARK("insert then remove last" + suffix)
+  {
+    insertToStlContainer(container, size, 1, record);
+    removeLastFromStlContainer(container);
+  };
+
+  BENCHMARK_ADVANCED("remove first" + suffix)(Catch::Benchmark::Chronometer meter)
+  {
+    insertToStlContainer(container, 0, meter.runs(), record);
+    meter.measure([&container]{
+      removeFirstFromStlContainer(container);
+    });
+  };
+
+  BENCHMARK_ADVANCED("remove last" + suffix)(Catch::Benchmark::Chronometer meter)
+  {
+    insertToStlContainer(container, size, meter.runs(), record);
+    meter.measure([&container]{
+      removeLastFromStlContainer(container);
+    });
+  };
+
+  REQUIRE( container.size() == static_cast<size_t>(size) );
+}
+
+
+TEST_CASE("StlHelpers")
+{
+  const int size = GENERATE(1'000, 100'000, 1'000'000);
+
+  SECTION("std::vector")
+  {
+    runStlHelpersBenchmarks< std::vector<Record> >("std::vector", size);
+  }
+
+  SECTION("std::deque")
+  {
+    runStlHelpersBenchmarks< std::deque<Record> >("std::deque", size);
+  }
+
+  SECTION("RingBuffer")
+  {
+    runStlHelpersBenchmarks< Mdt::ItemModel::RingBuffer<Record> >("RingBuffer", size);
+  }
+}
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "ReadOnlyTableModel.h"
+#include "Mdt/ItemModel/ItemSelectionModel.h"
+#include "Mdt/ItemModel/RowSelection.h"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include <QItemSelectionModel>
+#include <QItemSelection>
+#include <QModelIndex>
+#include <string>
+#include <algorithm>
+#include <cassert>
+
+using namespace Mdt::ItemModel;
+
+void populateModelWithRowCount(ReadOnlyTableModel & model, int rowCount)
+{
+  assert( rowCount > 0 );
+
+  ReadOnlyTableModel::Table table;
+  table.reserve( static_cast<size_t>(rowCount) );
+
+  for(int row = 0; row < rowCount; ++row){
+    table.push_back( {row, "A"} );
+  }
+
+  model.setTable(table);
+}
+
+/*
+ * Ranges of blockSize rows, separated by blockSize unselected rows.
+ * With a block size of 1, every other row is selected,
+ * which is the worst case: one range per selected row.
+ */
+RowSelection makeBlocksRowSelection(int rowCount, int blockSize)
+{
+  assert( rowCount > 0 );
+  assert( blockSize > 0 );
+
+  RowRangeList rowRangeList;
+
+  for(int firstRow = 0; firstRow < rowCount; firstRow += 2*blockSize){
+    const int lastRow = std::min(firstRow + blockSize, rowCount) - 1;
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow(firstRow, lastRow) );
+  }
+
+  return RowSelection::fromRowRangeList(rowRangeList);
+}
+
+/*
+ * What a application typically does without a helper
+ */
+void selectRowsOneByOne(QItemSelectionModel & selectionModel, const RowSelection & rowSelection)
+{
+  assert( selectionModel.model() != nullptr );
+
+  const QAbstractItemModel *model = selectionModel.model();
+  for(const RowRange & range : rowSelection){
+    for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+      selectionModel.select( model->index(row, 0), QItemSelectionModel::Select | QItemSelectionModel::Rows );
+    }
+  }
+}
+
+/*
+ * One call to select(), but with one range per row
+ */
+void selectRowsWithOneRangePerRow(QItemSelectionModel & selectionModel, const RowSelection & rowSelection)
+{
+  assert( selectionModel.model() != nullptr );
+
+  const QAbstractItemModel *model = selectionModel.model();
+  const int lastColumn = model->columnCount() - 1;
+  QItemSelection selection;
+  for(const RowRange & range : rowSelection){
+    for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+      selection.select( model->index(row, 0), model->index(row, lastColumn) );
+    }
+  }
+
+  selectionModel.select(selection, QItemSelectionModel::Select);
+}
+
+int selectedRowCount(const RowSelection & rowSelection) noexcept
+{
+  int count = 0;
+
+  for(const RowRange & range : rowSelection){
+    count += range.rowCount();
+  }
+
+  return count;
+}
+
+
+TEST_CASE("select_rows")
+{
+  const int rowCount = GENERATE(1'000, 10'000);
+  const int blockSize = GENERATE(1, 100);
+  ReadOnlyTableModel model;
+  populateModelWithRowCount(model, rowCount);
+  ItemSelectionModel selectionModel(&model);
+  const RowSelection rowSelection = makeBlocksRowSelection(rowCount, blockSize);
+
+  const std::string name = std::to_string(rowCount) + " rows, blocks of " + std::to_string(blockSize);
+
+  BENCHMARK("select one by one, " + name)
+  {
+    selectionModel.clearSelection();
+    selectRowsOneByOne(selectionModel, rowSelection);
+  };
+  REQUIRE( selectionModel.selectedRows().count() == selectedRowCount(rowSelection) );
+
+  BENCHMARK("select one range per row, " + name)
+  {
+    selectionModel.clearSelection();
+    selectRowsWithOneRangePerRow(selectionModel, rowSelection);
+  };
+  REQUIRE( selectionModel.selectedRows().count() == selectedRowCount(rowSelection) );
+
+  BENCHMARK("selectRows, " + name)
+  {
+    selectionModel.selectRows(rowSelection, QItemSelectionModel::ClearAndSelect);
+  };
+  REQUIRE( selectionModel.selectedRows().count() == selectedRowCount(rowSelection) );
+  REQUIRE( selectionModel.selection().count() == static_cast<int>( rowSelection.rangeCount() ) );
+}
+
+/*
+ * Selecting one by one is too slow for large models,
+ * so only selectRows() is measured here
+ */
+TEST_CASE("selectRows_large_model")
+{
+  const int rowCount = GENERATE(100'000, 1'000'000);
+  const int blockSize = GENERATE(1, 100);
+  ReadOnlyTableModel model;
+  populateModelWithRowCount(model, rowCount);
+  ItemSelectionModel selectionModel(&model);
+  const RowSelection rowSelection = makeBlocksRowSelection(rowCount, blockSize);
+
+  BENCHMARK("selectRows, " + std::to_string(rowCount) + " rows, blocks of " + std::to_string(blockSize))
+  {
+    selectionModel.selectRows(rowSelection, QItemSelectionModel::ClearAndSelect);
+  };
+  REQUIRE( selectionModel.selection().count() == static_cast<int>( rowSelection.rangeCount() ) );
+}
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "ReadOnlyTableModel.h"
+#include "Mdt/ItemModel/ProxyModelPipeline.h"
+#include "Mdt/ItemModel/RowSelection.h"
+#include <QAbstractProxyModel>
+#include <QIdentityProxyModel>
+#include <QSortFilterProxyModel>
+#include <QAbstractItemModel>
+#include <QItemSelection>
+#include <QModelIndex>
+#include <QString>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cassert>
+
+/*
+ * This benchmark characterizes how ProxyModelPipeline scales
+ * regarding the pipeline depth and the selection size.
+ *
+ * Each benchmark name contains the proxy kind, the depth and the range count,
+ * so results can be processed by a tool using a machine-readable reporter:
+ *   proxyModelPipelineBenchmark --reporter xml --out ProxyModelPipelineBenchmark.xml
+ * The ProxyModelPipelineBenchmarkXml test does exactly that.
+ */
+
+using namespace Mdt::ItemModel;
+
+/*
+ * Selections are made of single row ranges separated by a unselected row,
+ * so the source model must have at least 2 times the biggest selection
+ */
+constexpr int maxRangeCount = 100'000;
+constexpr int sourceRowCount = 2 * maxRangeCount;
+
+
+enum class ProxyKind
+{
+  Identity,
+  Sort,
+  Filter
+};
+
+std::string proxyKindName(ProxyKind kind)
+{
+  switch(kind){
+    case ProxyKind::Identity:
+      return "identity";
+    case ProxyKind::Sort:
+      return "sort";
+    case ProxyKind::Filter:
+      return "filter";
+  }
+
+  return std::string();
+}
+
+void populateModelWithRowCount(ReadOnlyTableModel & model, int rowCount)
+{
+  assert( rowCount > 0 );
+
+  ReadOnlyTableModel::Table table;
+  table.reserve( static_cast<size_t>(rowCount) );
+
+  for(int row = 0; row < rowCount; ++row){
+    table.push_back( {row, "A"} );
+  }
+
+  model.setTable(table);
+}
+
+/*
+ * Creates a proxy model of given kind.
+ *
+ * The sort proxy sorts in descending order,
+ * so that the mapping is not a identity.
+ *
+ * The filter proxy accepts all rows,
+ * so that the selection size stays the same for each depth,
+ * but it still has to maintain its mapping.
+ */
+std::unique_ptr<QAbstractProxyModel> makeProxyModel(ProxyKind kind)
+{
+  switch(kind){
+    case ProxyKind::Identity:
+      return std::make_unique<QIdentityProxyModel>();
+    case ProxyKind::Sort:{
+      auto proxyModel = std::make_unique<QSortFilterProxyModel>();
+      proxyModel->sort(0, Qt::DescendingOrder);
+      return proxyModel;
+    }
+    case ProxyKind::Filter:{
+      auto proxyModel = std::make_unique<QSortFilterProxyModel>();
+      proxyModel->setFilterKeyColumn(1);
+      proxyModel->setFilterFixedString( QStringLiteral("A") );
+      return proxyModel;
+    }
+  }
+
+  return nullptr;
+}
+
+struct PipelineFixture
+{
+  ReadOnlyTableModel sourceModel;
+  std::vector< std::unique_ptr<QAbstractProxyModel> > proxyModels;
+  ProxyModelPipeline pipeline;
+
+  PipelineFixture(ProxyKind kind, int depth)
+  {
+    assert( depth >= 1 );
+
+    populateModelWithRowCount(sourceModel, sourceRowCount);
+    pipeline.setSourceModel(&sourceModel);
+    for(int i = 0; i < depth; ++i){
+      proxyModels.push_back( makeProxyModel(kind) );
+      pipeline.appendProxyModel( proxyModels.back().get() );
+    }
+  }
+};
+
+/*
+ * Returns a selection of rangeCount full width single row ranges,
+ * separated by a unselected row
+ */
+QItemSelection makeScatteredSelection(const QAbstractItemModel & model, int rangeCount)
+{
+  assert( rangeCount >= 1 );
+  assert( 2*rangeCount <= model.rowCount() );
+
+  const int lastColumn = model.columnCount() - 1;
+  QItemSelection selection;
+  selection.reserve(rangeCount);
+
+  for(int i = 0; i < rangeCount; ++i){
+    const int row = 2*i;
+    selection.append( QItemSelectionRange( model.index(row, 0), model.index(row, lastColumn) ) );
+  }
+
+  return selection;
+}
+
+
+TEST_CASE("mapIndex")
+{
+  const ProxyKind kind = GENERATE(ProxyKind::Identity, ProxyKind::Sort, ProxyKind::Filter);
+  const int depth = GENERATE(1, 2, 4, 8);
+  const std::string suffix = ", " + proxyKindName(kind) + ", depth " + std::to_string(depth);
+
+  PipelineFixture fixture(kind, depth);
+  const QModelIndex viewIndex = fixture.pipeline.modelForView()->index(sourceRowCount / 2, 0);
+  const QModelIndex sourceIndex = fixture.sourceModel.index(sourceRowCount / 2, 0);
+  QModelIndex index;
+
+  BENCHMARK("mapIndexToSource" + suffix)
+  {
+    index = fixture.pipeline.mapIndexToSource(viewIndex);
+  };
+  REQUIRE( index.isValid() );
+  REQUIRE( index.model() == &fixture.sourceModel );
+
+  BENCHMARK("mapIndexFromSource" + suffix)
+  {
+    index = fixture.pipeline.mapIndexFromSource(sourceIndex);
+  };
+  REQUIRE( index.isValid() );
+  REQUIRE( index.model() == fixture.pipeline.modelForView() );
+}
+
+TEST_CASE("mapSelection")
+{
+  const ProxyKind kind = GENERATE(ProxyKind::Identity, ProxyKind::Sort, ProxyKind::Filter);
+  const int depth = GENERATE(1, 2, 4, 8);
+  const int rangeCount = GENERATE(1, 10, 100, 1'000, 10'000, maxRangeCount);
+  const std::string suffix = ", " + proxyKindName(kind)
+                           + ", depth " + std::to_string(depth)
+                           + ", " + std::to_string(rangeCount) + " ranges";
+
+  PipelineFixture fixture(kind, depth);
+  const QItemSelection viewSelection = makeScatteredSelection(*fixture.pipeline.modelForView(), rangeCount);
+  const QItemSelection sourceSelection = makeScatteredSelection(fixture.sourceModel, rangeCount);
+  QItemSelection selection;
+
+  BENCHMARK("mapSelectionToSource" + suffix)
+  {
+    selection = fixture.pipeline.mapSelectionToSource(viewSelection);
+  };
+  REQUIRE( RowSelection::fromItemSelection(selection).rangeCount() == static_cast<size_t>(rangeCount) );
+
+  BENCHMARK("mapSelectionFromSource" + suffix)
+  {
+    selection = fixture.pipeline.mapSelectionFromSource(sourceSelection);
+  };
+  REQUIRE( RowSelection::fromItemSelection(selection).rangeCount() == static_cast<size_t>(rangeCount) );
+}
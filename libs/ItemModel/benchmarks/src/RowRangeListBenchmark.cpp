@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include "Mdt/ItemModel/RowSelection.h"
+#include <memory_resource>
+#include <cstddef>
+#include <string>
+
+/*
+ * Counts the allocations made while building typical selections,
+ * which are made of a few ranges, and should not allocate.
+ *
+ * RowRangeList allocates from a memory resource,
+ * which is the default one unless an other is given.
+ */
+
+class CountingDefaultMemoryResource : public std::pmr::memory_resource
+{
+ public:
+
+  CountingDefaultMemoryResource() noexcept
+   : mPrevious( std::pmr::set_default_resource(this) )
+  {
+  }
+
+  ~CountingDefaultMemoryResource() noexcept
+  {
+    std::pmr::set_default_resource(mPrevious);
+  }
+
+  CountingDefaultMemoryResource(const CountingDefaultMemoryResource &) = delete;
+  CountingDefaultMemoryResource & operator=(const CountingDefaultMemoryResource &) = delete;
+  CountingDefaultMemoryResource(CountingDefaultMemoryResource &&) = delete;
+  CountingDefaultMemoryResource & operator=(CountingDefaultMemoryResource &&) = delete;
+
+  long allocationCount = 0;
+
+ private:
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    ++allocationCount;
+    return mPrevious->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+  {
+    mPrevious->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+  {
+    return &other == this;
+  }
+
+  std::pmr::memory_resource *mPrevious;
+};
+
+using namespace Mdt::ItemModel;
+
+/*
+ * Adds rangeCount ranges that are not adjacent,
+ * so they are not merged: [0,1], [4,5], [8,9], ...
+ */
+void addRanges(RowRangeList & list, int rangeCount)
+{
+  for(int i = 0; i < rangeCount; ++i){
+    list.addRange( RowRange::fromFirstAndLastRow(4*i, 4*i+1) );
+  }
+}
+
+/*
+ * Adds the ranges in reverse order, so each one is inserted at the beginning
+ */
+void addRangesReversed(RowRangeList & list, int rangeCount)
+{
+  for(int i = rangeCount-1; i >= 0; --i){
+    list.addRange( RowRange::fromFirstAndLastRow(4*i, 4*i+1) );
+  }
+}
+
+/*
+ * Returns the count of allocations made to build, then destroy, a list of rangeCount ranges
+ */
+long allocationsToBuildList(int rangeCount, std::size_t & resultRangeCount)
+{
+  CountingDefaultMemoryResource resource;
+  {
+    RowRangeList list;
+    addRanges(list, rangeCount);
+    resultRangeCount = list.rangeCount();
+  }
+
+  return resource.allocationCount;
+}
+
+
+TEST_CASE("allocations")
+{
+  SECTION("up to the inline capacity")
+  {
+    const int rangeCount = GENERATE(1, 2, 3, 4);
+    REQUIRE( static_cast<std::size_t>(rangeCount) <= rowRangeListInlineCapacity );
+
+    std::size_t resultRangeCount = 0;
+    const long allocations = allocationsToBuildList(rangeCount, resultRangeCount);
+
+    REQUIRE( resultRangeCount == static_cast<std::size_t>(rangeCount) );
+    REQUIRE( allocations == 0 );
+  }
+
+  SECTION("insert and merge up to the inline capacity")
+  {
+    std::size_t resultRangeCount = 0;
+    CountingDefaultMemoryResource resource;
+    {
+      RowRangeList list;
+      addRangesReversed(list, 4);
+      list.addRange( RowRange::fromFirstAndLastRow(0, 9) );
+      resultRangeCount = list.rangeCount();
+    }
+    const long allocations = resource.allocationCount;
+
+    REQUIRE( resultRangeCount == 2 );
+    REQUIRE( allocations == 0 );
+  }
+
+  SECTION("copy a selection")
+  {
+    RowRangeList list;
+    addRanges(list, 4);
+    const RowSelection selection = RowSelection::fromRowRangeList(list);
+
+    std::size_t resultRangeCount = 0;
+    CountingDefaultMemoryResource resource;
+    {
+      const RowSelection copy = selection;
+      resultRangeCount = copy.rangeCount();
+    }
+    const long allocations = resource.allocationCount;
+
+    REQUIRE( resultRangeCount == 4 );
+    REQUIRE( allocations == 0 );
+  }
+
+  SECTION("past the inline capacity")
+  {
+    std::size_t resultRangeCount = 0;
+    const long allocations = allocationsToBuildList(5, resultRangeCount);
+
+    REQUIRE( resultRangeCount == 5 );
+    REQUIRE( allocations > 0 );
+  }
+
+  SECTION("past the inline capacity with a arena")
+  {
+    alignas(std::max_align_t) unsigned char buffer[4096];
+
+    std::size_t resultRangeCount = 0;
+    CountingDefaultMemoryResource resource;
+    {
+      std::pmr::monotonic_buffer_resource arena( buffer, sizeof(buffer) );
+      RowRangeList list(&arena);
+      addRanges(list, 64);
+      resultRangeCount = list.rangeCount();
+    }
+    const long allocations = resource.allocationCount;
+
+    REQUIRE( resultRangeCount == 64 );
+    REQUIRE( allocations == 0 );
+  }
+}
+
+TEST_CASE("addRange")
+{
+  const int rangeCount = GENERATE(1, 4, 8, 64);
+  const std::string suffix = ", " + std::to_string(rangeCount) + " ranges";
+
+  BENCHMARK("append" + suffix)
+  {
+    RowRangeList list;
+    addRanges(list, rangeCount);
+    return list.rangeCount();
+  };
+
+  BENCHMARK("prepend" + suffix)
+  {
+    RowRangeList list;
+    addRangesReversed(list, rangeCount);
+    return list.rangeCount();
+  };
+
+  alignas(std::max_align_t) unsigned char buffer[4096];
+
+  BENCHMARK("append with a arena" + suffix)
+  {
+    std::pmr::monotonic_buffer_resource arena( buffer, sizeof(buffer) );
+    RowRangeList list(&arena);
+    addRanges(list, rangeCount);
+    return list.rangeCount();
+  };
+}
+
+TEST_CASE("copy")
+{
+  const int rangeCount = GENERATE(1, 4, 8, 64);
+  const std::string suffix = ", " + std::to_string(rangeCount) + " ranges";
+
+  RowRangeList list;
+  addRanges(list, rangeCount);
+  const RowSelection selection = RowSelection::fromRowRangeList(list);
+
+  BENCHMARK("RowSelection copy" + suffix)
+  {
+    const RowSelection copy = selection;
+    return copy.rangeCount();
+  };
+}
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "EventWindowTableModel.h"
+#include <QSortFilterProxyModel>
+#include <vector>
+#include <string>
+
+/*
+ * Compares appending events one by one (1 remove and 1 insert per event)
+ * to appending them in batches,
+ * with a sort proxy attached, like a live event monitor would have.
+ */
+
+constexpr int windowSize = 10'000;
+
+std::vector<EventRecord> makeEvents(int count)
+{
+  std::vector<EventRecord> events;
+  events.reserve( static_cast<size_t>(count) );
+
+  for(int id = 0; id < count; ++id){
+    events.push_back( {id, "Event " + std::to_string(id)} );
+  }
+
+  return events;
+}
+
+struct SlidingWindowFixture
+{
+  EventWindowTableModel model;
+  QSortFilterProxyModel proxyModel;
+
+  SlidingWindowFixture()
+   : model(windowSize)
+  {
+    const auto events = makeEvents(windowSize);
+    model.appendRecords( events.cbegin(), events.cend() );
+    proxyModel.setSourceModel(&model);
+    proxyModel.sort(0, Qt::DescendingOrder);
+  }
+};
+
+
+TEST_CASE("appendRecords")
+{
+  const int batchSize = GENERATE(1, 10, 100, 1'000, 5'000, windowSize);
+  const std::string suffix = ", window " + std::to_string(windowSize)
+                           + ", batch " + std::to_string(batchSize);
+
+  SlidingWindowFixture fixture;
+  const auto events = makeEvents(batchSize);
+
+  BENCHMARK("one by one" + suffix)
+  {
+    for(const auto & event : events){
+      fixture.model.appendRecord(event);
+    }
+  };
+  REQUIRE( fixture.proxyModel.rowCount() == windowSize );
+
+  BENCHMARK("batch" + suffix)
+  {
+    fixture.model.appendRecords( events.cbegin(), events.cend() );
+  };
+  REQUIRE( fixture.proxyModel.rowCount() == windowSize );
+}
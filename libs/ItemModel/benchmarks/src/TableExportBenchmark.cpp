@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "ChunkedTableModel.h"
+#include "Mdt/ItemModel/TableExport.h"
+#include "Mdt/ItemModel/DelimitedTextWriter.h"
+#include <QBuffer>
+#include <QByteArray>
+#include <QIODevice>
+#include <string>
+#include <chrono>
+
+/*
+ * Compares exporting a model with data() , on the GUI thread,
+ * to exporting a snapshot of its table, as a worker thread would do.
+ *
+ * The output size is reported, so the throughput in MB/s
+ * is the output size divided by the mean time.
+ */
+
+using namespace Mdt::ItemModel;
+
+using Record = ChunkedTableModel::Record;
+
+constexpr int rowCount = 1'000'000;
+
+void writeRecordField(DelimitedTextWriter & writer, const Record & record, int column)
+{
+  if(column == 0){
+    writer.writeField(record.id);
+  }else{
+    writer.writeField(record.name);
+  }
+}
+
+/*
+ * Writes to a buffer that keeps its allocation between runs,
+ * so only the export is measured
+ */
+qint64 exportSnapshot(const ChunkedTableModel::Snapshot & snapshot, QBuffer & buffer)
+{
+  buffer.seek(0);
+  DelimitedTextWriter writer(buffer);
+  exportTable(snapshot, {0, 1}, writeRecordField, writer);
+  writer.flush();
+
+  return writer.byteCount();
+}
+
+qint64 exportWithData(const ChunkedTableModel & model, QBuffer & buffer)
+{
+  buffer.seek(0);
+  DelimitedTextWriter writer(buffer);
+  exportModel(model, {0, 1}, writer);
+  writer.flush();
+
+  return writer.byteCount();
+}
+
+
+TEST_CASE("export")
+{
+  ChunkedTableModel::Table table;
+  table.reserve( static_cast<size_t>(rowCount) );
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "Device name " + std::to_string(id)} );
+  }
+  ChunkedTableModel model;
+  model.setTable(table);
+
+  QByteArray data;
+  QBuffer buffer(&data);
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+
+  const qint64 byteCount = exportSnapshot(model.snapshot(), buffer);
+  REQUIRE( byteCount > 0 );
+  WARN( "Output size: " + std::to_string(byteCount / (1024 * 1024)) + " MB" );
+
+  const auto start = std::chrono::steady_clock::now();
+  exportSnapshot(model.snapshot(), buffer);
+  const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  WARN( "Snapshot export: " + std::to_string( static_cast<int>( static_cast<double>(byteCount) / (1024.0 * 1024.0) / duration.count() ) ) + " MB/s" );
+
+  BENCHMARK("exportModel(), data() for each cell")
+  {
+    return exportWithData(model, buffer);
+  };
+
+  BENCHMARK("exportTable(), snapshot")
+  {
+    return exportSnapshot(model.snapshot(), buffer);
+  };
+
+  REQUIRE( exportWithData(model, buffer) == byteCount );
+}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "EditCommandsTableModel.h"
+#include "ChunkedTableModel.h"
+#include "Mdt/ItemModel/TableImport.h"
+#include "Mdt/ItemModel/TableExport.h"
+#include "Mdt/ItemModel/DelimitedTextWriter.h"
+#include <QBuffer>
+#include <QByteArray>
+#include <QIODevice>
+#include <string>
+#include <chrono>
+#include <utility>
+
+/*
+ * Compares importing a CSV text with 1 thread
+ * to importing it with all hardware threads,
+ * then handing the table to the model with a single insertRows signal.
+ *
+ * The input size is reported, so the throughput in MB/s
+ * is the input size divided by the mean time.
+ */
+
+using namespace Mdt::ItemModel;
+
+using Record = EditCommandsTableModel::Record;
+using Table = EditCommandsTableModel::Table;
+
+constexpr int rowCount = 1'000'000;
+
+void writeRecordField(DelimitedTextWriter & writer, const Record & record, int column)
+{
+  if(column == 0){
+    writer.writeField(record.id);
+  }else{
+    writer.writeField(record.name);
+  }
+}
+
+bool parseRecord(const DelimitedTextRow & row, Record & record)
+{
+  if(row.fieldCount() != 2){
+    return false;
+  }
+  record.name = row.toStdString(1);
+
+  return row.toInt(0, record.id);
+}
+
+QByteArray makeCsvText()
+{
+  EditCommandsTableModel::Table table;
+  table.reserve( static_cast<size_t>(rowCount) );
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "Device name, " + std::to_string(id)} );
+  }
+  ChunkedTableModel model;
+  model.setTable(table);
+
+  QByteArray data;
+  QBuffer buffer(&data);
+  buffer.open(QIODevice::WriteOnly);
+  DelimitedTextWriter writer(buffer);
+  exportTable(model.snapshot(), {0, 1}, writeRecordField, writer);
+  writer.flush();
+
+  return data;
+}
+
+std::size_t importText(const QByteArray & text, int threadCount)
+{
+  Table records;
+  DelimitedTextImportOptions options;
+  options.threadCount = threadCount;
+  importDelimitedText( text.constData(), static_cast<std::size_t>( text.size() ), parseRecord, records, options );
+
+  return records.size();
+}
+
+
+TEST_CASE("import")
+{
+  const QByteArray text = makeCsvText();
+  const auto byteCount = static_cast<double>( text.size() );
+  const int threadCount = DelimitedTextImportOptions().effectiveThreadCount();
+  WARN( "Input size: " + std::to_string( text.size() / (1024 * 1024) ) + " MB, " + std::to_string(threadCount) + " threads" );
+
+  const auto start = std::chrono::steady_clock::now();
+  REQUIRE( importText(text, threadCount) == static_cast<std::size_t>(rowCount) );
+  const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  WARN( "Parallel import: " + std::to_string( static_cast<int>( byteCount / (1024.0 * 1024.0) / duration.count() ) ) + " MB/s" );
+
+  BENCHMARK("findDelimitedTextRowStarts(), all threads")
+  {
+    return findDelimitedTextRowStarts( text.constData(), static_cast<std::size_t>( text.size() ), threadCount ).size();
+  };
+
+  BENCHMARK("importDelimitedText(), 1 thread")
+  {
+    return importText(text, 1);
+  };
+
+  BENCHMARK("importDelimitedText(), all threads")
+  {
+    return importText(text, threadCount);
+  };
+
+  BENCHMARK("importDelimitedText() and appendTable()")
+  {
+    Table records;
+    importDelimitedText( text.constData(), static_cast<std::size_t>( text.size() ), parseRecord, records );
+    EditCommandsTableModel model;
+    model.appendTable( std::move(records) );
+    return model.rowCount();
+  };
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "AbstractColumnIndex.h"
+
+namespace Mdt{ namespace ItemModel{
+
+void AbstractColumnIndex::rowsAboutToBeInserted(int firstRow, int lastRow)
+{
+  assert( firstRow >= 0 );
+  assert( lastRow >= firstRow );
+
+  if( !mIsBuilt ){
+    return;
+  }
+  if( firstRow > indexedRowCount() ){
+    invalidate();
+    return;
+  }
+
+  const int count = lastRow - firstRow + 1;
+  if( firstRow < indexedRowCount() ){
+    shiftRows(firstRow, count);
+  }
+  mRows.insert( mRows.begin() + firstRow, static_cast<std::size_t>(count), Row{QString(), true} );
+  for(int row = firstRow; row <= lastRow; ++row){
+    mPendingRows.push_back(row);
+  }
+}
+
+void AbstractColumnIndex::rowsAboutToBeRemoved(int firstRow, int lastRow) noexcept
+{
+  assert( firstRow >= 0 );
+  assert( lastRow >= firstRow );
+
+  if( !mIsBuilt ){
+    return;
+  }
+  if( lastRow >= indexedRowCount() ){
+    invalidate();
+    return;
+  }
+
+  const int rowCount = indexedRowCount();
+  doRemoveRows(firstRow, lastRow);
+  const auto isRemoved = [firstRow, lastRow](int row){
+    return (row >= firstRow) && (row <= lastRow);
+  };
+  mPendingRows.erase( std::remove_if(mPendingRows.begin(), mPendingRows.end(), isRemoved), mPendingRows.end() );
+  mRows.erase( mRows.begin() + firstRow, mRows.begin() + lastRow + 1 );
+  if( lastRow + 1 < rowCount ){
+    shiftRows( lastRow + 1, -(lastRow - firstRow + 1) );
+  }
+}
+
+void AbstractColumnIndex::rowsAboutToBeMoved(int sourceFirst, int sourceLast, int destinationRow) noexcept
+{
+  assert( sourceFirst >= 0 );
+  assert( sourceLast >= sourceFirst );
+  assert( (destinationRow < sourceFirst) || (destinationRow > sourceLast + 1) );
+
+  if( !mIsBuilt ){
+    return;
+  }
+  if( (sourceLast >= indexedRowCount()) || (destinationRow > indexedRowCount()) ){
+    invalidate();
+    return;
+  }
+
+  const RowMove move{sourceFirst, sourceLast, destinationRow};
+  doMoveRows(move);
+  for(int & row : mPendingRows){
+    if( (row >= move.firstRow()) && (row <= move.lastRow()) ){
+      row = move.newRow(row);
+    }
+  }
+  if(destinationRow > sourceLast){
+    std::rotate( mRows.begin() + sourceFirst, mRows.begin() + sourceLast + 1, mRows.begin() + destinationRow );
+  }else{
+    std::rotate( mRows.begin() + destinationRow, mRows.begin() + sourceFirst, mRows.begin() + sourceLast + 1 );
+  }
+}
+
+void AbstractColumnIndex::rowsDataChanged(int firstRow, int lastRow)
+{
+  assert( firstRow >= 0 );
+  assert( lastRow >= firstRow );
+
+  if( !mIsBuilt ){
+    return;
+  }
+
+  const int end = std::min( lastRow + 1, indexedRowCount() );
+  for(int row = firstRow; row < end; ++row){
+    Row & r = mRows[static_cast<std::size_t>(row)];
+    if(r.isPending){
+      continue;
+    }
+    doRemoveRow(row);
+    r.isPending = true;
+    mPendingRows.push_back(row);
+  }
+}
+
+void AbstractColumnIndex::doRemoveRows(int firstRow, int lastRow) noexcept
+{
+  for(int row = firstRow; row <= lastRow; ++row){
+    if( !rowIsPending(row) ){
+      doRemoveRow(row);
+    }
+  }
+}
+
+void AbstractColumnIndex::clear() noexcept
+{
+  doClear();
+  mRows.clear();
+  mPendingRows.clear();
+}
+
+void AbstractColumnIndex::shiftRows(int firstRow, int offset) noexcept
+{
+  doShiftRows(firstRow, offset);
+  for(int & row : mPendingRows){
+    if(row >= firstRow){
+      row += offset;
+    }
+  }
+}
+
+}} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,325 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_ABSTRACT_COLUMN_INDEX_H
+#define MDT_ITEM_MODEL_ABSTRACT_COLUMN_INDEX_H
+
+#include "mdt_itemmodel_export.h"
+#include <QString>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Common base of the indexes on a column of a table
+   *
+   * Holds the key of each row of the indexed column
+   * and does the bookkeeping that is common to all indexes:
+   *  - inserting, removing or moving rows shifts the row numbers stored in the index.
+   *    These methods only need the rows given by the *AboutTo* signals of the model,
+   *    so the index is already correct when the views and proxy models are notified
+   *    that the rows have been inserted, removed or moved
+   *  - the inserted rows and the rows whose data changed are marked as pending.
+   *    Their keys are read on the next lookup, by update()
+   *
+   * This way, a batch of changes reads only the keys of the inserted and changed rows.
+   *
+   * A concrete index implements the lookup structure through the doXxx() methods.
+   *
+   * \sa ColumnHashIndex
+   * \sa ColumnPrefixIndex
+   * \sa ColumnTrigramIndex
+   */
+  class MDT_ITEMMODEL_EXPORT AbstractColumnIndex
+  {
+   public:
+
+    /*! \brief Description of a move of rows
+     *
+     * Moving rows \a sourceFirst to \a sourceLast before \a destinationRow ,
+     * like in QAbstractItemModel::beginMoveRows() .
+     */
+    struct RowMove
+    {
+      int sourceFirst;
+      int sourceLast;
+      int destinationRow;
+
+      /*! \brief Get the first row that changes its position
+       */
+      int firstRow() const noexcept
+      {
+        return std::min(sourceFirst, destinationRow);
+      }
+
+      /*! \brief Get the last row that changes its position
+       */
+      int lastRow() const noexcept
+      {
+        return std::max(sourceLast, destinationRow - 1);
+      }
+
+      /*! \brief Get the position of \a row after the move
+       *
+       * \pre \a row must be in the range [ firstRow() , lastRow() ]
+       */
+      int newRow(int row) const noexcept
+      {
+        assert( row >= firstRow() );
+        assert( row <= lastRow() );
+
+        const int count = sourceLast - sourceFirst + 1;
+        if( (row >= sourceFirst) && (row <= sourceLast) ){
+          if(destinationRow > sourceLast){
+            return row + destinationRow - sourceLast - 1;
+          }
+          return row - sourceFirst + destinationRow;
+        }
+        if(destinationRow > sourceLast){
+          return row - count;
+        }
+        return row + count;
+      }
+    };
+
+    /*! \brief Construct a index for \a column
+     *
+     * The index is initially not built, so the first update() builds it.
+     *
+     * \pre \a column must be >= 0
+     */
+    explicit AbstractColumnIndex(int column) noexcept
+     : mColumn(column)
+    {
+      assert( column >= 0 );
+    }
+
+    virtual ~AbstractColumnIndex() = default;
+
+    AbstractColumnIndex(const AbstractColumnIndex &) = delete;
+    AbstractColumnIndex & operator=(const AbstractColumnIndex &) = delete;
+    AbstractColumnIndex(AbstractColumnIndex &&) = delete;
+    AbstractColumnIndex & operator=(AbstractColumnIndex &&) = delete;
+
+    /*! \brief Get the column this index is about
+     */
+    int column() const noexcept
+    {
+      return mColumn;
+    }
+
+    /*! \brief Check if this index is up to date
+     *
+     * Returns false if this index has not been built yet,
+     * or if it has pending rows.
+     *
+     * \sa update()
+     */
+    bool isUpToDate() const noexcept
+    {
+      return mIsBuilt && mPendingRows.empty();
+    }
+
+    /*! \brief Get the count of rows known by this index
+     */
+    int indexedRowCount() const noexcept
+    {
+      return static_cast<int>( mRows.size() );
+    }
+
+    /*! \brief Get the count of rows whose key has to be read by update()
+     */
+    int pendingRowCount() const noexcept
+    {
+      return static_cast<int>( mPendingRows.size() );
+    }
+
+    /*! \brief Mark the index to be rebuilt
+     *
+     * Must be called on a model reset or a layout change.
+     */
+    void invalidate() noexcept
+    {
+      mIsBuilt = false;
+    }
+
+    /*! \brief Tell this index that rows \a firstRow to \a lastRow are about to be inserted
+     *
+     * The following rows are shifted, and the inserted rows are pending.
+     *
+     * \pre \a firstRow must be >= 0
+     * \pre \a lastRow must be >= \a firstRow
+     */
+    void rowsAboutToBeInserted(int firstRow, int lastRow);
+
+    /*! \brief Tell this index that rows \a firstRow to \a lastRow are about to be removed
+     *
+     * The removed rows are dropped and the following rows are shifted.
+     *
+     * \pre \a firstRow must be >= 0
+     * \pre \a lastRow must be >= \a firstRow
+     */
+    void rowsAboutToBeRemoved(int firstRow, int lastRow) noexcept;
+
+    /*! \brief Tell this index that rows \a sourceFirst to \a sourceLast are about to be moved
+     *
+     * \a destinationRow has the same meaning
+     * than \a destinationChild in QAbstractItemModel::beginMoveRows() .
+     *
+     * \pre \a sourceFirst must be >= 0
+     * \pre \a sourceLast must be >= \a sourceFirst
+     * \pre \a destinationRow must not be in the range [ \a sourceFirst , \a sourceLast + 1 ]
+     */
+    void rowsAboutToBeMoved(int sourceFirst, int sourceLast, int destinationRow) noexcept;
+
+    /*! \brief Tell this index that the data of rows \a firstRow to \a lastRow changed
+     *
+     * The changed rows are pending.
+     *
+     * \pre \a firstRow must be >= 0
+     * \pre \a lastRow must be >= \a firstRow
+     */
+    void rowsDataChanged(int firstRow, int lastRow);
+
+    /*! \brief Read the keys of the pending rows
+     *
+     * \a rowCount is the current row count of the table,
+     * and \a textOfRow is called for each pending row,
+     * and must return the text of the row in the indexed column.
+     *
+     * If this index is not built, or if \a rowCount
+     * is not the count of rows known by this index,
+     * the index is rebuilt.
+     *
+     * Does nothing if this index is up to date.
+     */
+    template<typename TextOfRow>
+    void update(int rowCount, const TextOfRow & textOfRow)
+    {
+      assert( rowCount >= 0 );
+
+      if( isUpToDate() && (rowCount == indexedRowCount()) ){
+        return;
+      }
+      if( !mIsBuilt || (rowCount != indexedRowCount()) ){
+        clear();
+        mRows.reserve( static_cast<std::size_t>(rowCount) );
+        mPendingRows.reserve( static_cast<std::size_t>(rowCount) );
+        for(int row = 0; row < rowCount; ++row){
+          mRows.push_back( {doKeyFromText( textOfRow(row) ), false} );
+          mPendingRows.push_back(row);
+        }
+        mIsBuilt = true;
+      }else{
+        for(const int row : mPendingRows){
+          Row & r = mRows[static_cast<std::size_t>(row)];
+          assert( r.isPending );
+          r.key = doKeyFromText( textOfRow(row) );
+          r.isPending = false;
+        }
+      }
+      doAddRows(mPendingRows);
+      mPendingRows.clear();
+    }
+
+   protected:
+
+    /*! \brief Get the key of \a row
+     *
+     * \pre \a row must be in valid range
+     * \pre \a row must not be pending
+     */
+    const QString & keyOfRow(int row) const noexcept
+    {
+      assert( row >= 0 );
+      assert( row < indexedRowCount() );
+      assert( !mRows[static_cast<std::size_t>(row)].isPending );
+
+      return mRows[static_cast<std::size_t>(row)].key;
+    }
+
+    /*! \brief Check if \a row is pending
+     *
+     * A pending row is not in the lookup structure of the concrete index.
+     *
+     * \pre \a row must be in valid range
+     */
+    bool rowIsPending(int row) const noexcept
+    {
+      assert( row >= 0 );
+      assert( row < indexedRowCount() );
+
+      return mRows[static_cast<std::size_t>(row)].isPending;
+    }
+
+   private:
+
+    /*! \brief Get the key stored for \a text
+     */
+    virtual
+    QString doKeyFromText(const QString & text) const = 0;
+
+    /*! \brief Clear the lookup structure
+     */
+    virtual
+    void doClear() noexcept = 0;
+
+    /*! \brief Add \a rows to the lookup structure
+     *
+     * The keys of \a rows are available with keyOfRow() .
+     */
+    virtual
+    void doAddRows(const std::vector<int> & rows) = 0;
+
+    /*! \brief Remove \a row from the lookup structure
+     *
+     * \a row is not pending, its key is available with keyOfRow() .
+     */
+    virtual
+    void doRemoveRow(int row) noexcept = 0;
+
+    /*! \brief Remove rows \a firstRow to \a lastRow from the lookup structure
+     *
+     * The row numbers are shifted afterwards, by doShiftRows() .
+     *
+     * The default implementation calls doRemoveRow() for each row that is not pending.
+     */
+    virtual
+    void doRemoveRows(int firstRow, int lastRow) noexcept;
+
+    /*! \brief Add \a offset to the rows >= \a firstRow stored in the lookup structure
+     */
+    virtual
+    void doShiftRows(int firstRow, int offset) noexcept = 0;
+
+    /*! \brief Renumber the rows stored in the lookup structure for \a move
+     */
+    virtual
+    void doMoveRows(const RowMove & move) noexcept = 0;
+
+    struct Row
+    {
+      QString key;
+      bool isPending;
+    };
+
+    void clear() noexcept;
+    void shiftRows(int firstRow, int offset) noexcept;
+
+    int mColumn;
+    bool mIsBuilt = false;
+    std::vector<Row> mRows;
+    std::vector<int> mPendingRows;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_ABSTRACT_COLUMN_INDEX_H
@@ -8,6 +8,19 @@
  **
  *****************************************************************************************/
 #include "AbstractTableModel.h"
+#include "RowSelection.h"
+#include "RowRange.h"
+#include "RowRangeList.h"
+#include "RowRangeMimeData.h"
+#include "TableEditCommand.h"
+#include "ColumnHashIndex.h"
+#include "ColumnPrefixIndex.h"
+#include "ColumnTrigramIndex.h"
+#include <map>
+#include <memory>
+#include <vector>
+#include <tuple>
+#include <algorithm>
 #include <cassert>
 
 namespace Mdt{ namespace ItemModel{
@@ -81,6 +94,9 @@ QVariant AbstractTableModel::data(const QModelIndex & index, int role) const
 
   switch(role){
     case Qt::DisplayRole:
+      if( mDisplayDataCache.isEnabled() ){
+        return cachedDisplayRoleData(index);
+      }
       return displayRoleData(index);
     case Qt::EditRole:
       return editRoleData(index);
@@ -95,21 +111,9 @@ bool AbstractTableModel::setData(const QModelIndex & index, const QVariant & val
     return false;
   }
 
-  if( role == Qt::EditRole ){
-    if( setEditRoleData(index, value) ){
-      emit dataChanged(index, index);
-      return true;
-    }
-  }else if( role == Qt::DisplayRole ){
-    if( setDisplayRoleData(index, value) ){
-      emit dataChanged(index, index);
-      return true;
-    }
-  }else{
-    if( setOtherRoleData(index, value, role) ){
-      emit dataChanged(index, index);
-      return true;
-    }
+  if( setDataWithoutSignal(index, value, role) ){
+    emitDataChanged(index, index);
+    return true;
   }
 
   return false;
@@ -167,21 +171,8 @@ bool AbstractTableModel::insertRows(int row, int count, const QModelIndex & pare
     return false;
   }
 
-  enum class InsertMethod
-  {
-    InsertRows,
-    PrependRow,
-    AppendRow
-  };
-
   InsertMethod insertMethod;
-  if( supportsInsertRows() ){
-    insertMethod = InsertMethod::InsertRows;
-  }else if( supportsPrependRow() && rowAndCountRepresentsPrependRow(row, count) ){
-    insertMethod = InsertMethod::PrependRow;
-  }else if( supportsAppendRow() && rowAndCountRepresentsAppendRow(row, count) ){
-    insertMethod = InsertMethod::AppendRow;
-  }else{
+  if( !findInsertMethod(row, count, insertMethod) ){
     return false;
   }
 
@@ -190,19 +181,7 @@ bool AbstractTableModel::insertRows(int row, int count, const QModelIndex & pare
   assert( last >= first );
 
   beginInsertRows( QModelIndex(), first, last );
-
-  switch(insertMethod){
-    case InsertMethod::InsertRows:
-      doInsertRows(row, count);
-      break;
-    case InsertMethod::PrependRow:
-      doPrependRow();
-      break;
-    case InsertMethod::AppendRow:
-      doAppendRow();
-      break;
-  }
-
+  insertRowsInStorage(insertMethod, row, count);
   endInsertRows();
 
   return true;
@@ -260,21 +239,8 @@ bool AbstractTableModel::removeRows(int row, int count, const QModelIndex & pare
     return false;
   }
 
-  enum class RemoveMethod
-  {
-    RemoveRows,
-    RemoveFirstRow,
-    RemoveLastRow
-  };
-
   RemoveMethod removeMethod;
-  if( supportsRemoveRows() ){
-    removeMethod = RemoveMethod::RemoveRows;
-  }else if( supportsRemoveFirstRow() && rowAndCountRepresentsRemoveFirstRow(row, count) ){
-    removeMethod = RemoveMethod::RemoveFirstRow;
-  }else if( supportsRemoveLastRow() && rowAndCountRepresentsRemoveLastRow(row, count) ){
-    removeMethod = RemoveMethod::RemoveLastRow;
-  }else{
+  if( !findRemoveMethod(row, count, removeMethod) ){
     return false;
   }
 
@@ -283,24 +249,647 @@ bool AbstractTableModel::removeRows(int row, int count, const QModelIndex & pare
   assert( last >= first );
 
   beginRemoveRows(QModelIndex(), first, last);
+  removeRowsFromStorage(removeMethod, row, count);
+  endRemoveRows();
 
-  switch(removeMethod){
-    case RemoveMethod::RemoveRows:
-      doRemoveRows(row, count);
-      break;
-    case RemoveMethod::RemoveFirstRow:
-      doRemoveFirstRow();
-      break;
-    case RemoveMethod::RemoveLastRow:
-      doRemoveLastRow();
+  return true;
+}
+
+bool AbstractTableModel::rowsAreValidForMoveRows(int sourceRow, int count, int destinationRow) const noexcept
+{
+  if( !rowAndCountIsValidForRemoveRows(sourceRow, count) ){
+    return false;
+  }
+  if(destinationRow < 0){
+    return false;
+  }
+  if( destinationRow > rowCountWithoutParentIndex() ){
+    return false;
+  }
+  if( (destinationRow >= sourceRow) && (destinationRow <= sourceRow + count) ){
+    return false;
+  }
+
+  return true;
+}
+
+bool AbstractTableModel::moveRows(const QModelIndex & sourceParent, int sourceRow, int count,
+                                  const QModelIndex & destinationParent, int destinationChild)
+{
+  if( sourceParent.isValid() || destinationParent.isValid() ){
+    return false;
+  }
+  if( !supportsMoveRows() ){
+    return false;
+  }
+  if( !rowsAreValidForMoveRows(sourceRow, count, destinationChild) ){
+    return false;
+  }
+
+  const int first = sourceRow;
+  const int last = first + count-1;
+  assert( last >= first );
+
+  if( !beginMoveRows(QModelIndex(), first, last, QModelIndex(), destinationChild) ){
+    return false;
+  }
+  doMoveRows(sourceRow, count, destinationChild);
+  endMoveRows();
+
+  return true;
+}
+
+bool AbstractTableModel::moveRowRanges(const RowSelection & selection, int destinationRow)
+{
+  assert( destinationRow >= 0 );
+  assert( destinationRow <= rowCountWithoutParentIndex() );
+
+  if( !supportsMoveRows() ){
+    return false;
+  }
+
+  /*
+   * Ranges before the destination are gathered from the first one downwards.
+   * Moving rows before the destination does not change the rows after it,
+   * so the ranges after the destination are then gathered from the last one upwards.
+   * A range that contains the destination is split in 2 parts,
+   * each one is already adjacent to the destination.
+   */
+
+  int blockFirst = 0;
+  int blockCount = 0;
+  for(const RowRange & range : selection){
+    if(range.firstRow() >= destinationRow){
       break;
+    }
+    assert( rowIndexIsInRange( range.lastRow() ) );
+    const int last = std::min(range.lastRow(), destinationRow - 1);
+    if( (blockCount > 0) && (blockFirst + blockCount < range.firstRow()) ){
+      if( !moveRows(QModelIndex(), blockFirst, blockCount, QModelIndex(), range.firstRow()) ){
+        return false;
+      }
+    }
+    blockCount += last - range.firstRow() + 1;
+    blockFirst = last - blockCount + 1;
+  }
+  if( (blockCount > 0) && (blockFirst + blockCount < destinationRow) ){
+    if( !moveRows(QModelIndex(), blockFirst, blockCount, QModelIndex(), destinationRow) ){
+      return false;
+    }
   }
 
-  endRemoveRows();
+  int blockLast = 0;
+  blockCount = 0;
+  for(auto it = selection.crbegin(); it != selection.crend(); ++it){
+    const RowRange & range = *it;
+    if(range.lastRow() < destinationRow){
+      break;
+    }
+    assert( rowIndexIsInRange( range.lastRow() ) );
+    const int first = std::max(range.firstRow(), destinationRow);
+    if( (blockCount > 0) && (range.lastRow() + 1 < blockLast - blockCount + 1) ){
+      if( !moveRows(QModelIndex(), blockLast - blockCount + 1, blockCount, QModelIndex(), range.lastRow() + 1) ){
+        return false;
+      }
+    }
+    blockCount += range.lastRow() - first + 1;
+    blockLast = first + blockCount - 1;
+  }
+  if( (blockCount > 0) && (blockLast - blockCount + 1 > destinationRow) ){
+    if( !moveRows(QModelIndex(), blockLast - blockCount + 1, blockCount, QModelIndex(), destinationRow) ){
+      return false;
+    }
+  }
 
   return true;
 }
 
+QStringList AbstractTableModel::mimeTypes() const
+{
+  QStringList types = QAbstractTableModel::mimeTypes();
+  if(mRowRangeDragAndDropEnabled){
+    types.append( RowRangeMimeData::rowRangesMimeType() );
+  }
+
+  return types;
+}
+
+QMimeData *AbstractTableModel::mimeData(const QModelIndexList & indexes) const
+{
+  if(!mRowRangeDragAndDropEnabled){
+    return QAbstractTableModel::mimeData(indexes);
+  }
+  if( indexes.isEmpty() ){
+    return nullptr;
+  }
+
+  std::vector<int> columns;
+  for(const QModelIndex & index : indexes){
+    if( index.isValid() ){
+      columns.push_back( index.column() );
+    }
+  }
+  std::sort( columns.begin(), columns.end() );
+  columns.erase( std::unique( columns.begin(), columns.end() ), columns.end() );
+
+  return mimeDataForRows( RowSelection::fromModelIndexList(indexes), columns );
+}
+
+QMimeData *AbstractTableModel::mimeDataForRows(const RowSelection & selection, const std::vector<int> & columns) const
+{
+  return new RowRangeMimeData(*this, selection, columns);
+}
+
+Qt::DropActions AbstractTableModel::supportedDragActions() const
+{
+  Qt::DropActions actions = QAbstractTableModel::supportedDragActions();
+  if(!mRowRangeDragAndDropEnabled){
+    return actions;
+  }
+  actions |= Qt::CopyAction;
+  if( supportsMoveRows() ){
+    actions |= Qt::MoveAction;
+  }
+
+  return actions;
+}
+
+Qt::DropActions AbstractTableModel::supportedDropActions() const
+{
+  Qt::DropActions actions = QAbstractTableModel::supportedDropActions();
+  if( mRowRangeDragAndDropEnabled && supportsMoveRows() ){
+    actions |= Qt::MoveAction;
+  }
+
+  return actions;
+}
+
+bool AbstractTableModel::canDropMimeData(const QMimeData *data, Qt::DropAction action,
+                                         int row, int column, const QModelIndex & parent) const
+{
+  if( !isRowRangeMove(data, action) ){
+    return QAbstractTableModel::canDropMimeData(data, action, row, column, parent);
+  }
+  if( !supportsMoveRows() ){
+    return false;
+  }
+
+  const auto *rowRangeData = qobject_cast<const RowRangeMimeData*>(data);
+  assert( rowRangeData != nullptr );
+
+  return (rowRangeData->sourceModel() == this) && rowRangeData->refersToCurrentRows();
+}
+
+bool AbstractTableModel::dropMimeData(const QMimeData *data, Qt::DropAction action,
+                                      int row, int column, const QModelIndex & parent)
+{
+  if( !isRowRangeMove(data, action) ){
+    return QAbstractTableModel::dropMimeData(data, action, row, column, parent);
+  }
+  if( !canDropMimeData(data, action, row, column, parent) ){
+    return false;
+  }
+
+  int destinationRow = rowCountWithoutParentIndex();
+  if(row >= 0){
+    destinationRow = std::min(row, destinationRow);
+  }else if( parent.isValid() ){
+    destinationRow = parent.row();
+  }
+  moveDroppedRows(data, destinationRow);
+
+  /*
+   * The rows have been moved in place:
+   * returning true would make the view remove them
+   */
+  return false;
+}
+
+bool AbstractTableModel::moveDroppedRows(const QMimeData *data, int destinationRow)
+{
+  assert( data != nullptr );
+  assert( destinationRow >= 0 );
+  assert( destinationRow <= rowCountWithoutParentIndex() );
+
+  const auto *rowRangeData = qobject_cast<const RowRangeMimeData*>(data);
+  if( (rowRangeData == nullptr) || (rowRangeData->sourceModel() != this) ){
+    return false;
+  }
+  if( !rowRangeData->refersToCurrentRows() ){
+    return false;
+  }
+
+  const RowSelection & selection = rowRangeData->rowSelection();
+  if( selection.isEmpty() ){
+    return false;
+  }
+  assert( selection.rangeAt( selection.rangeCount() - 1 ).lastRow() < rowCountWithoutParentIndex() );
+
+  return moveRowRanges(selection, destinationRow);
+}
+
+bool AbstractTableModel::isRowRangeMove(const QMimeData *data, Qt::DropAction action) const noexcept
+{
+  if( !mRowRangeDragAndDropEnabled || (action != Qt::MoveAction) ){
+    return false;
+  }
+
+  return qobject_cast<const RowRangeMimeData*>(data) != nullptr;
+}
+
+bool AbstractTableModel::isResetCheaperThanKeyedTableDiff(const KeyedTableDiff & diff, std::size_t newRowCount) const noexcept
+{
+  const int referenceRowCount = std::max( {rowCountWithoutParentIndex(), static_cast<int>(newRowCount), 1} );
+
+  return diff.affectedRowCount() >= BulkChangeScope::defaultResetThreshold * referenceRowCount;
+}
+
+bool AbstractTableModel::applyEditCommands(const std::vector<TableEditCommand> & commands)
+{
+  /*
+   * Consecutive InsertRows (or RemoveRows) commands are kept pending
+   * as long as the next one can be merged into them.
+   * Merging is only done if the model supports inserting (or removing) rows at any place,
+   * for example 2 removes of the first row must not become a single remove of 2 rows
+   * for a model that only supports removing the first row.
+   * SetData commands are kept pending, coalesced per item,
+   * until the next InsertRows or RemoveRows command, which changes the meaning of the rows.
+   * So, at any time, at most one of both is pending.
+   *
+   * The validity of a InsertRows or RemoveRows command is checked
+   * against the row count this model will have once the pending rows have been inserted or removed.
+   */
+
+  using ItemKey = std::tuple<int, int, int>; // row, column, role
+
+  /*
+   * SetData commands are applied in the order they have been issued,
+   * so that a model that validates an item against other ones
+   * sees the same order as if they had been applied one by one.
+   * A coalesced item takes the place of its last SetData command.
+   */
+  struct PendingItem
+  {
+    ItemKey key;
+    QVariant value;
+    bool superseded = false;
+  };
+
+  bool ok = true;
+  std::vector<PendingItem> pendingData;
+  std::map<ItemKey, size_t> pendingDataIndexes;
+  TableEditCommand pendingRows;
+  bool hasPendingRows = false;
+  int expectedRowCount = rowCountWithoutParentIndex();
+
+  const auto applyPendingRows = [&](){
+    if(!hasPendingRows){
+      return;
+    }
+    hasPendingRows = false;
+    if( pendingRows.type() == TableEditCommand::Type::InsertRows ){
+      ok = insertRows( pendingRows.row(), pendingRows.count() ) && ok;
+    }else{
+      assert( pendingRows.type() == TableEditCommand::Type::RemoveRows );
+      ok = removeRows( pendingRows.row(), pendingRows.count() ) && ok;
+    }
+    expectedRowCount = rowCountWithoutParentIndex();
+  };
+
+  const auto applyPendingData = [&](){
+    if( pendingData.empty() ){
+      return;
+    }
+    RowRangeList changedRows;
+    int firstColumn = columnCountWithoutParentIndex();
+    int lastColumn = -1;
+    for(const PendingItem & item : pendingData){
+      if(item.superseded){
+        continue;
+      }
+      const int row = std::get<0>(item.key);
+      const int column = std::get<1>(item.key);
+      const QModelIndex itemIndex = index(row, column);
+      if( !indexIsValidAndInRange(itemIndex) || !setDataWithoutSignal( itemIndex, item.value, std::get<2>(item.key) ) ){
+        ok = false;
+        continue;
+      }
+      changedRows.addRange( RowRange::fromFirstAndLastRow(row, row) );
+      firstColumn = std::min(firstColumn, column);
+      lastColumn = std::max(lastColumn, column);
+    }
+    pendingData.clear();
+    pendingDataIndexes.clear();
+    for(const RowRange & range : changedRows){
+      emitDataChanged( index(range.firstRow(), firstColumn), index(range.lastRow(), lastColumn) );
+    }
+  };
+
+  for(const TableEditCommand & command : commands){
+    switch( command.type() ){
+      case TableEditCommand::Type::SetData:
+      {
+        applyPendingRows();
+        const ItemKey key( command.row(), command.column(), command.role() );
+        const auto it = pendingDataIndexes.find(key);
+        if( it != pendingDataIndexes.end() ){
+          pendingData[it->second].superseded = true;
+          it->second = pendingData.size();
+        }else{
+          pendingDataIndexes.emplace( key, pendingData.size() );
+        }
+        pendingData.push_back( PendingItem{key, command.value()} );
+        break;
+      }
+      case TableEditCommand::Type::InsertRows:
+        if( (command.row() < 0) || (command.row() > expectedRowCount) || (command.count() < 1) ){
+          ok = false;
+          break;
+        }
+        applyPendingData();
+        if( hasPendingRows && (pendingRows.type() == TableEditCommand::Type::InsertRows) && supportsInsertRows()
+            && (command.row() >= pendingRows.row()) && (command.row() <= pendingRows.row() + pendingRows.count()) )
+        {
+          pendingRows = TableEditCommand::insertRows( pendingRows.row(), pendingRows.count() + command.count() );
+        }else{
+          applyPendingRows();
+          pendingRows = command;
+          hasPendingRows = true;
+        }
+        expectedRowCount += command.count();
+        break;
+      case TableEditCommand::Type::RemoveRows:
+        if( (command.row() < 0) || (command.count() < 1) || (command.row() + command.count() > expectedRowCount) ){
+          ok = false;
+          break;
+        }
+        applyPendingData();
+        if( hasPendingRows && (pendingRows.type() == TableEditCommand::Type::RemoveRows) && supportsRemoveRows()
+            && (command.row() <= pendingRows.row()) && (pendingRows.row() <= command.row() + command.count()) )
+        {
+          pendingRows = TableEditCommand::removeRows( command.row(), pendingRows.count() + command.count() );
+        }else{
+          applyPendingRows();
+          pendingRows = command;
+          hasPendingRows = true;
+        }
+        expectedRowCount -= command.count();
+        break;
+    }
+  }
+  applyPendingRows();
+  applyPendingData();
+
+  return ok;
+}
+
+bool AbstractTableModel::applyEditCommandsInModelReset(const std::vector<TableEditCommand> & commands)
+{
+  /*
+   * The commands are applied directly to the storage,
+   * without insertRows() and removeRows() ,
+   * because rows must not be inserted nor removed with their signals inside a reset.
+   * As the whole model is reset, nothing needs to be coalesced.
+   */
+  bool ok = true;
+
+  beginResetModel();
+  for(const TableEditCommand & command : commands){
+    switch( command.type() ){
+      case TableEditCommand::Type::SetData:
+      {
+        const QModelIndex itemIndex = index( command.row(), command.column() );
+        if( !indexIsValidAndInRange(itemIndex) || !setDataWithoutSignal( itemIndex, command.value(), command.role() ) ){
+          ok = false;
+        }
+        break;
+      }
+      case TableEditCommand::Type::InsertRows:
+      {
+        InsertMethod insertMethod;
+        if( rowAndCountIsValidForInsertRows( command.row(), command.count() )
+            && findInsertMethod( command.row(), command.count(), insertMethod ) )
+        {
+          insertRowsInStorage( insertMethod, command.row(), command.count() );
+        }else{
+          ok = false;
+        }
+        break;
+      }
+      case TableEditCommand::Type::RemoveRows:
+      {
+        RemoveMethod removeMethod;
+        if( rowAndCountIsValidForRemoveRows( command.row(), command.count() )
+            && findRemoveMethod( command.row(), command.count(), removeMethod ) )
+        {
+          removeRowsFromStorage( removeMethod, command.row(), command.count() );
+        }else{
+          ok = false;
+        }
+        break;
+      }
+    }
+  }
+  endResetModel();
+
+  return ok;
+}
+
+template<typename Index>
+Index *AbstractTableModel::findColumnIndex(int column) const noexcept
+{
+  for(const auto & index : mColumnIndexes){
+    if( index->column() != column ){
+      continue;
+    }
+    if( auto *typedIndex = dynamic_cast<Index*>( index.get() ) ){
+      return typedIndex;
+    }
+  }
+
+  return nullptr;
+}
+
+template<typename Index>
+const Index & AbstractTableModel::updatedColumnIndex(int column) const
+{
+  Index *index = findColumnIndex<Index>(column);
+  assert( index != nullptr );
+
+  const auto textOfRow = [this, column](int row){
+    return columnIndexTextOfRow(row, column);
+  };
+  index->update(rowCountWithoutParentIndex(), textOfRow);
+
+  return *index;
+}
+
+template<typename Index>
+void AbstractTableModel::addColumnIndex(int column)
+{
+  if( findColumnIndex<Index>(column) != nullptr ){
+    return;
+  }
+  connectColumnIndexSignals();
+  mColumnIndexes.push_back( std::make_unique<Index>(column) );
+}
+
+template<typename Index>
+void AbstractTableModel::removeColumnIndex(int column) noexcept
+{
+  const auto pred = [column](const std::unique_ptr<AbstractColumnIndex> & index){
+    return (index->column() == column) && ( dynamic_cast<const Index*>( index.get() ) != nullptr );
+  };
+
+  mColumnIndexes.erase( std::remove_if(mColumnIndexes.begin(), mColumnIndexes.end(), pred), mColumnIndexes.end() );
+}
+
+void AbstractTableModel::addColumnHashIndex(int column)
+{
+  assert( columnIndexIsInRange(column) );
+
+  addColumnIndex<ColumnHashIndex>(column);
+}
+
+void AbstractTableModel::removeColumnHashIndex(int column) noexcept
+{
+  removeColumnIndex<ColumnHashIndex>(column);
+}
+
+bool AbstractTableModel::hasColumnHashIndex(int column) const noexcept
+{
+  return findColumnIndex<ColumnHashIndex>(column) != nullptr;
+}
+
+int AbstractTableModel::rowForKey(int column, const QVariant & key) const
+{
+  assert( hasColumnHashIndex(column) );
+
+  const std::vector<int> & rows = updatedColumnIndex<ColumnHashIndex>(column).rowsForKey( ColumnHashIndex::keyFromValue(key) );
+  if( rows.empty() ){
+    return -1;
+  }
+
+  return rows.front();
+}
+
+void AbstractTableModel::addColumnPrefixIndex(int column)
+{
+  assert( columnIndexIsInRange(column) );
+
+  addColumnIndex<ColumnPrefixIndex>(column);
+}
+
+void AbstractTableModel::removeColumnPrefixIndex(int column) noexcept
+{
+  removeColumnIndex<ColumnPrefixIndex>(column);
+}
+
+bool AbstractTableModel::hasColumnPrefixIndex(int column) const noexcept
+{
+  return findColumnIndex<ColumnPrefixIndex>(column) != nullptr;
+}
+
+RowRangeList AbstractTableModel::rowsStartingWith(int column, const QString & prefix, Qt::CaseSensitivity caseSensitivity) const
+{
+  assert( hasColumnPrefixIndex(column) );
+
+  const RowRangeList candidates = updatedColumnIndex<ColumnPrefixIndex>(column).rowsStartingWith(prefix);
+  if(caseSensitivity == Qt::CaseInsensitive){
+    return candidates;
+  }
+
+  RowRangeList rows;
+  for(const RowRange & range : candidates){
+    for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+      if( columnIndexTextOfRow(row, column).startsWith(prefix, Qt::CaseSensitive) ){
+        rows.addRange( RowRange::fromFirstAndLastRow(row, row) );
+      }
+    }
+  }
+
+  return rows;
+}
+
+void AbstractTableModel::addColumnTrigramIndex(int column)
+{
+  assert( columnIndexIsInRange(column) );
+
+  addColumnIndex<ColumnTrigramIndex>(column);
+}
+
+void AbstractTableModel::removeColumnTrigramIndex(int column) noexcept
+{
+  removeColumnIndex<ColumnTrigramIndex>(column);
+}
+
+bool AbstractTableModel::hasColumnTrigramIndex(int column) const noexcept
+{
+  return findColumnIndex<ColumnTrigramIndex>(column) != nullptr;
+}
+
+RowRangeList AbstractTableModel::rowsThatMayContain(int column, const QString & text) const
+{
+  assert( hasColumnTrigramIndex(column) );
+
+  return updatedColumnIndex<ColumnTrigramIndex>(column).rowsThatMayContain(text);
+}
+
+int AbstractTableModel::columnMaximumTextLength(int column) const noexcept
+{
+  assert( columnIndexIsInRange(column) );
+
+  return doGetColumnMaximumTextLength(column);
+}
+
+QModelIndexList AbstractTableModel::match(const QModelIndex & start, int role, const QVariant & value, int hits, Qt::MatchFlags flags) const
+{
+  const int column = start.column();
+  std::vector<int> rows;
+
+  if( canUseColumnHashIndexForMatch(start, role, flags) ){
+    rows = updatedColumnIndex<ColumnHashIndex>(column).rowsForKey( ColumnHashIndex::keyFromValue(value) );
+  }else if( canUseColumnPrefixIndexForMatch(start, role, flags) ){
+    const Qt::CaseSensitivity caseSensitivity = (flags & Qt::MatchCaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    for( const RowRange & range : rowsStartingWith(column, value.toString(), caseSensitivity) ){
+      for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+        rows.push_back(row);
+      }
+    }
+  }else if( canUseColumnTrigramIndexForMatch(start, role, flags) ){
+    const QString text = value.toString();
+    const Qt::CaseSensitivity caseSensitivity = (flags & Qt::MatchCaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    for( const RowRange & range : rowsThatMayContain(column, text) ){
+      for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+        if( columnIndexTextOfRow(row, column).contains(text, caseSensitivity) ){
+          rows.push_back(row);
+        }
+      }
+    }
+  }else{
+    return QAbstractTableModel::match(start, role, value, hits, flags);
+  }
+
+  const auto first = std::lower_bound( rows.cbegin(), rows.cend(), start.row() );
+
+  QModelIndexList result;
+  const auto appendMatches = [this, column, hits, &result](auto begin, auto end){
+    for(auto it = begin; it != end; ++it){
+      if( (hits != -1) && (result.size() >= hits) ){
+        return;
+      }
+      result.append( index(*it, column) );
+    }
+  };
+
+  appendMatches( first, rows.cend() );
+  if( flags & Qt::MatchWrap ){
+    appendMatches( rows.cbegin(), first );
+  }
+
+  return result;
+}
+
 QVariant AbstractTableModel::horizontalHeaderDisplayRoleData(int column) const noexcept
 {
   assert( columnIndexIsInRange(column) );
@@ -322,6 +911,21 @@ QVariant AbstractTableModel::editRoleData(const QModelIndex & index) const
   return displayRoleData(index);
 }
 
+TypedColumnData AbstractTableModel::doGetTypedColumnData(int column, int row, const std::type_info &) const noexcept
+{
+  assert( columnIndexIsInRange(column) );
+  assert( rowIndexIsInRange(row) );
+
+  return TypedColumnData();
+}
+
+int AbstractTableModel::doGetColumnMaximumTextLength(int column) const noexcept
+{
+  assert( columnIndexIsInRange(column) );
+
+  return -1;
+}
+
 QVariant AbstractTableModel::otherRoleData(const QModelIndex&, int) const
 {
   return QVariant();
@@ -352,6 +956,20 @@ void AbstractTableModel::emitRowDataChanged(int row, const QVector<int> & roles)
   QModelIndex topLeft = index(row, 0);
   QModelIndex bottomRight = index( row, columnCount()-1 );
 
+  emitDataChanged(topLeft, bottomRight, roles);
+}
+
+/*
+ * A proxy model or a view connected to dataChanged() before this model
+ * could otherwise use a column index that still has the old keys,
+ * or get the old display data from the cache
+ */
+void AbstractTableModel::emitDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles)
+{
+  updateColumnIndexesOnDataChanged(topLeft, bottomRight);
+  if( mDisplayDataCache.isEnabled() ){
+    updateDisplayDataCacheOnDataChanged(topLeft, bottomRight, roles);
+  }
   emit dataChanged(topLeft, bottomRight, roles);
 }
 
@@ -368,6 +986,310 @@ void AbstractTableModel::endAppendRow()
   endInsertRows();
 }
 
+void AbstractTableModel::beginPrependRow()
+{
+  beginInsertRows( QModelIndex(), 0, 0 );
+}
+
+void AbstractTableModel::endPrependRow()
+{
+  endInsertRows();
+}
+
+bool AbstractTableModel::findInsertMethod(int row, int count, InsertMethod & method) const noexcept
+{
+  assert( rowAndCountIsValidForInsertRows(row, count) );
+
+  if( supportsInsertRows() ){
+    method = InsertMethod::InsertRows;
+  }else if( supportsPrependRow() && rowAndCountRepresentsPrependRow(row, count) ){
+    method = InsertMethod::PrependRow;
+  }else if( supportsAppendRow() && rowAndCountRepresentsAppendRow(row, count) ){
+    method = InsertMethod::AppendRow;
+  }else{
+    return false;
+  }
+
+  return true;
+}
+
+void AbstractTableModel::insertRowsInStorage(InsertMethod method, int row, int count) noexcept
+{
+  switch(method){
+    case InsertMethod::InsertRows:
+      doInsertRows(row, count);
+      break;
+    case InsertMethod::PrependRow:
+      doPrependRow();
+      break;
+    case InsertMethod::AppendRow:
+      doAppendRow();
+      break;
+  }
+}
+
+bool AbstractTableModel::findRemoveMethod(int row, int count, RemoveMethod & method) const noexcept
+{
+  assert( rowAndCountIsValidForRemoveRows(row, count) );
+
+  if( supportsRemoveRows() ){
+    method = RemoveMethod::RemoveRows;
+  }else if( supportsRemoveFirstRow() && rowAndCountRepresentsRemoveFirstRow(row, count) ){
+    method = RemoveMethod::RemoveFirstRow;
+  }else if( supportsRemoveLastRow() && rowAndCountRepresentsRemoveLastRow(row, count) ){
+    method = RemoveMethod::RemoveLastRow;
+  }else{
+    return false;
+  }
+
+  return true;
+}
+
+void AbstractTableModel::removeRowsFromStorage(RemoveMethod method, int row, int count) noexcept
+{
+  switch(method){
+    case RemoveMethod::RemoveRows:
+      doRemoveRows(row, count);
+      break;
+    case RemoveMethod::RemoveFirstRow:
+      doRemoveFirstRow();
+      break;
+    case RemoveMethod::RemoveLastRow:
+      doRemoveLastRow();
+      break;
+  }
+}
+
+bool AbstractTableModel::setDataWithoutSignal(const QModelIndex & index, const QVariant & value, int role)
+{
+  assert( indexIsValidAndInRange(index) );
+
+  if( role == Qt::EditRole ){
+    return setEditRoleData(index, value);
+  }
+  if( role == Qt::DisplayRole ){
+    return setDisplayRoleData(index, value);
+  }
+
+  return setOtherRoleData(index, value, role);
+}
+
+QString AbstractTableModel::columnIndexTextOfRow(int row, int column) const
+{
+  return displayRoleData( index(row, column) ).toString();
+}
+
+bool AbstractTableModel::startIsValidForColumnIndexMatch(const QModelIndex & start, int role) const noexcept
+{
+  if( role != Qt::DisplayRole ){
+    return false;
+  }
+  if( start.model() != this ){
+    return false;
+  }
+
+  return indexIsValidAndInRange(start);
+}
+
+bool AbstractTableModel::canUseColumnHashIndexForMatch(const QModelIndex & start, int role, Qt::MatchFlags flags) const noexcept
+{
+  if( static_cast<int>(flags & ~Qt::MatchWrap) != static_cast<int>(Qt::MatchExactly) ){
+    return false;
+  }
+  if( !startIsValidForColumnIndexMatch(start, role) ){
+    return false;
+  }
+
+  return hasColumnHashIndex( start.column() );
+}
+
+bool AbstractTableModel::canUseColumnPrefixIndexForMatch(const QModelIndex & start, int role, Qt::MatchFlags flags) const noexcept
+{
+  if( static_cast<int>(flags & ~(Qt::MatchWrap|Qt::MatchCaseSensitive)) != static_cast<int>(Qt::MatchStartsWith) ){
+    return false;
+  }
+  if( !startIsValidForColumnIndexMatch(start, role) ){
+    return false;
+  }
+
+  return hasColumnPrefixIndex( start.column() );
+}
+
+bool AbstractTableModel::canUseColumnTrigramIndexForMatch(const QModelIndex & start, int role, Qt::MatchFlags flags) const noexcept
+{
+  if( static_cast<int>(flags & ~(Qt::MatchWrap|Qt::MatchCaseSensitive)) != static_cast<int>(Qt::MatchContains) ){
+    return false;
+  }
+  if( !startIsValidForColumnIndexMatch(start, role) ){
+    return false;
+  }
+
+  return hasColumnTrigramIndex( start.column() );
+}
+
+void AbstractTableModel::connectColumnIndexSignals()
+{
+  if(mColumnIndexSignalsAreConnected){
+    return;
+  }
+
+  connect(this, &AbstractTableModel::rowsAboutToBeInserted, this, &AbstractTableModel::updateColumnIndexesOnRowsAboutToBeInserted);
+  connect(this, &AbstractTableModel::rowsAboutToBeRemoved, this, &AbstractTableModel::updateColumnIndexesOnRowsAboutToBeRemoved);
+  connect(this, &AbstractTableModel::rowsAboutToBeMoved, this, &AbstractTableModel::updateColumnIndexesOnRowsAboutToBeMoved);
+  connect(this, &AbstractTableModel::dataChanged, this, &AbstractTableModel::updateColumnIndexesOnDataChanged);
+  connect(this, &AbstractTableModel::modelAboutToBeReset, this, &AbstractTableModel::invalidateColumnIndexes);
+  connect(this, &AbstractTableModel::modelReset, this, &AbstractTableModel::invalidateColumnIndexes);
+  connect(this, &AbstractTableModel::layoutAboutToBeChanged, this, &AbstractTableModel::invalidateColumnIndexes);
+  connect(this, &AbstractTableModel::layoutChanged, this, &AbstractTableModel::invalidateColumnIndexes);
+  mColumnIndexSignalsAreConnected = true;
+}
+
+/*
+ * The column indexes are updated on the *AboutTo* signals,
+ * so they are correct for the views and proxy models
+ * connected to the rowsInserted(), rowsRemoved() and rowsMoved() signals before this model.
+ */
+void AbstractTableModel::updateColumnIndexesOnRowsAboutToBeInserted(const QModelIndex &, int first, int last)
+{
+  for(const auto & index : mColumnIndexes){
+    index->rowsAboutToBeInserted(first, last);
+  }
+}
+
+void AbstractTableModel::updateColumnIndexesOnRowsAboutToBeRemoved(const QModelIndex &, int first, int last) noexcept
+{
+  for(const auto & index : mColumnIndexes){
+    index->rowsAboutToBeRemoved(first, last);
+  }
+}
+
+void AbstractTableModel::updateColumnIndexesOnRowsAboutToBeMoved(const QModelIndex &, int sourceStart, int sourceEnd,
+                                                                 const QModelIndex &, int destinationRow) noexcept
+{
+  for(const auto & index : mColumnIndexes){
+    index->rowsAboutToBeMoved(sourceStart, sourceEnd, destinationRow);
+  }
+}
+
+/*
+ * Also called by emitDataChanged() before the signal is emitted.
+ * Marking a row as pending twice does nothing.
+ */
+void AbstractTableModel::updateColumnIndexesOnDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight)
+{
+  if( !topLeft.isValid() || !bottomRight.isValid() ){
+    return;
+  }
+
+  for(const auto & index : mColumnIndexes){
+    const int column = index->column();
+    if( (column < topLeft.column()) || (column > bottomRight.column()) ){
+      continue;
+    }
+    index->rowsDataChanged( topLeft.row(), bottomRight.row() );
+  }
+}
+
+void AbstractTableModel::invalidateColumnIndexes() noexcept
+{
+  for(const auto & index : mColumnIndexes){
+    index->invalidate();
+  }
+}
+
+void AbstractTableModel::setDisplayDataCacheCapacity(int capacity)
+{
+  assert( capacity >= 0 );
+
+  if(capacity > 0){
+    connectDisplayDataCacheSignals();
+  }
+  mDisplayDataCache.setCapacity(capacity);
+  if(capacity == 0){
+    mDisplayDataCache.clear();
+  }
+}
+
+QVariant AbstractTableModel::cachedDisplayRoleData(const QModelIndex & index) const
+{
+  assert( mDisplayDataCache.isEnabled() );
+
+  if( const QVariant *data = mDisplayDataCache.find( index.row(), index.column() ) ){
+    return *data;
+  }
+
+  const QVariant data = displayRoleData(index);
+  mDisplayDataCache.insert( index.row(), index.column(), data );
+
+  return data;
+}
+
+void AbstractTableModel::connectDisplayDataCacheSignals()
+{
+  if(mDisplayDataCacheSignalsAreConnected){
+    return;
+  }
+
+  /*
+   * The rows are renumbered on the AboutTo signals,
+   * so the cache is up to date for the slots connected before these ones.
+   * The changes that clear the cache clear it again once done,
+   * in case data() has been called meanwhile.
+   */
+  connect(this, &AbstractTableModel::rowsAboutToBeInserted, this, &AbstractTableModel::updateDisplayDataCacheOnRowsAboutToBeInserted);
+  connect(this, &AbstractTableModel::rowsAboutToBeRemoved, this, &AbstractTableModel::updateDisplayDataCacheOnRowsAboutToBeRemoved);
+  connect(this, &AbstractTableModel::rowsAboutToBeMoved, this, &AbstractTableModel::updateDisplayDataCacheOnRowsAboutToBeMoved);
+  connect(this, &AbstractTableModel::dataChanged, this, &AbstractTableModel::updateDisplayDataCacheOnDataChanged);
+  connect(this, &AbstractTableModel::modelAboutToBeReset, this, &AbstractTableModel::clearDisplayDataCache);
+  connect(this, &AbstractTableModel::modelReset, this, &AbstractTableModel::clearDisplayDataCache);
+  connect(this, &AbstractTableModel::layoutAboutToBeChanged, this, &AbstractTableModel::clearDisplayDataCache);
+  connect(this, &AbstractTableModel::layoutChanged, this, &AbstractTableModel::clearDisplayDataCache);
+  connect(this, &AbstractTableModel::columnsAboutToBeInserted, this, &AbstractTableModel::clearDisplayDataCache);
+  connect(this, &AbstractTableModel::columnsInserted, this, &AbstractTableModel::clearDisplayDataCache);
+  connect(this, &AbstractTableModel::columnsAboutToBeRemoved, this, &AbstractTableModel::clearDisplayDataCache);
+  connect(this, &AbstractTableModel::columnsRemoved, this, &AbstractTableModel::clearDisplayDataCache);
+  connect(this, &AbstractTableModel::columnsAboutToBeMoved, this, &AbstractTableModel::clearDisplayDataCache);
+  connect(this, &AbstractTableModel::columnsMoved, this, &AbstractTableModel::clearDisplayDataCache);
+  mDisplayDataCacheSignalsAreConnected = true;
+}
+
+void AbstractTableModel::updateDisplayDataCacheOnRowsAboutToBeInserted(const QModelIndex &, int first, int last)
+{
+  mDisplayDataCache.rowsInserted(first, last);
+}
+
+void AbstractTableModel::updateDisplayDataCacheOnRowsAboutToBeRemoved(const QModelIndex &, int first, int last)
+{
+  mDisplayDataCache.rowsRemoved(first, last);
+}
+
+void AbstractTableModel::updateDisplayDataCacheOnRowsAboutToBeMoved(const QModelIndex &, int sourceStart, int sourceEnd,
+                                                                    const QModelIndex &, int destinationRow) noexcept
+{
+  /*
+   * Moving [sourceStart,sourceEnd] before destinationRow
+   * changes the position of the rows between the smallest and the biggest of them
+   */
+  const int firstRow = std::min(sourceStart, destinationRow);
+  const int lastRow = std::max(sourceEnd, destinationRow - 1);
+
+  mDisplayDataCache.invalidateRows(firstRow, lastRow);
+}
+
+void AbstractTableModel::updateDisplayDataCacheOnDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight,
+                                                             const QVector<int> & roles) noexcept
+{
+  if( !roles.isEmpty() && !roles.contains(Qt::DisplayRole) ){
+    return;
+  }
+  if( !topLeft.isValid() || !bottomRight.isValid() ){
+    mDisplayDataCache.clear();
+    return;
+  }
+
+  mDisplayDataCache.invalidateCells( topLeft.row(), bottomRight.row(), topLeft.column(), bottomRight.column() );
+}
+
 void AbstractTableModel::doInsertRows(int, int) noexcept
 {
 }
@@ -376,4 +1298,8 @@ void AbstractTableModel::doRemoveRows(int, int) noexcept
 {
 }
 
+void AbstractTableModel::doMoveRows(int, int, int) noexcept
+{
+}
+
 }} // namespace Mdt{ namespace ItemModel{
@@ -10,14 +10,39 @@
 #ifndef MDT_ITEM_MODEL_ABSTRACT_TABLE_MODEL_H
 #define MDT_ITEM_MODEL_ABSTRACT_TABLE_MODEL_H
 
+#include "Mdt/ItemModel/KeyedTableDiff.h"
+#include "Mdt/ItemModel/TableStorage.h"
+#include "Mdt/ItemModel/BulkChangeScope.h"
+#include "Mdt/ItemModel/AbstractColumnIndex.h"
+#include "Mdt/ItemModel/DisplayDataCache.h"
+#include "Mdt/ItemModel/TableReclaimer.h"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include "Mdt/ItemModel/TypedColumn.h"
 #include "mdt_itemmodel_export.h"
 #include <QAbstractTableModel>
 #include <QModelIndex>
 #include <QVariant>
 #include <QVector>
+#include <QModelIndexList>
+#include <QMimeData>
+#include <QStringList>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <typeinfo>
+#include <iterator>
+#include <type_traits>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+#include <cassert>
 
 namespace Mdt{ namespace ItemModel{
 
+  class RowSelection;
+  class TableEditCommand;
+
   /*! \brief Provides a base to create table models
    *
    * The common way to create a custom table model is to subclass QAbstractTableModel .
@@ -348,6 +373,38 @@ namespace Mdt{ namespace ItemModel{
    * };
    * \endcode
    *
+   * Example of a model that supports moving rows.
+   * It should implement doMoveRows():
+   * \code
+   * class MoveRowsTableModel : public Mdt::ItemModel::AbstractTableModel
+   * {
+   *  Q_OBJECT
+   *
+   *  public:
+   *
+   *   MoveRowsTableModel(QObject *parent = nullptr)
+   *    : AbstractTableModel(parent)
+   *   {
+   *   }
+   *
+   *  private:
+   *
+   *   // Methods identical to the ReadOnlyTableModel example omitted here
+   *
+   *   bool doSupportsMoveRows() const noexcept override
+   *   {
+   *     return true;
+   *   }
+   *
+   *   void doMoveRows(int sourceRow, int count, int destinationRow) noexcept override
+   *   {
+   *     assert( rowsAreValidForMoveRows(sourceRow, count, destinationRow) );
+   *
+   *     moveInStlContainer(mTable, sourceRow, count, destinationRow);
+   *   }
+   * };
+   * \endcode
+   *
    * \todo We should remove noexcept in the contract.
    * Think about models that maybe fetches data from file, DB, etc..
    * Thera are also incoherences between displayRoleData() , editRoleData() , setDisplayRoleData() , setEditRoleData() ...
@@ -433,6 +490,9 @@ namespace Mdt{ namespace ItemModel{
      *  - editRoleData() if \a role is Qt::EditRole
      *  - otherRoleData() if \a role is none of the above ones
      *
+     * If the display data cache is enabled, displayRoleData() is only called
+     * for the cells that are not in the cache, see setDisplayDataCacheCapacity() .
+     *
      * \note For other stuff as data access, for example formating,
      *   using a proxy model should be a good solution.
      */
@@ -456,7 +516,8 @@ namespace Mdt{ namespace ItemModel{
      *
      * \note If many data for a row has to be updated (not from the user),
      * a specific method should be implemented.
-     * This one should emit dataChanged() only once for the complete set of updated items in the row.
+     * This one should emit dataChanged() only once for the complete set of updated items in the row,
+     * with emitDataChanged() or emitRowDataChanged() .
      * This prevents strange behaviour, as example, when using dynamic sorting.
      * Emitting dataChanged() for each item in the row will apply sorting every time,
      * which can end up to missmatched data:
@@ -654,6 +715,562 @@ namespace Mdt{ namespace ItemModel{
      */
     bool removeRows( int row, int count, const QModelIndex & parent = QModelIndex() ) override;
 
+    /*! \brief Check if this model supports moving rows
+     *
+     * \sa moveRows()
+     * \sa doSupportsMoveRows()
+     */
+    bool supportsMoveRows() const noexcept
+    {
+      return doSupportsMoveRows();
+    }
+
+    /*! \brief Check if given source row, count and destination row are valid to move rows
+     *
+     * A \a sourceRow < 0 is not valid.
+     *
+     * A \a count < 1 is not valid.
+     *
+     * ( \a sourceRow + \a count ) > rowCount() is not valid.
+     *
+     * A \a destinationRow that is not in range [0, rowCount()] is not valid.
+     *
+     * A \a destinationRow in range [\a sourceRow, \a sourceRow + \a count] is not valid,
+     * because moving the rows there would not change anything
+     * (QAbstractItemModel::beginMoveRows() also refuses such a move).
+     */
+    bool rowsAreValidForMoveRows(int sourceRow, int count, int destinationRow) const noexcept;
+
+    /*! \brief Move \a count rows starting from \a sourceRow before \a destinationChild
+     *
+     * If \a sourceParent or \a destinationParent is valid,
+     * this method does nothing and returns false.
+     *
+     * If this model does not support moving rows,
+     * or \a sourceRow, \a count and \a destinationChild are not valid values for a move,
+     * this method does nothing and returns false.
+     *
+     * Otherwise, doMoveRows() is called between beginMoveRows() and endMoveRows() .
+     * Persistent indexes, so also the selection, follow the moved rows.
+     *
+     * \sa rowsAreValidForMoveRows()
+     * \sa supportsMoveRows()
+     * \sa moveRowRanges()
+     */
+    bool moveRows(const QModelIndex & sourceParent, int sourceRow, int count,
+                  const QModelIndex & destinationParent, int destinationChild) override;
+
+    /*! \brief Move all rows of \a selection before \a destinationRow
+     *
+     * The selected rows are gathered in a single block,
+     * keeping their order, just before the row that was at \a destinationRow .
+     * For example, to move the selected rows to the top:
+     * \code
+     * const auto rowSelection = RowSelection::fromItemSelection( selectionModel->selection() );
+     * model.moveRowRanges(rowSelection, 0);
+     * \endcode
+     *
+     * The ranges are gathered from the farthest range towards \a destinationRow:
+     * the block of already gathered rows is moved over the next gap of unselected rows,
+     * so each unselected row is moved only once.
+     * Each step is a single moveRows() , so persistent indexes are preserved
+     * and proxy models receive row moves instead of removals and insertions.
+     *
+     * \note This is one moveRows() , so one rotation of the storage, per gap between the ranges,
+     * not a single pass over the storage.
+     * beginMoveRows() only describes the move of a contiguous block,
+     * and signaling the whole reordering at once would be a layout change,
+     * which makes proxy models rebuild their mapping.
+     * A rotation costs the size of the gathered block plus the size of the gap,
+     * so a selection of many small ranges far from \a destinationRow
+     * moves the gathered rows many times.
+     *
+     * Returns false if a move failed, for example if this model does not support moving rows.
+     *
+     * \pre all rows of \a selection must be in range
+     * \pre \a destinationRow must be in range [0, rowCount()]
+     * \sa moveRows()
+     */
+    bool moveRowRanges(const RowSelection & selection, int destinationRow);
+
+    /*! \brief Enable or disable drag and drop of row ranges
+     *
+     * When enabled, mimeData() returns a RowRangeMimeData ,
+     * which refers to the dragged rows instead of encoding each index,
+     * and dropping it in this model moves the rows with moveRowRanges() .
+     *
+     * When disabled (the default), the mime and drag and drop methods
+     * behave like the ones of QAbstractTableModel .
+     *
+     * \sa isRowRangeDragAndDropEnabled()
+     */
+    void setRowRangeDragAndDropEnabled(bool enable) noexcept
+    {
+      mRowRangeDragAndDropEnabled = enable;
+    }
+
+    /*! \brief Check if drag and drop of row ranges is enabled
+     *
+     * \sa setRowRangeDragAndDropEnabled()
+     */
+    bool isRowRangeDragAndDropEnabled() const noexcept
+    {
+      return mRowRangeDragAndDropEnabled;
+    }
+
+    /*! \brief Get the mime types this model can accept in a drop
+     *
+     * Returns the ones of QAbstractTableModel ,
+     * followed by RowRangeMimeData::rowRangesMimeType() if row range drag and drop is enabled.
+     *
+     * \sa setRowRangeDragAndDropEnabled()
+     */
+    QStringList mimeTypes() const override;
+
+    /*! \brief Get mime data for \a indexes
+     *
+     * If row range drag and drop is enabled,
+     * \a indexes are reduced to a RowSelection and a list of columns,
+     * which are held by the returned RowRangeMimeData .
+     * The cells are only encoded (as TSV or CSV) if that format is requested.
+     * Returns a nullptr if \a indexes is empty.
+     *
+     * Otherwise, returns QAbstractTableModel::mimeData() .
+     *
+     * \sa mimeDataForRows()
+     * \sa setRowRangeDragAndDropEnabled()
+     */
+    QMimeData *mimeData(const QModelIndexList & indexes) const override;
+
+    /*! \brief Get mime data for the rows in \a selection and \a columns
+     *
+     * Unlike mimeData() , this does not need a index for each selected cell,
+     * and does not depend on setRowRangeDragAndDropEnabled() .
+     * For example, to copy the selected rows to the clipboard:
+     * \code
+     * const auto rowSelection = RowSelection::fromItemSelection( selectionModel->selection() );
+     * QGuiApplication::clipboard()->setMimeData( model.mimeDataForRows(rowSelection, {0, 1}) );
+     * \endcode
+     *
+     * \pre each row in \a selection must be in range
+     * \pre each column in \a columns must be in range
+     */
+    QMimeData *mimeDataForRows(const RowSelection & selection, const std::vector<int> & columns) const;
+
+    /*! \brief Get the supported drag actions
+     *
+     * Returns the ones of QAbstractTableModel .
+     * If row range drag and drop is enabled, Qt::CopyAction is added,
+     * so rows can be dragged to other applications,
+     * and also Qt::MoveAction if this model supports moving rows.
+     */
+    Qt::DropActions supportedDragActions() const override;
+
+    /*! \brief Get the supported drop actions
+     *
+     * Returns the ones of QAbstractTableModel ,
+     * plus Qt::MoveAction if row range drag and drop is enabled and this model supports moving rows.
+     */
+    Qt::DropActions supportedDropActions() const override;
+
+    /*! \brief Check if \a data can be dropped in this model
+     *
+     * If row range drag and drop is enabled, \a data is a RowRangeMimeData
+     * and \a action is Qt::MoveAction , returns true if \a data refers to the current rows of this model
+     * and this model supports moving rows.
+     *
+     * Otherwise, returns QAbstractTableModel::canDropMimeData() .
+     */
+    bool canDropMimeData(const QMimeData *data, Qt::DropAction action,
+                         int row, int column, const QModelIndex & parent) const override;
+
+    /*! \brief Handle \a data dropped in this model
+     *
+     * If row range drag and drop is enabled, \a data is a RowRangeMimeData
+     * and \a action is Qt::MoveAction , the rows referenced by \a data
+     * are moved with moveRowRanges() before \a row ,
+     * or before \a parent if \a row is -1 (dropped on a item),
+     * or to the end if both are invalid (dropped after the last row).
+     * So, only a few moveRows() are done, whatever the count of dragged rows is.
+     *
+     * In that case, this method returns false, even if the rows have been moved.
+     * When a drop succeeds with Qt::MoveAction ,
+     * QAbstractItemView removes the dragged rows from the source model,
+     * which is this model here, and the rows have already been moved.
+     *
+     * Other drops are handled by QAbstractTableModel::dropMimeData() .
+     *
+     * \sa moveDroppedRows()
+     */
+    bool dropMimeData(const QMimeData *data, Qt::DropAction action,
+                      int row, int column, const QModelIndex & parent) override;
+
+    /*! \brief Move the rows referenced by \a data before \a destinationRow
+     *
+     * Returns true if the rows have been moved.
+     * Returns false if \a data is not a RowRangeMimeData
+     * that refers to the current rows of this model.
+     *
+     * \pre \a data must not be a nullptr
+     * \pre \a destinationRow must be in range [0, rowCount()]
+     * \sa dropMimeData()
+     */
+    bool moveDroppedRows(const QMimeData *data, int destinationRow);
+
+    /*! \brief Apply \a commands to this model
+     *
+     * The commands are applied in order,
+     * but the signals are reduced to the minimum:
+     *  - successive SetData commands on the same item (same row, column and role)
+     *    are coalesced, only the last value is set
+     *  - the items are set in the order of their last SetData command,
+     *    so a model that validates a item against other ones sees the order of the commands
+     *  - updated items are reported with a single dataChanged() per range of contiguous rows
+     *  - a InsertRows command that inserts rows adjacent to (or inside) rows inserted by the previous command
+     *    is merged with it, so insertRows() is called once
+     *  - the same is done for RemoveRows commands that remove rows adjacent to the previously removed ones
+     *
+     * Merging InsertRows (or RemoveRows) commands is only done
+     * if this model supports inserting (or removing) rows at any place.
+     *
+     * Rows in a command refer to the state of this model
+     * once all the previous commands have been applied,
+     * exactly as if they had been applied one by one.
+     * For example, appending 3 rows and setting their data:
+     * \code
+     * const int row = model.rowCount();
+     * std::vector<TableEditCommand> commands;
+     *
+     * commands.push_back( TableEditCommand::insertRows(row, 1) );
+     * commands.push_back( TableEditCommand::insertRows(row + 1, 2) );
+     * commands.push_back( TableEditCommand::setData(row, 0, 1) );
+     * commands.push_back( TableEditCommand::setData(row + 1, 0, 2) );
+     * commands.push_back( TableEditCommand::setData(row + 2, 0, 3) );
+     *
+     * model.applyEditCommands(commands);
+     * \endcode
+     * results in one rowsInserted() and one dataChanged() .
+     *
+     * This is typically used to apply edits that come from a other thread
+     * in a single batch, see TableEditQueue .
+     *
+     * A command that cannot be applied (out of range row or column,
+     * or a operation not supported by this model) is ignored, and this method returns false.
+     * The other commands are applied.
+     *
+     * \sa TableEditCommand
+     * \sa insertRows()
+     * \sa removeRows()
+     * \sa setData()
+     */
+    bool applyEditCommands(const std::vector<TableEditCommand> & commands);
+
+    /*! \brief Apply \a commands to this model inside a model reset
+     *
+     * The commands are applied in order, directly to the storage
+     * (with doInsertRows() , doRemoveRows() , setEditRoleData() , ...),
+     * between beginResetModel() and endResetModel() .
+     * So, the only signals emitted are modelAboutToBeReset() and modelReset() .
+     * Like with applyEditCommands() , a command that cannot be applied is ignored,
+     * and this method returns false.
+     *
+     * When most of the rows are affected by \a commands ,
+     * a single reset is cheaper for the attached views and proxy models
+     * than fine-grained signals.
+     * BulkChangeScope can be used to choose between both.
+     *
+     * \sa applyEditCommands()
+     */
+    bool applyEditCommandsInModelReset(const std::vector<TableEditCommand> & commands);
+
+    /*! \brief Add a hash index on \a column
+     *
+     * Once added, rowForKey() and match() (with Qt::MatchExactly on Qt::DisplayRole)
+     * find the rows that have a given value in \a column in constant time,
+     * instead of reading the data of each row.
+     *
+     * The index is built on the first lookup,
+     * then it is maintained by following the signals of this model
+     * (rowsAboutToBeInserted(), rowsAboutToBeRemoved(), rowsAboutToBeMoved(), dataChanged(), modelReset(), layoutChanged()).
+     * Inserting, removing or moving rows shifts the row numbers stored in the index,
+     * before the views and proxy models are notified.
+     * The keys of the inserted and changed rows are read on the next lookup.
+     *
+     * The index holds the display role data of each row as a string,
+     * see ColumnHashIndex .
+     *
+     * Does nothing if a index already exists for \a column .
+     *
+     * \pre \a column must be in valid range
+     * \sa removeColumnHashIndex()
+     */
+    void addColumnHashIndex(int column);
+
+    /*! \brief Remove the hash index on \a column
+     *
+     * Does nothing if \a column has no hash index.
+     */
+    void removeColumnHashIndex(int column) noexcept;
+
+    /*! \brief Check if \a column has a hash index
+     *
+     * \sa addColumnHashIndex()
+     */
+    bool hasColumnHashIndex(int column) const noexcept;
+
+    /*! \brief Get the first row that has \a key in \a column
+     *
+     * Returns -1 if no row has \a key in \a column .
+     *
+     * \code
+     * model.addColumnHashIndex(idColumn);
+     *
+     * const int row = model.rowForKey(idColumn, id);
+     * \endcode
+     *
+     * \pre \a column must have a hash index
+     * \sa addColumnHashIndex()
+     */
+    int rowForKey(int column, const QVariant & key) const;
+
+    /*! \brief Add a prefix index on \a column
+     *
+     * Once added, rowsStartingWith() and match() (with Qt::MatchStartsWith on Qt::DisplayRole)
+     * find the rows that start with a given text in \a column in O(log n + k),
+     * instead of reading the data of each row.
+     * This keeps keyboard search (type-ahead) in views instant on big tables.
+     *
+     * The index is built on the first lookup,
+     * then it is maintained by following the signals of this model, see ColumnPrefixIndex .
+     *
+     * Does nothing if a prefix index already exists for \a column .
+     *
+     * \pre \a column must be in valid range
+     * \sa ColumnPrefixIndex
+     * \sa removeColumnPrefixIndex()
+     */
+    void addColumnPrefixIndex(int column);
+
+    /*! \brief Remove the prefix index on \a column
+     *
+     * Does nothing if \a column has no prefix index.
+     */
+    void removeColumnPrefixIndex(int column) noexcept;
+
+    /*! \brief Check if \a column has a prefix index
+     *
+     * \sa addColumnPrefixIndex()
+     */
+    bool hasColumnPrefixIndex(int column) const noexcept;
+
+    /*! \brief Get the rows that start with \a prefix in \a column
+     *
+     * If \a caseSensitivity is Qt::CaseSensitive,
+     * the rows found by the index are checked against their data.
+     *
+     * \pre \a column must have a prefix index
+     * \sa addColumnPrefixIndex()
+     */
+    RowRangeList rowsStartingWith(int column, const QString & prefix, Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive) const;
+
+    /*! \brief Add a trigram index on \a column
+     *
+     * Once added, rowsThatMayContain() returns the candidate rows
+     * for a substring search in \a column , by intersecting posting lists,
+     * instead of reading the data of each row.
+     * The candidates then have to be checked with the full predicate
+     * (for example a regular expression), see ColumnTrigramIndex .
+     *
+     * match() with Qt::MatchContains on Qt::DisplayRole also uses this index.
+     *
+     * The index is built on the first lookup,
+     * then it is maintained by following the signals of this model, see ColumnTrigramIndex .
+     *
+     * Does nothing if a trigram index already exists for \a column .
+     *
+     * \pre \a column must be in valid range
+     * \sa removeColumnTrigramIndex()
+     */
+    void addColumnTrigramIndex(int column);
+
+    /*! \brief Remove the trigram index on \a column
+     *
+     * Does nothing if \a column has no trigram index.
+     */
+    void removeColumnTrigramIndex(int column) noexcept;
+
+    /*! \brief Check if \a column has a trigram index
+     *
+     * \sa addColumnTrigramIndex()
+     */
+    bool hasColumnTrigramIndex(int column) const noexcept;
+
+    /*! \brief Get the rows that may contain \a text in \a column
+     *
+     * The returned rows are a superset of the rows that contain \a text
+     * (case insensitive).
+     * If \a text is shorter than 3 characters, all rows are returned.
+     *
+     * \pre \a column must have a trigram index
+     * \sa addColumnTrigramIndex()
+     */
+    RowRangeList rowsThatMayContain(int column, const QString & text) const;
+
+    /*! \brief Get the values of \a column as a array of \a T
+     *
+     * Returns a view that reads the values directly in the storage of this model,
+     * without boxing them in a QVariant.
+     *
+     * A null view is returned if this model does not expose \a column with the type \a T ,
+     * or if the values are not in a single array (for example, in a ChunkedTable ).
+     * In that case, visitTypedColumn() can still be used.
+     *
+     * \pre \a column must be in valid range
+     * \sa doGetTypedColumnData()
+     */
+    template<typename T>
+    TypedColumn<T> typedColumn(int column) const noexcept
+    {
+      assert( columnIndexIsInRange(column) );
+
+      const int rowCount = rowCountWithoutParentIndex();
+      if(rowCount == 0){
+        return TypedColumn<T>();
+      }
+      const TypedColumnData data = doGetTypedColumnData( column, 0, typeid(T) );
+      if( data.isNull() || (data.rowCount < rowCount) ){
+        return TypedColumn<T>();
+      }
+
+      return TypedColumn<T>(data);
+    }
+
+    /*! \brief Call \a visitor for each value of \a column in \a rows
+     *
+     * \a visitor is called as visitor(int row, const T & value) ,
+     * in the order of the rows.
+     *
+     * Returns false, without calling \a visitor ,
+     * if this model does not expose \a column with the type \a T .
+     *
+     * \pre \a column must be in valid range
+     * \pre \a rows must be in valid range
+     * \sa typedColumn()
+     * \sa forEachColumnValue()
+     */
+    template<typename T, typename Visitor>
+    bool visitTypedColumn(int column, const RowRange & rows, const Visitor & visitor) const
+    {
+      assert( columnIndexIsInRange(column) );
+      assert( rowIndexIsInRange( rows.firstRow() ) );
+      assert( rowIndexIsInRange( rows.lastRow() ) );
+
+      int row = rows.firstRow();
+      while( row <= rows.lastRow() ){
+        const TypedColumnData data = doGetTypedColumnData( column, row, typeid(T) );
+        if( data.isNull() ){
+          assert( row == rows.firstRow() );
+          return false;
+        }
+        assert( data.rowCount >= 1 );
+        const TypedColumn<T> values(data);
+        const int count = std::min( values.rowCount(), rows.lastRow() - row + 1 );
+        for(int i = 0; i < count; ++i){
+          visitor(row + i, values[i]);
+        }
+        row += count;
+      }
+
+      return true;
+    }
+
+    /*! \brief Get the maximum length, in characters, of the display text of \a column
+     *
+     * Returns -1 if the maximum length is not known.
+     *
+     * Views can use this hint to size a column without reading its data,
+     * see Mdt::ItemView::estimateColumnWidths() .
+     *
+     * \pre \a column must be in valid range
+     * \sa doGetColumnMaximumTextLength()
+     */
+    int columnMaximumTextLength(int column) const noexcept;
+
+    /*! \brief Get the indexes that match \a value
+     *
+     * If \a role is Qt::DisplayRole and the column of \a start has:
+     *  - a hash index, and \a flags requests Qt::MatchExactly ,
+     *    the hash index is used
+     *  - a prefix index, and \a flags requests Qt::MatchStartsWith ,
+     *    the prefix index is used
+     *  - a trigram index, and \a flags requests Qt::MatchContains ,
+     *    the candidates given by the trigram index are checked
+     *
+     * Qt::MatchWrap is supported,
+     * and Qt::MatchCaseSensitive for Qt::MatchStartsWith and Qt::MatchContains .
+     * Otherwise, QAbstractTableModel::match() is called.
+     *
+     * \sa addColumnHashIndex()
+     * \sa addColumnPrefixIndex()
+     * \sa addColumnTrigramIndex()
+     */
+    QModelIndexList match(const QModelIndex & start, int role, const QVariant & value, int hits = 1,
+                          Qt::MatchFlags flags = Qt::MatchFlags(Qt::MatchStartsWith|Qt::MatchWrap) ) const override;
+
+    /*! \brief Cache the display role data of up to \a capacity cells
+     *
+     * Views call data() for the visible cells each time they paint.
+     * If displayRoleData() is expensive, for example because it formats numbers or dates with QLocale ,
+     * the cache returns the data of the recently displayed cells without calling it again.
+     * A capacity a bit bigger than the count of visible cells is a good start.
+     *
+     * The cache is invalidated by following the signals of this model:
+     *  - setData() , emitDataChanged() and emitRowDataChanged() drop the changed cells
+     *    before emitting dataChanged() , unless its roles do not contain Qt::DisplayRole .
+     *    A dataChanged() emitted directly by a concrete model also drops the changed cells,
+     *    but views connected before the cache could read stale data,
+     *    so concrete models should use emitDataChanged()
+     *  - rowsAboutToBeInserted() and rowsAboutToBeRemoved() drop the removed cells
+     *    and renumber the following ones
+     *  - rowsAboutToBeMoved() drops the cells of the rows that change their position
+     *  - a reset, a layout change and changes of the columns clear the cache,
+     *    both when they are about to happen and once they are done
+     *
+     * So a model that modifies its data must emit the corresponding signals,
+     * which is already required by the views.
+     * If the display data changes without a signal, for example after a change of the locale,
+     * clearDisplayDataCache() must be called.
+     *
+     * Because the rows are renumbered on the *AboutTo* signals,
+     * the cache is up to date when the views and proxy models are notified
+     * that the rows have been inserted, removed or moved,
+     * whatever the order in which they are connected to this model is.
+     *
+     * A \a capacity of 0 (the default) disables the cache.
+     *
+     * \pre \a capacity must be >= 0
+     * \sa DisplayDataCache
+     */
+    void setDisplayDataCacheCapacity(int capacity);
+
+    /*! \brief Get the count of cells the display data cache can hold
+     *
+     * \sa setDisplayDataCacheCapacity()
+     */
+    int displayDataCacheCapacity() const noexcept
+    {
+      return mDisplayDataCache.capacity();
+    }
+
+    /*! \brief Drop all cells of the display data cache
+     *
+     * \sa setDisplayDataCacheCapacity()
+     */
+    void clearDisplayDataCache() noexcept
+    {
+      mDisplayDataCache.clear();
+    }
+
    protected:
 
     /*! \brief Get count of rows
@@ -721,6 +1338,56 @@ namespace Mdt{ namespace ItemModel{
     virtual
     QVariant editRoleData(const QModelIndex & index) const;
 
+    /*! \brief Get the values of \a column starting at \a row , if they are of type \a type
+     *
+     * This is the hook used by typedColumn() and visitTypedColumn() .
+     * A model that stores its records in a array can return a strided view of them:
+     * \code
+     * TypedColumnData doGetTypedColumnData(int column, int row, const std::type_info & type) const noexcept override
+     * {
+     *   const Record *first = mTable.data() + row;
+     *   const int count = rowCount() - row;
+     *
+     *   if( (column == 0) && (type == typeid(int)) ){
+     *     return TypedColumnData::fromMember(first, count, &Record::id);
+     *   }
+     *
+     *   return TypedColumnData();
+     * }
+     * \endcode
+     *
+     * The returned data must begin at \a row ,
+     * and may contain less rows than the remaining ones
+     * (for example, only the rest of a chunk).
+     * For a given \a column and \a type , a model must return a null data
+     * either for all rows, or for none.
+     *
+     * The exposed values must be the ones returned by data()
+     * for Qt::DisplayRole and Qt::EditRole , converted to \a type ,
+     * because consumers like forEachColumnValue() and exportModel()
+     * use them in place of data() .
+     *
+     * This default implementation returns a null data.
+     *
+     * \pre \a column must be in valid range
+     * \pre \a row must be in valid range
+     */
+    virtual
+    TypedColumnData doGetTypedColumnData(int column, int row, const std::type_info & type) const noexcept;
+
+    /*! \brief Get the maximum length, in characters, of the display text of \a column
+     *
+     * This is the hook used by columnMaximumTextLength() .
+     * A model whose column has a bounded length (for example a fixed format id,
+     * or a text limited by the database schema) can return it.
+     *
+     * This default implementation returns -1 (unknown).
+     *
+     * \pre \a column must be in valid range
+     */
+    virtual
+    int doGetColumnMaximumTextLength(int column) const noexcept;
+
     /*! \brief Get other role data
      *
      * If the table model has to return data for roles that are not proposed
@@ -790,6 +1457,20 @@ namespace Mdt{ namespace ItemModel{
      */
     void emitRowDataChanged( int row, const QVector<int> & roles = QVector<int>() ) noexcept;
 
+    /*! \brief Emit dataChanged() for the cells from \a topLeft to \a bottomRight
+     *
+     * This is the way for a concrete model to signal that its data changed,
+     * for example from a method that updates many items of a row (see setData() ).
+     * Before the signal is emitted, the column indexes and the display data cache
+     * are told about the change, so the views and proxy models
+     * that are notified do not read stale data.
+     * Emitting dataChanged() directly does not guarantee that.
+     *
+     * \pre \a topLeft and \a bottomRight must be valid indexes of this model
+     * \sa emitRowDataChanged()
+     */
+    void emitDataChanged( const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles = QVector<int>() );
+
     /*! \brief Begins a row append operation
      *
      * This is a helper to beginInsertRows().
@@ -811,6 +1492,237 @@ namespace Mdt{ namespace ItemModel{
      */
     void endAppendRow();
 
+    /*! \brief Begins a row prepend operation
+     *
+     * This is a helper to beginInsertRows().
+     *
+     * \note when implementing doPrependRow(),
+     * this method has NOT to be called.
+     *
+     * \sa endPrependRow()
+     */
+    void beginPrependRow();
+
+    /*! \brief Ends a row prepend operation
+     *
+     * This helper calls endInsertRows().
+     * It is provided to be coherent with beginPrependRow().
+     *
+     * \sa beginPrependRow()
+     */
+    void endPrependRow();
+
+    /*! \brief Replace the records of \a table with the ones of \a newTable
+     *
+     * Instead of resetting the model, the differences between both tables
+     * are computed with computeKeyedTableDiff() ,
+     * records being matched by the key returned by \a keyFunction .
+     * Then, only the removed, moved, inserted and changed rows are notified,
+     * with removeRows, moveRows, insertRows and dataChanged signals,
+     * one for each range of contiguous rows.
+     * So, the selection, the current index and the mapping of proxy models are preserved.
+     *
+     * If the differences affect half or more of the rows
+     * (see BulkChangeScope::defaultResetThreshold ),
+     * the model is reset, which is cheaper.
+     *
+     * \a table is the storage of this model, for example a std::vector or a ChunkedTable ,
+     * which is accessed with TableStorage .
+     *
+     * \code
+     * void DeviceListTableModel::setTable(const DeviceListTable & table)
+     * {
+     *   replaceTableByKey(mTable, table, [](const DeviceListRecord & record){
+     *     return record.id;
+     *   });
+     * }
+     * \endcode
+     *
+     * \a equal is used to tell if a record that exists in both tables has changed.
+     * By default, the records are compared with operator==() .
+     *
+     * \pre \a table must be the storage of this model
+     *  (rowCount() must be the size of \a table )
+     */
+    template<typename Table, typename NewTable, typename KeyFunction, typename EqualFunction = std::equal_to<>>
+    void replaceTableByKey(Table & table, const NewTable & newTable,
+                           const KeyFunction & keyFunction, const EqualFunction & equal = EqualFunction())
+    {
+      using Storage = TableStorage<Table>;
+
+      assert( static_cast<std::size_t>( rowCountWithoutParentIndex() ) == table.size() );
+
+      const KeyedTableDiff diff = computeKeyedTableDiff(table, newTable, keyFunction, equal);
+      if( diff.isEmpty() ){
+        return;
+      }
+      if( isResetCheaperThanKeyedTableDiff( diff, newTable.size() ) ){
+        beginResetModel();
+        Storage::assign( table, std::cbegin(newTable), std::cend(newTable) );
+        endResetModel();
+        return;
+      }
+      applyKeyedTableDiff(table, newTable, diff);
+    }
+
+    /*! \brief Replace the records of \a table with the ones of \a newTable , destroying the replaced records in the thread of \a reclaimer
+     *
+     * Like the other replaceTableByKey() ,
+     * only the differences are notified, unless they affect half or more of the rows.
+     *
+     * If the model is reset, \a table and \a newTable are swapped
+     * and the old table is given to \a reclaimer , like replaceTable() does.
+     * Otherwise, the differences are applied to \a table ,
+     * then \a newTable is given to \a reclaimer .
+     * So, the GUI thread only destroys the removed and changed records.
+     *
+     * \code
+     * void DeviceListTableModel::setTable(DeviceListTable && table)
+     * {
+     *   replaceTableByKey(mTable, std::move(table), mReclaimer, [](const DeviceListRecord & record){
+     *     return record.id;
+     *   });
+     * }
+     * \endcode
+     *
+     * \pre \a table must be the storage of this model
+     *  (rowCount() must be the size of \a table )
+     * \sa TableReclaimer
+     */
+    template<typename Table, typename KeyFunction, typename EqualFunction = std::equal_to<>>
+    void replaceTableByKey(Table & table, Table && newTable, TableReclaimer & reclaimer,
+                           const KeyFunction & keyFunction, const EqualFunction & equal = EqualFunction())
+    {
+      assert( static_cast<std::size_t>( rowCountWithoutParentIndex() ) == table.size() );
+
+      const KeyedTableDiff diff = computeKeyedTableDiff(table, newTable, keyFunction, equal);
+      if( diff.isEmpty() ){
+        reclaimer.reclaim( std::move(newTable) );
+        return;
+      }
+      if( isResetCheaperThanKeyedTableDiff( diff, newTable.size() ) ){
+        replaceTable( table, std::move(newTable), reclaimer );
+        return;
+      }
+      applyKeyedTableDiff(table, newTable, diff);
+      reclaimer.reclaim( std::move(newTable) );
+    }
+
+    /*! \brief Append the records of \a newRecords to \a table
+     *
+     * If \a newRecords is a rvalue, the records are moved from it to \a table ,
+     * otherwise they are copied.
+     * The views are notified with a single insertRows signal,
+     * whatever the count of records is.
+     * This is the way to hand a table built in a worker thread
+     * (for example by importDelimitedText() ) to the model.
+     *
+     * \code
+     * void DeviceListTableModel::appendRecords(std::vector<DeviceListRecord> && records)
+     * {
+     *   appendRecordsToTable( mTable, std::move(records) );
+     * }
+     * \endcode
+     *
+     * \pre \a table must be the storage of this model
+     *  (rowCount() must be the size of \a table )
+     * \sa assignRecordsToTable()
+     */
+    template<typename Table, typename NewRecords>
+    void appendRecordsToTable(Table & table, NewRecords && newRecords)
+    {
+      using Storage = TableStorage<Table>;
+
+      assert( static_cast<std::size_t>( rowCountWithoutParentIndex() ) == table.size() );
+
+      if( newRecords.empty() ){
+        return;
+      }
+
+      const int firstRow = rowCountWithoutParentIndex();
+      const int lastRow = firstRow + static_cast<int>( newRecords.size() ) - 1;
+
+      beginInsertRows(QModelIndex(), firstRow, lastRow);
+      if constexpr( std::is_lvalue_reference<NewRecords>::value ){
+        Storage::insertRows( table, firstRow, std::begin(newRecords), std::end(newRecords) );
+      }else{
+        Storage::insertRows( table, firstRow,
+                             std::make_move_iterator( std::begin(newRecords) ), std::make_move_iterator( std::end(newRecords) ) );
+      }
+      endInsertRows();
+    }
+
+    /*! \brief Replace the records of \a table with the ones of \a newRecords
+     *
+     * If \a newRecords is a rvalue, the records are moved from it to \a table ,
+     * otherwise they are copied.
+     * The model is reset once.
+     * Unlike replaceTableByKey() , no difference is computed,
+     * which is what a freshly loaded table needs.
+     *
+     * \pre \a table must be the storage of this model
+     * \sa appendRecordsToTable()
+     * \sa replaceTable()
+     */
+    template<typename Table, typename NewRecords>
+    void assignRecordsToTable(Table & table, NewRecords && newRecords)
+    {
+      using Storage = TableStorage<Table>;
+
+      beginResetModel();
+      if constexpr( std::is_lvalue_reference<NewRecords>::value ){
+        Storage::assign( table, std::begin(newRecords), std::end(newRecords) );
+      }else{
+        Storage::assign( table, std::make_move_iterator( std::begin(newRecords) ), std::make_move_iterator( std::end(newRecords) ) );
+      }
+      endResetModel();
+    }
+
+    /*! \brief Replace \a table with \a newTable , resetting the model once
+     *
+     * \a table and \a newTable are swapped, so no record is copied nor moved.
+     * The previous storage of this model is returned once the reset is done,
+     * so the caller decides where its records are destroyed.
+     *
+     * Unlike assignRecordsToTable() , the old records
+     * are not destroyed between beginResetModel() and endResetModel() .
+     *
+     * \pre \a table must be the storage of this model
+     */
+    template<typename Table>
+    Table replaceTable(Table & table, Table && newTable)
+    {
+      using std::swap;
+
+      beginResetModel();
+      swap(table, newTable);
+      endResetModel();
+
+      return std::move(newTable);
+    }
+
+    /*! \brief Replace \a table with \a newTable , then destroy the old table in the thread of \a reclaimer
+     *
+     * Destroying a big table can take a noticeable time,
+     * for example if each record has std::string members.
+     * This is done by \a reclaimer , after the reset.
+     *
+     * \code
+     * void DeviceListTableModel::setTable(DeviceListTable && table)
+     * {
+     *   replaceTable( mTable, std::move(table), mReclaimer );
+     * }
+     * \endcode
+     *
+     * \pre \a table must be the storage of this model
+     * \sa TableReclaimer
+     */
+    template<typename Table>
+    void replaceTable(Table & table, Table && newTable, TableReclaimer & reclaimer)
+    {
+      reclaimer.reclaim( replaceTable( table, std::move(newTable) ) );
+    }
+
     /*! \brief Check if this model supports prepending a row
      *
      * If the implementation does not support inserting rows at any valid place,
@@ -874,6 +1786,9 @@ namespace Mdt{ namespace ItemModel{
      *
      * This default implementation does nothing.
      *
+     * \note when implementing this method,
+     * beginPrependRow() / endPrependRow() have NOT to be called.
+     *
      * \sa doSupportsPrependRow()
      */
     virtual
@@ -993,6 +1908,131 @@ namespace Mdt{ namespace ItemModel{
      */
     virtual
     void doRemoveRows(int row, int count) noexcept;
+
+    /*! \brief Check if this model supports moving rows
+     *
+     * If the implementation supports moving rows,
+     * this method should be reimplemented and return true.
+     *
+     * In that case, doMoveRows() should also be implemented.
+     *
+     * This default implementation returns false.
+     *
+     * \sa doMoveRows()
+     * \sa supportsMoveRows()
+     */
+    virtual
+    bool doSupportsMoveRows() const noexcept
+    {
+      return false;
+    }
+
+    /*! \brief Move \a count rows starting from \a sourceRow before \a destinationRow
+     *
+     * \a destinationRow is the row before the move,
+     * like \a destinationChild in QAbstractItemModel::beginMoveRows() .
+     * moveInStlContainer() can be used to implement this method.
+     *
+     * This default implementation does nothing.
+     *
+     * \note when implementing this method,
+     * beginMoveRows() and endMoveRows() have NOT to be called.
+     *
+     * \sa doSupportsMoveRows()
+     * \sa rowsAreValidForMoveRows()
+     */
+    virtual
+    void doMoveRows(int sourceRow, int count, int destinationRow) noexcept;
+
+   private:
+
+    enum class InsertMethod
+    {
+      InsertRows,
+      PrependRow,
+      AppendRow
+    };
+
+    enum class RemoveMethod
+    {
+      RemoveRows,
+      RemoveFirstRow,
+      RemoveLastRow
+    };
+
+    bool findInsertMethod(int row, int count, InsertMethod & method) const noexcept;
+    void insertRowsInStorage(InsertMethod method, int row, int count) noexcept;
+    bool findRemoveMethod(int row, int count, RemoveMethod & method) const noexcept;
+    void removeRowsFromStorage(RemoveMethod method, int row, int count) noexcept;
+    bool setDataWithoutSignal(const QModelIndex & index, const QVariant & value, int role);
+    QString columnIndexTextOfRow(int row, int column) const;
+    template<typename Index>
+    Index *findColumnIndex(int column) const noexcept;
+    template<typename Index>
+    const Index & updatedColumnIndex(int column) const;
+    template<typename Index>
+    void addColumnIndex(int column);
+    template<typename Index>
+    void removeColumnIndex(int column) noexcept;
+    bool startIsValidForColumnIndexMatch(const QModelIndex & start, int role) const noexcept;
+    bool canUseColumnHashIndexForMatch(const QModelIndex & start, int role, Qt::MatchFlags flags) const noexcept;
+    bool canUseColumnPrefixIndexForMatch(const QModelIndex & start, int role, Qt::MatchFlags flags) const noexcept;
+    bool canUseColumnTrigramIndexForMatch(const QModelIndex & start, int role, Qt::MatchFlags flags) const noexcept;
+    bool isRowRangeMove(const QMimeData *data, Qt::DropAction action) const noexcept;
+    bool isResetCheaperThanKeyedTableDiff(const KeyedTableDiff & diff, std::size_t newRowCount) const noexcept;
+
+    template<typename Table, typename NewTable>
+    void applyKeyedTableDiff(Table & table, const NewTable & newTable, const KeyedTableDiff & diff)
+    {
+      using Storage = TableStorage<Table>;
+
+      for(auto it = diff.removedRows().crbegin(); it != diff.removedRows().crend(); ++it){
+        beginRemoveRows( QModelIndex(), it->firstRow(), it->lastRow() );
+        Storage::removeRows( table, it->firstRow(), it->rowCount() );
+        endRemoveRows();
+      }
+      for(const RowMove & move : diff.moves()){
+        beginMoveRows(QModelIndex(), move.sourceRow, move.sourceRow + move.count - 1, QModelIndex(), move.destinationRow);
+        Storage::moveRows(table, move.sourceRow, move.count, move.destinationRow);
+        endMoveRows();
+      }
+      for(const RowRange & range : diff.insertedRows()){
+        const auto first = std::next( std::cbegin(newTable), range.firstRow() );
+        beginInsertRows( QModelIndex(), range.firstRow(), range.lastRow() );
+        Storage::insertRows( table, range.firstRow(), first, std::next( first, range.rowCount() ) );
+        endInsertRows();
+      }
+      const int lastColumn = columnCountWithoutParentIndex() - 1;
+      for(const RowRange & range : diff.changedRows()){
+        for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+          Storage::setRecord( table, row, newTable[static_cast<std::size_t>(row)] );
+        }
+        if(lastColumn >= 0){
+          emitDataChanged( index(range.firstRow(), 0), index(range.lastRow(), lastColumn) );
+        }
+      }
+    }
+
+    void connectColumnIndexSignals();
+    void updateColumnIndexesOnRowsAboutToBeInserted(const QModelIndex & parent, int first, int last);
+    void updateColumnIndexesOnRowsAboutToBeRemoved(const QModelIndex & parent, int first, int last) noexcept;
+    void updateColumnIndexesOnRowsAboutToBeMoved(const QModelIndex & sourceParent, int sourceStart, int sourceEnd,
+                                                 const QModelIndex & destinationParent, int destinationRow) noexcept;
+    void updateColumnIndexesOnDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight);
+    void invalidateColumnIndexes() noexcept;
+    QVariant cachedDisplayRoleData(const QModelIndex & index) const;
+    void connectDisplayDataCacheSignals();
+    void updateDisplayDataCacheOnRowsAboutToBeInserted(const QModelIndex & parent, int first, int last);
+    void updateDisplayDataCacheOnRowsAboutToBeRemoved(const QModelIndex & parent, int first, int last);
+    void updateDisplayDataCacheOnRowsAboutToBeMoved(const QModelIndex & sourceParent, int sourceStart, int sourceEnd,
+                                                    const QModelIndex & destinationParent, int destinationRow) noexcept;
+    void updateDisplayDataCacheOnDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles) noexcept;
+
+    std::vector< std::unique_ptr<AbstractColumnIndex> > mColumnIndexes;
+    bool mColumnIndexSignalsAreConnected = false;
+    mutable DisplayDataCache mDisplayDataCache;
+    bool mDisplayDataCacheSignalsAreConnected = false;
+    bool mRowRangeDragAndDropEnabled = false;
   };
 
 }} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "BulkChangeScope.h"
+#include "AbstractTableModel.h"
+#include "RowRange.h"
+#include <algorithm>
+#include <utility>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+BulkChangeScope::BulkChangeScope(AbstractTableModel & model, double resetThreshold) noexcept
+ : mModel(model),
+   mResetThreshold(resetThreshold),
+   mInitialRowCount( model.rowCount() ),
+   mExpectedRowCount(mInitialRowCount)
+{
+  assert( resetThreshold > 0.0 );
+}
+
+BulkChangeScope::~BulkChangeScope() noexcept
+{
+  /*
+   * Applying the edits emits signals, so it runs the connected slots.
+   * An exception thrown by one of them must not leave this destructor.
+   */
+  try{
+    commit();
+  }catch(...){
+  }
+}
+
+void BulkChangeScope::setResetThreshold(double ratio) noexcept
+{
+  assert( ratio > 0.0 );
+
+  mResetThreshold = ratio;
+}
+
+void BulkChangeScope::insertRows(int row, int count)
+{
+  assert( row >= 0 );
+  assert( row <= mExpectedRowCount );
+  assert( count >= 1 );
+
+  mCommands.push_back( TableEditCommand::insertRows(row, count) );
+  mExpectedRowCount += count;
+  mInsertedOrRemovedRowCount += count;
+}
+
+void BulkChangeScope::removeRows(int row, int count)
+{
+  assert( row >= 0 );
+  assert( count >= 1 );
+  assert( row + count <= mExpectedRowCount );
+
+  mCommands.push_back( TableEditCommand::removeRows(row, count) );
+  mExpectedRowCount -= count;
+  mInsertedOrRemovedRowCount += count;
+}
+
+void BulkChangeScope::setData(int row, int column, const QVariant & value, int role)
+{
+  assert( row >= 0 );
+  assert( row < mExpectedRowCount );
+
+  mCommands.push_back( TableEditCommand::setData(row, column, value, role) );
+  mRowsWithSetData.addRange( RowRange::fromFirstAndLastRow(row, row) );
+}
+
+double BulkChangeScope::affectedRowsRatio() const noexcept
+{
+  /*
+   * The rows with data set are recorded regarding the rows at the time of the edit,
+   * so a row can be counted more than once if rows have been inserted or removed before it.
+   * This is good enough to decide which notifications are the cheapest.
+   */
+  int affectedRowCount = mInsertedOrRemovedRowCount;
+  for(const RowRange & range : mRowsWithSetData){
+    affectedRowCount += range.rowCount();
+  }
+  if(affectedRowCount == 0){
+    return 0.0;
+  }
+
+  const int referenceRowCount = std::max( {mInitialRowCount, mExpectedRowCount, 1} );
+
+  return static_cast<double>(affectedRowCount) / static_cast<double>(referenceRowCount);
+}
+
+bool BulkChangeScope::commit()
+{
+  if( mCommands.empty() ){
+    return true;
+  }
+
+  /*
+   * The recorded edits are forgotten before they are applied:
+   * if a slot throws, the destructor must not apply them again
+   */
+  const bool resetModel = willResetModel();
+  const std::vector<TableEditCommand> commands = std::move(mCommands);
+  mCommands.clear();
+  mRowsWithSetData = RowRangeList();
+  mInsertedOrRemovedRowCount = 0;
+  mInitialRowCount = mExpectedRowCount;
+
+  bool ok;
+  if(resetModel){
+    ok = mModel.applyEditCommandsInModelReset(commands);
+  }else{
+    ok = mModel.applyEditCommands(commands);
+  }
+
+  mInitialRowCount = mModel.rowCount();
+  mExpectedRowCount = mInitialRowCount;
+
+  return ok;
+}
+
+}} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_BULK_CHANGE_SCOPE_H
+#define MDT_ITEM_MODEL_BULK_CHANGE_SCOPE_H
+
+#include "Mdt/ItemModel/TableEditCommand.h"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "mdt_itemmodel_export.h"
+#include <QVariant>
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{
+
+  class AbstractTableModel;
+
+  /*! \brief Records a big set of edits and applies them with the cheapest notifications
+   *
+   * For a few edits, fine-grained signals (rowsInserted(), dataChanged(), ...)
+   * are cheaper for the attached views and proxy models.
+   * When most of the rows are affected, a single model reset is cheaper,
+   * because each fine-grained signal has a cost for each proxy model and view.
+   *
+   * A BulkChangeScope records the edits and the rows they affect.
+   * When the scope ends (or commit() is called), the edits are applied:
+   *  - if the ratio of affected rows is less than the reset threshold,
+   *    with AbstractTableModel::applyEditCommands() ,
+   *    which emits the minimal set of fine-grained signals
+   *  - otherwise, with AbstractTableModel::applyEditCommandsInModelReset() ,
+   *    which emits a single model reset
+   *
+   * \code
+   * {
+   *   BulkChangeScope scope(model);
+   *
+   *   for(const auto & device : changedDevices){
+   *     scope.setData( rowOfDevice(device), statusColumn, device.status );
+   *   }
+   *   scope.insertRows( scope.rowCount(), newDevices.size() );
+   * } // edits are applied here
+   * \endcode
+   *
+   * The edits are only applied at the end of the scope,
+   * and rows refer to the state of the model
+   * once all the previous edits of the scope have been applied.
+   * rowCount() returns the row count the model will have.
+   *
+   * The affected rows are the inserted rows, the removed rows
+   * and the rows in which data is set.
+   * The ratio is the count of affected rows divided by
+   * the biggest row count of the model before and after the edits.
+   *
+   * \sa TableEditCommand
+   */
+  class MDT_ITEMMODEL_EXPORT BulkChangeScope
+  {
+   public:
+
+    /*! \brief Default reset threshold
+     *
+     * If half or more of the rows are affected, the model is reset.
+     */
+    static constexpr double defaultResetThreshold = 0.5;
+
+    /*! \brief Start recording edits for \a model
+     *
+     * \pre \a resetThreshold must be > 0
+     * \sa setResetThreshold()
+     */
+    explicit BulkChangeScope(AbstractTableModel & model, double resetThreshold = defaultResetThreshold) noexcept;
+
+    /*! \brief Apply the recorded edits
+     *
+     * Applying the edits runs the slots connected to the model.
+     * If one of them throws, the exception is dropped here,
+     * because a destructor must not throw.
+     * To get the errors, and the exceptions, call commit() before the end of the scope.
+     *
+     * \sa commit()
+     */
+    ~BulkChangeScope() noexcept;
+
+    BulkChangeScope(const BulkChangeScope &) = delete;
+    BulkChangeScope & operator=(const BulkChangeScope &) = delete;
+    BulkChangeScope(BulkChangeScope &&) = delete;
+    BulkChangeScope & operator=(BulkChangeScope &&) = delete;
+
+    /*! \brief Set the ratio of affected rows from which the model is reset
+     *
+     * For example, 0.2 resets the model if 20% or more of the rows are affected.
+     * A value > 1 never resets the model.
+     *
+     * \pre \a ratio must be > 0
+     */
+    void setResetThreshold(double ratio) noexcept;
+
+    /*! \brief Get the ratio of affected rows from which the model is reset
+     */
+    double resetThreshold() const noexcept
+    {
+      return mResetThreshold;
+    }
+
+    /*! \brief Get the row count the model will have once the recorded edits are applied
+     */
+    int rowCount() const noexcept
+    {
+      return mExpectedRowCount;
+    }
+
+    /*! \brief Record inserting \a count rows before \a row
+     *
+     * \pre \a row must be in range [0, rowCount()]
+     * \pre \a count must be >= 1
+     */
+    void insertRows(int row, int count);
+
+    /*! \brief Record removing \a count rows starting from \a row
+     *
+     * \pre \a row and \a count must be >= 0 and >= 1 respectively
+     * \pre \a row + \a count must be <= rowCount()
+     */
+    void removeRows(int row, int count);
+
+    /*! \brief Record setting \a value for \a role at \a row and \a column
+     *
+     * \pre \a row must be in range [0, rowCount()[
+     */
+    void setData(int row, int column, const QVariant & value, int role = Qt::EditRole);
+
+    /*! \brief Get the ratio of affected rows by the recorded edits
+     */
+    double affectedRowsRatio() const noexcept;
+
+    /*! \brief Check if applying the recorded edits will reset the model
+     */
+    bool willResetModel() const noexcept
+    {
+      return affectedRowsRatio() >= mResetThreshold;
+    }
+
+    /*! \brief Apply the recorded edits now
+     *
+     * Returns false if a edit could not be applied.
+     * A exception thrown by a slot connected to the model is propagated.
+     * In that case, the recorded edits are not applied again,
+     * neither by a other commit() nor at the end of the scope.
+     *
+     * Once done, this scope records new edits,
+     * that will be applied at the end of the scope.
+     */
+    bool commit();
+
+   private:
+
+    AbstractTableModel & mModel;
+    double mResetThreshold;
+    int mInitialRowCount;
+    int mExpectedRowCount;
+    int mInsertedOrRemovedRowCount = 0;
+    RowRangeList mRowsWithSetData;
+    std::vector<TableEditCommand> mCommands;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_BULK_CHANGE_SCOPE_H
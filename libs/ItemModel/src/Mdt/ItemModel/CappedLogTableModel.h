@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_CAPPED_LOG_TABLE_MODEL_H
+#define MDT_ITEM_MODEL_CAPPED_LOG_TABLE_MODEL_H
+
+#include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemModel/RingBuffer.h"
+#include "Mdt/ItemModel/NumericLimits.h"
+#include <QModelIndex>
+#include <utility>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Table model that holds at most a given count of records, newest first
+   *
+   * This is a base to create log tail views:
+   * each new record is prepended,
+   * and once the maximum row count is reached, the oldest record (the last row) is removed.
+   *
+   * The records are stored in a RingBuffer,
+   * so prepending and removing the last row is O(1),
+   * regardless of the count of rows.
+   *
+   * Removing the last row is done with removeRows(),
+   * which calls doRemoveLastRow().
+   * Inserting a row at the beginning from the generic API
+   * (for example with prependRowToModel() ) calls doPrependRow(),
+   * which prepends a default constructed record.
+   *
+   * A subclass only has to implement the column count and the data:
+   * \code
+   * struct LogRecord
+   * {
+   *   QDateTime time;
+   *   QString message;
+   * };
+   *
+   * class LogTableModel : public Mdt::ItemModel::CappedLogTableModel<LogRecord>
+   * {
+   *   Q_OBJECT
+   *
+   *  public:
+   *
+   *   LogTableModel(QObject *parent = nullptr)
+   *    : CappedLogTableModel(1000, parent)
+   *   {
+   *   }
+   *
+   *  private:
+   *
+   *   int columnCountWithoutParentIndex() const noexcept override
+   *   {
+   *     return 2;
+   *   }
+   *
+   *   QVariant displayRoleData(const QModelIndex & index) const noexcept override
+   *   {
+   *     assert( indexIsValidAndInRange(index) );
+   *
+   *     const LogRecord & record = recordAt( index.row() );
+   *     switch( index.column() ){
+   *       case 0:
+   *         return record.time;
+   *       case 1:
+   *         return record.message;
+   *     }
+   *
+   *     return QVariant();
+   *   }
+   * };
+   * \endcode
+   *
+   * Then records can be added:
+   * \code
+   * LogTableModel model;
+   *
+   * model.prependRecord({QDateTime::currentDateTime(), tr("Started")});
+   * \endcode
+   *
+   * \note Because this is a class template, it does not use the Q_OBJECT macro.
+   *  Subclasses can use it.
+   *
+   * \sa RingBuffer
+   */
+  template<typename Record>
+  class CappedLogTableModel : public AbstractTableModel
+  {
+   public:
+
+    /*! \brief Storage of the records
+     */
+    using Table = RingBuffer<Record>;
+
+    /*! \brief Construct a log table model that holds at most \a maximumRowCount records
+     *
+     * \pre \a maximumRowCount must be >= 1
+     */
+    explicit CappedLogTableModel(int maximumRowCount, QObject *parent = nullptr)
+     : AbstractTableModel(parent),
+       mMaximumRowCount(maximumRowCount)
+    {
+      assert( maximumRowCount >= 1 );
+
+      reserveTable();
+    }
+
+    /*! \brief Get the maximum count of rows (records) this model can hold
+     */
+    int maximumRowCount() const noexcept
+    {
+      return mMaximumRowCount;
+    }
+
+    /*! \brief Set the maximum count of rows (records) this model can hold
+     *
+     * If this model holds more than \a count rows,
+     * the oldest ones (at the end) are removed.
+     *
+     * \pre \a count must be >= 1
+     */
+    void setMaximumRowCount(int count)
+    {
+      assert( count >= 1 );
+
+      mMaximumRowCount = count;
+      removeRowsExceedingMaximum();
+      reserveTable();
+    }
+
+    /*! \brief Prepend \a record to this model
+     *
+     * If this model is full, the last row (the oldest record)
+     * is removed first.
+     */
+    void prependRecord(Record record)
+    {
+      if( rowCountWithoutParentIndex() >= mMaximumRowCount ){
+        removeRows(rowCountWithoutParentIndex() - 1, 1);
+      }
+
+      beginPrependRow();
+      mTable.push_front( std::move(record) );
+      endPrependRow();
+    }
+
+    /*! \brief Get the record at \a row
+     *
+     * \pre \a row must be in valid range
+     * \sa rowIndexIsInRange()
+     */
+    const Record & recordAt(int row) const noexcept
+    {
+      assert( rowIndexIsInRange(row) );
+
+      return mTable[static_cast<std::size_t>(row)];
+    }
+
+    /*! \brief Access the records of this model
+     */
+    const Table & table() const noexcept
+    {
+      return mTable;
+    }
+
+    /*! \brief Remove all records from this model
+     */
+    void clear()
+    {
+      beginResetModel();
+      mTable.clear();
+      endResetModel();
+    }
+
+    /*! \brief Insert \a count rows before \a row into the model
+     *
+     * Calls AbstractTableModel::insertRows().
+     * Once the rows have been inserted, the rows that exceed the maximum row count
+     * are removed.
+     */
+    bool insertRows( int row, int count, const QModelIndex & parent = QModelIndex() ) override
+    {
+      if( !AbstractTableModel::insertRows(row, count, parent) ){
+        return false;
+      }
+      removeRowsExceedingMaximum();
+
+      return true;
+    }
+
+   protected:
+
+    /*! \brief Get the count of rows
+     */
+    int rowCountWithoutParentIndex() const noexcept override
+    {
+      assert( mTable.size() <= static_cast<std::size_t>( intMax() ) );
+
+      return static_cast<int>( mTable.size() );
+    }
+
+    /*! \brief Returns true
+     */
+    bool doSupportsPrependRow() const noexcept override
+    {
+      return true;
+    }
+
+    /*! \brief Prepend a default constructed record
+     */
+    void doPrependRow() noexcept override
+    {
+      mTable.emplace_front();
+    }
+
+    /*! \brief Returns true
+     */
+    bool doSupportsRemoveLastRow() const noexcept override
+    {
+      return true;
+    }
+
+    /*! \brief Remove the last (the oldest) record
+     */
+    void doRemoveLastRow() noexcept override
+    {
+      assert( !mTable.empty() );
+
+      mTable.pop_back();
+    }
+
+   private:
+
+    void removeRowsExceedingMaximum()
+    {
+      const int rowCount = rowCountWithoutParentIndex();
+      if(rowCount <= mMaximumRowCount){
+        return;
+      }
+
+      beginRemoveRows(QModelIndex(), mMaximumRowCount, rowCount - 1);
+      while( rowCountWithoutParentIndex() > mMaximumRowCount ){
+        mTable.pop_back();
+      }
+      endRemoveRows();
+    }
+
+    /*
+     * While prepending a row from the generic API,
+     * the table holds 1 more record than the maximum
+     */
+    void reserveTable()
+    {
+      mTable.reserve( static_cast<std::size_t>(mMaximumRowCount) + 1 );
+    }
+
+    int mMaximumRowCount;
+    Table mTable;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_CAPPED_LOG_TABLE_MODEL_H
@@ -0,0 +1,556 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_CHUNKED_TABLE_H
+#define MDT_ITEM_MODEL_CHUNKED_TABLE_H
+
+#include "Mdt/ItemModel/ChunkedTableData.h"
+#include "Mdt/ItemModel/ChunkedTableConstIterator.h"
+#include "Mdt/ItemModel/ChunkedTableSnapshot.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <initializer_list>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Copy-on-write table storage, made of shared chunks
+   *
+   * ChunkedTable can be used as storage of a table model
+   * instead of a std::vector .
+   * Its elements are stored in chunks of at most chunkCapacity() elements,
+   * and the chunks are shared between copies of the table and its snapshots.
+   *
+   * snapshot() returns a immutable view of the table in O(1),
+   * that can be read from a other thread while the table is modified.
+   * A modification only copies what is shared with a snapshot:
+   * the list of chunks (O(chunk count)), and the chunks that are modified.
+   *
+   * Example of a model that provides snapshots:
+   * \code
+   * class MyTableModel : public Mdt::ItemModel::AbstractTableModel
+   * {
+   *  public:
+   *
+   *   using Snapshot = Mdt::ItemModel::ChunkedTableSnapshot<Record>;
+   *
+   *   Snapshot snapshot() const noexcept
+   *   {
+   *     return mTable.snapshot();
+   *   }
+   *
+   *  private:
+   *
+   *   bool setEditRoleData(const QModelIndex & index, const QVariant & value) noexcept override
+   *   {
+   *     const auto row = static_cast<size_t>( index.row() );
+   *     mTable.mutableAt(row).name = value.toString();
+   *     return true;
+   *   }
+   *
+   *   Mdt::ItemModel::ChunkedTable<Record> mTable;
+   * };
+   * \endcode
+   *
+   * \note A ChunkedTable must only be modified from one thread (typically the GUI thread).
+   *  Copies of it, and its snapshots, can be used from any thread.
+   *
+   * \sa ChunkedTableSnapshot
+   */
+  template<typename T>
+  class ChunkedTable
+  {
+    using Data = ChunkedTableData<T>;
+    using Chunk = typename Data::Chunk;
+
+   public:
+
+    /*! \brief STL value_type
+     */
+    using value_type = T;
+
+    /*! \brief STL size_type
+     */
+    using size_type = std::size_t;
+
+    /*! \brief STL const_iterator
+     */
+    using const_iterator = ChunkedTableConstIterator<T>;
+
+    /*! \brief Snapshot type
+     */
+    using Snapshot = ChunkedTableSnapshot<T>;
+
+    /*! \brief Chunk capacity used by default
+     */
+    static constexpr size_type defaultChunkCapacity = 256;
+
+    /*! \brief Construct a empty table
+     *
+     * \pre \a chunkCapacity must be >= 1
+     */
+    explicit ChunkedTable(size_type chunkCapacity = defaultChunkCapacity)
+     : mData( makeEmptyData(chunkCapacity) )
+    {
+    }
+
+    /*! \brief Construct a table with the elements in range [\a first, \a last)
+     *
+     * \pre \a chunkCapacity must be >= 1
+     */
+    template<typename InputIt>
+    ChunkedTable(InputIt first, InputIt last, size_type chunkCapacity = defaultChunkCapacity)
+     : ChunkedTable(chunkCapacity)
+    {
+      assign(first, last);
+    }
+
+    /*! \brief Construct a table with the elements of \a list
+     *
+     * \pre \a chunkCapacity must be >= 1
+     */
+    ChunkedTable(std::initializer_list<T> list, size_type chunkCapacity = defaultChunkCapacity)
+     : ChunkedTable(list.begin(), list.end(), chunkCapacity)
+    {
+    }
+
+    /*! \brief Copy construct a table from \a other
+     *
+     * This is O(1): the chunks are shared until one of the tables is modified.
+     */
+    ChunkedTable(const ChunkedTable & other) noexcept = default;
+
+    /*! \brief Copy assign \a other to this table
+     *
+     * This is O(1): the chunks are shared until one of the tables is modified.
+     */
+    ChunkedTable & operator=(const ChunkedTable & other) noexcept = default;
+
+    /*! \brief Move construct a table from \a other
+     *
+     * \a other no longer references the chunks,
+     * so they are released where this table is destroyed
+     * (for example by a TableReclaimer ).
+     * \a other is left empty, with defaultChunkCapacity .
+     */
+    ChunkedTable(ChunkedTable && other) noexcept
+     : mData( std::exchange( other.mData, sharedEmptyData() ) )
+    {
+    }
+
+    /*! \brief Move assign \a other to this table
+     *
+     * \a other is left empty, with defaultChunkCapacity .
+     */
+    ChunkedTable & operator=(ChunkedTable && other) noexcept
+    {
+      if(&other != this){
+        mData = std::exchange( other.mData, sharedEmptyData() );
+      }
+
+      return *this;
+    }
+
+    /*! \brief Get the count of elements in this table
+     */
+    size_type size() const noexcept
+    {
+      return mData->size;
+    }
+
+    /*! \brief Check if this table is empty
+     */
+    bool empty() const noexcept
+    {
+      return size() == 0;
+    }
+
+    /*! \brief Get the count of chunks
+     */
+    size_type chunkCount() const noexcept
+    {
+      return mData->chunks.size();
+    }
+
+    /*! \brief Get the maximum count of elements in a chunk
+     */
+    size_type chunkCapacity() const noexcept
+    {
+      return mData->chunkCapacity;
+    }
+
+    /*! \brief Get the element at \a index
+     *
+     * Locating the element is O(log(chunk count)).
+     *
+     * \pre \a index must be < size()
+     */
+    const T & operator[](size_type index) const noexcept
+    {
+      assert( index < size() );
+
+      return mData->at(index);
+    }
+
+    /*! \brief Get the contiguous elements starting at \a index
+     *
+     * Returns a pointer to the element at \a index
+     * and the count of elements that follow it in the same chunk
+     * (including the element at \a index ).
+     *
+     * The pointer is only valid until this table is modified.
+     *
+     * \pre \a index must be < size()
+     */
+    std::pair<const T*, size_type> contiguousElementsFrom(size_type index) const noexcept
+    {
+      assert( index < size() );
+
+      const size_type c = mData->chunkIndexForElement(index);
+      const Chunk & chunk = *mData->chunks[c];
+      const size_type pos = index - mData->offsets[c];
+
+      return {chunk.data() + pos, chunk.size() - pos};
+    }
+
+    /*! \brief Get a modifiable reference to the element at \a index
+     *
+     * If the chunk that contains the element is shared
+     * with a snapshot or a other table, it is copied first.
+     *
+     * The returned reference is only valid until this table is modified again
+     * or a snapshot is taken.
+     *
+     * \pre \a index must be < size()
+     */
+    T & mutableAt(size_type index)
+    {
+      assert( index < size() );
+
+      const size_type c = mData->chunkIndexForElement(index);
+      const size_type offset = mData->offsets[c];
+
+      return detachedChunk(c)[index - offset];
+    }
+
+    /*! \brief Replace the elements of this table with the ones in range [\a first, \a last)
+     */
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last)
+    {
+      auto data = std::make_shared<Data>( chunkCapacity() );
+
+      for(; first != last; ++first){
+        if( data->chunks.empty() || (data->chunks.back()->size() >= data->chunkCapacity) ){
+          data->chunks.push_back( std::make_shared<Chunk>() );
+          data->chunks.back()->reserve(data->chunkCapacity);
+        }
+        data->chunks.back()->push_back(*first);
+      }
+      data->updateOffsets();
+
+      mData = std::move(data);
+    }
+
+    /*! \brief Append \a value to the end of this table
+     */
+    void push_back(const T & value)
+    {
+      detach();
+
+      if( mData->chunks.empty() || (mData->chunks.back()->size() >= mData->chunkCapacity) ){
+        auto chunk = std::make_shared<Chunk>();
+        chunk->reserve(mData->chunkCapacity);
+        chunk->push_back(value);
+        mData->chunks.push_back( std::move(chunk) );
+      }else{
+        detachedChunk(mData->chunks.size() - 1).push_back(value);
+      }
+      mData->updateOffsets(mData->chunks.size() - 1);
+    }
+
+    /*! \brief Remove the last element
+     *
+     * \pre this table must not be empty
+     */
+    void pop_back()
+    {
+      assert( !empty() );
+
+      erase(size() - 1, 1);
+    }
+
+    /*! \brief Insert \a count copies of \a value before \a index
+     *
+     * Only the chunk that contains \a index is modified (and split if needed).
+     *
+     * \pre \a index must be <= size()
+     */
+    void insert(size_type index, size_type count, const T & value)
+    {
+      assert( index <= size() );
+
+      if(count == 0){
+        return;
+      }
+      insertInChunk(index, [count, &value](Chunk & chunk, size_type pos){
+        chunk.insert(std::next( chunk.begin(), static_cast<std::ptrdiff_t>(pos) ), count, value);
+      });
+    }
+
+    /*! \brief Insert the elements in range [\a first, \a last) before \a index
+     *
+     * \pre \a index must be <= size()
+     */
+    template<typename ForwardIt>
+    void insert(size_type index, ForwardIt first, ForwardIt last)
+    {
+      assert( index <= size() );
+
+      if(first == last){
+        return;
+      }
+      insertInChunk(index, [first, last](Chunk & chunk, size_type pos){
+        chunk.insert(std::next( chunk.begin(), static_cast<std::ptrdiff_t>(pos) ), first, last);
+      });
+    }
+
+    /*! \brief Remove \a count elements starting from \a index
+     *
+     * Chunks that are completely removed are only released,
+     * they are not copied even if they are shared.
+     *
+     * \pre ( \a index + \a count ) must be <= size()
+     */
+    void erase(size_type index, size_type count)
+    {
+      assert( index + count <= size() );
+
+      if(count == 0){
+        return;
+      }
+      detach();
+
+      const size_type firstChunk = mData->chunkIndexForElement(index);
+      size_type c = firstChunk;
+      size_type pos = index - mData->offsets[c];
+      size_type remaining = count;
+      while(remaining > 0){
+        assert( c < mData->chunks.size() );
+        const size_type chunkSize = mData->chunks[c]->size();
+        const size_type n = std::min(remaining, chunkSize - pos);
+        if(n == chunkSize){
+          mData->chunks.erase( std::next( mData->chunks.begin(), static_cast<std::ptrdiff_t>(c) ) );
+        }else{
+          Chunk & chunk = detachedChunk(c);
+          const auto first = std::next( chunk.begin(), static_cast<std::ptrdiff_t>(pos) );
+          chunk.erase( first, std::next( first, static_cast<std::ptrdiff_t>(n) ) );
+          ++c;
+        }
+        remaining -= n;
+        pos = 0;
+      }
+      mData->updateOffsets(firstChunk);
+    }
+
+    /*! \brief Move \a count elements starting from \a index before \a destinationIndex
+     *
+     * \a destinationIndex has the same meaning than in moveInStlContainer().
+     *
+     * \pre ( \a index + \a count ) must be <= size()
+     * \pre \a destinationIndex must be <= size()
+     * \pre \a destinationIndex must not be in range [\a index, \a index + \a count]
+     */
+    void move(size_type index, size_type count, size_type destinationIndex)
+    {
+      assert( index + count <= size() );
+      assert( destinationIndex <= size() );
+      assert( (destinationIndex < index) || (destinationIndex > index + count) );
+
+      std::vector<T> elements;
+      elements.reserve(count);
+      for(size_type i = index; i < index + count; ++i){
+        elements.push_back( (*this)[i] );
+      }
+
+      erase(index, count);
+      if(destinationIndex > index){
+        destinationIndex -= count;
+      }
+      insert( destinationIndex, elements.cbegin(), elements.cend() );
+    }
+
+    /*! \brief Remove all elements
+     */
+    void clear()
+    {
+      mData = makeEmptyData( chunkCapacity() );
+    }
+
+    /*! \brief Get a immutable snapshot of this table
+     *
+     * This is O(1).
+     */
+    Snapshot snapshot() const noexcept
+    {
+      return Snapshot(mData);
+    }
+
+    /*! \brief Get a const iterator to the first element
+     */
+    const_iterator cbegin() const noexcept
+    {
+      return const_iterator(mData.get(), 0, 0);
+    }
+
+    /*! \brief Get a const iterator past the last element
+     */
+    const_iterator cend() const noexcept
+    {
+      return const_iterator(mData.get(), mData->chunks.size(), 0);
+    }
+
+    /*! \brief Get a const iterator to the first element
+     */
+    const_iterator begin() const noexcept
+    {
+      return cbegin();
+    }
+
+    /*! \brief Get a const iterator past the last element
+     */
+    const_iterator end() const noexcept
+    {
+      return cend();
+    }
+
+   private:
+
+    /*
+     * Only the thread that modifies this table can create new references
+     * to mData and its chunks. So, if a use count is 1, no other thread can hold them.
+     * Other threads can still release a reference concurrently:
+     * the acquire fence makes their last reads happen before our writes.
+     */
+    template<typename Pointer>
+    static
+    bool isShared(const Pointer & pointer) noexcept
+    {
+      if(pointer.use_count() > 1){
+        return true;
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      return false;
+    }
+
+    /*
+     * Empty data with defaultChunkCapacity, shared by all the empty tables that use it.
+     * It is never modified: as it is shared, a table detaches before any modification.
+     */
+    static
+    const std::shared_ptr<Data> & sharedEmptyData() noexcept
+    {
+      static const std::shared_ptr<Data> data = std::make_shared<Data>(defaultChunkCapacity);
+
+      return data;
+    }
+
+    /*
+     * Every table is first constructed by this function,
+     * so sharedEmptyData() is initialized before a move can use it
+     */
+    static
+    std::shared_ptr<Data> makeEmptyData(size_type chunkCapacity)
+    {
+      const std::shared_ptr<Data> & empty = sharedEmptyData();
+      if(chunkCapacity == empty->chunkCapacity){
+        return empty;
+      }
+
+      return std::make_shared<Data>(chunkCapacity);
+    }
+
+    void detach()
+    {
+      if( isShared(mData) ){
+        mData = std::make_shared<Data>(*mData);
+      }
+    }
+
+    Chunk & detachedChunk(size_type chunkIndex)
+    {
+      detach();
+      assert( chunkIndex < mData->chunks.size() );
+
+      auto & chunk = mData->chunks[chunkIndex];
+      if( isShared(chunk) ){
+        chunk = std::make_shared<Chunk>(*chunk);
+      }
+
+      return *chunk;
+    }
+
+    template<typename InsertFunction>
+    void insertInChunk(size_type index, InsertFunction insertFunction)
+    {
+      detach();
+
+      if( mData->chunks.empty() ){
+        mData->chunks.push_back( std::make_shared<Chunk>() );
+        mData->updateOffsets();
+      }
+      size_type c;
+      if( index == size() ){
+        c = mData->chunks.size() - 1;
+      }else{
+        c = mData->chunkIndexForElement(index);
+      }
+      const size_type pos = index - mData->offsets[c];
+
+      insertFunction(detachedChunk(c), pos);
+      splitChunk(c);
+      mData->updateOffsets(c);
+    }
+
+    void splitChunk(size_type chunkIndex)
+    {
+      Chunk & chunk = *mData->chunks[chunkIndex];
+      const size_type capacity = mData->chunkCapacity;
+      if(chunk.size() <= capacity){
+        return;
+      }
+
+      std::vector<typename Data::ChunkPointer> newChunks;
+      for(size_type first = capacity; first < chunk.size(); first += capacity){
+        const size_type last = std::min(first + capacity, chunk.size());
+        auto newChunk = std::make_shared<Chunk>();
+        newChunk->reserve(capacity);
+        newChunk->insert( newChunk->end(),
+                          std::make_move_iterator( std::next( chunk.begin(), static_cast<std::ptrdiff_t>(first) ) ),
+                          std::make_move_iterator( std::next( chunk.begin(), static_cast<std::ptrdiff_t>(last) ) ) );
+        newChunks.push_back( std::move(newChunk) );
+      }
+      chunk.erase( std::next( chunk.begin(), static_cast<std::ptrdiff_t>(capacity) ), chunk.end() );
+
+      auto pos = std::next( mData->chunks.begin(), static_cast<std::ptrdiff_t>(chunkIndex + 1) );
+      mData->chunks.insert( pos, newChunks.begin(), newChunks.end() );
+    }
+
+    std::shared_ptr<Data> mData;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_CHUNKED_TABLE_H
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_CHUNKED_TABLE_CONST_ITERATOR_H
+#define MDT_ITEM_MODEL_CHUNKED_TABLE_CONST_ITERATOR_H
+
+#include "Mdt/ItemModel/ChunkedTableData.h"
+#include <iterator>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Forward const iterator for ChunkedTable and ChunkedTableSnapshot
+   *
+   * Iterating is done chunk by chunk,
+   * so scanning a whole table does not have to locate each element.
+   */
+  template<typename T>
+  class ChunkedTableConstIterator
+  {
+   public:
+
+    /*! \brief STL iterator value_type
+     */
+    using value_type = T;
+
+    /*! \brief STL iterator difference_type
+     */
+    using difference_type = std::ptrdiff_t;
+
+    /*! \brief STL iterator reference
+     */
+    using reference = const T&;
+
+    /*! \brief STL iterator pointer
+     */
+    using pointer = const T*;
+
+    /*! \brief STL iterator iterator_category
+     */
+    using iterator_category = std::forward_iterator_tag;
+
+    /*! \brief Construct a null iterator
+     */
+    ChunkedTableConstIterator() noexcept = default;
+
+    /*! \brief Construct a iterator that refers to element \a elementIndex of chunk \a chunkIndex in \a data
+     */
+    ChunkedTableConstIterator(const ChunkedTableData<T> *data, std::size_t chunkIndex, std::size_t elementIndex) noexcept
+     : mData(data),
+       mChunkIndex(chunkIndex),
+       mElementIndex(elementIndex)
+    {
+    }
+
+    /*! \brief Get the element this iterator refers to
+     *
+     * \pre this iterator must be dereferencable
+     */
+    reference operator*() const noexcept
+    {
+      assert( mData != nullptr );
+      assert( mChunkIndex < mData->chunks.size() );
+
+      return (*mData->chunks[mChunkIndex])[mElementIndex];
+    }
+
+    /*! \brief Access a member of the element this iterator refers to
+     *
+     * \pre this iterator must be dereferencable
+     */
+    pointer operator->() const noexcept
+    {
+      return &operator*();
+    }
+
+    /*! \brief Increment this iterator (pre-increment)
+     */
+    ChunkedTableConstIterator & operator++() noexcept
+    {
+      assert( mData != nullptr );
+      assert( mChunkIndex < mData->chunks.size() );
+
+      ++mElementIndex;
+      if( mElementIndex >= mData->chunks[mChunkIndex]->size() ){
+        ++mChunkIndex;
+        mElementIndex = 0;
+      }
+
+      return *this;
+    }
+
+    /*! \brief Increment this iterator (post-increment)
+     */
+    ChunkedTableConstIterator operator++(int) noexcept
+    {
+      ChunkedTableConstIterator old = *this;
+      ++(*this);
+      return old;
+    }
+
+    /*! \brief Check if iterators \a a and \a b are equal
+     */
+    friend
+    bool operator==(const ChunkedTableConstIterator & a, const ChunkedTableConstIterator & b) noexcept
+    {
+      return (a.mData == b.mData) && (a.mChunkIndex == b.mChunkIndex) && (a.mElementIndex == b.mElementIndex);
+    }
+
+    /*! \brief Check if iterators \a a and \a b are not equal
+     */
+    friend
+    bool operator!=(const ChunkedTableConstIterator & a, const ChunkedTableConstIterator & b) noexcept
+    {
+      return !(a == b);
+    }
+
+   private:
+
+    const ChunkedTableData<T> *mData = nullptr;
+    std::size_t mChunkIndex = 0;
+    std::size_t mElementIndex = 0;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_CHUNKED_TABLE_CONST_ITERATOR_H
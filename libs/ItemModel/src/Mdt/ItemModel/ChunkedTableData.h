@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_CHUNKED_TABLE_DATA_H
+#define MDT_ITEM_MODEL_CHUNKED_TABLE_DATA_H
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \internal Storage shared by ChunkedTable and ChunkedTableSnapshot
+   *
+   * The elements are stored in chunks of at most chunkCapacity elements.
+   * Each chunk is held by a shared pointer,
+   * so that copies of this data share the chunks.
+   *
+   * offsets[i] is the index of the first element of chunks[i].
+   */
+  template<typename T>
+  struct ChunkedTableData
+  {
+    using Chunk = std::vector<T>;
+    using ChunkPointer = std::shared_ptr<Chunk>;
+
+    explicit ChunkedTableData(std::size_t capacity) noexcept
+     : chunkCapacity(capacity)
+    {
+      assert( chunkCapacity >= 1 );
+    }
+
+    /*! \brief Get the index of the chunk that contains the element at \a index
+     *
+     * \pre \a index must be < size
+     */
+    std::size_t chunkIndexForElement(std::size_t index) const noexcept
+    {
+      assert( index < size );
+
+      const auto it = std::upper_bound(offsets.cbegin(), offsets.cend(), index);
+      assert( it != offsets.cbegin() );
+
+      return static_cast<std::size_t>( std::distance(offsets.cbegin(), it) ) - 1;
+    }
+
+    /*! \brief Get the element at \a index
+     *
+     * \pre \a index must be < size
+     */
+    const T & at(std::size_t index) const noexcept
+    {
+      const std::size_t c = chunkIndexForElement(index);
+
+      return (*chunks[c])[index - offsets[c]];
+    }
+
+    /*! \brief Update the offsets from chunk \a firstChunk
+     */
+    void updateOffsets(std::size_t firstChunk = 0)
+    {
+      offsets.resize( chunks.size() );
+      std::size_t offset = (firstChunk == 0) ? 0 : offsets[firstChunk - 1] + chunks[firstChunk - 1]->size();
+      for(std::size_t c = firstChunk; c < chunks.size(); ++c){
+        offsets[c] = offset;
+        offset += chunks[c]->size();
+      }
+      size = offset;
+    }
+
+    std::vector<ChunkPointer> chunks;
+    std::vector<std::size_t> offsets;
+    std::size_t size = 0;
+    std::size_t chunkCapacity;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_CHUNKED_TABLE_DATA_H
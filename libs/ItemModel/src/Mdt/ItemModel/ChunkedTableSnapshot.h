@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_CHUNKED_TABLE_SNAPSHOT_H
+#define MDT_ITEM_MODEL_CHUNKED_TABLE_SNAPSHOT_H
+
+#include "Mdt/ItemModel/ChunkedTableData.h"
+#include "Mdt/ItemModel/ChunkedTableConstIterator.h"
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Immutable view of a ChunkedTable at a given time
+   *
+   * A snapshot is obtained with ChunkedTable::snapshot() in O(1).
+   * It shares the chunks of the table,
+   * and keeps them alive until it is destroyed.
+   * When the table is modified after the snapshot was taken,
+   * only the modified chunks are copied by the table.
+   *
+   * A snapshot can be copied and passed to a other thread,
+   * for example to export, aggregate or search the data,
+   * while the table continues to be edited in the GUI thread.
+   * Reading a snapshot from many threads is safe.
+   *
+   * \code
+   * const auto snapshot = model.snapshot();
+   *
+   * QtConcurrent::run([snapshot](){
+   *   for(const auto & record : snapshot){
+   *     // Process record
+   *   }
+   * });
+   * \endcode
+   *
+   * \sa ChunkedTable
+   */
+  template<typename T>
+  class ChunkedTableSnapshot
+  {
+   public:
+
+    /*! \brief STL value_type
+     */
+    using value_type = T;
+
+    /*! \brief STL size_type
+     */
+    using size_type = std::size_t;
+
+    /*! \brief STL const_iterator
+     */
+    using const_iterator = ChunkedTableConstIterator<T>;
+
+    /*! \brief Construct a empty snapshot
+     */
+    ChunkedTableSnapshot() noexcept = default;
+
+    /*! \internal Construct a snapshot that shares \a data
+     */
+    explicit ChunkedTableSnapshot(std::shared_ptr<const ChunkedTableData<T>> data) noexcept
+     : mData( std::move(data) )
+    {
+    }
+
+    /*! \brief Get the count of elements in this snapshot
+     */
+    size_type size() const noexcept
+    {
+      if(!mData){
+        return 0;
+      }
+      return mData->size;
+    }
+
+    /*! \brief Check if this snapshot is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return size() == 0;
+    }
+
+    /*! \brief Get the element at \a index
+     *
+     * Locating the element is O(log(chunk count)).
+     * To scan the whole snapshot, prefer iterators.
+     *
+     * \pre \a index must be < size()
+     */
+    const T & operator[](size_type index) const noexcept
+    {
+      assert( index < size() );
+
+      return mData->at(index);
+    }
+
+    /*! \brief Get a const iterator to the first element
+     */
+    const_iterator cbegin() const noexcept
+    {
+      return const_iterator(mData.get(), 0, 0);
+    }
+
+    /*! \brief Get a const iterator past the last element
+     */
+    const_iterator cend() const noexcept
+    {
+      if(!mData){
+        return const_iterator(nullptr, 0, 0);
+      }
+      return const_iterator(mData.get(), mData->chunks.size(), 0);
+    }
+
+    /*! \brief Get a const iterator to the first element
+     */
+    const_iterator begin() const noexcept
+    {
+      return cbegin();
+    }
+
+    /*! \brief Get a const iterator past the last element
+     */
+    const_iterator end() const noexcept
+    {
+      return cend();
+    }
+
+   private:
+
+    std::shared_ptr<const ChunkedTableData<T>> mData;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_CHUNKED_TABLE_SNAPSHOT_H
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "ColumnHashIndex.h"
+#include <algorithm>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+const std::vector<int> & ColumnHashIndex::rowsForKey(const QString & key) const noexcept
+{
+  assert( isUpToDate() );
+
+  static const std::vector<int> noRows;
+
+  const auto it = mRowsOfKey.find(key);
+  if( it == mRowsOfKey.cend() ){
+    return noRows;
+  }
+
+  return it->second;
+}
+
+void ColumnHashIndex::doClear() noexcept
+{
+  mRowsOfKey.clear();
+}
+
+void ColumnHashIndex::doAddRows(const std::vector<int> & rows)
+{
+  for(const int row : rows){
+    std::vector<int> & rowsOfKey = mRowsOfKey[keyOfRow(row)];
+    rowsOfKey.insert( std::lower_bound(rowsOfKey.begin(), rowsOfKey.end(), row), row );
+  }
+}
+
+void ColumnHashIndex::doRemoveRow(int row) noexcept
+{
+  const auto it = mRowsOfKey.find( keyOfRow(row) );
+  assert( it != mRowsOfKey.end() );
+  std::vector<int> & rows = it->second;
+  const auto rowIt = std::lower_bound(rows.begin(), rows.end(), row);
+  assert( rowIt != rows.end() );
+  assert( *rowIt == row );
+  rows.erase(rowIt);
+  if( rows.empty() ){
+    mRowsOfKey.erase(it);
+  }
+}
+
+/*
+ * Adding the same offset to all the rows >= firstRow
+ * keeps each list of rows sorted
+ */
+void ColumnHashIndex::doShiftRows(int firstRow, int offset) noexcept
+{
+  for(auto & rowsOfKey : mRowsOfKey){
+    std::vector<int> & rows = rowsOfKey.second;
+    for(auto it = std::lower_bound(rows.begin(), rows.end(), firstRow); it != rows.end(); ++it){
+      *it += offset;
+    }
+  }
+}
+
+/*
+ * The moved rows stay in [move.firstRow(),move.lastRow()],
+ * so only this part of each list of rows has to be sorted again
+ */
+void ColumnHashIndex::doMoveRows(const RowMove & move) noexcept
+{
+  const auto newRow = [&move](int row){
+    return move.newRow(row);
+  };
+
+  for(auto & rowsOfKey : mRowsOfKey){
+    std::vector<int> & rows = rowsOfKey.second;
+    const auto first = std::lower_bound( rows.begin(), rows.end(), move.firstRow() );
+    const auto last = std::upper_bound( first, rows.end(), move.lastRow() );
+    if(first == last){
+      continue;
+    }
+    std::transform(first, last, first, newRow);
+    std::sort(first, last);
+  }
+}
+
+}} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_COLUMN_HASH_INDEX_H
+#define MDT_ITEM_MODEL_COLUMN_HASH_INDEX_H
+
+#include "Mdt/ItemModel/AbstractColumnIndex.h"
+#include "mdt_itemmodel_export.h"
+#include <QVariant>
+#include <QString>
+#include <QHash>
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Hash function for QString usable with STL containers
+   */
+  struct QStringHash
+  {
+    std::size_t operator()(const QString & str) const noexcept
+    {
+      return qHash(str);
+    }
+  };
+
+  /*! \brief Hash index of the values of a column of a table
+   *
+   * Maps each key (the value of the column, as a string)
+   * to the rows that have this key.
+   * Lookups are O(1).
+   *
+   * The index is maintained like the other column indexes, see AbstractColumnIndex .
+   *
+   * Keys are the values converted with QVariant::toString().
+   * This matches QVariant comparison for the common key types (strings, integers).
+   *
+   * AbstractTableModel uses this index, see AbstractTableModel::addColumnHashIndex() .
+   */
+  class MDT_ITEMMODEL_EXPORT ColumnHashIndex : public AbstractColumnIndex
+  {
+   public:
+
+    /*! \brief Construct a index for \a column
+     *
+     * \pre \a column must be >= 0
+     */
+    explicit ColumnHashIndex(int column) noexcept
+     : AbstractColumnIndex(column)
+    {
+    }
+
+    /*! \brief Get the rows that have \a key , in ascending order
+     *
+     * Returns a empty list if no row has \a key .
+     *
+     * \pre this index must be up to date
+     */
+    const std::vector<int> & rowsForKey(const QString & key) const noexcept;
+
+    /*! \brief Get the key for \a value
+     */
+    static
+    QString keyFromValue(const QVariant & value)
+    {
+      return value.toString();
+    }
+
+   private:
+
+    QString doKeyFromText(const QString & text) const override
+    {
+      return text;
+    }
+
+    void doClear() noexcept override;
+    void doAddRows(const std::vector<int> & rows) override;
+    void doRemoveRow(int row) noexcept override;
+    void doShiftRows(int firstRow, int offset) noexcept override;
+    void doMoveRows(const RowMove & move) noexcept override;
+
+    std::unordered_map<QString, std::vector<int>, QStringHash> mRowsOfKey;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_COLUMN_HASH_INDEX_H
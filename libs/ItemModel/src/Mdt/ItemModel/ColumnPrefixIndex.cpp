@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "ColumnPrefixIndex.h"
+#include "RowRange.h"
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+RowRangeList ColumnPrefixIndex::rowsStartingWith(const QString & prefix) const
+{
+  assert( isUpToDate() );
+
+  const QString key = keyFromText(prefix);
+  const auto keyLessThan = [](const Entry & entry, const QString & key){
+    return entry.key < key;
+  };
+
+  std::vector<int> rows;
+  auto it = std::lower_bound(mSortedEntries.cbegin(), mSortedEntries.cend(), key, keyLessThan);
+  while( (it != mSortedEntries.cend()) && it->key.startsWith(key) ){
+    rows.push_back(it->row);
+    ++it;
+  }
+  std::sort( rows.begin(), rows.end() );
+
+  RowRangeList list;
+  auto first = rows.cbegin();
+  while( first != rows.cend() ){
+    auto last = first;
+    while( (std::next(last) != rows.cend()) && (*std::next(last) == *last + 1) ){
+      ++last;
+    }
+    list.addRange( RowRange::fromFirstAndLastRow(*first, *last) );
+    first = std::next(last);
+  }
+
+  return list;
+}
+
+void ColumnPrefixIndex::doClear() noexcept
+{
+  mSortedEntries.clear();
+}
+
+/*
+ * The entries of the added rows are sorted,
+ * then merged with the existing ones
+ */
+void ColumnPrefixIndex::doAddRows(const std::vector<int> & rows)
+{
+  if( rows.empty() ){
+    return;
+  }
+
+  const auto middle = static_cast<std::ptrdiff_t>( mSortedEntries.size() );
+  mSortedEntries.reserve( mSortedEntries.size() + rows.size() );
+  for(const int row : rows){
+    mSortedEntries.push_back( Entry{keyOfRow(row), row} );
+  }
+  std::sort(mSortedEntries.begin() + middle, mSortedEntries.end(), entryLessThan);
+  std::inplace_merge(mSortedEntries.begin(), mSortedEntries.begin() + middle, mSortedEntries.end(), entryLessThan);
+}
+
+void ColumnPrefixIndex::doRemoveRow(int row) noexcept
+{
+  const auto it = std::lower_bound(mSortedEntries.begin(), mSortedEntries.end(), Entry{keyOfRow(row), row}, entryLessThan);
+  assert( it != mSortedEntries.end() );
+  assert( it->row == row );
+  mSortedEntries.erase(it);
+}
+
+void ColumnPrefixIndex::doRemoveRows(int firstRow, int lastRow) noexcept
+{
+  const auto isRemoved = [firstRow, lastRow](const Entry & entry){
+    return (entry.row >= firstRow) && (entry.row <= lastRow);
+  };
+  mSortedEntries.erase( std::remove_if(mSortedEntries.begin(), mSortedEntries.end(), isRemoved), mSortedEntries.end() );
+}
+
+/*
+ * Adding the same offset to all the rows >= firstRow
+ * keeps the entries sorted
+ */
+void ColumnPrefixIndex::doShiftRows(int firstRow, int offset) noexcept
+{
+  for(Entry & entry : mSortedEntries){
+    if(entry.row >= firstRow){
+      entry.row += offset;
+    }
+  }
+}
+
+/*
+ * The keys do not change,
+ * so only the entries that have the same key can have to be sorted again
+ */
+void ColumnPrefixIndex::doMoveRows(const RowMove & move) noexcept
+{
+  for(Entry & entry : mSortedEntries){
+    if( (entry.row >= move.firstRow()) && (entry.row <= move.lastRow()) ){
+      entry.row = move.newRow(entry.row);
+    }
+  }
+
+  auto first = mSortedEntries.begin();
+  while( first != mSortedEntries.end() ){
+    const auto hasOtherKey = [first](const Entry & entry){
+      return entry.key != first->key;
+    };
+    const auto last = std::find_if(first, mSortedEntries.end(), hasOtherKey);
+    if( !std::is_sorted(first, last, entryLessThan) ){
+      std::sort(first, last, entryLessThan);
+    }
+    first = last;
+  }
+}
+
+}} // namespace Mdt{ namespace ItemModel{
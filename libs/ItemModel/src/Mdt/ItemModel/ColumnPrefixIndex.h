@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_COLUMN_PREFIX_INDEX_H
+#define MDT_ITEM_MODEL_COLUMN_PREFIX_INDEX_H
+
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/AbstractColumnIndex.h"
+#include "mdt_itemmodel_export.h"
+#include <QString>
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Prefix index of the values of a column of a table
+   *
+   * Holds the values of the column, case folded,
+   * in a array sorted by value.
+   * The rows that start with a given prefix are then
+   * a contiguous part of this array, found by a binary search.
+   * rowsStartingWith() is O(log n + k), plus sorting the k found rows.
+   *
+   * The index is maintained like the other column indexes, see AbstractColumnIndex .
+   * The keys of the pending rows are merged back into the sorted array in O(n + m log m)
+   * ( m being the count of pending rows).
+   *
+   * AbstractTableModel uses this index, see AbstractTableModel::addColumnPrefixIndex() .
+   */
+  class MDT_ITEMMODEL_EXPORT ColumnPrefixIndex : public AbstractColumnIndex
+  {
+   public:
+
+    /*! \brief Construct a index for \a column
+     *
+     * \pre \a column must be >= 0
+     */
+    explicit ColumnPrefixIndex(int column) noexcept
+     : AbstractColumnIndex(column)
+    {
+    }
+
+    /*! \brief Get the rows that start with \a prefix
+     *
+     * The comparison is case insensitive.
+     * An empty \a prefix matches all rows.
+     *
+     * \pre this index must be up to date
+     */
+    RowRangeList rowsStartingWith(const QString & prefix) const;
+
+    /*! \brief Get the key for \a text
+     *
+     * This is the case folded \a text
+     */
+    static
+    QString keyFromText(const QString & text)
+    {
+      return text.toCaseFolded();
+    }
+
+   private:
+
+    struct Entry
+    {
+      QString key;
+      int row;
+    };
+
+    static
+    bool entryLessThan(const Entry & a, const Entry & b) noexcept
+    {
+      if(a.key == b.key){
+        return a.row < b.row;
+      }
+      return a.key < b.key;
+    }
+
+    QString doKeyFromText(const QString & text) const override
+    {
+      return keyFromText(text);
+    }
+
+    void doClear() noexcept override;
+    void doAddRows(const std::vector<int> & rows) override;
+    void doRemoveRow(int row) noexcept override;
+    void doRemoveRows(int firstRow, int lastRow) noexcept override;
+    void doShiftRows(int firstRow, int offset) noexcept override;
+    void doMoveRows(const RowMove & move) noexcept override;
+
+    std::vector<Entry> mSortedEntries;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_COLUMN_PREFIX_INDEX_H
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "ColumnTrigramIndex.h"
+#include "RowRange.h"
+#include <iterator>
+#include <algorithm>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+RowRangeList ColumnTrigramIndex::rowsThatMayContain(const QString & text) const
+{
+  assert( isUpToDate() );
+
+  RowRangeList list;
+
+  const TrigramList trigrams = distinctTrigramsOfFoldedText( text.toCaseFolded() );
+  if( trigrams.empty() ){
+    if( indexedRowCount() > 0 ){
+      list.addRange( RowRange::fromFirstAndLastRow(0, indexedRowCount() - 1) );
+    }
+    return list;
+  }
+
+  std::vector<const std::vector<int>*> postingLists;
+  postingLists.reserve( trigrams.size() );
+  for(const Trigram trigram : trigrams){
+    const auto it = mRowsOfTrigram.find(trigram);
+    if( it == mRowsOfTrigram.cend() ){
+      return list;
+    }
+    postingLists.push_back(&it->second);
+  }
+
+  const auto shorter = [](const std::vector<int> *a, const std::vector<int> *b){
+    return a->size() < b->size();
+  };
+  std::sort(postingLists.begin(), postingLists.end(), shorter);
+
+  std::vector<int> rows = *postingLists.front();
+  for(auto it = std::next( postingLists.cbegin() ); it != postingLists.cend(); ++it){
+    const std::vector<int> & postingList = **it;
+    const auto isNotInPostingList = [&postingList](int row){
+      return !std::binary_search(postingList.cbegin(), postingList.cend(), row);
+    };
+    rows.erase( std::remove_if(rows.begin(), rows.end(), isNotInPostingList), rows.end() );
+    if( rows.empty() ){
+      return list;
+    }
+  }
+
+  auto first = rows.cbegin();
+  while( first != rows.cend() ){
+    auto last = first;
+    while( (std::next(last) != rows.cend()) && (*std::next(last) == *last + 1) ){
+      ++last;
+    }
+    list.addRange( RowRange::fromFirstAndLastRow(*first, *last) );
+    first = std::next(last);
+  }
+
+  return list;
+}
+
+ColumnTrigramIndex::TrigramList ColumnTrigramIndex::distinctTrigramsOfFoldedText(const QString & text)
+{
+  TrigramList trigrams;
+
+  const int size = text.size();
+  if(size < 3){
+    return trigrams;
+  }
+  trigrams.reserve( static_cast<std::size_t>(size - 2) );
+  for(int i = 0; i < size - 2; ++i){
+    const Trigram trigram = ( static_cast<Trigram>( text.at(i).unicode() ) << 32 )
+                          | ( static_cast<Trigram>( text.at(i+1).unicode() ) << 16 )
+                          | static_cast<Trigram>( text.at(i+2).unicode() );
+    trigrams.push_back(trigram);
+  }
+  std::sort( trigrams.begin(), trigrams.end() );
+  trigrams.erase( std::unique( trigrams.begin(), trigrams.end() ), trigrams.end() );
+
+  return trigrams;
+}
+
+void ColumnTrigramIndex::doClear() noexcept
+{
+  mRowsOfTrigram.clear();
+}
+
+void ColumnTrigramIndex::doAddRows(const std::vector<int> & rows)
+{
+  for(const int row : rows){
+    for( const Trigram trigram : distinctTrigramsOfFoldedText( keyOfRow(row) ) ){
+      std::vector<int> & postingList = mRowsOfTrigram[trigram];
+      postingList.insert( std::lower_bound(postingList.begin(), postingList.end(), row), row );
+    }
+  }
+}
+
+/*
+ * distinctTrigramsOfFoldedText() allocates.
+ * If it fails, the row stays in some posting lists,
+ * which only gives a false positive to rowsThatMayContain()
+ */
+void ColumnTrigramIndex::doRemoveRow(int row) noexcept
+{
+  TrigramList trigrams;
+  try{
+    trigrams = distinctTrigramsOfFoldedText( keyOfRow(row) );
+  }catch(...){
+    return;
+  }
+
+  for(const Trigram trigram : trigrams){
+    const auto it = mRowsOfTrigram.find(trigram);
+    assert( it != mRowsOfTrigram.end() );
+    std::vector<int> & postingList = it->second;
+    const auto rowIt = std::lower_bound(postingList.begin(), postingList.end(), row);
+    assert( rowIt != postingList.end() );
+    assert( *rowIt == row );
+    postingList.erase(rowIt);
+    if( postingList.empty() ){
+      mRowsOfTrigram.erase(it);
+    }
+  }
+}
+
+/*
+ * Adding the same offset to all the rows >= firstRow
+ * keeps each posting list sorted
+ */
+void ColumnTrigramIndex::doShiftRows(int firstRow, int offset) noexcept
+{
+  for(auto & rowsOfTrigram : mRowsOfTrigram){
+    std::vector<int> & postingList = rowsOfTrigram.second;
+    for(auto it = std::lower_bound(postingList.begin(), postingList.end(), firstRow); it != postingList.end(); ++it){
+      *it += offset;
+    }
+  }
+}
+
+/*
+ * The moved rows stay in [move.firstRow(),move.lastRow()],
+ * so only this part of each posting list has to be sorted again
+ */
+void ColumnTrigramIndex::doMoveRows(const RowMove & move) noexcept
+{
+  const auto newRow = [&move](int row){
+    return move.newRow(row);
+  };
+
+  for(auto & rowsOfTrigram : mRowsOfTrigram){
+    std::vector<int> & postingList = rowsOfTrigram.second;
+    const auto first = std::lower_bound( postingList.begin(), postingList.end(), move.firstRow() );
+    const auto last = std::upper_bound( first, postingList.end(), move.lastRow() );
+    if(first == last){
+      continue;
+    }
+    std::transform(first, last, first, newRow);
+    std::sort(first, last);
+  }
+}
+
+}} // namespace Mdt{ namespace ItemModel{
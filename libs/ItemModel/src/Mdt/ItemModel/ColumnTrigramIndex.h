@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_COLUMN_TRIGRAM_INDEX_H
+#define MDT_ITEM_MODEL_COLUMN_TRIGRAM_INDEX_H
+
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/AbstractColumnIndex.h"
+#include "mdt_itemmodel_export.h"
+#include <QString>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Trigram inverted index of the values of a column of a table
+   *
+   * For each trigram (sequence of 3 characters) found in the case folded values of the column,
+   * this index holds the sorted list of the rows that contain it (the posting list).
+   *
+   * A row that contains a text contains all the trigrams of this text.
+   * rowsThatMayContain() intersects the posting lists of the trigrams of a text,
+   * starting from the shortest one.
+   * The result is a set of candidate rows, which can contain false positives
+   * (the trigrams are present, but not contiguous),
+   * so the candidates must then be checked with the full predicate.
+   *
+   * The index is maintained like the other column indexes, see AbstractColumnIndex .
+   *
+   * AbstractTableModel uses this index, see AbstractTableModel::addColumnTrigramIndex() .
+   */
+  class MDT_ITEMMODEL_EXPORT ColumnTrigramIndex : public AbstractColumnIndex
+  {
+   public:
+
+    /*! \brief Construct a index for \a column
+     *
+     * \pre \a column must be >= 0
+     */
+    explicit ColumnTrigramIndex(int column) noexcept
+     : AbstractColumnIndex(column)
+    {
+    }
+
+    /*! \brief Get the rows that may contain \a text
+     *
+     * The comparison is case insensitive.
+     * If \a text is shorter than 3 characters,
+     * it has no trigram, and all rows are returned.
+     *
+     * \pre this index must be up to date
+     */
+    RowRangeList rowsThatMayContain(const QString & text) const;
+
+   private:
+
+    using Trigram = std::uint64_t;
+    using TrigramList = std::vector<Trigram>;
+
+    static
+    TrigramList distinctTrigramsOfFoldedText(const QString & text);
+
+    QString doKeyFromText(const QString & text) const override
+    {
+      return text.toCaseFolded();
+    }
+
+    void doClear() noexcept override;
+    void doAddRows(const std::vector<int> & rows) override;
+    void doRemoveRow(int row) noexcept override;
+    void doShiftRows(int firstRow, int offset) noexcept override;
+    void doMoveRows(const RowMove & move) noexcept override;
+
+    std::unordered_map< Trigram, std::vector<int> > mRowsOfTrigram;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_COLUMN_TRIGRAM_INDEX_H
@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "DelimitedTextParser.h"
+#include <charconv>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <exception>
+#include <system_error>
+#include <algorithm>
+
+namespace Mdt{ namespace ItemModel{
+
+namespace{
+
+  const char *findCharacter(const char *first, const char *last, char c) noexcept
+  {
+    if(first == last){
+      return nullptr;
+    }
+    return static_cast<const char*>( std::memchr( first, c, static_cast<std::size_t>(last - first) ) );
+  }
+
+  template<typename T>
+  bool fieldToInteger(const char *first, std::size_t size, T & value) noexcept
+  {
+    if(size == 0){
+      return false;
+    }
+    const char *last = first + size;
+    const auto result = std::from_chars(first, last, value);
+
+    return (result.ec == std::errc()) && (result.ptr == last);
+  }
+
+  std::size_t countQuotes(const char *first, const char *last) noexcept
+  {
+    std::size_t count = 0;
+    while( (first = findCharacter(first, last, '"')) != nullptr ){
+      ++count;
+      ++first;
+    }
+
+    return count;
+  }
+
+  void appendRowStarts(const char *data, std::size_t size, std::size_t chunkFirst, std::size_t chunkLast,
+                       bool inQuotes, std::vector<std::size_t> & rowStarts)
+  {
+    const char *first = data + chunkFirst;
+    const char *last = data + chunkLast;
+
+    while(first != last){
+      const char *quote = findCharacter(first, last, '"');
+      if(inQuotes){
+        if(quote == nullptr){
+          return;
+        }
+        first = quote + 1;
+        inQuotes = false;
+        continue;
+      }
+      const char *lineFeedSearchLast = (quote != nullptr) ? quote : last;
+      while( const char *lineFeed = findCharacter(first, lineFeedSearchLast, '\n') ){
+        const auto rowStart = static_cast<std::size_t>(lineFeed - data) + 1;
+        if(rowStart < size){
+          rowStarts.push_back(rowStart);
+        }
+        first = lineFeed + 1;
+      }
+      if(quote == nullptr){
+        return;
+      }
+      first = quote + 1;
+      inQuotes = true;
+    }
+  }
+
+} // namespace{
+
+char cLocaleDecimalPoint() noexcept
+{
+  return std::localeconv()->decimal_point[0];
+}
+
+void DelimitedTextRow::parse(const char *begin, const char *end, DelimitedTextFormat format)
+{
+  assert( begin <= end );
+
+  mFields.clear();
+  mUnescapedText.clear();
+
+  if( (begin != end) && (*(end-1) == '\r') ){
+    --end;
+  }
+
+  const char separator = (format == DelimitedTextFormat::Tsv) ? '\t' : ',';
+  const char *first = begin;
+  while(true){
+    Field field;
+    if( (first != end) && (*first == '"') ){
+      first = parseQuotedField(first + 1, end, field);
+      const char *separatorPos = findCharacter(first, end, separator);
+      first = (separatorPos != nullptr) ? separatorPos : end;
+    }else{
+      const char *separatorPos = findCharacter(first, end, separator);
+      const char *last = (separatorPos != nullptr) ? separatorPos : end;
+      field.first = first;
+      field.size = static_cast<std::size_t>(last - first);
+      first = last;
+    }
+    mFields.push_back(field);
+    if(first == end){
+      return;
+    }
+    ++first;
+  }
+}
+
+QString DelimitedTextRow::toQString(int column) const
+{
+  return QString::fromUtf8( fieldData(column), static_cast<int>( fieldSize(column) ) );
+}
+
+bool DelimitedTextRow::toInt(int column, int & value) const noexcept
+{
+  return fieldToInteger( fieldData(column), fieldSize(column), value );
+}
+
+bool DelimitedTextRow::toLongLong(int column, qlonglong & value) const noexcept
+{
+  return fieldToInteger( fieldData(column), fieldSize(column), value );
+}
+
+bool DelimitedTextRow::toDouble(int column, double & value) const noexcept
+{
+  /*
+   * std::from_chars() for floating point values is not available on all our compilers,
+   * so the field is copied to a null terminated buffer for std::strtod() ,
+   * which uses the decimal point of the current C locale,
+   * read once when this row was constructed
+   */
+  char text[64];
+  const std::size_t size = fieldSize(column);
+  if( (size == 0) || (size >= sizeof(text)) ){
+    return false;
+  }
+  std::memcpy( text, fieldData(column), size );
+  text[size] = '\0';
+
+  if(mCDecimalPoint != '.'){
+    std::replace(text, text + size, '.', mCDecimalPoint);
+  }
+
+  char *last = nullptr;
+  value = std::strtod(text, &last);
+
+  return last == text + size;
+}
+
+const char *DelimitedTextRow::parseQuotedField(const char *first, const char *end, Field & field)
+{
+  const char *quote = findCharacter(first, end, '"');
+
+  // Field without doubled double quotes: refer to the parsed text
+  if( (quote == nullptr) || (quote + 1 == end) || (*(quote + 1) != '"') ){
+    const char *last = (quote != nullptr) ? quote : end;
+    field.first = first;
+    field.size = static_cast<std::size_t>(last - first);
+    return (quote != nullptr) ? quote + 1 : end;
+  }
+
+  field.isUnescaped = true;
+  field.offset = mUnescapedText.size();
+  while(true){
+    if(quote == nullptr){
+      mUnescapedText.append(first, end);
+      first = end;
+      break;
+    }
+    mUnescapedText.append(first, quote);
+    if( (quote + 1 != end) && (*(quote + 1) == '"') ){
+      mUnescapedText.push_back('"');
+      first = quote + 2;
+      quote = findCharacter(first, end, '"');
+      continue;
+    }
+    first = quote + 1;
+    break;
+  }
+  field.size = mUnescapedText.size() - field.offset;
+
+  return first;
+}
+
+void runInParallel(int taskCount, const std::function<void(int)> & task)
+{
+  assert( taskCount >= 1 );
+
+  std::vector<std::exception_ptr> exceptions( static_cast<std::size_t>(taskCount) );
+  const auto runTask = [&task, &exceptions](int i) noexcept{
+    try{
+      task(i);
+    }catch(...){
+      exceptions[static_cast<std::size_t>(i)] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve( static_cast<std::size_t>(taskCount - 1) );
+  for(int i = 1; i < taskCount; ++i){
+    try{
+      threads.emplace_back(runTask, i);
+    }catch(const std::system_error &){
+      runTask(i);
+    }
+  }
+  runTask(0);
+  for(std::thread & thread : threads){
+    thread.join();
+  }
+
+  for(const std::exception_ptr & exception : exceptions){
+    if(exception){
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+std::vector<std::size_t> findDelimitedTextRowStarts(const char *data, std::size_t size, int chunkCount)
+{
+  assert( (data != nullptr) || (size == 0) );
+  assert( chunkCount >= 1 );
+
+  std::vector<std::size_t> rowStarts;
+  if(size == 0){
+    return rowStarts;
+  }
+
+  const std::size_t maxChunkCount = std::max( size / delimitedTextMinimumChunkSize, std::size_t(1) );
+  const std::size_t count = std::min( static_cast<std::size_t>(chunkCount), maxChunkCount );
+  const std::size_t chunkSize = size / count;
+
+  std::vector<std::size_t> chunkFirsts(count + 1);
+  for(std::size_t c = 0; c < count; ++c){
+    chunkFirsts[c] = c * chunkSize;
+  }
+  chunkFirsts[count] = size;
+
+  std::vector<std::size_t> quoteCounts(count);
+  runInParallel( static_cast<int>(count), [&](int task){
+    const auto c = static_cast<std::size_t>(task);
+    quoteCounts[c] = countQuotes(data + chunkFirsts[c], data + chunkFirsts[c+1]);
+  });
+
+  /*
+   * Quotes are balanced in each quoted field (doubled quotes included),
+   * so a chunk starts inside a quoted field
+   * if the count of quotes before it is odd
+   */
+  std::vector<char> startsInQuotes(count);
+  std::size_t quoteCount = 0;
+  for(std::size_t c = 0; c < count; ++c){
+    startsInQuotes[c] = static_cast<char>( (quoteCount % 2) == 1 );
+    quoteCount += quoteCounts[c];
+  }
+
+  std::vector< std::vector<std::size_t> > chunkRowStarts(count);
+  runInParallel( static_cast<int>(count), [&](int task){
+    const auto c = static_cast<std::size_t>(task);
+    appendRowStarts(data, size, chunkFirsts[c], chunkFirsts[c+1], startsInQuotes[c] != 0, chunkRowStarts[c]);
+  });
+
+  std::size_t rowCount = 1;
+  for(const auto & starts : chunkRowStarts){
+    rowCount += starts.size();
+  }
+  rowStarts.reserve(rowCount);
+  rowStarts.push_back(0);
+  for(const auto & starts : chunkRowStarts){
+    rowStarts.insert( rowStarts.end(), starts.cbegin(), starts.cend() );
+  }
+
+  return rowStarts;
+}
+
+}} // namespace Mdt{ namespace ItemModel{
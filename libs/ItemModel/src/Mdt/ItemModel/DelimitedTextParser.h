@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_DELIMITED_TEXT_PARSER_H
+#define MDT_ITEM_MODEL_DELIMITED_TEXT_PARSER_H
+
+#include "Mdt/ItemModel/DelimitedTextWriter.h"
+#include "mdt_itemmodel_export.h"
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+#include <functional>
+#include <string>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Get the decimal point of the current C locale
+   *
+   * Calls std::localeconv() , which is not thread safe.
+   */
+  MDT_ITEMMODEL_EXPORT
+  char cLocaleDecimalPoint() noexcept;
+
+  /*! \brief Fields of a row of delimited text (CSV or TSV), encoded in UTF-8
+   *
+   * A row is parsed with parse() , which splits it into fields
+   * and removes the enclosing double quotes (RFC 4180),
+   * like DelimitedTextWriter writes them.
+   *
+   * The fields refer to the parsed text, which must outlive the row.
+   * Only fields that contain doubled double quotes are copied,
+   * to a buffer that is reused from one row to the next,
+   * so parsing a row in a loop does not allocate once the buffers have grown.
+   *
+   * \sa importDelimitedText()
+   */
+  class MDT_ITEMMODEL_EXPORT DelimitedTextRow
+  {
+   public:
+
+    /*! \brief Construct a empty row
+     *
+     * \a cDecimalPoint is the decimal point of the current C locale,
+     * used by toDouble() .
+     * Reading it with std::localeconv() is not thread safe,
+     * so a row that is used in a worker thread should receive
+     * a value read before starting the thread.
+     *
+     * \sa cLocaleDecimalPoint()
+     */
+    explicit DelimitedTextRow(char cDecimalPoint = cLocaleDecimalPoint()) noexcept
+     : mCDecimalPoint(cDecimalPoint)
+    {
+    }
+
+    /*! \brief Parse the row starting at \a begin and ending at \a end
+     *
+     * \a end is the end of the row, without the line feed.
+     * A trailing carriage return is ignored.
+     *
+     * \pre \a begin must be <= \a end
+     */
+    void parse(const char *begin, const char *end, DelimitedTextFormat format);
+
+    /*! \brief Get the count of fields in this row
+     *
+     * A empty row has a single empty field.
+     */
+    int fieldCount() const noexcept
+    {
+      return static_cast<int>( mFields.size() );
+    }
+
+    /*! \brief Get the UTF-8 text of the field at \a column
+     *
+     * The text is not null terminated, see fieldSize() .
+     *
+     * \pre \a column must be in valid range ( 0 <= \a column < fieldCount() )
+     */
+    const char *fieldData(int column) const noexcept
+    {
+      const Field & f = field(column);
+      if(f.isUnescaped){
+        return mUnescapedText.data() + f.offset;
+      }
+      return f.first;
+    }
+
+    /*! \brief Get the size, in bytes, of the field at \a column
+     *
+     * \pre \a column must be in valid range ( 0 <= \a column < fieldCount() )
+     */
+    std::size_t fieldSize(int column) const noexcept
+    {
+      return field(column).size;
+    }
+
+    /*! \brief Get the text of the field at \a column
+     *
+     * \pre \a column must be in valid range ( 0 <= \a column < fieldCount() )
+     */
+    std::string toStdString(int column) const
+    {
+      return std::string( fieldData(column), fieldSize(column) );
+    }
+
+    /*! \brief Get the text of the field at \a column
+     *
+     * \pre \a column must be in valid range ( 0 <= \a column < fieldCount() )
+     */
+    QString toQString(int column) const;
+
+    /*! \brief Convert the field at \a column to a integer
+     *
+     * Returns false if the field is not a integer in the range of \a value .
+     *
+     * \pre \a column must be in valid range ( 0 <= \a column < fieldCount() )
+     */
+    bool toInt(int column, int & value) const noexcept;
+
+    /*! \brief Convert the field at \a column to a integer
+     *
+     * \sa toInt()
+     */
+    bool toLongLong(int column, qlonglong & value) const noexcept;
+
+    /*! \brief Convert the field at \a column to a floating point value
+     *
+     * The decimal point is always a dot, whatever the locale is.
+     * Returns false if the field is not a number.
+     *
+     * \pre \a column must be in valid range ( 0 <= \a column < fieldCount() )
+     */
+    bool toDouble(int column, double & value) const noexcept;
+
+   private:
+
+    struct Field
+    {
+      const char *first = nullptr;
+      std::size_t offset = 0;
+      std::size_t size = 0;
+      bool isUnescaped = false;
+    };
+
+    const Field & field(int column) const noexcept
+    {
+      assert( column >= 0 );
+      assert( column < fieldCount() );
+
+      return mFields[static_cast<std::size_t>(column)];
+    }
+
+    const char *parseQuotedField(const char *first, const char *end, Field & field);
+
+    char mCDecimalPoint;
+    std::vector<Field> mFields;
+    std::string mUnescapedText;
+  };
+
+  /*! \brief Minimum size, in bytes, of a chunk scanned by a thread
+   *
+   * \sa findDelimitedTextRowStarts()
+   */
+  constexpr std::size_t delimitedTextMinimumChunkSize = 256 * 1024;
+
+  /*! \internal Run \a task for each task index in range [0, \a taskCount)
+   *
+   * Task 0 runs in the calling thread, the other ones in their own thread
+   * (or in the calling thread if a thread can not be started).
+   * Returns once all tasks are finished.
+   * If a task throws, the exception is rethrown in the calling thread,
+   * once all tasks are finished.
+   *
+   * \pre \a taskCount must be >= 1
+   */
+  MDT_ITEMMODEL_EXPORT
+  void runInParallel(int taskCount, const std::function<void(int)> & task);
+
+  /*! \brief Find the start of each row of the delimited text of \a size bytes starting at \a data
+   *
+   * Rows are terminated by a line feed.
+   * A line feed inside a quoted field does not terminate a row.
+   * The returned offsets are in ascending order,
+   * the first one being 0 if \a size is not 0.
+   *
+   * The text is split into \a chunkCount chunks, which are scanned in parallel, in 2 passes.
+   * The first pass counts the double quotes of each chunk,
+   * which tells, for each chunk, if it starts inside a quoted field.
+   * The second pass finds the line feeds that are outside of quoted fields.
+   * Both passes search characters with std::memchr() ,
+   * which is vectorized by the C library.
+   *
+   * Chunks smaller than delimitedTextMinimumChunkSize are not worth a thread,
+   * so less chunks are used for small texts.
+   *
+   * \pre \a data must not be a nullptr if \a size is not 0
+   * \pre \a chunkCount must be >= 1
+   */
+  MDT_ITEMMODEL_EXPORT
+  std::vector<std::size_t> findDelimitedTextRowStarts(const char *data, std::size_t size, int chunkCount);
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_DELIMITED_TEXT_PARSER_H
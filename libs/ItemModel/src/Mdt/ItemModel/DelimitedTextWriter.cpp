@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "DelimitedTextWriter.h"
+#include <QChar>
+#include <QMetaType>
+#include <charconv>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+DelimitedTextWriter::DelimitedTextWriter(QIODevice & device, DelimitedTextFormat format, std::size_t bufferCapacity)
+ : mDevice(device),
+   mFormat(format),
+   mBufferCapacity(bufferCapacity),
+   mDecimalPoint( std::localeconv()->decimal_point[0] )
+{
+  assert( device.isWritable() );
+  assert( bufferCapacity >= 1 );
+
+  mBuffer.reserve(mBufferCapacity);
+}
+
+DelimitedTextWriter::~DelimitedTextWriter() noexcept
+{
+  flush();
+}
+
+void DelimitedTextWriter::writeField(const char *text, std::size_t size)
+{
+  assert( (text != nullptr) || (size == 0) );
+
+  beginField();
+
+  bool mustBeQuoted = false;
+  for(std::size_t i = 0; i < size; ++i){
+    if( isSpecialCharacter(text[i]) ){
+      mustBeQuoted = true;
+      break;
+    }
+  }
+
+  if(mustBeQuoted){
+    appendQuoted(text, size);
+  }else{
+    mBuffer.append(text, size);
+  }
+  flushIfBufferIsFull();
+}
+
+void DelimitedTextWriter::writeField(const QString & text)
+{
+  beginField();
+
+  const QChar *first = text.constData();
+  const int size = text.size();
+  const QChar sep = QLatin1Char( separator() );
+
+  bool mustBeQuoted = false;
+  for(int i = 0; i < size; ++i){
+    const QChar c = first[i];
+    if( (c == sep) || (c == QLatin1Char('"')) || (c == QLatin1Char('\n')) || (c == QLatin1Char('\r')) ){
+      mustBeQuoted = true;
+      break;
+    }
+  }
+
+  if(mustBeQuoted){
+    mBuffer.push_back('"');
+    appendUtf8(first, size, true);
+    mBuffer.push_back('"');
+  }else{
+    appendUtf8(first, size, false);
+  }
+  flushIfBufferIsFull();
+}
+
+void DelimitedTextWriter::writeField(qlonglong value)
+{
+  beginField();
+
+  char text[32];
+  const auto result = std::to_chars(text, text + sizeof(text), value);
+  assert( result.ec == std::errc() );
+
+  mBuffer.append( text, static_cast<std::size_t>(result.ptr - text) );
+  flushIfBufferIsFull();
+}
+
+void DelimitedTextWriter::writeField(double value)
+{
+  beginField();
+
+  /*
+   * std::to_chars() for floating point values is not available on all our compilers.
+   * %.15g is enough for most values, %.17g always reads back to the same value.
+   */
+  char text[40];
+  int size = std::snprintf(text, sizeof(text), "%.15g", value);
+  assert( size > 0 );
+  if( std::strtod(text, nullptr) != value ){
+    size = std::snprintf(text, sizeof(text), "%.17g", value);
+    assert( size > 0 );
+  }
+
+  /*
+   * snprintf() uses the decimal point of the current C locale,
+   * which QCoreApplication sets from the environment
+   */
+  if(mDecimalPoint != '.'){
+    for(int i = 0; i < size; ++i){
+      if(text[i] == mDecimalPoint){
+        text[i] = '.';
+      }
+    }
+  }
+
+  mBuffer.append( text, static_cast<std::size_t>(size) );
+  flushIfBufferIsFull();
+}
+
+void DelimitedTextWriter::writeField(const QVariant & value)
+{
+  switch( value.userType() ){
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+      writeField( value.toLongLong() );
+      return;
+    case QMetaType::Double:
+    case QMetaType::Float:
+      writeField( value.toDouble() );
+      return;
+    default:
+      break;
+  }
+
+  writeField( value.toString() );
+}
+
+void DelimitedTextWriter::writeEmptyField()
+{
+  beginField();
+}
+
+void DelimitedTextWriter::endRow()
+{
+  mBuffer.push_back('\n');
+  mIsFirstFieldOfRow = true;
+  flushIfBufferIsFull();
+}
+
+bool DelimitedTextWriter::flush()
+{
+  if( mBuffer.empty() ){
+    return !mHasError;
+  }
+
+  const auto size = static_cast<qint64>( mBuffer.size() );
+  if( mDevice.write(mBuffer.data(), size) != size ){
+    mHasError = true;
+  }
+  mFlushedByteCount += size;
+  mBuffer.clear();
+
+  return !mHasError;
+}
+
+void DelimitedTextWriter::beginField()
+{
+  if(mIsFirstFieldOfRow){
+    mIsFirstFieldOfRow = false;
+  }else{
+    mBuffer.push_back( separator() );
+  }
+}
+
+void DelimitedTextWriter::flushIfBufferIsFull()
+{
+  if( mBuffer.size() >= mBufferCapacity ){
+    flush();
+  }
+}
+
+void DelimitedTextWriter::appendQuoted(const char *text, std::size_t size)
+{
+  mBuffer.push_back('"');
+  for(std::size_t i = 0; i < size; ++i){
+    if(text[i] == '"'){
+      mBuffer.push_back('"');
+    }
+    mBuffer.push_back(text[i]);
+  }
+  mBuffer.push_back('"');
+}
+
+void DelimitedTextWriter::appendUtf8(const QChar *text, int size, bool quoted)
+{
+  for(int i = 0; i < size; ++i){
+    char32_t codePoint = text[i].unicode();
+
+    if( codePoint < 0x80 ){
+      if( quoted && (codePoint == '"') ){
+        mBuffer.push_back('"');
+      }
+      mBuffer.push_back( static_cast<char>(codePoint) );
+      continue;
+    }
+
+    if( QChar::isHighSurrogate(codePoint) && (i + 1 < size) && text[i+1].isLowSurrogate() ){
+      codePoint = QChar::surrogateToUcs4( text[i].unicode(), text[i+1].unicode() );
+      ++i;
+    }else if( QChar::isSurrogate(codePoint) ){
+      codePoint = QChar::ReplacementCharacter;
+    }
+
+    if( codePoint < 0x800 ){
+      mBuffer.push_back( static_cast<char>( 0xC0 | (codePoint >> 6) ) );
+      mBuffer.push_back( static_cast<char>( 0x80 | (codePoint & 0x3F) ) );
+    }else if( codePoint < 0x10000 ){
+      mBuffer.push_back( static_cast<char>( 0xE0 | (codePoint >> 12) ) );
+      mBuffer.push_back( static_cast<char>( 0x80 | ((codePoint >> 6) & 0x3F) ) );
+      mBuffer.push_back( static_cast<char>( 0x80 | (codePoint & 0x3F) ) );
+    }else{
+      mBuffer.push_back( static_cast<char>( 0xF0 | (codePoint >> 18) ) );
+      mBuffer.push_back( static_cast<char>( 0x80 | ((codePoint >> 12) & 0x3F) ) );
+      mBuffer.push_back( static_cast<char>( 0x80 | ((codePoint >> 6) & 0x3F) ) );
+      mBuffer.push_back( static_cast<char>( 0x80 | (codePoint & 0x3F) ) );
+    }
+  }
+}
+
+}} // namespace Mdt{ namespace ItemModel{
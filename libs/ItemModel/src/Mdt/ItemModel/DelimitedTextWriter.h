@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_DELIMITED_TEXT_WRITER_H
+#define MDT_ITEM_MODEL_DELIMITED_TEXT_WRITER_H
+
+#include "mdt_itemmodel_export.h"
+#include <QIODevice>
+#include <QString>
+#include <QVariant>
+#include <QtGlobal>
+#include <string>
+#include <cstddef>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Format of delimited text
+   */
+  enum class DelimitedTextFormat
+  {
+    Csv,  /*!< Fields separated by a comma */
+    Tsv   /*!< Fields separated by a tab */
+  };
+
+  /*! \brief Writes delimited text (CSV or TSV), encoded in UTF-8, to a QIODevice
+   *
+   * The fields are appended to a output buffer,
+   * which is written to the device each time it exceeds its capacity.
+   * The buffer is allocated once and reused,
+   * so writing a field does not allocate
+   * (except writeField(const QVariant &) , which converts the value to a QString ).
+   *
+   * A field that contains the separator, a double quote or a line break
+   * is enclosed in double quotes, and its double quotes are doubled (RFC 4180).
+   * Rows are terminated by a line feed.
+   *
+   * \code
+   * QFile file(path);
+   * file.open(QIODevice::WriteOnly);
+   *
+   * DelimitedTextWriter writer(file);
+   * writer.writeField(42);
+   * writer.writeField( QLatin1String("Name, with comma") );
+   * writer.endRow();
+   * writer.flush();
+   * \endcode
+   *
+   * Doubles are written with a '.' decimal point.
+   * The decimal point of the C locale is read once, when the writer is constructed,
+   * so the C locale must not be changed while a writer exists
+   * (std::localeconv() is not thread safe).
+   *
+   * \note The device must not be used by a other thread while this writer writes to it.
+   */
+  class MDT_ITEMMODEL_EXPORT DelimitedTextWriter
+  {
+   public:
+
+    /*! \brief Capacity of the output buffer used by default
+     */
+    static constexpr std::size_t defaultBufferCapacity = 64 * 1024;
+
+    /*! \brief Construct a writer that writes to \a device
+     *
+     * \pre \a device must be open for writing
+     * \pre \a bufferCapacity must be >= 1
+     */
+    explicit DelimitedTextWriter(QIODevice & device, DelimitedTextFormat format = DelimitedTextFormat::Csv,
+                                 std::size_t bufferCapacity = defaultBufferCapacity);
+
+    DelimitedTextWriter(const DelimitedTextWriter & other) = delete;
+    DelimitedTextWriter & operator=(const DelimitedTextWriter & other) = delete;
+    DelimitedTextWriter(DelimitedTextWriter && other) = delete;
+    DelimitedTextWriter & operator=(DelimitedTextWriter && other) = delete;
+
+    /*! \brief Flushes the buffer
+     */
+    ~DelimitedTextWriter() noexcept;
+
+    /*! \brief Get the format of this writer
+     */
+    DelimitedTextFormat format() const noexcept
+    {
+      return mFormat;
+    }
+
+    /*! \brief Write a field containing the UTF-8 text of \a size bytes starting at \a text
+     */
+    void writeField(const char *text, std::size_t size);
+
+    /*! \brief Write a field containing the UTF-8 text \a text
+     */
+    void writeField(const std::string & text)
+    {
+      writeField( text.data(), text.size() );
+    }
+
+    /*! \brief Write a field containing \a text
+     *
+     * \a text is encoded to UTF-8 directly in the output buffer.
+     */
+    void writeField(const QString & text);
+
+    /*! \brief Write a field containing \a value
+     */
+    void writeField(int value)
+    {
+      writeField( static_cast<qlonglong>(value) );
+    }
+
+    /*! \brief Write a field containing \a value
+     */
+    void writeField(qlonglong value);
+
+    /*! \brief Write a field containing \a value
+     *
+     * The shortest representation that reads back to \a value is written.
+     */
+    void writeField(double value);
+
+    /*! \brief Write a field containing \a value
+     *
+     * Integers and floating point values are written like the typed overloads,
+     * other values are converted with QVariant::toString() .
+     */
+    void writeField(const QVariant & value);
+
+    /*! \brief Write a empty field
+     */
+    void writeEmptyField();
+
+    /*! \brief Terminate the current row
+     */
+    void endRow();
+
+    /*! \brief Write the buffered text to the device
+     *
+     * Returns false if the device reported a error.
+     */
+    bool flush();
+
+    /*! \brief Check if writing to the device failed
+     */
+    bool hasError() const noexcept
+    {
+      return mHasError;
+    }
+
+    /*! \brief Get the count of bytes written so far, including the buffered ones
+     */
+    qint64 byteCount() const noexcept
+    {
+      return mFlushedByteCount + static_cast<qint64>( mBuffer.size() );
+    }
+
+   private:
+
+    char separator() const noexcept
+    {
+      if(mFormat == DelimitedTextFormat::Tsv){
+        return '\t';
+      }
+      return ',';
+    }
+
+    bool isSpecialCharacter(char c) const noexcept
+    {
+      return (c == separator()) || (c == '"') || (c == '\n') || (c == '\r');
+    }
+
+    void beginField();
+    void flushIfBufferIsFull();
+    void appendQuoted(const char *text, std::size_t size);
+    void appendUtf8(const QChar *text, int size, bool quoted);
+
+    QIODevice & mDevice;
+    DelimitedTextFormat mFormat;
+    std::size_t mBufferCapacity;
+    std::string mBuffer;
+    char mDecimalPoint;
+    bool mIsFirstFieldOfRow = true;
+    bool mHasError = false;
+    qint64 mFlushedByteCount = 0;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_DELIMITED_TEXT_WRITER_H
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "DisplayDataCache.h"
+#include <iterator>
+
+namespace Mdt{ namespace ItemModel{
+
+void DisplayDataCache::setCapacity(int capacity) noexcept
+{
+  assert( capacity >= 0 );
+
+  mCapacity = capacity;
+  while(size() > mCapacity){
+    evictLeastRecentlyUsed();
+  }
+}
+
+const QVariant *DisplayDataCache::find(int row, int column) noexcept
+{
+  const auto it = mMap.find( keyOf(row, column) );
+  if( it == mMap.end() ){
+    return nullptr;
+  }
+
+  mEntries.splice( mEntries.begin(), mEntries, it->second );
+
+  return &it->second->data;
+}
+
+void DisplayDataCache::insert(int row, int column, const QVariant & data)
+{
+  if( !isEnabled() ){
+    return;
+  }
+
+  const quint64 key = keyOf(row, column);
+  const auto it = mMap.find(key);
+  if( it != mMap.end() ){
+    it->second->data = data;
+    mEntries.splice( mEntries.begin(), mEntries, it->second );
+    return;
+  }
+
+  if(size() >= mCapacity){
+    evictLeastRecentlyUsed();
+  }
+  mEntries.push_front( Entry{row, column, data} );
+  mMap.emplace( key, mEntries.begin() );
+}
+
+void DisplayDataCache::invalidateCells(int firstRow, int lastRow, int firstColumn, int lastColumn) noexcept
+{
+  assert( firstRow <= lastRow );
+  assert( firstColumn <= lastColumn );
+
+  if( mMap.empty() ){
+    return;
+  }
+
+  /*
+   * Typically a single cell or a single row changes:
+   * looking up each cell of the range is then cheaper than scanning the cache
+   */
+  const qint64 cellCount = static_cast<qint64>(lastRow - firstRow + 1) * static_cast<qint64>(lastColumn - firstColumn + 1);
+  if( (cellCount <= static_cast<qint64>( mMap.size() )) && (firstRow >= 0) && (firstColumn >= 0) ){
+    for(int row = firstRow; row <= lastRow; ++row){
+      for(int column = firstColumn; column <= lastColumn; ++column){
+        const auto it = mMap.find( keyOf(row, column) );
+        if( it != mMap.end() ){
+          erase(it->second);
+        }
+      }
+    }
+    return;
+  }
+
+  auto it = mEntries.begin();
+  while( it != mEntries.end() ){
+    const auto next = std::next(it);
+    if( (it->row >= firstRow) && (it->row <= lastRow) && (it->column >= firstColumn) && (it->column <= lastColumn) ){
+      erase(it);
+    }
+    it = next;
+  }
+}
+
+void DisplayDataCache::invalidateRows(int firstRow, int lastRow) noexcept
+{
+  assert( firstRow <= lastRow );
+
+  auto it = mEntries.begin();
+  while( it != mEntries.end() ){
+    const auto next = std::next(it);
+    if( (it->row >= firstRow) && (it->row <= lastRow) ){
+      erase(it);
+    }
+    it = next;
+  }
+}
+
+void DisplayDataCache::rowsInserted(int firstRow, int lastRow)
+{
+  assert( firstRow >= 0 );
+  assert( lastRow >= firstRow );
+
+  const int count = lastRow - firstRow + 1;
+  bool renumbered = false;
+
+  for(Entry & entry : mEntries){
+    if(entry.row >= firstRow){
+      entry.row += count;
+      renumbered = true;
+    }
+  }
+
+  if(renumbered){
+    rebuildMap();
+  }
+}
+
+void DisplayDataCache::rowsRemoved(int firstRow, int lastRow)
+{
+  assert( firstRow >= 0 );
+  assert( lastRow >= firstRow );
+
+  const int count = lastRow - firstRow + 1;
+  bool renumbered = false;
+
+  auto it = mEntries.begin();
+  while( it != mEntries.end() ){
+    const auto next = std::next(it);
+    if(it->row > lastRow){
+      it->row -= count;
+      renumbered = true;
+    }else if(it->row >= firstRow){
+      erase(it);
+    }
+    it = next;
+  }
+
+  if(renumbered){
+    rebuildMap();
+  }
+}
+
+void DisplayDataCache::clear() noexcept
+{
+  mMap.clear();
+  mEntries.clear();
+}
+
+void DisplayDataCache::erase(EntryList::iterator it) noexcept
+{
+  mMap.erase( keyOf(it->row, it->column) );
+  mEntries.erase(it);
+}
+
+void DisplayDataCache::evictLeastRecentlyUsed() noexcept
+{
+  assert( !mEntries.empty() );
+
+  erase( std::prev( mEntries.end() ) );
+}
+
+void DisplayDataCache::rebuildMap()
+{
+  mMap.clear();
+  for(auto it = mEntries.begin(); it != mEntries.end(); ++it){
+    mMap.emplace( keyOf(it->row, it->column), it );
+  }
+}
+
+}} // namespace Mdt{ namespace ItemModel{
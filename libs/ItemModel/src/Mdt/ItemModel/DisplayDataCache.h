@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_DISPLAY_DATA_CACHE_H
+#define MDT_ITEM_MODEL_DISPLAY_DATA_CACHE_H
+
+#include "mdt_itemmodel_export.h"
+#include <QVariant>
+#include <QtGlobal>
+#include <list>
+#include <unordered_map>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Least recently used cache of the display role data of the cells of a table
+   *
+   * Holds at most capacity() cells, keyed by (row, column).
+   * When a cell is inserted in a full cache,
+   * the least recently used one is evicted.
+   *
+   * The cache does not know the table:
+   * it has to be told about the changes of the table,
+   * so that it drops the cells that changed,
+   * and renumbers the cells that have been shifted by inserted or removed rows.
+   *
+   * AbstractTableModel uses this cache, see AbstractTableModel::setDisplayDataCacheCapacity() .
+   */
+  class MDT_ITEMMODEL_EXPORT DisplayDataCache
+  {
+   public:
+
+    /*! \brief Construct a cache that can hold \a capacity cells
+     *
+     * A capacity of 0 disables the cache.
+     *
+     * \pre \a capacity must be >= 0
+     */
+    explicit DisplayDataCache(int capacity = 0) noexcept
+     : mCapacity(capacity)
+    {
+      assert( capacity >= 0 );
+    }
+
+    /*! \brief Get the count of cells this cache can hold
+     */
+    int capacity() const noexcept
+    {
+      return mCapacity;
+    }
+
+    /*! \brief Set the count of cells this cache can hold
+     *
+     * If this cache holds more than \a capacity cells,
+     * the least recently used ones are evicted.
+     *
+     * \pre \a capacity must be >= 0
+     */
+    void setCapacity(int capacity) noexcept;
+
+    /*! \brief Check if this cache is enabled
+     *
+     * Returns true if capacity() is > 0
+     */
+    bool isEnabled() const noexcept
+    {
+      return mCapacity > 0;
+    }
+
+    /*! \brief Get the count of cells this cache holds
+     */
+    int size() const noexcept
+    {
+      return static_cast<int>( mMap.size() );
+    }
+
+    /*! \brief Find the data of the cell at \a row and \a column
+     *
+     * Returns a nullptr if the cell is not in this cache.
+     * Otherwise, the cell becomes the most recently used one.
+     *
+     * The returned pointer is valid until this cache is modified.
+     */
+    const QVariant *find(int row, int column) noexcept;
+
+    /*! \brief Put \a data for the cell at \a row and \a column
+     *
+     * The cell becomes the most recently used one.
+     *
+     * Does nothing if this cache is not enabled.
+     *
+     * \pre \a row and \a column must be >= 0
+     */
+    void insert(int row, int column, const QVariant & data);
+
+    /*! \brief Drop the cells in rows \a firstRow to \a lastRow and columns \a firstColumn to \a lastColumn
+     *
+     * \pre \a firstRow must be <= \a lastRow
+     * \pre \a firstColumn must be <= \a lastColumn
+     */
+    void invalidateCells(int firstRow, int lastRow, int firstColumn, int lastColumn) noexcept;
+
+    /*! \brief Drop the cells in rows \a firstRow to \a lastRow
+     *
+     * \pre \a firstRow must be <= \a lastRow
+     */
+    void invalidateRows(int firstRow, int lastRow) noexcept;
+
+    /*! \brief Tell this cache that rows \a firstRow to \a lastRow are inserted
+     *
+     * The cells starting from \a firstRow are renumbered.
+     * Only the row numbers are used, so this can be called before the rows are inserted.
+     *
+     * \pre \a firstRow must be >= 0
+     * \pre \a lastRow must be >= \a firstRow
+     */
+    void rowsInserted(int firstRow, int lastRow);
+
+    /*! \brief Tell this cache that rows \a firstRow to \a lastRow are removed
+     *
+     * The cells in the removed rows are dropped,
+     * the ones after \a lastRow are renumbered.
+     * Only the row numbers are used, so this can be called before the rows are removed.
+     *
+     * \pre \a firstRow must be >= 0
+     * \pre \a lastRow must be >= \a firstRow
+     */
+    void rowsRemoved(int firstRow, int lastRow);
+
+    /*! \brief Drop all cells
+     */
+    void clear() noexcept;
+
+   private:
+
+    struct Entry
+    {
+      int row;
+      int column;
+      QVariant data;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    static
+    quint64 keyOf(int row, int column) noexcept
+    {
+      assert( row >= 0 );
+      assert( column >= 0 );
+
+      return (static_cast<quint64>(row) << 32) | static_cast<quint64>(column);
+    }
+
+    void erase(EntryList::iterator it) noexcept;
+    void evictLeastRecentlyUsed() noexcept;
+    void rebuildMap();
+
+    // Most recently used first
+    EntryList mEntries;
+    std::unordered_map<quint64, EntryList::iterator> mMap;
+    int mCapacity;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_DISPLAY_DATA_CACHE_H
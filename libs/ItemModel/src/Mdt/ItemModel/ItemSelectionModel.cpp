@@ -4,10 +4,11 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2011-2023 Philippe Steinmann.
+ ** Copyright (C) 2011-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #include "ItemSelectionModel.h"
+#include "RowSelectionHelpers.h"
 #include <QItemSelectionRange>
 #include <algorithm>
 #include <cassert>
@@ -30,6 +31,13 @@ void ItemSelectionModel::setCurrentIndexToFirstRowAfterReset(bool enable) noexce
   mSetCurrentIndexToFirstRowAfterResetIsEnabled = enable;
 }
 
+void ItemSelectionModel::selectRows(const RowSelection & rowSelection, QItemSelectionModel::SelectionFlags command)
+{
+  assert( model() != nullptr );
+
+  select( itemSelectionFromRowSelection(*model(), rowSelection), command );
+}
+
 bool ItemSelectionModel::canSetCurrentIndex(const QModelIndex & index) noexcept
 {
   if( changeCurrentRowIsAllowed() ){
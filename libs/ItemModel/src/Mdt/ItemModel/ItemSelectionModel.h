@@ -4,12 +4,13 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2011-2023 Philippe Steinmann.
+ ** Copyright (C) 2011-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #ifndef MDT_ITEM_MODEL_ITEM_SELECTION_MODEL_H
 #define MDT_ITEM_MODEL_ITEM_SELECTION_MODEL_H
 
+#include "Mdt/ItemModel/RowSelection.h"
 #include "mdt_itemmodel_export.h"
 #include <QItemSelectionModel>
 #include <QItemSelection>
@@ -312,6 +313,29 @@ namespace Mdt{ namespace ItemModel{
       return mChangeCurrentRowIsAllowed;
     }
 
+    /*! \brief Select the rows in \a rowSelection
+     *
+     * Builds a item selection with one range per row range,
+     * that spans all the columns,
+     * and applies it with a single call to select() .
+     * The selection is merged once, and selectionChanged() is emitted once,
+     * which is much faster than selecting the rows one by one.
+     *
+     * \code
+     * const auto rowSelection = RowSelection::fromRowRangeList(matchingRows);
+     * selectionModel.selectRows(rowSelection, QItemSelectionModel::ClearAndSelect);
+     * \endcode
+     *
+     * Like select(), the selection is not applied
+     * if it is a single item on another row than the current one,
+     * while changing the current row is not allowed.
+     *
+     * \pre a model must have been set
+     * \pre each range in \a rowSelection must be in the rows of the model
+     * \sa itemSelectionFromRowSelection()
+     */
+    void selectRows(const RowSelection & rowSelection, QItemSelectionModel::SelectionFlags command);
+
     /*! \internal Check if current index can be set to the given one
      */
     bool canSetCurrentIndex(const QModelIndex & index) noexcept;
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "KeyedTableDiff.h"
+#include "RowRange.h"
+#include <algorithm>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+namespace{
+
+  /*
+   * Binary indexed (Fenwick) tree,
+   * to count elements before a position in O(log(n))
+   */
+  class CountTree
+  {
+   public:
+
+    explicit CountTree(std::size_t size)
+     : mTree(size + 1, 0)
+    {
+    }
+
+    void add(int position, int value) noexcept
+    {
+      assert( position >= 0 );
+
+      for(std::size_t i = static_cast<std::size_t>(position) + 1; i < mTree.size(); i += i & (~i + 1)){
+        mTree[i] += value;
+      }
+    }
+
+    /*
+     * Sum of the values at positions [0, position]
+     * (0 if position < 0)
+     */
+    int sumUntil(int position) const noexcept
+    {
+      int sum = 0;
+
+      for(std::size_t i = static_cast<std::size_t>(position + 1); i > 0; i -= i & (~i + 1)){
+        sum += mTree[i];
+      }
+
+      return sum;
+    }
+
+   private:
+
+    std::vector<int> mTree;
+  };
+
+  /*
+   * Returns, for each element of sequence, true if it is part of a longest increasing subsequence
+   */
+  std::vector<bool> longestIncreasingSubsequenceFlags(const std::vector<int> & sequence)
+  {
+    const std::size_t size = sequence.size();
+    std::vector<bool> flags(size, false);
+    std::vector<std::size_t> tails;
+    std::vector<std::size_t> previous(size, size);
+
+    for(std::size_t i = 0; i < size; ++i){
+      const auto it = std::lower_bound(tails.begin(), tails.end(), sequence[i], [&sequence](std::size_t index, int value){
+        return sequence[index] < value;
+      });
+      if( it != tails.begin() ){
+        previous[i] = *std::prev(it);
+      }
+      if( it == tails.end() ){
+        tails.push_back(i);
+      }else{
+        *it = i;
+      }
+    }
+
+    if( !tails.empty() ){
+      for(std::size_t i = tails.back(); i != size; i = previous[i]){
+        flags[i] = true;
+      }
+    }
+
+    return flags;
+  }
+
+  bool isNoOpMove(const RowMove & move) noexcept
+  {
+    return (move.destinationRow >= move.sourceRow) && (move.destinationRow <= move.sourceRow + move.count);
+  }
+
+  /*
+   * Appends a single row move,
+   * merging it with the previous one if they move a contiguous block
+   */
+  void appendMove(std::vector<RowMove> & moves, int sourceRow, int destinationRow)
+  {
+    if( !moves.empty() ){
+      RowMove & last = moves.back();
+      const bool movedDown = last.destinationRow > last.sourceRow;
+      const bool follows = movedDown
+                           ? (sourceRow == last.sourceRow) && (destinationRow == last.destinationRow)
+                           : (sourceRow == last.sourceRow + last.count) && (destinationRow == last.destinationRow + last.count);
+      if(follows){
+        ++last.count;
+        if( isNoOpMove(last) ){
+          moves.pop_back();
+        }
+        return;
+      }
+    }
+
+    moves.push_back( {sourceRow, 1, destinationRow} );
+  }
+
+} // namespace{
+
+KeyedTableDiff KeyedTableDiff::fromRowMapping(const std::vector<int> & newRowOfOldRow, int newRowCount, std::vector<int> changedNewRows)
+{
+  assert( newRowCount >= 0 );
+
+  KeyedTableDiff diff;
+
+  /*
+   * Removed rows, and the kept ones in old order
+   */
+  std::vector<int> keptNewRows;
+  std::vector<bool> newRowIsKept(static_cast<std::size_t>(newRowCount), false);
+  for(std::size_t oldRow = 0; oldRow < newRowOfOldRow.size(); ++oldRow){
+    const int newRow = newRowOfOldRow[oldRow];
+    if(newRow < 0){
+      const int row = static_cast<int>(oldRow);
+      diff.mRemovedRows.addRange( RowRange::fromFirstAndLastRow(row, row) );
+    }else{
+      assert( newRow < newRowCount );
+      assert( !newRowIsKept[static_cast<std::size_t>(newRow)] );
+      newRowIsKept[static_cast<std::size_t>(newRow)] = true;
+      keptNewRows.push_back(newRow);
+    }
+  }
+
+  /*
+   * Moves
+   *
+   * The rows of a longest increasing subsequence (LIS) stay in place.
+   * The other ones are moved, by increasing new row,
+   * just after the row that precedes them in the new table.
+   *
+   * A row is stable once it is in its final relative order:
+   * LIS rows, and rows that have already been moved.
+   * The stable rows are always sorted by new row.
+   * A moved row is placed in the group of moved rows
+   * that follows its anchor: the LIS row with the biggest new row less than its own
+   * (or at the beginning if there is none).
+   * Rows that are not yet moved (pending) keep their initial position relative to the LIS rows.
+   *
+   * So, the count of rows before a position can be computed with 3 trees:
+   *  - present: LIS and pending rows, by initial position
+   *  - movedByNewRow: moved rows, by new row
+   *  - movedByAnchor: moved rows, by the initial position of their anchor (shifted by 1, 0 meaning no anchor)
+   */
+  const std::vector<bool> isInLis = longestIncreasingSubsequenceFlags(keptNewRows);
+  std::vector<int> lisNewRows;
+  std::vector<int> lisPositions;
+  std::vector< std::pair<int, int> > rowsToMove; // new row, initial position
+  for(std::size_t position = 0; position < keptNewRows.size(); ++position){
+    if(isInLis[position]){
+      lisNewRows.push_back(keptNewRows[position]);
+      lisPositions.push_back( static_cast<int>(position) );
+    }else{
+      rowsToMove.emplace_back( keptNewRows[position], static_cast<int>(position) );
+    }
+  }
+  std::sort(rowsToMove.begin(), rowsToMove.end());
+
+  CountTree present( keptNewRows.size() );
+  for(std::size_t position = 0; position < keptNewRows.size(); ++position){
+    present.add(static_cast<int>(position), 1);
+  }
+  CountTree movedByNewRow( static_cast<std::size_t>(newRowCount) );
+  CountTree movedByAnchor( keptNewRows.size() + 1 );
+
+  for(const auto & rowToMove : rowsToMove){
+    const int newRow = rowToMove.first;
+    const int position = rowToMove.second;
+
+    const auto lisIt = std::lower_bound(lisNewRows.cbegin(), lisNewRows.cend(), newRow);
+    int anchorPosition = -1;
+    if( lisIt != lisNewRows.cbegin() ){
+      anchorPosition = lisPositions[static_cast<std::size_t>( std::distance(lisNewRows.cbegin(), lisIt) - 1 )];
+    }
+
+    const int sourceRow = present.sumUntil(position - 1) + movedByAnchor.sumUntil(position);
+    const int destinationRow = present.sumUntil(anchorPosition) + movedByNewRow.sumUntil(newRow - 1);
+    if( (destinationRow != sourceRow) && (destinationRow != sourceRow + 1) ){
+      appendMove(diff.mMoves, sourceRow, destinationRow);
+    }
+
+    present.add(position, -1);
+    movedByNewRow.add(newRow, 1);
+    movedByAnchor.add(anchorPosition + 1, 1);
+  }
+
+  /*
+   * Inserted and changed rows
+   */
+  for(int newRow = 0; newRow < newRowCount; ++newRow){
+    if( !newRowIsKept[static_cast<std::size_t>(newRow)] ){
+      diff.mInsertedRows.addRange( RowRange::fromFirstAndLastRow(newRow, newRow) );
+    }
+  }
+  std::sort(changedNewRows.begin(), changedNewRows.end());
+  for(int newRow : changedNewRows){
+    diff.mChangedRows.addRange( RowRange::fromFirstAndLastRow(newRow, newRow) );
+  }
+
+  return diff;
+}
+
+int KeyedTableDiff::affectedRowCount() const noexcept
+{
+  int count = 0;
+
+  for(const RowRange & range : mRemovedRows){
+    count += range.rowCount();
+  }
+  for(const RowMove & move : mMoves){
+    count += move.count;
+  }
+  for(const RowRange & range : mInsertedRows){
+    count += range.rowCount();
+  }
+  for(const RowRange & range : mChangedRows){
+    count += range.rowCount();
+  }
+
+  return count;
+}
+
+}} // namespace Mdt{ namespace ItemModel{
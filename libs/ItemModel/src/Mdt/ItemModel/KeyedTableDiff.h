@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_KEYED_TABLE_DIFF_H
+#define MDT_ITEM_MODEL_KEYED_TABLE_DIFF_H
+
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/NumericLimits.h"
+#include "mdt_itemmodel_export.h"
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Move of rows, with the same meaning than QAbstractItemModel::moveRows()
+   */
+  struct RowMove
+  {
+    int sourceRow;
+    int count;
+    int destinationRow;
+  };
+
+  /*! \brief Operations that transform a table into a other one
+   *
+   * The operations have to be applied in this order:
+   *  1. remove the removedRows() , from the last range to the first one
+   *  2. apply the moves() , in order
+   *  3. insert the insertedRows() , from the first range to the last one
+   *  4. update the changedRows()
+   *
+   * Rows of removedRows() refer to the old table,
+   * rows of moves() refer to the table at the time of the move,
+   * and rows of insertedRows() and changedRows() refer to the new table.
+   *
+   * A diff is created with computeKeyedTableDiff() .
+   *
+   * \sa AbstractTableModel::replaceTableByKey()
+   */
+  class MDT_ITEMMODEL_EXPORT KeyedTableDiff
+  {
+   public:
+
+    /*! \brief Create a diff from a row mapping
+     *
+     * \a newRowOfOldRow gives, for each row of the old table,
+     * the row of the new table that has the same key,
+     * or -1 if the row has been removed.
+     * Each row of the new table must appear at most once.
+     *
+     * \a changedNewRows are the rows of the new table
+     * that have a matching row in the old table, but with different data.
+     *
+     * Moves are computed from the longest increasing subsequence of the kept rows:
+     * the rows of this subsequence stay in place, only the other ones are moved,
+     * so the count of moved rows is minimal.
+     * Moved rows that stay contiguous are moved together.
+     *
+     * Complexity is O(n log(n)).
+     *
+     * \pre \a newRowCount must be >= 0
+     */
+    static
+    KeyedTableDiff fromRowMapping(const std::vector<int> & newRowOfOldRow, int newRowCount, std::vector<int> changedNewRows);
+
+    /*! \brief Get the rows to remove (rows of the old table)
+     */
+    const RowRangeList & removedRows() const noexcept
+    {
+      return mRemovedRows;
+    }
+
+    /*! \brief Get the moves to apply once the rows have been removed
+     */
+    const std::vector<RowMove> & moves() const noexcept
+    {
+      return mMoves;
+    }
+
+    /*! \brief Get the rows to insert (rows of the new table)
+     */
+    const RowRangeList & insertedRows() const noexcept
+    {
+      return mInsertedRows;
+    }
+
+    /*! \brief Get the rows with changed data (rows of the new table)
+     */
+    const RowRangeList & changedRows() const noexcept
+    {
+      return mChangedRows;
+    }
+
+    /*! \brief Check if this diff is empty
+     *
+     * A empty diff means that both tables are the same.
+     */
+    bool isEmpty() const noexcept
+    {
+      return mRemovedRows.isEmpty() && mMoves.empty() && mInsertedRows.isEmpty() && mChangedRows.isEmpty();
+    }
+
+    /*! \brief Get the count of rows removed, moved, inserted or changed
+     */
+    int affectedRowCount() const noexcept;
+
+   private:
+
+    RowRangeList mRemovedRows;
+    std::vector<RowMove> mMoves;
+    RowRangeList mInsertedRows;
+    RowRangeList mChangedRows;
+  };
+
+  /*! \brief Compute the diff between \a oldTable and \a newTable
+   *
+   * Rows are matched by the key returned by \a keyFunction ,
+   * which must be hashable with std::hash .
+   * If a key appears more than once in a table,
+   * only its first occurrence is matched.
+   *
+   * Matched rows for which \a equal returns false are reported as changed.
+   *
+   * \a oldTable and \a newTable must provide size() and operator[]() ,
+   * for example std::vector or ChunkedTable.
+   *
+   * \sa KeyedTableDiff::fromRowMapping()
+   */
+  template<typename OldTable, typename NewTable, typename KeyFunction, typename EqualFunction>
+  KeyedTableDiff computeKeyedTableDiff(const OldTable & oldTable, const NewTable & newTable,
+                                       const KeyFunction & keyFunction, const EqualFunction & equal)
+  {
+    using Key = std::decay_t< decltype( keyFunction( newTable[0] ) ) >;
+
+    assert( oldTable.size() <= static_cast<std::size_t>( intMax() ) );
+    assert( newTable.size() <= static_cast<std::size_t>( intMax() ) );
+
+    const std::size_t oldRowCount = oldTable.size();
+    const std::size_t newRowCount = newTable.size();
+
+    std::unordered_map<Key, int> newRowOfKey;
+    newRowOfKey.reserve(newRowCount);
+    for(std::size_t row = 0; row < newRowCount; ++row){
+      newRowOfKey.emplace( keyFunction( newTable[row] ), static_cast<int>(row) );
+    }
+
+    std::vector<int> newRowOfOldRow(oldRowCount, -1);
+    std::vector<int> changedNewRows;
+    for(std::size_t row = 0; row < oldRowCount; ++row){
+      const auto it = newRowOfKey.find( keyFunction( oldTable[row] ) );
+      if( it == newRowOfKey.end() ){
+        continue;
+      }
+      const int newRow = it->second;
+      newRowOfOldRow[row] = newRow;
+      if( !equal( oldTable[row], newTable[static_cast<std::size_t>(newRow)] ) ){
+        changedNewRows.push_back(newRow);
+      }
+      // Matched only once
+      newRowOfKey.erase(it);
+    }
+
+    return KeyedTableDiff::fromRowMapping( newRowOfOldRow, static_cast<int>(newRowCount), std::move(changedNewRows) );
+  }
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_KEYED_TABLE_DIFF_H
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_MPSC_QUEUE_H
+#define MDT_ITEM_MODEL_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Lock-free multiple producers, single consumer queue
+   *
+   * Any thread can push() values.
+   * Only one thread (the consumer) may call tryPop() .
+   *
+   * push() does not block and never waits for other producers or for the consumer:
+   * it allocates a node and links it with a single atomic exchange.
+   *
+   * A value pushed by a producer can become visible to the consumer a little later
+   * than the return of push() , if a other producer is linking its own value at the same time.
+   * The order of the values pushed by a given producer is preserved.
+   *
+   * \pre \a T must be default constructible and move assignable
+   * \sa TableEditQueue
+   */
+  template<typename T>
+  class MpscQueue
+  {
+    struct Node
+    {
+      std::atomic<Node*> next{nullptr};
+      T value;
+    };
+
+   public:
+
+    /*! \brief Construct a empty queue
+     */
+    MpscQueue()
+     : mHead(new Node),
+       mTail( mHead.load(std::memory_order_relaxed) )
+    {
+    }
+
+    /*! \brief Destroy this queue and the values it still contains
+     *
+     * \pre no producer may push values while this queue is destroyed
+     */
+    ~MpscQueue()
+    {
+      while(mTail != nullptr){
+        Node *next = mTail->next.load(std::memory_order_acquire);
+        delete mTail;
+        mTail = next;
+      }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue & operator=(const MpscQueue &) = delete;
+    MpscQueue(MpscQueue &&) = delete;
+    MpscQueue & operator=(MpscQueue &&) = delete;
+
+    /*! \brief Push \a value to this queue
+     *
+     * Can be called from any thread.
+     */
+    void push(T value)
+    {
+      Node *node = new Node;
+      node->value = std::move(value);
+
+      Node *previous = mHead.exchange(node, std::memory_order_acq_rel);
+      previous->next.store(node, std::memory_order_release);
+    }
+
+    /*! \brief Pop the oldest value of this queue into \a value
+     *
+     * Returns false if this queue is empty.
+     *
+     * Must only be called by the consumer thread.
+     */
+    bool tryPop(T & value)
+    {
+      Node *next = mTail->next.load(std::memory_order_acquire);
+      if(next == nullptr){
+        return false;
+      }
+
+      value = std::move(next->value);
+      delete mTail;
+      mTail = next;
+
+      return true;
+    }
+
+    /*! \brief Check if this queue is empty
+     *
+     * Must only be called by the consumer thread.
+     */
+    bool isEmpty() const noexcept
+    {
+      return mTail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+   private:
+
+    /*
+     * Producers append nodes at the head,
+     * the consumer pops them at the tail.
+     * mTail always points to a node that has already been consumed (initially a stub),
+     * so the queue is never structurally empty.
+     */
+    std::atomic<Node*> mHead;
+    Node *mTail;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_MPSC_QUEUE_H
@@ -0,0 +1,795 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_RING_BUFFER_H
+#define MDT_ITEM_MODEL_RING_BUFFER_H
+
+#include "Mdt/ItemModel/RingBufferIterator.h"
+#include <memory>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <new>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Contiguous part of a RingBuffer
+   *
+   * \sa RingBuffer::firstSegment()
+   * \sa RingBuffer::secondSegment()
+   */
+  template<typename T>
+  struct RingBufferSegment
+  {
+    /*! \brief Pointer to the first element of this segment
+     */
+    T *data = nullptr;
+
+    /*! \brief Count of elements in this segment
+     */
+    std::size_t size = 0;
+
+    /*! \brief Check if this segment is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return size == 0;
+    }
+
+    /*! \brief Get a pointer to the first element of this segment
+     */
+    T *begin() const noexcept
+    {
+      return data;
+    }
+
+    /*! \brief Get a pointer past the last element of this segment
+     */
+    T *end() const noexcept
+    {
+      return data + size;
+    }
+  };
+
+  /*! \brief Random access container with O(1) insertion and removal at both ends
+   *
+   * Storing the rows of a table model in a std::vector
+   * makes prepending a row, or removing the first one, O(n):
+   * all the other rows have to be moved.
+   *
+   * RingBuffer stores its elements in a circular buffer.
+   * Adding or removing elements at the beginning or the end
+   * is O(1) (amortized when the buffer has to grow).
+   * Inserting or removing in the middle moves the elements
+   * of the shortest side, like std::deque .
+   *
+   * Contrary to std::deque, the storage is a single block of memory.
+   * The elements are at most split into 2 contiguous segments,
+   * which can be scanned in a cache friendly way:
+   * \code
+   * RingBuffer<Record> table;
+   *
+   * for( const Record & record : table.firstSegment() ){
+   *   doSomething(record);
+   * }
+   * for( const Record & record : table.secondSegment() ){
+   *   doSomething(record);
+   * }
+   * \endcode
+   *
+   * RingBuffer provides the interface required by the STL helpers,
+   * so it can be used to implement a table model:
+   * \code
+   * void doInsertRows(int row, int count) noexcept override
+   * {
+   *   assert( rowAndCountIsValidForInsertRows(row, count) );
+   *
+   *   insertToStlContainer( mTable, row, count, Record() );
+   * }
+   *
+   * void doRemoveFirstRow() noexcept override
+   * {
+   *   removeFirstFromStlContainer(mTable);
+   * }
+   *
+   * RingBuffer<Record> mTable;
+   * \endcode
+   *
+   * Like std::vector, inserting or removing elements invalidates iterators.
+   *
+   * \sa insertToStlContainer()
+   * \sa removeFromStlContainer()
+   * \sa removeFirstFromStlContainer()
+   * \sa removeLastFromStlContainer()
+   * \sa CappedLogTableModel
+   */
+  template<typename T>
+  class RingBuffer
+  {
+    using Allocator = std::allocator<T>;
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+   public:
+
+    /*! \brief STL value_type
+     */
+    using value_type = T;
+
+    /*! \brief STL size_type
+     */
+    using size_type = std::size_t;
+
+    /*! \brief STL difference_type
+     */
+    using difference_type = std::ptrdiff_t;
+
+    /*! \brief STL reference
+     */
+    using reference = T&;
+
+    /*! \brief STL const_reference
+     */
+    using const_reference = const T&;
+
+    /*! \brief STL pointer
+     */
+    using pointer = T*;
+
+    /*! \brief STL const_pointer
+     */
+    using const_pointer = const T*;
+
+    /*! \brief STL iterator
+     */
+    using iterator = RingBufferIterator<RingBuffer, false>;
+
+    /*! \brief STL const_iterator
+     */
+    using const_iterator = RingBufferIterator<RingBuffer, true>;
+
+    /*! \brief STL reverse_iterator
+     */
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /*! \brief STL const_reverse_iterator
+     */
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /*! \brief Segment of elements
+     */
+    using Segment = RingBufferSegment<T>;
+
+    /*! \brief Segment of const elements
+     */
+    using ConstSegment = RingBufferSegment<const T>;
+
+    /*! \brief Construct a empty ring buffer
+     */
+    RingBuffer() noexcept = default;
+
+    /*! \brief Construct a ring buffer with \a count value-initialized elements
+     */
+    explicit
+    RingBuffer(size_type count)
+    {
+      reserve(count);
+      for(size_type i = 0; i < count; ++i){
+        emplace_back();
+      }
+    }
+
+    /*! \brief Construct a ring buffer with \a count copies of \a value
+     */
+    RingBuffer(size_type count, const T & value)
+    {
+      reserve(count);
+      for(size_type i = 0; i < count; ++i){
+        push_back(value);
+      }
+    }
+
+    /*! \brief Construct a ring buffer from a initializer list
+     */
+    RingBuffer(std::initializer_list<T> list)
+    {
+      reserve( list.size() );
+      for(const T & value : list){
+        push_back(value);
+      }
+    }
+
+    /*! \brief Copy construct a ring buffer from \a other
+     */
+    RingBuffer(const RingBuffer & other)
+    {
+      reserve( other.size() );
+      for(const T & value : other){
+        push_back(value);
+      }
+    }
+
+    /*! \brief Copy assign \a other to this ring buffer
+     */
+    RingBuffer & operator=(const RingBuffer & other)
+    {
+      if(&other != this){
+        RingBuffer copy(other);
+        swap(copy);
+      }
+
+      return *this;
+    }
+
+    /*! \brief Move construct a ring buffer from \a other
+     *
+     * \a other is left empty
+     */
+    RingBuffer(RingBuffer && other) noexcept
+    {
+      swap(other);
+    }
+
+    /*! \brief Move assign \a other to this ring buffer
+     *
+     * \a other is left empty
+     */
+    RingBuffer & operator=(RingBuffer && other) noexcept
+    {
+      if(&other != this){
+        RingBuffer old( std::move(*this) );
+        swap(other);
+      }
+
+      return *this;
+    }
+
+    /*! \brief Destruct this ring buffer
+     */
+    ~RingBuffer() noexcept
+    {
+      clear();
+      deallocate();
+    }
+
+    /*! \brief Swap this ring buffer with \a other
+     */
+    void swap(RingBuffer & other) noexcept
+    {
+      std::swap(mData, other.mData);
+      std::swap(mCapacity, other.mCapacity);
+      std::swap(mFirst, other.mFirst);
+      std::swap(mSize, other.mSize);
+    }
+
+    /*! \brief Get the count of elements in this ring buffer
+     */
+    size_type size() const noexcept
+    {
+      return mSize;
+    }
+
+    /*! \brief Check if this ring buffer is empty
+     */
+    bool empty() const noexcept
+    {
+      return mSize == 0;
+    }
+
+    /*! \brief Get the count of elements this ring buffer can hold without allocating
+     */
+    size_type capacity() const noexcept
+    {
+      return mCapacity;
+    }
+
+    /*! \brief Get the maximum count of elements this ring buffer can hold
+     */
+    size_type max_size() const noexcept
+    {
+      return AllocatorTraits::max_size( Allocator() );
+    }
+
+    /*! \brief Reserve storage for at least \a newCapacity elements
+     *
+     * If \a newCapacity is greater than capacity(),
+     * new storage is allocated and the elements are moved to it,
+     * otherwise this method does nothing.
+     */
+    void reserve(size_type newCapacity)
+    {
+      if(newCapacity > mCapacity){
+        reallocate(newCapacity);
+      }
+    }
+
+    /*! \brief Access the element at \a index
+     *
+     * \pre \a index must be < size()
+     */
+    reference operator[](size_type index) noexcept
+    {
+      assert( index < mSize );
+
+      return mData[physicalIndex(index)];
+    }
+
+    /*! \brief Access the element at \a index
+     *
+     * \pre \a index must be < size()
+     */
+    const_reference operator[](size_type index) const noexcept
+    {
+      assert( index < mSize );
+
+      return mData[physicalIndex(index)];
+    }
+
+    /*! \brief Access the first element
+     *
+     * \pre this ring buffer must not be empty
+     */
+    reference front() noexcept
+    {
+      assert( !empty() );
+
+      return mData[mFirst];
+    }
+
+    /*! \brief Access the first element
+     *
+     * \pre this ring buffer must not be empty
+     */
+    const_reference front() const noexcept
+    {
+      assert( !empty() );
+
+      return mData[mFirst];
+    }
+
+    /*! \brief Access the last element
+     *
+     * \pre this ring buffer must not be empty
+     */
+    reference back() noexcept
+    {
+      assert( !empty() );
+
+      return mData[physicalIndex(mSize - 1)];
+    }
+
+    /*! \brief Access the last element
+     *
+     * \pre this ring buffer must not be empty
+     */
+    const_reference back() const noexcept
+    {
+      assert( !empty() );
+
+      return mData[physicalIndex(mSize - 1)];
+    }
+
+    /*! \brief Get the first contiguous segment of elements
+     *
+     * Starts at the first element.
+     * If the elements do not wrap around the end of the storage,
+     * this segment contains all elements.
+     *
+     * \sa secondSegment()
+     */
+    ConstSegment firstSegment() const noexcept
+    {
+      return ConstSegment{ mData + mFirst, firstSegmentSize() };
+    }
+
+    /*! \brief Get the second contiguous segment of elements
+     *
+     * Contains the elements that wrap around the end of the storage.
+     * It can be empty.
+     *
+     * \sa firstSegment()
+     */
+    ConstSegment secondSegment() const noexcept
+    {
+      return ConstSegment{ mData, mSize - firstSegmentSize() };
+    }
+
+    /*! \brief Get the first contiguous segment of elements
+     *
+     * \sa firstSegment() const
+     */
+    Segment firstSegment() noexcept
+    {
+      return Segment{ mData + mFirst, firstSegmentSize() };
+    }
+
+    /*! \brief Get the second contiguous segment of elements
+     *
+     * \sa secondSegment() const
+     */
+    Segment secondSegment() noexcept
+    {
+      return Segment{ mData, mSize - firstSegmentSize() };
+    }
+
+    /*! \brief Get a iterator to the first element
+     */
+    iterator begin() noexcept
+    {
+      return iterator(this, 0);
+    }
+
+    /*! \brief Get a iterator past the last element
+     */
+    iterator end() noexcept
+    {
+      return iterator( this, static_cast<difference_type>(mSize) );
+    }
+
+    /*! \brief Get a const iterator to the first element
+     */
+    const_iterator begin() const noexcept
+    {
+      return cbegin();
+    }
+
+    /*! \brief Get a const iterator past the last element
+     */
+    const_iterator end() const noexcept
+    {
+      return cend();
+    }
+
+    /*! \brief Get a const iterator to the first element
+     */
+    const_iterator cbegin() const noexcept
+    {
+      return const_iterator(this, 0);
+    }
+
+    /*! \brief Get a const iterator past the last element
+     */
+    const_iterator cend() const noexcept
+    {
+      return const_iterator( this, static_cast<difference_type>(mSize) );
+    }
+
+    /*! \brief Get a reverse iterator to the last element
+     */
+    reverse_iterator rbegin() noexcept
+    {
+      return reverse_iterator( end() );
+    }
+
+    /*! \brief Get a reverse iterator before the first element
+     */
+    reverse_iterator rend() noexcept
+    {
+      return reverse_iterator( begin() );
+    }
+
+    /*! \brief Get a const reverse iterator to the last element
+     */
+    const_reverse_iterator crbegin() const noexcept
+    {
+      return const_reverse_iterator( cend() );
+    }
+
+    /*! \brief Get a const reverse iterator before the first element
+     */
+    const_reverse_iterator crend() const noexcept
+    {
+      return const_reverse_iterator( cbegin() );
+    }
+
+    /*! \brief Construct a element at the end
+     */
+    template<typename...Args>
+    reference emplace_back(Args &&...args)
+    {
+      if(mSize == mCapacity){
+        /*
+         * args could refer to a element of this buffer,
+         * which will be moved by reallocate()
+         */
+        T value( std::forward<Args>(args)... );
+        reallocate( grownCapacity(mSize + 1) );
+        return emplace_back( std::move(value) );
+      }
+
+      const size_type index = physicalIndex(mSize);
+      ::new( static_cast<void*>(mData + index) ) T( std::forward<Args>(args)... );
+      ++mSize;
+
+      return mData[index];
+    }
+
+    /*! \brief Add a copy of \a value to the end
+     */
+    void push_back(const T & value)
+    {
+      emplace_back(value);
+    }
+
+    /*! \brief Move \a value to the end
+     */
+    void push_back(T && value)
+    {
+      emplace_back( std::move(value) );
+    }
+
+    /*! \brief Construct a element at the beginning
+     */
+    template<typename...Args>
+    reference emplace_front(Args &&...args)
+    {
+      if(mSize == mCapacity){
+        T value( std::forward<Args>(args)... );
+        reallocate( grownCapacity(mSize + 1) );
+        return emplace_front( std::move(value) );
+      }
+
+      const size_type index = (mFirst == 0) ? (mCapacity - 1) : (mFirst - 1);
+      ::new( static_cast<void*>(mData + index) ) T( std::forward<Args>(args)... );
+      mFirst = index;
+      ++mSize;
+
+      return mData[index];
+    }
+
+    /*! \brief Add a copy of \a value to the beginning
+     */
+    void push_front(const T & value)
+    {
+      emplace_front(value);
+    }
+
+    /*! \brief Move \a value to the beginning
+     */
+    void push_front(T && value)
+    {
+      emplace_front( std::move(value) );
+    }
+
+    /*! \brief Remove the first element
+     *
+     * \pre this ring buffer must not be empty
+     */
+    void pop_front() noexcept
+    {
+      assert( !empty() );
+
+      destroy(mFirst);
+      mFirst = physicalIndex(1);
+      --mSize;
+    }
+
+    /*! \brief Remove the last element
+     *
+     * \pre this ring buffer must not be empty
+     */
+    void pop_back() noexcept
+    {
+      assert( !empty() );
+
+      destroy( physicalIndex(mSize - 1) );
+      --mSize;
+    }
+
+    /*! \brief Insert a copy of \a value before \a pos
+     *
+     * Returns a iterator to the inserted element.
+     */
+    iterator insert(const_iterator pos, const T & value)
+    {
+      return insert(pos, 1, value);
+    }
+
+    /*! \brief Insert \a count copies of \a value before \a pos
+     *
+     * The elements before or after \a pos are moved,
+     * whichever is the shortest.
+     *
+     * Returns a iterator to the first inserted element,
+     * or \a pos if \a count is 0.
+     */
+    iterator insert(const_iterator pos, size_type count, const T & value)
+    {
+      assert( pos >= cbegin() );
+      assert( pos <= cend() );
+
+      const auto index = pos.index();
+      const auto dCount = static_cast<difference_type>(count);
+      if(count == 0){
+        return begin() + index;
+      }
+
+      // value could refer to a element of this buffer
+      const T copy(value);
+      if(mSize + count > mCapacity){
+        reallocate( grownCapacity(mSize + count) );
+      }
+
+      const auto elementsAfter = static_cast<difference_type>(mSize) - index;
+      if(index < elementsAfter){
+        for(size_type i = 0; i < count; ++i){
+          emplace_front(copy);
+        }
+        std::rotate( begin(), begin() + dCount, begin() + dCount + index );
+      }else{
+        const auto oldSize = static_cast<difference_type>(mSize);
+        for(size_type i = 0; i < count; ++i){
+          emplace_back(copy);
+        }
+        std::rotate( begin() + index, begin() + oldSize, end() );
+      }
+
+      return begin() + index;
+    }
+
+    /*! \brief Remove the element at \a pos
+     *
+     * \pre \a pos must be dereferencable
+     */
+    iterator erase(const_iterator pos)
+    {
+      assert( pos >= cbegin() );
+      assert( pos < cend() );
+
+      return erase(pos, pos + 1);
+    }
+
+    /*! \brief Remove the elements in the range [ \a first , \a last )
+     *
+     * The elements before or after the range are moved,
+     * whichever is the shortest.
+     *
+     * Returns a iterator to the element that follows the last removed one.
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+      assert( first >= cbegin() );
+      assert( first <= last );
+      assert( last <= cend() );
+
+      const auto index = first.index();
+      const auto dCount = last - first;
+      const auto count = static_cast<size_type>(dCount);
+      const auto elementsAfter = static_cast<difference_type>(mSize) - index - dCount;
+
+      if(index < elementsAfter){
+        std::move_backward( begin(), begin() + index, begin() + index + dCount );
+        for(size_type i = 0; i < count; ++i){
+          pop_front();
+        }
+      }else{
+        std::move( begin() + index + dCount, end(), begin() + index );
+        for(size_type i = 0; i < count; ++i){
+          pop_back();
+        }
+      }
+
+      return begin() + index;
+    }
+
+    /*! \brief Remove all elements
+     *
+     * The storage is not released.
+     */
+    void clear() noexcept
+    {
+      while( !empty() ){
+        pop_back();
+      }
+      mFirst = 0;
+    }
+
+    /*! \brief Check if \a a and \a b contain equal elements
+     */
+    friend
+    bool operator==(const RingBuffer & a, const RingBuffer & b)
+    {
+      if( a.size() != b.size() ){
+        return false;
+      }
+
+      return std::equal( a.cbegin(), a.cend(), b.cbegin() );
+    }
+
+    /*! \brief Check if \a a and \a b do not contain equal elements
+     */
+    friend
+    bool operator!=(const RingBuffer & a, const RingBuffer & b)
+    {
+      return !(a == b);
+    }
+
+   private:
+
+    size_type physicalIndex(size_type logicalIndex) const noexcept
+    {
+      assert( logicalIndex <= mCapacity );
+
+      const size_type index = mFirst + logicalIndex;
+      if(index >= mCapacity){
+        return index - mCapacity;
+      }
+
+      return index;
+    }
+
+    size_type firstSegmentSize() const noexcept
+    {
+      return std::min(mSize, mCapacity - mFirst);
+    }
+
+    size_type grownCapacity(size_type requiredCapacity) const noexcept
+    {
+      return std::max( {requiredCapacity, 2*mCapacity, size_type(8)} );
+    }
+
+    void destroy(size_type index) noexcept
+    {
+      assert( index < mCapacity );
+
+      mData[index].~T();
+    }
+
+    void reallocate(size_type newCapacity)
+    {
+      assert( newCapacity >= mSize );
+
+      Allocator allocator;
+      T *newData = AllocatorTraits::allocate(allocator, newCapacity);
+
+      // If a element can not be moved without throwing, it is copied, so this buffer stays untouched
+      size_type constructedCount = 0;
+      try{
+        for(; constructedCount < mSize; ++constructedCount){
+          T & element = mData[physicalIndex(constructedCount)];
+          ::new( static_cast<void*>(newData + constructedCount) ) T( std::move_if_noexcept(element) );
+        }
+      }catch(...){
+        for(size_type i = 0; i < constructedCount; ++i){
+          newData[i].~T();
+        }
+        AllocatorTraits::deallocate(allocator, newData, newCapacity);
+        throw;
+      }
+
+      for(size_type i = 0; i < mSize; ++i){
+        destroy( physicalIndex(i) );
+      }
+      deallocate();
+      mData = newData;
+      mCapacity = newCapacity;
+      mFirst = 0;
+    }
+
+    void deallocate() noexcept
+    {
+      if(mData != nullptr){
+        Allocator allocator;
+        AllocatorTraits::deallocate(allocator, mData, mCapacity);
+        mData = nullptr;
+        mCapacity = 0;
+      }
+    }
+
+    T *mData = nullptr;
+    size_type mCapacity = 0;
+    size_type mFirst = 0;
+    size_type mSize = 0;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_RING_BUFFER_H
@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_RING_BUFFER_ITERATOR_H
+#define MDT_ITEM_MODEL_RING_BUFFER_ITERATOR_H
+
+#include <iterator>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Random access iterator for RingBuffer
+   *
+   * The iterator refers to a logical position in the ring buffer
+   * (0 is the first element, regardless where it is stored).
+   *
+   * \sa RingBuffer
+   */
+  template<typename Buffer, bool IsConst>
+  class RingBufferIterator
+  {
+    using BufferPointer = std::conditional_t<IsConst, const Buffer*, Buffer*>;
+
+    template<typename OtherBuffer, bool OtherIsConst>
+    friend class RingBufferIterator;
+
+   public:
+
+    /*! \brief STL iterator value_type
+     */
+    using value_type = typename Buffer::value_type;
+
+    /*! \brief STL iterator difference_type
+     */
+    using difference_type = std::ptrdiff_t;
+
+    /*! \brief STL iterator reference
+     */
+    using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    /*! \brief STL iterator pointer
+     */
+    using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+    /*! \brief STL iterator iterator_category
+     */
+    using iterator_category = std::random_access_iterator_tag;
+
+    /*! \brief Construct a null iterator
+     */
+    constexpr
+    RingBufferIterator() noexcept = default;
+
+    /*! \brief Construct a iterator that refers to \a index in \a buffer
+     */
+    constexpr
+    RingBufferIterator(BufferPointer buffer, difference_type index) noexcept
+     : mBuffer(buffer),
+       mIndex(index)
+    {
+    }
+
+    /*! \brief Construct a const iterator from a non const one
+     */
+    template<bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+    constexpr
+    RingBufferIterator(const RingBufferIterator<Buffer, OtherIsConst> & other) noexcept
+     : mBuffer(other.mBuffer),
+       mIndex(other.mIndex)
+    {
+    }
+
+    /*! \brief Get the logical index this iterator refers to
+     */
+    constexpr
+    difference_type index() const noexcept
+    {
+      return mIndex;
+    }
+
+    /*! \brief Get the element this iterator refers to
+     *
+     * \pre this iterator must be dereferencable
+     */
+    reference operator*() const noexcept
+    {
+      assert( mBuffer != nullptr );
+      assert( mIndex >= 0 );
+
+      return (*mBuffer)[static_cast<typename Buffer::size_type>(mIndex)];
+    }
+
+    /*! \brief Access a member of the element this iterator refers to
+     *
+     * \pre this iterator must be dereferencable
+     */
+    pointer operator->() const noexcept
+    {
+      return &operator*();
+    }
+
+    /*! \brief Get the element at \a n positions from this iterator
+     */
+    reference operator[](difference_type n) const noexcept
+    {
+      return *(*this + n);
+    }
+
+    /*! \brief Increment this iterator (pre-increment)
+     */
+    RingBufferIterator & operator++() noexcept
+    {
+      ++mIndex;
+      return *this;
+    }
+
+    /*! \brief Increment this iterator (post-increment)
+     */
+    RingBufferIterator operator++(int) noexcept
+    {
+      RingBufferIterator old = *this;
+      ++mIndex;
+      return old;
+    }
+
+    /*! \brief Decrement this iterator (pre-decrement)
+     */
+    RingBufferIterator & operator--() noexcept
+    {
+      --mIndex;
+      return *this;
+    }
+
+    /*! \brief Decrement this iterator (post-decrement)
+     */
+    RingBufferIterator operator--(int) noexcept
+    {
+      RingBufferIterator old = *this;
+      --mIndex;
+      return old;
+    }
+
+    /*! \brief Advance this iterator by \a n
+     */
+    RingBufferIterator & operator+=(difference_type n) noexcept
+    {
+      mIndex += n;
+      return *this;
+    }
+
+    /*! \brief Move back this iterator by \a n
+     */
+    RingBufferIterator & operator-=(difference_type n) noexcept
+    {
+      mIndex -= n;
+      return *this;
+    }
+
+    /*! \brief Get a iterator that is \a n positions after \a it
+     */
+    friend
+    RingBufferIterator operator+(RingBufferIterator it, difference_type n) noexcept
+    {
+      it += n;
+      return it;
+    }
+
+    /*! \brief Get a iterator that is \a n positions after \a it
+     */
+    friend
+    RingBufferIterator operator+(difference_type n, RingBufferIterator it) noexcept
+    {
+      it += n;
+      return it;
+    }
+
+    /*! \brief Get a iterator that is \a n positions before \a it
+     */
+    friend
+    RingBufferIterator operator-(RingBufferIterator it, difference_type n) noexcept
+    {
+      it -= n;
+      return it;
+    }
+
+    /*! \brief Get the distance between \a a and \a b
+     *
+     * \pre \a a and \a b must refer to the same ring buffer
+     */
+    friend
+    difference_type operator-(const RingBufferIterator & a, const RingBufferIterator & b) noexcept
+    {
+      assert( a.mBuffer == b.mBuffer );
+
+      return a.mIndex - b.mIndex;
+    }
+
+    /*! \brief Check if iterators \a a and \a b are equal
+     */
+    friend
+    bool operator==(const RingBufferIterator & a, const RingBufferIterator & b) noexcept
+    {
+      return (a.mBuffer == b.mBuffer) && (a.mIndex == b.mIndex);
+    }
+
+    /*! \brief Check if iterators \a a and \a b are not equal
+     */
+    friend
+    bool operator!=(const RingBufferIterator & a, const RingBufferIterator & b) noexcept
+    {
+      return !(a == b);
+    }
+
+    /*! \brief Check if \a a is before \a b
+     */
+    friend
+    bool operator<(const RingBufferIterator & a, const RingBufferIterator & b) noexcept
+    {
+      assert( a.mBuffer == b.mBuffer );
+
+      return a.mIndex < b.mIndex;
+    }
+
+    /*! \brief Check if \a a is after \a b
+     */
+    friend
+    bool operator>(const RingBufferIterator & a, const RingBufferIterator & b) noexcept
+    {
+      return b < a;
+    }
+
+    /*! \brief Check if \a a is before or equal to \a b
+     */
+    friend
+    bool operator<=(const RingBufferIterator & a, const RingBufferIterator & b) noexcept
+    {
+      return !(b < a);
+    }
+
+    /*! \brief Check if \a a is after or equal to \a b
+     */
+    friend
+    bool operator>=(const RingBufferIterator & a, const RingBufferIterator & b) noexcept
+    {
+      return !(a < b);
+    }
+
+   private:
+
+    BufferPointer mBuffer = nullptr;
+    difference_type mIndex = 0;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_RING_BUFFER_ITERATOR_H
@@ -13,6 +13,7 @@
 #include "Mdt/ItemModel/RowRangeListDef.h"
 #include "Mdt/ItemModel/RowRange.h"
 #include "mdt_itemmodel_export.h"
+#include <memory_resource>
 #include <cassert>
 
 namespace Mdt{ namespace ItemModel{
@@ -22,6 +23,21 @@ namespace Mdt{ namespace ItemModel{
    * As an example, the list {[0,2],[5,10]}
    * represents the rows {0,1,2,5,6,7,8,9,10}.
    *
+   * The first ranges are stored inline, without allocating.
+   * When more ranges are added, they are allocated from a memory resource,
+   * which is by default std::pmr::get_default_resource() .
+   * A handler that builds many temporary lists can pass a arena,
+   * for example a std::pmr::monotonic_buffer_resource ,
+   * that is released at once:
+   * \code
+   * std::pmr::monotonic_buffer_resource arena;
+   * RowRangeList list(&arena);
+   * \endcode
+   *
+   * Like for the std::pmr containers, the memory resource is not propagated:
+   * a copy uses the default resource, unless an other one is given,
+   * and assigning a list keeps the resource of the assigned one.
+   *
    * \sa RowSelection
    * \sa RowRange
    */
@@ -41,6 +57,40 @@ namespace Mdt{ namespace ItemModel{
      */
     using const_reverse_iterator = RowRangeListContainer::const_reverse_iterator;
 
+    /*! \brief Construct a empty list that allocates from the default memory resource
+     */
+    RowRangeList() noexcept = default;
+
+    /*! \brief Construct a empty list that allocates from \a resource
+     *
+     * \pre \a resource must be a valid pointer
+     * \pre \a resource must outlive this list
+     */
+    explicit
+    RowRangeList(std::pmr::memory_resource *resource) noexcept
+     : mList( RowRangeListAllocator(resource) )
+    {
+      assert( resource != nullptr );
+    }
+
+    /*! \brief Construct a copy of \a other that allocates from \a resource
+     *
+     * \pre \a resource must be a valid pointer
+     * \pre \a resource must outlive this list
+     */
+    RowRangeList(const RowRangeList & other, std::pmr::memory_resource *resource)
+     : mList( other.mList, RowRangeListAllocator(resource) )
+    {
+      assert( resource != nullptr );
+    }
+
+    /*! \brief Get the memory resource this list allocates from
+     */
+    std::pmr::memory_resource *memoryResource() const noexcept
+    {
+      return mList.get_allocator().resource();
+    }
+
     /*! \brief Check if this list is empty
      */
     bool isEmpty() const noexcept
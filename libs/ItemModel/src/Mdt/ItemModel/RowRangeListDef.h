@@ -11,8 +11,10 @@
 #define MDT_ITEM_MODEL_ROW_RANGE_LIST_DEF_H
 
 #include "Mdt/ItemModel/RowRange.h"
+#include "Mdt/ItemModel/SmallVector.h"
 #include <QtGlobal>
-#include <vector>
+#include <memory_resource>
+#include <cstddef>
 
 #ifdef Q_CC_MSVC
   #pragma warning( push )
@@ -21,9 +23,19 @@
 
 namespace Mdt{ namespace ItemModel{
 
+  /*! \internal Count of ranges a RowRangeList holds without allocating
+   *
+   * Most selections are made of a few ranges.
+   */
+  constexpr std::size_t rowRangeListInlineCapacity = 4;
+
+  /*! \internal
+   */
+  using RowRangeListAllocator = std::pmr::polymorphic_allocator<RowRange>;
+
   /*! \internal
    */
-  using RowRangeListContainer = std::vector<RowRange>;
+  using RowRangeListContainer = SmallVector<RowRange, rowRangeListInlineCapacity, RowRangeListAllocator>;
 
   /*! \internal
    */
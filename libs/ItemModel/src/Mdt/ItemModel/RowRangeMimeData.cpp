@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "RowRangeMimeData.h"
+#include "RowRangeList.h"
+#include "RowRange.h"
+#include "TableExport.h"
+#include <QBuffer>
+#include <QDataStream>
+#include <QIODevice>
+#include <iterator>
+#include <algorithm>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+namespace{
+
+  constexpr qint32 rowRangesEncodingVersion = 1;
+
+  QString textPlainMimeType()
+  {
+    return QStringLiteral("text/plain");
+  }
+
+  QString textCsvMimeType()
+  {
+    return QStringLiteral("text/csv");
+  }
+
+} // namespace{
+
+RowRangeMimeData::RowRangeMimeData(const QAbstractItemModel & model, const RowSelection & selection, const std::vector<int> & columns)
+ : QMimeData(),
+   mModel(&model),
+   mSelection(selection),
+   mColumns(columns)
+{
+  connect(&model, &QAbstractItemModel::rowsAboutToBeInserted, this, &RowRangeMimeData::takeSnapshot);
+  connect(&model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &RowRangeMimeData::takeSnapshot);
+  connect(&model, &QAbstractItemModel::rowsAboutToBeMoved, this, &RowRangeMimeData::takeSnapshot);
+  connect(&model, &QAbstractItemModel::modelAboutToBeReset, this, &RowRangeMimeData::takeSnapshot);
+  connect(&model, &QAbstractItemModel::layoutAboutToBeChanged, this, &RowRangeMimeData::takeSnapshot);
+}
+
+QStringList RowRangeMimeData::formats() const
+{
+  if( refersToCurrentRows() ){
+    return QStringList{rowRangesMimeType(), textPlainMimeType(), textCsvMimeType()};
+  }
+
+  return QStringList{textPlainMimeType(), textCsvMimeType()};
+}
+
+QString RowRangeMimeData::rowRangesMimeType()
+{
+  return QStringLiteral("application/x-mdt-itemmodel-rowranges");
+}
+
+QByteArray RowRangeMimeData::encodeRowRanges(const RowSelection & selection, const std::vector<int> & columns)
+{
+  QByteArray data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_5_0);
+
+  stream << rowRangesEncodingVersion;
+  stream << static_cast<qint32>( columns.size() );
+  for(const int column : columns){
+    stream << static_cast<qint32>(column);
+  }
+  stream << static_cast<qint32>( selection.rangeCount() );
+  for(const RowRange & range : selection){
+    stream << static_cast<qint32>( range.firstRow() ) << static_cast<qint32>( range.lastRow() );
+  }
+
+  return data;
+}
+
+bool RowRangeMimeData::decodeRowRanges(const QByteArray & data, RowSelection & selection, std::vector<int> & columns)
+{
+  QDataStream stream(data);
+  stream.setVersion(QDataStream::Qt_5_0);
+
+  qint32 version = 0;
+  stream >> version;
+  if(version != rowRangesEncodingVersion){
+    return false;
+  }
+
+  qint32 columnCount = 0;
+  stream >> columnCount;
+  if(columnCount < 0){
+    return false;
+  }
+  columns.clear();
+  for(qint32 i = 0; i < columnCount; ++i){
+    qint32 column = -1;
+    stream >> column;
+    if( (stream.status() != QDataStream::Ok) || (column < 0) ){
+      return false;
+    }
+    columns.push_back(column);
+  }
+
+  qint32 rangeCount = 0;
+  stream >> rangeCount;
+  if(rangeCount < 0){
+    return false;
+  }
+  RowRangeList rowRangeList;
+  for(qint32 i = 0; i < rangeCount; ++i){
+    qint32 firstRow = -1;
+    qint32 lastRow = -1;
+    stream >> firstRow >> lastRow;
+    if( (stream.status() != QDataStream::Ok) || (firstRow < 0) || (lastRow < firstRow) ){
+      return false;
+    }
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow(firstRow, lastRow) );
+  }
+  if(stream.status() != QDataStream::Ok){
+    return false;
+  }
+  selection = RowSelection::fromRowRangeList(rowRangeList);
+
+  return true;
+}
+
+QVariant RowRangeMimeData::retrieveData(const QString & mimeType, QVariant::Type preferredType) const
+{
+  if( mimeType == rowRangesMimeType() ){
+    if( !refersToCurrentRows() ){
+      return QVariant();
+    }
+    return encodeRowRanges(mSelection, mColumns);
+  }
+  if( mimeType == textPlainMimeType() ){
+    const QByteArray text = mIsSnapshot ? mTsvText : exportText(DelimitedTextFormat::Tsv);
+    if(preferredType == QVariant::String){
+      return QString::fromUtf8(text);
+    }
+    return text;
+  }
+  if( mimeType == textCsvMimeType() ){
+    if(mIsSnapshot){
+      return mCsvText;
+    }
+    return exportText(DelimitedTextFormat::Csv);
+  }
+
+  return QMimeData::retrieveData(mimeType, preferredType);
+}
+
+void RowRangeMimeData::takeSnapshot()
+{
+  assert( !mIsSnapshot );
+
+  mTsvText = exportText(DelimitedTextFormat::Tsv);
+  mCsvText = exportText(DelimitedTextFormat::Csv);
+  mIsSnapshot = true;
+  disconnect(mModel.data(), nullptr, this, nullptr);
+}
+
+QByteArray RowRangeMimeData::exportText(DelimitedTextFormat format) const
+{
+  QByteArray text;
+  if( mModel.isNull() ){
+    return text;
+  }
+  const QAbstractItemModel & model = *mModel;
+
+  /*
+   * A model that does not signal its changes
+   * could have less rows or columns than when this mime data was created
+   */
+  const int rowCount = model.rowCount();
+  RowRangeList rowRangeList;
+  for(const RowRange & range : mSelection){
+    if(range.firstRow() >= rowCount){
+      break;
+    }
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow( range.firstRow(), std::min(range.lastRow(), rowCount - 1) ) );
+  }
+  const int columnCount = model.columnCount();
+  std::vector<int> columns;
+  std::copy_if( mColumns.cbegin(), mColumns.cend(), std::back_inserter(columns), [columnCount](int column){
+    return (column >= 0) && (column < columnCount);
+  });
+
+  QBuffer buffer(&text);
+  buffer.open(QIODevice::WriteOnly);
+  DelimitedTextWriter writer(buffer, format);
+  exportModel( model, RowSelection::fromRowRangeList(rowRangeList), columns, writer );
+  writer.flush();
+
+  return text;
+}
+
+}} // namespace Mdt{ namespace ItemModel{
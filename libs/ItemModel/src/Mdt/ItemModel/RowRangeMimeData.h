@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_ROW_RANGE_MIME_DATA_H
+#define MDT_ITEM_MODEL_ROW_RANGE_MIME_DATA_H
+
+#include "Mdt/ItemModel/RowSelection.h"
+#include "Mdt/ItemModel/DelimitedTextWriter.h"
+#include "mdt_itemmodel_export.h"
+#include <QMimeData>
+#include <QAbstractItemModel>
+#include <QPointer>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Mime data that refers to ranges of rows of a model
+   *
+   * Instead of encoding each index, like QAbstractItemModel::mimeData() does,
+   * RowRangeMimeData holds a RowSelection and a list of columns,
+   * so its size does not depend on the count of selected rows.
+   *
+   * The payload is only produced when a format is requested,
+   * for example when the data is dropped in a other application,
+   * or pasted from the clipboard:
+   *  - rowRangesMimeType() : the row ranges and the columns, see encodeRowRanges()
+   *  - text/plain : the selected cells as TSV (what spreadsheets expect when pasting)
+   *  - text/csv : the selected cells as CSV
+   *
+   * The text is get from the model at the time it is requested,
+   * with exportModel() .
+   * So, the values are the ones of the model when the data is pasted or dropped,
+   * not when it was copied or dragged:
+   * a cell edited after a copy to the clipboard is pasted with its new value.
+   * Qt signals a change of data only once it is done (dataChanged() ),
+   * so the previous value can not be kept.
+   *
+   * If rows of the model are about to be inserted, removed or moved,
+   * or the model is about to be reset or to change its layout,
+   * the row ranges would no longer refer to the same rows.
+   * So, the text is exported just before that change,
+   * and the row ranges are no longer provided (see refersToCurrentRows() ).
+   * From then on, the values no longer follow the model.
+   * No text is produced if the model has been destroyed.
+   *
+   * \sa AbstractTableModel::mimeData()
+   * \sa AbstractTableModel::dropMimeData()
+   */
+  class MDT_ITEMMODEL_EXPORT RowRangeMimeData : public QMimeData
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Construct mime data that refers to the rows of \a selection and the \a columns of \a model
+     */
+    RowRangeMimeData(const QAbstractItemModel & model, const RowSelection & selection, const std::vector<int> & columns);
+
+    /*! \brief Get the model the rows belong to
+     *
+     * Returns a nullptr if the model has been destroyed.
+     */
+    const QAbstractItemModel *sourceModel() const noexcept
+    {
+      return mModel.data();
+    }
+
+    /*! \brief Get the selected rows
+     */
+    const RowSelection & rowSelection() const noexcept
+    {
+      return mSelection;
+    }
+
+    /*! \brief Get the selected columns
+     */
+    const std::vector<int> & columns() const noexcept
+    {
+      return mColumns;
+    }
+
+    /*! \brief Check if the row ranges refer to the current rows of the model
+     *
+     * Returns false once the rows of the model have been inserted, removed or moved,
+     * or the model has been reset or has changed its layout,
+     * or if the model has been destroyed.
+     */
+    bool refersToCurrentRows() const noexcept
+    {
+      return !mIsSnapshot && !mModel.isNull();
+    }
+
+    /*! \brief Get the formats this mime data can provide
+     *
+     * rowRangesMimeType() is only provided while refersToCurrentRows() returns true.
+     */
+    QStringList formats() const override;
+
+    /*! \brief Get the mime type of the row ranges
+     */
+    static
+    QString rowRangesMimeType();
+
+    /*! \brief Encode \a selection and \a columns
+     *
+     * The encoding uses a few bytes per range,
+     * whatever the count of rows in each range is.
+     *
+     * \sa decodeRowRanges()
+     */
+    static
+    QByteArray encodeRowRanges(const RowSelection & selection, const std::vector<int> & columns);
+
+    /*! \brief Decode row ranges encoded with encodeRowRanges()
+     *
+     * Returns false if \a data is not a valid encoding.
+     */
+    static
+    bool decodeRowRanges(const QByteArray & data, RowSelection & selection, std::vector<int> & columns);
+
+   protected:
+
+    QVariant retrieveData(const QString & mimeType, QVariant::Type preferredType) const override;
+
+   private:
+
+    void takeSnapshot();
+    QByteArray exportText(DelimitedTextFormat format) const;
+
+    QPointer<const QAbstractItemModel> mModel;
+    RowSelection mSelection;
+    std::vector<int> mColumns;
+    bool mIsSnapshot = false;
+    QByteArray mTsvText;
+    QByteArray mCsvText;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_ROW_RANGE_MIME_DATA_H
@@ -10,12 +10,16 @@
 #include "RowSelection.h"
 #include "RowSelectionHelpers.h"
 #include <QItemSelectionRange>
+#include <QModelIndex>
+#include <vector>
+#include <iterator>
+#include <algorithm>
 
 namespace Mdt{ namespace ItemModel{
 
-RowSelection RowSelection::fromItemSelection(const QItemSelection & itemSelection) noexcept
+RowSelection RowSelection::fromItemSelection(const QItemSelection & itemSelection, std::pmr::memory_resource *resource) noexcept
 {
-  RowSelection rowSelection;
+  RowSelection rowSelection(resource);
 
   for(const QItemSelectionRange & itemRange : itemSelection){
     rowSelection.mRowRangeList.addRange( rowRangeFromItemSelectionRange(itemRange) );
@@ -24,4 +28,31 @@ RowSelection RowSelection::fromItemSelection(const QItemSelection & itemSelectio
   return rowSelection;
 }
 
+RowSelection RowSelection::fromModelIndexList(const QModelIndexList & indexes, std::pmr::memory_resource *resource)
+{
+  RowSelection rowSelection(resource);
+
+  std::pmr::vector<int> rows(resource);
+  rows.reserve( static_cast<std::size_t>( indexes.size() ) );
+  for(const QModelIndex & index : indexes){
+    if( index.isValid() ){
+      rows.push_back( index.row() );
+    }
+  }
+  std::sort( rows.begin(), rows.end() );
+  rows.erase( std::unique( rows.begin(), rows.end() ), rows.end() );
+
+  auto first = rows.cbegin();
+  while( first != rows.cend() ){
+    auto last = first;
+    while( ( std::next(last) != rows.cend() ) && ( *std::next(last) == *last + 1 ) ){
+      ++last;
+    }
+    rowSelection.mRowRangeList.addRange( RowRange::fromFirstAndLastRow(*first, *last) );
+    first = std::next(last);
+  }
+
+  return rowSelection;
+}
+
 }} // namespace Mdt{ namespace ItemModel{
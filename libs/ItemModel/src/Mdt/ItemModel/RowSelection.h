@@ -14,6 +14,8 @@
 #include "Mdt/ItemModel/RowRangeList.h"
 #include "mdt_itemmodel_export.h"
 #include <QItemSelection>
+#include <QModelIndexList>
+#include <memory_resource>
 #include <cassert>
 
 namespace Mdt{ namespace ItemModel{
@@ -76,6 +78,13 @@ namespace Mdt{ namespace ItemModel{
    * }
    * \endcode
    *
+   * Like RowRangeList, a row selection can allocate from a memory resource,
+   * for example a arena that is released after a event has been handled:
+   * \code
+   * std::pmr::monotonic_buffer_resource arena;
+   * const auto rowSelection = RowSelection::fromItemSelection(itemSelection, &arena);
+   * \endcode
+   *
    * \sa Mdt::ItemModel::removeSelectedRows()
    * \sa Mdt::ItemView::removeSelectedRows()
    * \sa RowListView
@@ -118,6 +127,25 @@ namespace Mdt{ namespace ItemModel{
      */
     RowSelection & operator=(RowSelection && other) noexcept = default;
 
+    /*! \brief Construct an empty row selection that allocates from \a resource
+     *
+     * \pre \a resource must be a valid pointer
+     * \pre \a resource must outlive this row selection
+     * \sa RowRangeList
+     */
+    explicit
+    RowSelection(std::pmr::memory_resource *resource) noexcept
+     : mRowRangeList(resource)
+    {
+    }
+
+    /*! \brief Get the memory resource this row selection allocates from
+     */
+    std::pmr::memory_resource *memoryResource() const noexcept
+    {
+      return mRowRangeList.memoryResource();
+    }
+
     /*! \brief Check if this selection is empty
      */
     bool isEmpty() const noexcept
@@ -226,9 +254,39 @@ namespace Mdt{ namespace ItemModel{
      * |S| |S|
      * |S| | |
      * represents 2 ranges of rows: [0,1] and [3,5]
+     *
+     * The returned selection allocates from \a resource .
      */
     static
-    RowSelection fromItemSelection(const QItemSelection & itemSelection) noexcept;
+    RowSelection fromItemSelection(const QItemSelection & itemSelection,
+                                   std::pmr::memory_resource *resource = std::pmr::get_default_resource()) noexcept;
+
+    /*! \brief Get a row selection from a list of indexes
+     *
+     * Returns a row selection holding the rows of all indexes in \a indexes ,
+     * whatever their column is.
+     * The rows are sorted once, so this is also efficient
+     * for the very long lists a view passes to QAbstractItemModel::mimeData() .
+     *
+     * The returned selection, and the temporary list of rows, allocate from \a resource .
+     */
+    static
+    RowSelection fromModelIndexList(const QModelIndexList & indexes,
+                                    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    /*! \brief Get a row selection from a list of row ranges
+     *
+     * The returned selection allocates from \a resource .
+     */
+    static
+    RowSelection fromRowRangeList(const RowRangeList & rowRangeList,
+                                  std::pmr::memory_resource *resource = std::pmr::get_default_resource()) noexcept
+    {
+      RowSelection rowSelection(resource);
+      rowSelection.mRowRangeList = rowRangeList;
+
+      return rowSelection;
+    }
 
    private:
 
@@ -4,14 +4,44 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2011-2023 Philippe Steinmann.
+ ** Copyright (C) 2011-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #include "RowSelectionHelpers.h"
+#include <QModelIndex>
 #include <cassert>
 
 namespace Mdt{ namespace ItemModel{
 
+namespace{
+
+  /*
+   * Works for RowRangeList and RowSelection,
+   * which both iterate over RowRange
+   */
+  template<typename RowRanges>
+  QItemSelection itemSelectionFromRowRanges(const QAbstractItemModel & model, const RowRanges & rowRanges, size_t rangeCount)
+  {
+    QItemSelection selection;
+
+    const int lastColumn = model.columnCount() - 1;
+    if(lastColumn < 0){
+      return selection;
+    }
+
+    selection.reserve( static_cast<int>(rangeCount) );
+    for(const RowRange & range : rowRanges){
+      assert( range.lastRow() < model.rowCount() );
+      const QModelIndex topLeft = model.index(range.firstRow(), 0);
+      const QModelIndex bottomRight = model.index(range.lastRow(), lastColumn);
+      selection.append( QItemSelectionRange(topLeft, bottomRight) );
+    }
+
+    return selection;
+  }
+
+} // namespace{
+
 RowRange rowRangeFromItemSelectionRange(const QItemSelectionRange & itemSelectionRange) noexcept
 {
   assert( itemSelectionRange.isValid() );
@@ -20,4 +50,14 @@ RowRange rowRangeFromItemSelectionRange(const QItemSelectionRange & itemSelectio
   return RowRange::fromFirstAndLastRow( itemSelectionRange.top(), itemSelectionRange.bottom() );
 }
 
+QItemSelection itemSelectionFromRowRangeList(const QAbstractItemModel & model, const RowRangeList & rowRangeList)
+{
+  return itemSelectionFromRowRanges( model, rowRangeList, rowRangeList.rangeCount() );
+}
+
+QItemSelection itemSelectionFromRowSelection(const QAbstractItemModel & model, const RowSelection & rowSelection)
+{
+  return itemSelectionFromRowRanges( model, rowSelection, rowSelection.rangeCount() );
+}
+
 }} // namespace Mdt{ namespace ItemModel{
@@ -4,15 +4,19 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2011-2023 Philippe Steinmann.
+ ** Copyright (C) 2011-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #ifndef MDT_ITEM_MODEL_ROW_SELECTION_HELPERS_H
 #define MDT_ITEM_MODEL_ROW_SELECTION_HELPERS_H
 
 #include "Mdt/ItemModel/RowRange.h"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/RowSelection.h"
 #include "mdt_itemmodel_export.h"
 #include <QItemSelectionRange>
+#include <QItemSelection>
+#include <QAbstractItemModel>
 
 namespace Mdt{ namespace ItemModel{
 
@@ -24,6 +28,37 @@ namespace Mdt{ namespace ItemModel{
   MDT_ITEMMODEL_EXPORT
   RowRange rowRangeFromItemSelectionRange(const QItemSelectionRange & itemSelectionRange) noexcept;
 
+  /*! \brief Get a item selection from given list of row ranges
+   *
+   * Returns a item selection with one range per row range,
+   * that spans all the columns of \a model .
+   * This is the smallest item selection that selects those rows,
+   * and it is built without visiting each row.
+   *
+   * Selecting many rows one by one, with QItemSelectionModel::select() ,
+   * merges each one into the selection and emits selectionChanged() each time.
+   * Instead, build the item selection once, and select it in a single call:
+   * \code
+   * const QItemSelection selection = itemSelectionFromRowRangeList(model, rowRangeList);
+   * selectionModel.select(selection, QItemSelectionModel::ClearAndSelect);
+   * \endcode
+   *
+   * If \a model has no column, a empty selection is returned.
+   *
+   * \pre each range in \a rowRangeList must be in the rows of \a model
+   * \sa ItemSelectionModel::selectRows()
+   */
+  MDT_ITEMMODEL_EXPORT
+  QItemSelection itemSelectionFromRowRangeList(const QAbstractItemModel & model, const RowRangeList & rowRangeList);
+
+  /*! \brief Get a item selection from given row selection
+   *
+   * \pre each range in \a rowSelection must be in the rows of \a model
+   * \sa itemSelectionFromRowRangeList()
+   */
+  MDT_ITEMMODEL_EXPORT
+  QItemSelection itemSelectionFromRowSelection(const QAbstractItemModel & model, const RowSelection & rowSelection);
+
 }} // namespace Mdt{ namespace ItemModel{
 
 #endif // #ifndef MDT_ITEM_MODEL_ROW_SELECTION_HELPERS_H
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_SLIDING_WINDOW_TABLE_MODEL_H
+#define MDT_ITEM_MODEL_SLIDING_WINDOW_TABLE_MODEL_H
+
+#include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemModel/RingBuffer.h"
+#include "Mdt/ItemModel/SlidingWindowUpdate.h"
+#include "Mdt/ItemModel/NumericLimits.h"
+#include <QModelIndex>
+#include <iterator>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Table model that holds the last records of a stream, oldest first
+   *
+   * This is a base to create live event monitors:
+   * new records are appended at the end,
+   * and once the window size is reached, the oldest records (the first rows) are evicted.
+   *
+   * Appending records one by one with a remove and a insert for each
+   * makes every attached proxy and view process 2 layout changes per record.
+   * appendRecords() takes a batch of records,
+   * and signals it at most with 1 remove and 1 insert,
+   * or with a single dataChanged() over the whole window
+   * when rotating in place is cheaper.
+   * The choice is done by slidingWindowUpdateForBatch().
+   *
+   * \note When the window is rotated in place,
+   * persistent indexes (and so the selection) keep their row,
+   * which then refers to another record.
+   *
+   * The records are stored in a RingBuffer that is allocated once,
+   * so evicting and appending records does not move the surviving ones.
+   *
+   * A subclass only has to implement the column count and the data:
+   * \code
+   * struct Event
+   * {
+   *   QDateTime time;
+   *   QString text;
+   * };
+   *
+   * class EventTableModel : public Mdt::ItemModel::SlidingWindowTableModel<Event>
+   * {
+   *   Q_OBJECT
+   *
+   *  public:
+   *
+   *   EventTableModel(QObject *parent = nullptr)
+   *    : SlidingWindowTableModel(1000, parent)
+   *   {
+   *   }
+   *
+   *  private:
+   *
+   *   int columnCountWithoutParentIndex() const noexcept override
+   *   {
+   *     return 2;
+   *   }
+   *
+   *   QVariant displayRoleData(const QModelIndex & index) const noexcept override;
+   * };
+   * \endcode
+   *
+   * Then batches of records can be added:
+   * \code
+   * EventTableModel model;
+   *
+   * const std::vector<Event> events = readPendingEvents();
+   * model.appendRecords( events.cbegin(), events.cend() );
+   * \endcode
+   *
+   * \note Because this is a class template, it does not use the Q_OBJECT macro.
+   *  Subclasses can use it.
+   *
+   * \sa CappedLogTableModel
+   */
+  template<typename Record>
+  class SlidingWindowTableModel : public AbstractTableModel
+  {
+   public:
+
+    /*! \brief Storage of the records
+     */
+    using Table = RingBuffer<Record>;
+
+    /*! \brief Construct a sliding window table model that holds at most \a windowSize records
+     *
+     * \pre \a windowSize must be >= 1
+     */
+    explicit SlidingWindowTableModel(int windowSize, QObject *parent = nullptr)
+     : AbstractTableModel(parent),
+       mWindowSize(windowSize)
+    {
+      assert( windowSize >= 1 );
+
+      mTable.reserve( static_cast<std::size_t>(mWindowSize) );
+    }
+
+    /*! \brief Get the maximum count of rows (records) this model can hold
+     */
+    int windowSize() const noexcept
+    {
+      return mWindowSize;
+    }
+
+    /*! \brief Append \a record to this model
+     *
+     * If this model is full, the first row (the oldest record)
+     * is evicted.
+     *
+     * \sa appendRecords()
+     */
+    void appendRecord(const Record & record)
+    {
+      appendRecords(&record, &record + 1);
+    }
+
+    /*! \brief Append the records in range [\a first, \a last) to this model
+     *
+     * The oldest records are evicted to make room for the new ones.
+     * If the range contains more records than the window size,
+     * only the last ones are kept.
+     *
+     * \pre \a first and \a last must be at least forward iterators
+     * \sa slidingWindowUpdateForBatch()
+     */
+    template<typename ForwardIt>
+    void appendRecords(ForwardIt first, ForwardIt last)
+    {
+      auto batchSize = std::distance(first, last);
+      assert( batchSize >= 0 );
+      if( batchSize > mWindowSize ){
+        std::advance(first, batchSize - mWindowSize);
+        batchSize = mWindowSize;
+      }
+      const int incomingCount = static_cast<int>(batchSize);
+      const int rowCount = rowCountWithoutParentIndex();
+
+      switch( slidingWindowUpdateForBatch(rowCount, mWindowSize, incomingCount) ){
+        case SlidingWindowUpdate::None:
+          return;
+        case SlidingWindowUpdate::Insert:
+          insertRecordsAtEnd(first, last, incomingCount);
+          return;
+        case SlidingWindowUpdate::RemoveAndInsert:
+          removeFirstRecords(rowCount + incomingCount - mWindowSize);
+          insertRecordsAtEnd(first, last, incomingCount);
+          return;
+        case SlidingWindowUpdate::DataChanged:
+          rotateRecords(first, last);
+          return;
+      }
+    }
+
+    /*! \brief Get the record at \a row
+     *
+     * \pre \a row must be in valid range
+     * \sa rowIndexIsInRange()
+     */
+    const Record & recordAt(int row) const noexcept
+    {
+      assert( rowIndexIsInRange(row) );
+
+      return mTable[static_cast<std::size_t>(row)];
+    }
+
+    /*! \brief Access the records of this model
+     */
+    const Table & table() const noexcept
+    {
+      return mTable;
+    }
+
+    /*! \brief Remove all records from this model
+     */
+    void clear()
+    {
+      beginResetModel();
+      mTable.clear();
+      endResetModel();
+    }
+
+   protected:
+
+    /*! \brief Get the count of rows
+     */
+    int rowCountWithoutParentIndex() const noexcept override
+    {
+      assert( mTable.size() <= static_cast<std::size_t>( intMax() ) );
+
+      return static_cast<int>( mTable.size() );
+    }
+
+    /*! \brief Returns true
+     */
+    bool doSupportsRemoveFirstRow() const noexcept override
+    {
+      return true;
+    }
+
+    /*! \brief Remove the first (the oldest) record
+     */
+    void doRemoveFirstRow() noexcept override
+    {
+      assert( !mTable.empty() );
+
+      mTable.pop_front();
+    }
+
+   private:
+
+    void removeFirstRecords(int count)
+    {
+      assert( count >= 1 );
+      assert( count <= rowCountWithoutParentIndex() );
+
+      beginRemoveRows(QModelIndex(), 0, count - 1);
+      for(int i = 0; i < count; ++i){
+        mTable.pop_front();
+      }
+      endRemoveRows();
+    }
+
+    template<typename ForwardIt>
+    void insertRecordsAtEnd(ForwardIt first, ForwardIt last, int count)
+    {
+      assert( count >= 1 );
+      assert( rowCountWithoutParentIndex() + count <= mWindowSize );
+
+      const int firstRow = rowCountWithoutParentIndex();
+      beginInsertRows(QModelIndex(), firstRow, firstRow + count - 1);
+      for(; first != last; ++first){
+        mTable.push_back(*first);
+      }
+      endInsertRows();
+    }
+
+    /*
+     * Popping before pushing keeps the table in its allocated capacity
+     */
+    template<typename ForwardIt>
+    void rotateRecords(ForwardIt first, ForwardIt last)
+    {
+      assert( rowCountWithoutParentIndex() == mWindowSize );
+
+      for(; first != last; ++first){
+        mTable.pop_front();
+        mTable.push_back(*first);
+      }
+
+      const int lastColumn = columnCountWithoutParentIndex() - 1;
+      if(lastColumn < 0){
+        return;
+      }
+      emitDataChanged( index(0, 0), index(mWindowSize - 1, lastColumn) );
+    }
+
+    int mWindowSize;
+    Table mTable;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_SLIDING_WINDOW_TABLE_MODEL_H
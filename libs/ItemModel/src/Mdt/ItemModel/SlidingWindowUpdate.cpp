@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "SlidingWindowUpdate.h"
+#include <algorithm>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+SlidingWindowUpdate slidingWindowUpdateForBatch(int rowCount, int windowSize, int batchSize) noexcept
+{
+  assert( windowSize >= 1 );
+  assert( rowCount >= 0 );
+  assert( rowCount <= windowSize );
+  assert( batchSize >= 0 );
+
+  if(batchSize == 0){
+    return SlidingWindowUpdate::None;
+  }
+
+  const int incomingCount = std::min(batchSize, windowSize);
+  if( incomingCount <= (windowSize - rowCount) ){
+    return SlidingWindowUpdate::Insert;
+  }
+
+  if( (rowCount == windowSize) && (2*incomingCount >= windowSize) ){
+    return SlidingWindowUpdate::DataChanged;
+  }
+
+  return SlidingWindowUpdate::RemoveAndInsert;
+}
+
+}} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_SLIDING_WINDOW_UPDATE_H
+#define MDT_ITEM_MODEL_SLIDING_WINDOW_UPDATE_H
+
+#include "mdt_itemmodel_export.h"
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief How a sliding window model signals the arrival of a batch of records
+   *
+   * \sa slidingWindowUpdateForBatch()
+   * \sa SlidingWindowTableModel
+   */
+  enum class SlidingWindowUpdate
+  {
+    None,             /*!< Nothing to do (the batch is empty) */
+    Insert,           /*!< The window is not full: the records are appended with 1 insert */
+    RemoveAndInsert,  /*!< The oldest records are removed with 1 remove, then the new ones are appended with 1 insert */
+    DataChanged       /*!< The window rotates in place, signaled with a single dataChanged() over the whole window */
+  };
+
+  /*! \brief Choose how a sliding window model signals the arrival of a batch of records
+   *
+   * \a rowCount is the current count of rows in the window,
+   * \a windowSize the maximum count of rows
+   * and \a batchSize the count of incoming records.
+   * If \a batchSize is greater than \a windowSize,
+   * only the last \a windowSize records of the batch are kept.
+   *
+   * If the window can hold the batch without evicting rows,
+   * SlidingWindowUpdate::Insert is returned.
+   *
+   * Otherwise, rows must be evicted.
+   * After a remove and a insert, each attached proxy and view
+   * has to shift the mapping of the surviving rows,
+   * and process the removed and inserted ones.
+   * Once at least half of a full window is replaced,
+   * re-evaluating the whole window once with a single dataChanged()
+   * is cheaper, and SlidingWindowUpdate::DataChanged is returned.
+   * This is only possible if the row count does not change
+   * (the window is already full).
+   *
+   * Else, SlidingWindowUpdate::RemoveAndInsert is returned.
+   *
+   * \pre \a windowSize must be >= 1
+   * \pre \a rowCount must be in range [0, \a windowSize]
+   * \pre \a batchSize must be >= 0
+   */
+  MDT_ITEMMODEL_EXPORT
+  SlidingWindowUpdate slidingWindowUpdateForBatch(int rowCount, int windowSize, int batchSize) noexcept;
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_SLIDING_WINDOW_UPDATE_H
@@ -0,0 +1,658 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_SMALL_VECTOR_H
+#define MDT_ITEM_MODEL_SMALL_VECTOR_H
+
+#include <memory>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Contiguous container that stores its first elements inline
+   *
+   * SmallVector has the same interface as std::vector for the operations it provides,
+   * but the storage for \a InlineCapacity elements is part of the object itself.
+   * As long as the size does not exceed \a InlineCapacity ,
+   * no memory is allocated.
+   * Once it is exceeded, the elements are moved to a heap allocated storage,
+   * which then grows like the one of std::vector .
+   *
+   * This is useful for containers that are created and destroyed often
+   * and that usually only hold a few elements,
+   * like the list of ranges of a RowSelection .
+   *
+   * The iterators are pointers.
+   * Like std::vector, inserting or removing elements invalidates iterators.
+   * Moving a SmallVector that stores its elements inline
+   * moves each element, so it also invalidates iterators.
+   *
+   * \a T does not have to be default constructible.
+   *
+   * SmallVector is allocator aware: \a Allocator is only used once the inline capacity is exceeded.
+   * With a std::pmr::polymorphic_allocator , the storage can come from a arena,
+   * like a std::pmr::monotonic_buffer_resource .
+   * Like for std::pmr::vector , the allocator is not propagated
+   * when a vector is copied or assigned.
+   *
+   * \sa RowRangeList
+   */
+  template<typename T, std::size_t InlineCapacity, typename Allocator = std::allocator<T>>
+  class SmallVector
+  {
+    static_assert( InlineCapacity >= 1, "InlineCapacity must be at least 1" );
+
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    static constexpr bool propagateOnCopyAssignment = AllocatorTraits::propagate_on_container_copy_assignment::value;
+    static constexpr bool propagateOnMoveAssignment = AllocatorTraits::propagate_on_container_move_assignment::value;
+    static constexpr bool allocatorIsAlwaysEqual = AllocatorTraits::is_always_equal::value;
+
+   public:
+
+    /*! \brief STL allocator_type
+     */
+    using allocator_type = Allocator;
+
+    /*! \brief STL value_type
+     */
+    using value_type = T;
+
+    /*! \brief STL size_type
+     */
+    using size_type = std::size_t;
+
+    /*! \brief STL difference_type
+     */
+    using difference_type = std::ptrdiff_t;
+
+    /*! \brief STL reference
+     */
+    using reference = T&;
+
+    /*! \brief STL const_reference
+     */
+    using const_reference = const T&;
+
+    /*! \brief STL pointer
+     */
+    using pointer = T*;
+
+    /*! \brief STL const_pointer
+     */
+    using const_pointer = const T*;
+
+    /*! \brief STL iterator
+     */
+    using iterator = T*;
+
+    /*! \brief STL const_iterator
+     */
+    using const_iterator = const T*;
+
+    /*! \brief STL reverse_iterator
+     */
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /*! \brief STL const_reverse_iterator
+     */
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /*! \brief Count of elements stored without allocating
+     */
+    static constexpr size_type inlineCapacity = InlineCapacity;
+
+    /*! \brief Construct a empty vector
+     */
+    SmallVector() noexcept( noexcept( Allocator() ) )
+     : mData( inlineData() )
+    {
+    }
+
+    /*! \brief Construct a empty vector that uses \a allocator
+     */
+    explicit
+    SmallVector(const Allocator & allocator) noexcept
+     : mAllocator(allocator),
+       mData( inlineData() )
+    {
+    }
+
+    /*! \brief Construct a vector from a initializer list
+     */
+    SmallVector(std::initializer_list<T> list, const Allocator & allocator = Allocator())
+     : SmallVector(allocator)
+    {
+      reserve( list.size() );
+      for(const T & value : list){
+        push_back(value);
+      }
+    }
+
+    /*! \brief Copy construct a vector from \a other
+     */
+    SmallVector(const SmallVector & other)
+     : SmallVector( other, AllocatorTraits::select_on_container_copy_construction(other.mAllocator) )
+    {
+    }
+
+    /*! \brief Copy construct a vector from \a other that uses \a allocator
+     */
+    SmallVector(const SmallVector & other, const Allocator & allocator)
+     : SmallVector(allocator)
+    {
+      reserve( other.size() );
+      for(const T & value : other){
+        push_back(value);
+      }
+    }
+
+    /*! \brief Copy assign \a other to this vector
+     */
+    SmallVector & operator=(const SmallVector & other)
+    {
+      if(&other != this){
+        clear();
+        if constexpr(propagateOnCopyAssignment){
+          if(mAllocator != other.mAllocator){
+            deallocate();
+          }
+          mAllocator = other.mAllocator;
+        }
+        reserve( other.size() );
+        for(const T & value : other){
+          push_back(value);
+        }
+      }
+
+      return *this;
+    }
+
+    /*! \brief Move construct a vector from \a other
+     *
+     * \a other is left empty
+     */
+    SmallVector(SmallVector && other) noexcept(std::is_nothrow_move_constructible<T>::value)
+     : SmallVector(other.mAllocator)
+    {
+      takeElementsFrom(other);
+    }
+
+    /*! \brief Move construct a vector from \a other that uses \a allocator
+     *
+     * If \a allocator is not equal to the one of \a other ,
+     * the elements are moved one by one to a storage allocated by \a allocator .
+     *
+     * \a other is left empty
+     */
+    SmallVector(SmallVector && other, const Allocator & allocator)
+     : SmallVector(allocator)
+    {
+      takeElementsFrom(other);
+    }
+
+    /*! \brief Move assign \a other to this vector
+     *
+     * \a other is left empty
+     */
+    SmallVector & operator=(SmallVector && other)
+      noexcept( (propagateOnMoveAssignment || allocatorIsAlwaysEqual) && std::is_nothrow_move_constructible<T>::value )
+    {
+      if(&other != this){
+        clear();
+        if constexpr(propagateOnMoveAssignment){
+          if(mAllocator != other.mAllocator){
+            deallocate();
+          }
+          mAllocator = other.mAllocator;
+        }
+        takeElementsFrom(other);
+      }
+
+      return *this;
+    }
+
+    /*! \brief Destruct this vector
+     */
+    ~SmallVector() noexcept
+    {
+      clear();
+      deallocate();
+    }
+
+    /*! \brief Get the count of elements in this vector
+     */
+    size_type size() const noexcept
+    {
+      return mSize;
+    }
+
+    /*! \brief Check if this vector is empty
+     */
+    bool empty() const noexcept
+    {
+      return mSize == 0;
+    }
+
+    /*! \brief Get the count of elements this vector can hold without allocating
+     */
+    size_type capacity() const noexcept
+    {
+      return mCapacity;
+    }
+
+    /*! \brief Get the maximum count of elements this vector can hold
+     */
+    size_type max_size() const noexcept
+    {
+      return AllocatorTraits::max_size(mAllocator);
+    }
+
+    /*! \brief Get the allocator of this vector
+     */
+    allocator_type get_allocator() const noexcept
+    {
+      return mAllocator;
+    }
+
+    /*! \brief Check if the elements are stored inline
+     *
+     * Returns false once the elements have been moved to a heap allocated storage.
+     */
+    bool isInline() const noexcept
+    {
+      return mData == inlineData();
+    }
+
+    /*! \brief Reserve storage for at least \a newCapacity elements
+     */
+    void reserve(size_type newCapacity)
+    {
+      if(newCapacity > mCapacity){
+        reallocate(newCapacity);
+      }
+    }
+
+    /*! \brief Access the element at \a index
+     *
+     * \pre \a index must be < size()
+     */
+    reference operator[](size_type index) noexcept
+    {
+      assert( index < mSize );
+
+      return mData[index];
+    }
+
+    /*! \brief Access the element at \a index
+     *
+     * \pre \a index must be < size()
+     */
+    const_reference operator[](size_type index) const noexcept
+    {
+      assert( index < mSize );
+
+      return mData[index];
+    }
+
+    /*! \brief Access the first element
+     *
+     * \pre this vector must not be empty
+     */
+    const_reference front() const noexcept
+    {
+      assert( !empty() );
+
+      return mData[0];
+    }
+
+    /*! \brief Access the last element
+     *
+     * \pre this vector must not be empty
+     */
+    const_reference back() const noexcept
+    {
+      assert( !empty() );
+
+      return mData[mSize - 1];
+    }
+
+    /*! \brief Get a pointer to the elements
+     */
+    T *data() noexcept
+    {
+      return mData;
+    }
+
+    /*! \brief Get a pointer to the elements
+     */
+    const T *data() const noexcept
+    {
+      return mData;
+    }
+
+    /*! \brief Get a iterator to the first element
+     */
+    iterator begin() noexcept
+    {
+      return mData;
+    }
+
+    /*! \brief Get a iterator past the last element
+     */
+    iterator end() noexcept
+    {
+      return mData + mSize;
+    }
+
+    /*! \brief Get a const iterator to the first element
+     */
+    const_iterator begin() const noexcept
+    {
+      return mData;
+    }
+
+    /*! \brief Get a const iterator past the last element
+     */
+    const_iterator end() const noexcept
+    {
+      return mData + mSize;
+    }
+
+    /*! \brief Get a const iterator to the first element
+     */
+    const_iterator cbegin() const noexcept
+    {
+      return mData;
+    }
+
+    /*! \brief Get a const iterator past the last element
+     */
+    const_iterator cend() const noexcept
+    {
+      return mData + mSize;
+    }
+
+    /*! \brief Get a reverse iterator to the last element
+     */
+    reverse_iterator rbegin() noexcept
+    {
+      return reverse_iterator( end() );
+    }
+
+    /*! \brief Get a reverse iterator before the first element
+     */
+    reverse_iterator rend() noexcept
+    {
+      return reverse_iterator( begin() );
+    }
+
+    /*! \brief Get a const reverse iterator to the last element
+     */
+    const_reverse_iterator crbegin() const noexcept
+    {
+      return const_reverse_iterator( cend() );
+    }
+
+    /*! \brief Get a const reverse iterator before the first element
+     */
+    const_reverse_iterator crend() const noexcept
+    {
+      return const_reverse_iterator( cbegin() );
+    }
+
+    /*! \brief Add \a value to the end of this vector
+     */
+    void push_back(const T & value)
+    {
+      emplace_back(value);
+    }
+
+    /*! \brief Add \a value to the end of this vector
+     */
+    void push_back(T && value)
+    {
+      emplace_back( std::move(value) );
+    }
+
+    /*! \brief Construct a element from \a args at the end of this vector
+     */
+    template<typename...Args>
+    reference emplace_back(Args &&...args)
+    {
+      if(mSize == mCapacity){
+        /*
+         * args could refer to a element of this vector,
+         * which will be moved by reallocate()
+         */
+        T value( std::forward<Args>(args)... );
+        reallocate( grownCapacity(mSize + 1) );
+        ::new( static_cast<void*>(mData + mSize) ) T( std::move(value) );
+      }else{
+        ::new( static_cast<void*>(mData + mSize) ) T( std::forward<Args>(args)... );
+      }
+      ++mSize;
+
+      return mData[mSize - 1];
+    }
+
+    /*! \brief Insert \a value before \a pos
+     *
+     * Returns a iterator to the inserted element.
+     *
+     * \pre \a pos must be in range [cbegin(), cend()]
+     */
+    iterator insert(const_iterator pos, const T & value)
+    {
+      return insert( pos, T(value) );
+    }
+
+    /*! \brief Insert \a value before \a pos
+     *
+     * \sa insert(const_iterator, const T &)
+     */
+    iterator insert(const_iterator pos, T && value)
+    {
+      assert( pos >= cbegin() );
+      assert( pos <= cend() );
+
+      const auto index = static_cast<size_type>( pos - cbegin() );
+      if(index == mSize){
+        emplace_back( std::move(value) );
+        return mData + index;
+      }
+
+      if(mSize == mCapacity){
+        T movedValue( std::move(value) );
+        reallocate( grownCapacity(mSize + 1) );
+        return insertInside(index, movedValue);
+      }
+
+      return insertInside(index, value);
+    }
+
+    /*! \brief Remove the element at \a pos
+     *
+     * Returns a iterator to the element that followed the removed one.
+     *
+     * \pre \a pos must be in range [cbegin(), cend())
+     */
+    iterator erase(const_iterator pos)
+    {
+      assert( pos < cend() );
+
+      return erase(pos, pos + 1);
+    }
+
+    /*! \brief Remove the elements in range [\a first, \a last)
+     *
+     * Returns a iterator to the element that followed the last removed one.
+     *
+     * \pre [\a first, \a last) must be a valid range of this vector
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+      assert( first >= cbegin() );
+      assert( first <= last );
+      assert( last <= cend() );
+
+      const auto firstIndex = static_cast<size_type>( first - cbegin() );
+      const auto lastIndex = static_cast<size_type>( last - cbegin() );
+      if(firstIndex == lastIndex){
+        return mData + firstIndex;
+      }
+
+      T *newEnd = std::move(mData + lastIndex, mData + mSize, mData + firstIndex);
+      destroyRange( newEnd, mData + mSize );
+      mSize -= lastIndex - firstIndex;
+
+      return mData + firstIndex;
+    }
+
+    /*! \brief Remove the last element
+     *
+     * \pre this vector must not be empty
+     */
+    void pop_back() noexcept
+    {
+      assert( !empty() );
+
+      --mSize;
+      mData[mSize].~T();
+    }
+
+    /*! \brief Remove all elements
+     *
+     * The capacity is not changed.
+     */
+    void clear() noexcept
+    {
+      destroyRange( mData, mData + mSize );
+      mSize = 0;
+    }
+
+   private:
+
+    T *inlineData() noexcept
+    {
+      return reinterpret_cast<T*>(mInlineStorage);
+    }
+
+    const T *inlineData() const noexcept
+    {
+      return reinterpret_cast<const T*>(mInlineStorage);
+    }
+
+    size_type grownCapacity(size_type requiredCapacity) const noexcept
+    {
+      return std::max(requiredCapacity, 2*mCapacity);
+    }
+
+    /*
+     * Requires that index < size() and that size() < capacity()
+     */
+    iterator insertInside(size_type index, T & value)
+    {
+      assert( index < mSize );
+      assert( mSize < mCapacity );
+
+      ::new( static_cast<void*>(mData + mSize) ) T( std::move(mData[mSize - 1]) );
+      std::move_backward( mData + index, mData + mSize - 1, mData + mSize );
+      mData[index] = std::move(value);
+      ++mSize;
+
+      return mData + index;
+    }
+
+    static
+    void destroyRange(T *first, T *last) noexcept
+    {
+      for(; first != last; ++first){
+        first->~T();
+      }
+    }
+
+    /*
+     * The storage of other can only be taken
+     * if it was allocated by a allocator equal to the one of this vector
+     */
+    void takeElementsFrom(SmallVector & other)
+    {
+      assert( empty() );
+
+      if( other.isInline() || (mAllocator != other.mAllocator) ){
+        reserve( other.mSize );
+        for(T & value : other){
+          ::new( static_cast<void*>(mData + mSize) ) T( std::move(value) );
+          ++mSize;
+        }
+        other.clear();
+        return;
+      }
+
+      deallocate();
+      mData = other.mData;
+      mCapacity = other.mCapacity;
+      mSize = other.mSize;
+      other.mData = other.inlineData();
+      other.mCapacity = InlineCapacity;
+      other.mSize = 0;
+    }
+
+    void reallocate(size_type newCapacity)
+    {
+      assert( newCapacity >= mSize );
+      assert( newCapacity > InlineCapacity );
+
+      T *newData = AllocatorTraits::allocate(mAllocator, newCapacity);
+
+      // If a element can not be moved without throwing, it is copied, so this vector stays untouched
+      size_type constructedCount = 0;
+      try{
+        for(; constructedCount < mSize; ++constructedCount){
+          ::new( static_cast<void*>(newData + constructedCount) ) T( std::move_if_noexcept(mData[constructedCount]) );
+        }
+      }catch(...){
+        destroyRange(newData, newData + constructedCount);
+        AllocatorTraits::deallocate(mAllocator, newData, newCapacity);
+        throw;
+      }
+
+      destroyRange( mData, mData + mSize );
+      deallocate();
+      mData = newData;
+      mCapacity = newCapacity;
+    }
+
+    void deallocate() noexcept
+    {
+      if( !isInline() ){
+        AllocatorTraits::deallocate(mAllocator, mData, mCapacity);
+        mData = inlineData();
+        mCapacity = InlineCapacity;
+      }
+    }
+
+    Allocator mAllocator;
+    T *mData;
+    size_type mCapacity = InlineCapacity;
+    size_type mSize = 0;
+    alignas(T) unsigned char mInlineStorage[sizeof(T) * InlineCapacity];
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_SMALL_VECTOR_H
@@ -11,6 +11,7 @@
 #define MDT_ITEM_MODEL_STL_HELPERS_H
 
 #include <iterator>
+#include <algorithm>
 #include <cassert>
 
 namespace Mdt{ namespace ItemModel{
@@ -92,6 +93,49 @@ namespace Mdt{ namespace ItemModel{
     container.erase(pos);
   }
 
+  /*! \brief Move \a count elements starting from \a index before \a destinationIndex
+   *
+   * This is a helper to implement Qt item models,
+   * typically AbstractTableModel::doMoveRows().
+   *
+   * \a destinationIndex has the same meaning than \a destinationChild
+   * in QAbstractItemModel::beginMoveRows():
+   * it is the index, before the move, of the element before which the elements are moved.
+   * Passing the container's size moves the elements to the end.
+   *
+   * The elements are moved with a single std::rotate().
+   *
+   * \pre \a index must be >= 0
+   * \pre \a count must be >= 1
+   * \pre ( \a index + \a count ) must be <= container's size
+   * \pre \a destinationIndex must be in range [0, container's size]
+   * \pre \a destinationIndex must not be in range [\a index, \a index + \a count]
+   */
+  template<typename Container>
+  void moveInStlContainer(Container & container, int index, int count, int destinationIndex) noexcept
+  {
+    assert( index >= 0 );
+    assert( count >= 1 );
+    assert( static_cast<typename Container::size_type>(index + count) <= container.size() );
+    assert( destinationIndex >= 0 );
+    assert( static_cast<typename Container::size_type>(destinationIndex) <= container.size() );
+    assert( (destinationIndex < index) || (destinationIndex > index + count) );
+
+    const auto dIndex = static_cast<typename Container::difference_type>(index);
+    const auto dCount = static_cast<typename Container::difference_type>(count);
+    const auto dDestination = static_cast<typename Container::difference_type>(destinationIndex);
+
+    const auto first = std::next(container.begin(), dIndex);
+    const auto last = std::next(first, dCount);
+    const auto destination = std::next(container.begin(), dDestination);
+
+    if(destinationIndex < index){
+      std::rotate(destination, first, last);
+    }else{
+      std::rotate(first, last, destination);
+    }
+  }
+
 }} // namespace Mdt{ namespace ItemModel{
 
 #endif // #ifndef MDT_ITEM_MODEL_STL_HELPERS_H
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "TableEditCommand.h"
+
+namespace Mdt{ namespace ItemModel{
+
+TableEditCommand TableEditCommand::insertRows(int row, int count) noexcept
+{
+  TableEditCommand command;
+
+  command.mType = Type::InsertRows;
+  command.mRow = row;
+  command.mCount = count;
+
+  return command;
+}
+
+TableEditCommand TableEditCommand::removeRows(int row, int count) noexcept
+{
+  TableEditCommand command;
+
+  command.mType = Type::RemoveRows;
+  command.mRow = row;
+  command.mCount = count;
+
+  return command;
+}
+
+TableEditCommand TableEditCommand::setData(int row, int column, const QVariant & value, int role) noexcept
+{
+  TableEditCommand command;
+
+  command.mType = Type::SetData;
+  command.mRow = row;
+  command.mColumn = column;
+  command.mValue = value;
+  command.mRole = role;
+
+  return command;
+}
+
+}} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_TABLE_EDIT_COMMAND_H
+#define MDT_ITEM_MODEL_TABLE_EDIT_COMMAND_H
+
+#include "mdt_itemmodel_export.h"
+#include <QVariant>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Edit to apply to a table model
+   *
+   * A command is created with one of the static factory functions:
+   * \code
+   * const auto command = TableEditCommand::setData(2, 1, QStringLiteral("New name"));
+   * \endcode
+   *
+   * Rows and columns refer to the state of the model
+   * once all the previous commands have been applied.
+   *
+   * \sa AbstractTableModel::applyEditCommands()
+   * \sa TableEditQueue
+   */
+  class MDT_ITEMMODEL_EXPORT TableEditCommand
+  {
+   public:
+
+    /*! \brief Type of a command
+     */
+    enum class Type
+    {
+      InsertRows, /*!< Insert rows */
+      RemoveRows, /*!< Remove rows */
+      SetData     /*!< Set data of a item */
+    };
+
+    /*! \brief Construct a null command
+     *
+     * This is only provided to store commands in containers.
+     */
+    TableEditCommand() noexcept = default;
+
+    /*! \brief Get a command to insert \a count rows before \a row
+     */
+    static
+    TableEditCommand insertRows(int row, int count) noexcept;
+
+    /*! \brief Get a command to remove \a count rows starting from \a row
+     */
+    static
+    TableEditCommand removeRows(int row, int count) noexcept;
+
+    /*! \brief Get a command to set \a value for \a role at \a row and \a column
+     */
+    static
+    TableEditCommand setData(int row, int column, const QVariant & value, int role = Qt::EditRole) noexcept;
+
+    /*! \brief Get the type of this command
+     */
+    Type type() const noexcept
+    {
+      return mType;
+    }
+
+    /*! \brief Get the row
+     */
+    int row() const noexcept
+    {
+      return mRow;
+    }
+
+    /*! \brief Get the count of rows to insert or remove
+     *
+     * Is 1 for a SetData command.
+     */
+    int count() const noexcept
+    {
+      return mCount;
+    }
+
+    /*! \brief Get the column of a SetData command
+     */
+    int column() const noexcept
+    {
+      return mColumn;
+    }
+
+    /*! \brief Get the value of a SetData command
+     */
+    const QVariant & value() const noexcept
+    {
+      return mValue;
+    }
+
+    /*! \brief Get the role of a SetData command
+     */
+    int role() const noexcept
+    {
+      return mRole;
+    }
+
+   private:
+
+    Type mType = Type::SetData;
+    int mRow = -1;
+    int mCount = 1;
+    int mColumn = -1;
+    int mRole = Qt::EditRole;
+    QVariant mValue;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_TABLE_EDIT_COMMAND_H
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "TableEditQueue.h"
+#include "AbstractTableModel.h"
+#include <vector>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+TableEditQueue::TableEditQueue(AbstractTableModel *model, QObject *parent)
+ : QObject(parent),
+   mModel(model)
+{
+  assert( model != nullptr );
+
+  connect(&mDrainTimer, &QTimer::timeout, this, &TableEditQueue::drain);
+}
+
+void TableEditQueue::startDrainTimer(int intervalMs)
+{
+  assert( intervalMs >= 0 );
+
+  mDrainTimer.start(intervalMs);
+}
+
+void TableEditQueue::stopDrainTimer() noexcept
+{
+  mDrainTimer.stop();
+}
+
+void TableEditQueue::drain()
+{
+  assert( mBatch.empty() );
+
+  TableEditCommand command;
+  while( mQueue.tryPop(command) ){
+    mBatch.push_back( std::move(command) );
+  }
+  if( mBatch.empty() || mModel.isNull() ){
+    mBatch.clear();
+    return;
+  }
+
+  /*
+   * The batch is taken out of mBatch before it is applied,
+   * so a exception thrown by a slot leaves this queue usable.
+   * It is given back afterwards, to reuse its capacity.
+   */
+  std::vector<TableEditCommand> batch;
+  batch.swap(mBatch);
+  mModel->applyEditCommands(batch);
+  batch.clear();
+  mBatch.swap(batch);
+}
+
+}} // namespace Mdt{ namespace ItemModel{
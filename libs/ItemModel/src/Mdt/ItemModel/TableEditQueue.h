@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_TABLE_EDIT_QUEUE_H
+#define MDT_ITEM_MODEL_TABLE_EDIT_QUEUE_H
+
+#include "Mdt/ItemModel/TableEditCommand.h"
+#include "Mdt/ItemModel/MpscQueue.h"
+#include "mdt_itemmodel_export.h"
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QVariant>
+#include <vector>
+
+namespace Mdt{ namespace ItemModel{
+
+  class AbstractTableModel;
+
+  /*! \brief Queue of edits, produced by any thread, applied to a table model in batches
+   *
+   * When a model is updated from worker threads,
+   * marshaling each edit with QMetaObject::invokeMethod()
+   * costs a queued event and a dataChanged() per edit.
+   *
+   * With TableEditQueue, producers push commands from any thread,
+   * without locking and without posting events.
+   * The thread of the model (typically the GUI thread) drains the queue,
+   * on a timer or when the event loop is idle,
+   * and applies all pending commands with AbstractTableModel::applyEditCommands() ,
+   * which coalesces and merges them to emit as few signals as possible.
+   *
+   * \code
+   * DeviceStatusTableModel model;
+   * TableEditQueue editQueue(&model);
+   *
+   * // Apply the edits at most every 50 ms
+   * editQueue.startDrainTimer(50);
+   *
+   * // In a worker thread
+   * editQueue.pushSetData(row, DeviceStatusTableModel::statusColumn(), status);
+   * \endcode
+   *
+   * Rows in the commands refer to the state of the model
+   * once all the previously pushed commands have been applied.
+   * If more than one producer changes the structure of the model (inserts or removes rows),
+   * they have to agree on the meaning of the rows,
+   * for example by only appending rows.
+   *
+   * \note This class must live in the thread of the model.
+   *  Only the push methods can be called from a other thread.
+   *
+   * \sa MpscQueue
+   * \sa TableEditCommand
+   */
+  class MDT_ITEMMODEL_EXPORT TableEditQueue : public QObject
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Construct a queue that applies edits to \a model
+     *
+     * \pre \a model must be a valid pointer
+     */
+    explicit TableEditQueue(AbstractTableModel *model, QObject *parent = nullptr);
+
+    /*! \brief Push \a command
+     *
+     * Can be called from any thread.
+     */
+    void push(TableEditCommand command)
+    {
+      mQueue.push( std::move(command) );
+    }
+
+    /*! \brief Push a command to insert \a count rows before \a row
+     *
+     * Can be called from any thread.
+     */
+    void pushInsertRows(int row, int count)
+    {
+      push( TableEditCommand::insertRows(row, count) );
+    }
+
+    /*! \brief Push a command to remove \a count rows starting from \a row
+     *
+     * Can be called from any thread.
+     */
+    void pushRemoveRows(int row, int count)
+    {
+      push( TableEditCommand::removeRows(row, count) );
+    }
+
+    /*! \brief Push a command to set \a value for \a role at \a row and \a column
+     *
+     * Can be called from any thread.
+     */
+    void pushSetData(int row, int column, const QVariant & value, int role = Qt::EditRole)
+    {
+      push( TableEditCommand::setData(row, column, value, role) );
+    }
+
+    /*! \brief Drain this queue every \a intervalMs milliseconds
+     *
+     * If \a intervalMs is 0, this queue is drained each time
+     * the event loop has processed all its pending events.
+     *
+     * \pre \a intervalMs must be >= 0
+     * \sa drain()
+     */
+    void startDrainTimer(int intervalMs);
+
+    /*! \brief Stop draining this queue periodically
+     */
+    void stopDrainTimer() noexcept;
+
+    /*! \brief Check if this queue is drained periodically
+     */
+    bool isDrainTimerActive() const noexcept
+    {
+      return mDrainTimer.isActive();
+    }
+
+   public slots:
+
+    /*! \brief Apply all pending commands to the model
+     *
+     * Does nothing if no command is pending,
+     * or if the model has been destroyed.
+     *
+     * Must be called from the thread of the model.
+     *
+     * A exception thrown by a slot connected to the model is propagated.
+     * In that case, the drained commands are dropped,
+     * and the next drain() applies the commands pushed since.
+     *
+     * \sa AbstractTableModel::applyEditCommands()
+     */
+    void drain();
+
+   private:
+
+    QPointer<AbstractTableModel> mModel;
+    MpscQueue<TableEditCommand> mQueue;
+    std::vector<TableEditCommand> mBatch;
+    QTimer mDrainTimer;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_TABLE_EDIT_QUEUE_H
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "TableExport.h"
+#include "AbstractTableModel.h"
+#include "TypedColumn.h"
+#include "Helpers.h"
+#include <QVariant>
+#include <QString>
+#include <string>
+
+namespace Mdt{ namespace ItemModel{
+
+namespace{
+
+  /*
+   * Acts as a table of row numbers,
+   * so exportTableRanges() can be used for models
+   */
+  struct ModelRowTable
+  {
+    const QAbstractItemModel & model;
+
+    std::size_t size() const
+    {
+      return static_cast<std::size_t>( model.rowCount() );
+    }
+
+    int operator[](std::size_t row) const noexcept
+    {
+      return static_cast<int>(row);
+    }
+  };
+
+  /*
+   * Writes the fields of a column of a model.
+   *
+   * If the model is a AbstractTableModel that exposes the column
+   * as a array of a type that DelimitedTextWriter writes without a QVariant,
+   * the values are read directly in its storage.
+   * Otherwise, they are get with data().
+   */
+  class ModelColumnWriter
+  {
+   public:
+
+    explicit ModelColumnWriter(int column) noexcept
+     : mColumn(column)
+    {
+    }
+
+    void useTypedColumnOf(const QAbstractItemModel & model) noexcept
+    {
+      const auto *tableModel = qobject_cast<const AbstractTableModel*>(&model);
+      if(tableModel == nullptr){
+        return;
+      }
+      const int column = mColumn;
+      mIntValues = tableModel->typedColumn<int>(column);
+      if( !mIntValues.isNull() ){
+        return;
+      }
+      mLongLongValues = tableModel->typedColumn<qlonglong>(column);
+      if( !mLongLongValues.isNull() ){
+        return;
+      }
+      mDoubleValues = tableModel->typedColumn<double>(column);
+      if( !mDoubleValues.isNull() ){
+        return;
+      }
+      mQStringValues = tableModel->typedColumn<QString>(column);
+      if( !mQStringValues.isNull() ){
+        return;
+      }
+      mStdStringValues = tableModel->typedColumn<std::string>(column);
+    }
+
+    void writeField(DelimitedTextWriter & writer, const QAbstractItemModel & model, int row) const
+    {
+      if( !mIntValues.isNull() ){
+        writer.writeField( mIntValues[row] );
+      }else if( !mLongLongValues.isNull() ){
+        writer.writeField( mLongLongValues[row] );
+      }else if( !mDoubleValues.isNull() ){
+        writer.writeField( mDoubleValues[row] );
+      }else if( !mQStringValues.isNull() ){
+        writer.writeField( mQStringValues[row] );
+      }else if( !mStdStringValues.isNull() ){
+        writer.writeField( mStdStringValues[row] );
+      }else{
+        writer.writeField( getModelData(model, row, mColumn) );
+      }
+    }
+
+   private:
+
+    int mColumn;
+    TypedColumn<int> mIntValues;
+    TypedColumn<qlonglong> mLongLongValues;
+    TypedColumn<double> mDoubleValues;
+    TypedColumn<QString> mQStringValues;
+    TypedColumn<std::string> mStdStringValues;
+  };
+
+  /*
+   * Column writers indexed by column number
+   */
+  std::vector<ModelColumnWriter> makeModelColumnWriters(const QAbstractItemModel & model, const std::vector<int> & columns)
+  {
+    std::vector<ModelColumnWriter> columnWriters;
+
+    const int columnCount = model.columnCount();
+    columnWriters.reserve( static_cast<std::size_t>(columnCount) );
+    for(int column = 0; column < columnCount; ++column){
+      columnWriters.emplace_back(column);
+    }
+    for(const int column : columns){
+      assert( column >= 0 );
+      assert( column < columnCount );
+      columnWriters[static_cast<std::size_t>(column)].useTypedColumnOf(model);
+    }
+
+    return columnWriters;
+  }
+
+} // namespace{
+
+void writeModelHeader(const QAbstractItemModel & model, const std::vector<int> & columns, DelimitedTextWriter & writer)
+{
+  for(const int column : columns){
+    assert( column >= 0 );
+    assert( column < model.columnCount() );
+    writer.writeField( model.headerData(column, Qt::Horizontal, Qt::DisplayRole) );
+  }
+  writer.endRow();
+}
+
+bool exportModel(const QAbstractItemModel & model, const RowSelection & selection, const std::vector<int> & columns,
+                 DelimitedTextWriter & writer, TableExportProgress *progress)
+{
+  const ModelRowTable table{model};
+  const std::vector<ModelColumnWriter> columnWriters = makeModelColumnWriters(model, columns);
+  const auto writeField = [&model, &columnWriters](DelimitedTextWriter & w, int row, int column){
+    columnWriters[static_cast<std::size_t>(column)].writeField(w, model, row);
+  };
+
+  return exportTable(table, selection, columns, writeField, writer, progress);
+}
+
+bool exportModel(const QAbstractItemModel & model, const std::vector<int> & columns,
+                 DelimitedTextWriter & writer, TableExportProgress *progress)
+{
+  const ModelRowTable table{model};
+  const std::vector<ModelColumnWriter> columnWriters = makeModelColumnWriters(model, columns);
+  const auto writeField = [&model, &columnWriters](DelimitedTextWriter & w, int row, int column){
+    columnWriters[static_cast<std::size_t>(column)].writeField(w, model, row);
+  };
+
+  return exportTable(table, columns, writeField, writer, progress);
+}
+
+}} // namespace Mdt{ namespace ItemModel{
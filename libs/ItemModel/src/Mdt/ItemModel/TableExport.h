@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_TABLE_EXPORT_H
+#define MDT_ITEM_MODEL_TABLE_EXPORT_H
+
+#include "Mdt/ItemModel/DelimitedTextWriter.h"
+#include "Mdt/ItemModel/RowSelection.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include "mdt_itemmodel_export.h"
+#include <QAbstractItemModel>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Progress of a table export, shared between the exporting thread and the GUI thread
+   *
+   * The exporting thread updates the count of exported rows,
+   * and checks if a cancellation was requested, every tableExportProgressInterval rows.
+   * The GUI thread can read the progress (for example on a timer)
+   * and request a cancellation at any time.
+   *
+   * \sa exportTable()
+   */
+  class MDT_ITEMMODEL_EXPORT TableExportProgress
+  {
+   public:
+
+    /*! \brief Get the count of rows to export
+     */
+    int rowCount() const noexcept
+    {
+      return mRowCount.load(std::memory_order_relaxed);
+    }
+
+    /*! \brief Get the count of rows exported so far
+     */
+    int exportedRowCount() const noexcept
+    {
+      return mExportedRowCount.load(std::memory_order_relaxed);
+    }
+
+    /*! \brief Request the export to stop
+     */
+    void requestCancel() noexcept
+    {
+      mCancelRequested.store(true, std::memory_order_relaxed);
+    }
+
+    /*! \brief Check if a cancellation was requested
+     */
+    bool isCancelRequested() const noexcept
+    {
+      return mCancelRequested.load(std::memory_order_relaxed);
+    }
+
+    /*! \internal Set the count of rows to export
+     */
+    void setRowCount(int count) noexcept
+    {
+      mRowCount.store(count, std::memory_order_relaxed);
+    }
+
+    /*! \internal Set the count of rows exported so far
+     */
+    void setExportedRowCount(int count) noexcept
+    {
+      mExportedRowCount.store(count, std::memory_order_relaxed);
+    }
+
+   private:
+
+    std::atomic<int> mRowCount{0};
+    std::atomic<int> mExportedRowCount{0};
+    std::atomic<bool> mCancelRequested{false};
+  };
+
+  /*! \brief Count of rows between two updates of a TableExportProgress
+   */
+  constexpr int tableExportProgressInterval = 1024;
+
+  /*! \internal Export the rows in \a ranges of \a table
+   */
+  template<typename Table, typename RangeList, typename WriteField>
+  bool exportTableRanges(const Table & table, const RangeList & ranges, int rowCount, const std::vector<int> & columns,
+                         const WriteField & writeField, DelimitedTextWriter & writer, TableExportProgress *progress)
+  {
+    if(progress != nullptr){
+      progress->setRowCount(rowCount);
+      progress->setExportedRowCount(0);
+    }
+
+    int exportedRowCount = 0;
+    for(const RowRange & range : ranges){
+      assert( static_cast<std::size_t>( range.lastRow() ) < table.size() );
+      for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+        const auto & record = table[static_cast<std::size_t>(row)];
+        for(const int column : columns){
+          writeField(writer, record, column);
+        }
+        writer.endRow();
+        ++exportedRowCount;
+        if( (exportedRowCount % tableExportProgressInterval) == 0 ){
+          if( writer.hasError() ){
+            return false;
+          }
+          if(progress != nullptr){
+            progress->setExportedRowCount(exportedRowCount);
+            if( progress->isCancelRequested() ){
+              return false;
+            }
+          }
+        }
+      }
+    }
+
+    if(progress != nullptr){
+      progress->setExportedRowCount(exportedRowCount);
+    }
+
+    return writer.flush();
+  }
+
+  /*! \brief Export all the rows of \a table to \a writer
+   *
+   * \a table is typically a ChunkedTableSnapshot ,
+   * so the export can run in a worker thread while the model is edited.
+   * It must provide size() and operator[](std::size_t) .
+   *
+   * For each row, \a writeField is called for each column in \a columns
+   * as writeField(DelimitedTextWriter & writer, const Record & record, int column) ,
+   * and should use the typed DelimitedTextWriter::writeField() overloads,
+   * which do not allocate.
+   *
+   * Returns true if all rows have been written,
+   * false if the export was cancelled with \a progress , or if writing failed.
+   *
+   * \code
+   * // In the GUI thread
+   * auto snapshot = model.snapshot();
+   * auto progress = std::make_shared<TableExportProgress>();
+   *
+   * // In a worker thread
+   * QFile file(path);
+   * file.open(QIODevice::WriteOnly);
+   * DelimitedTextWriter writer(file, DelimitedTextFormat::Csv);
+   * const auto writeField = [](DelimitedTextWriter & writer, const DeviceListRecord & record, int column){
+   *   if(column == 0){
+   *     writer.writeField(record.id);
+   *   }else{
+   *     writer.writeField(record.description);
+   *   }
+   * };
+   * exportTable(snapshot, {0, 1}, writeField, writer, progress.get());
+   * \endcode
+   *
+   * exportTableInWorkerThread() starts such a thread.
+   *
+   * \sa exportModel()
+   */
+  template<typename Table, typename WriteField>
+  bool exportTable(const Table & table, const std::vector<int> & columns,
+                   const WriteField & writeField, DelimitedTextWriter & writer, TableExportProgress *progress = nullptr)
+  {
+    std::vector<RowRange> ranges;
+    const auto rowCount = static_cast<int>( table.size() );
+    if(rowCount > 0){
+      ranges.push_back( RowRange::fromFirstAndLastRow(0, rowCount - 1) );
+    }
+
+    return exportTableRanges(table, ranges, rowCount, columns, writeField, writer, progress);
+  }
+
+  /*! \brief Export the rows of \a table that are in \a selection to \a writer
+   *
+   * \pre each row in \a selection must be < table.size()
+   * \sa exportTable(const Table &, const std::vector<int> &, const WriteField &, DelimitedTextWriter &, TableExportProgress *)
+   */
+  template<typename Table, typename WriteField>
+  bool exportTable(const Table & table, const RowSelection & selection, const std::vector<int> & columns,
+                   const WriteField & writeField, DelimitedTextWriter & writer, TableExportProgress *progress = nullptr)
+  {
+    int rowCount = 0;
+    for(const RowRange & range : selection){
+      rowCount += range.rowCount();
+    }
+
+    return exportTableRanges(table, selection, rowCount, columns, writeField, writer, progress);
+  }
+
+  /*! \brief Result of a table export run by exportTableInWorkerThread()
+   */
+  enum class TableExportStatus
+  {
+    Finished,   /*!< All rows have been written */
+    Cancelled,  /*!< The export was cancelled with TableExportProgress::requestCancel() */
+    WriteError  /*!< Writing to the device failed */
+  };
+
+  /*! \internal Run \a exportRows in a worker thread
+   */
+  template<typename ExportRows>
+  std::future<TableExportStatus> runTableExportInWorkerThread(QIODevice & device, DelimitedTextFormat format,
+                                                              const std::shared_ptr<TableExportProgress> & progress,
+                                                              ExportRows exportRows)
+  {
+    assert( device.isWritable() );
+    assert( progress.get() != nullptr );
+
+    auto run = [&device, format, progress, exportRows = std::move(exportRows)](){
+      DelimitedTextWriter writer(device, format);
+      if( exportRows( writer, progress.get() ) ){
+        return TableExportStatus::Finished;
+      }
+      if( writer.hasError() ){
+        return TableExportStatus::WriteError;
+      }
+      return TableExportStatus::Cancelled;
+    };
+
+    return std::async( std::launch::async, std::move(run) );
+  }
+
+  /*! \brief Export all the rows of \a table to \a device in a worker thread
+   *
+   * Starts a thread that writes \a table to \a device with a DelimitedTextWriter
+   * in \a format , like exportTable() , and returns immediately.
+   *
+   * The returned future becomes ready when the export is done,
+   * and tells if it finished, was cancelled or failed to write.
+   * A exception thrown during the export (for example by \a writeField )
+   * is rethrown by std::future::get() .
+   *
+   * \a table , \a columns and \a writeField are copied to the worker thread,
+   * so \a table is typically a ChunkedTableSnapshot .
+   * \a device must stay alive, and must not be used by a other thread, until the future is ready.
+   * \a progress is shared with the worker thread,
+   * so the GUI thread can follow the export and cancel it.
+   *
+   * \code
+   * auto progress = std::make_shared<TableExportProgress>();
+   * auto status = exportTableInWorkerThread(model.snapshot(), {0, 1}, writeField, file, DelimitedTextFormat::Csv, progress);
+   *
+   * // On a timer in the GUI thread
+   * progressBar.setValue( progress->exportedRowCount() );
+   * if( status.wait_for( std::chrono::seconds(0) ) == std::future_status::ready ){
+   *   if( status.get() == TableExportStatus::WriteError ){
+   *     // Tell the user
+   *   }
+   * }
+   * \endcode
+   *
+   * \note Like any future returned by std::async() ,
+   *  the destructor of the returned future waits until the export is done.
+   *
+   * \pre \a device must be open for writing
+   * \pre \a progress must not be null
+   */
+  template<typename Table, typename WriteField>
+  std::future<TableExportStatus> exportTableInWorkerThread(Table table, std::vector<int> columns, WriteField writeField,
+                                                           QIODevice & device, DelimitedTextFormat format,
+                                                           const std::shared_ptr<TableExportProgress> & progress)
+  {
+    auto exportRows = [table = std::move(table), columns = std::move(columns), writeField = std::move(writeField)]
+                      (DelimitedTextWriter & writer, TableExportProgress *p){
+      return exportTable(table, columns, writeField, writer, p);
+    };
+
+    return runTableExportInWorkerThread( device, format, progress, std::move(exportRows) );
+  }
+
+  /*! \brief Export the rows of \a table that are in \a selection to \a device in a worker thread
+   *
+   * \a selection is copied with the default memory resource,
+   * so it can have been allocated from a arena that is released before the export is done.
+   *
+   * \pre each row in \a selection must be < table.size()
+   * \pre \a device must be open for writing
+   * \pre \a progress must not be null
+   * \sa exportTableInWorkerThread(Table, std::vector<int>, WriteField, QIODevice &, DelimitedTextFormat, const std::shared_ptr<TableExportProgress> &)
+   */
+  template<typename Table, typename WriteField>
+  std::future<TableExportStatus> exportTableInWorkerThread(Table table, const RowSelection & selection, std::vector<int> columns,
+                                                           WriteField writeField, QIODevice & device, DelimitedTextFormat format,
+                                                           const std::shared_ptr<TableExportProgress> & progress)
+  {
+    auto exportRows = [table = std::move(table), selection = RowSelection(selection),
+                       columns = std::move(columns), writeField = std::move(writeField)]
+                      (DelimitedTextWriter & writer, TableExportProgress *p){
+      return exportTable(table, selection, columns, writeField, writer, p);
+    };
+
+    return runTableExportInWorkerThread( device, format, progress, std::move(exportRows) );
+  }
+
+  /*! \brief Write the horizontal header of \a columns of \a model to \a writer
+   *
+   * \pre each column in \a columns must be in range of \a model
+   */
+  MDT_ITEMMODEL_EXPORT
+  void writeModelHeader(const QAbstractItemModel & model, const std::vector<int> & columns, DelimitedTextWriter & writer);
+
+  /*! \brief Export the rows of \a model that are in \a selection to \a writer
+   *
+   * The data is get with data() for Qt::DisplayRole .
+   * If \a model is a AbstractTableModel that exposes a column
+   * as a int, qlonglong, double, QString or std::string array (see AbstractTableModel::typedColumn() ),
+   * the values of this column are read directly in its storage.
+   *
+   * This function must be called from the thread of \a model .
+   * To export big tables without freezing the GUI,
+   * prefer exporting a snapshot of the table in a worker thread with exportTable() .
+   *
+   * \pre each row in \a selection must be in range of \a model
+   * \pre each column in \a columns must be in range of \a model
+   */
+  MDT_ITEMMODEL_EXPORT
+  bool exportModel(const QAbstractItemModel & model, const RowSelection & selection, const std::vector<int> & columns,
+                   DelimitedTextWriter & writer, TableExportProgress *progress = nullptr);
+
+  /*! \brief Export all the rows of \a model to \a writer
+   *
+   * \sa exportModel(const QAbstractItemModel &, const RowSelection &, const std::vector<int> &, DelimitedTextWriter &, TableExportProgress *)
+   */
+  MDT_ITEMMODEL_EXPORT
+  bool exportModel(const QAbstractItemModel & model, const std::vector<int> & columns,
+                   DelimitedTextWriter & writer, TableExportProgress *progress = nullptr);
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_TABLE_EXPORT_H
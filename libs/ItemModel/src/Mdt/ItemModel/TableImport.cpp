@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "TableImport.h"
+#include <QIODevice>
+#include <thread>
+
+namespace Mdt{ namespace ItemModel{
+
+int DelimitedTextImportOptions::effectiveThreadCount() const noexcept
+{
+  assert( threadCount >= 0 );
+
+  if(threadCount > 0){
+    return threadCount;
+  }
+
+  return std::max( static_cast<int>( std::thread::hardware_concurrency() ), 1 );
+}
+
+bool MappedFile::open(const QString & filePath)
+{
+  assert( !mFile.isOpen() );
+
+  mFile.setFileName(filePath);
+  if( !mFile.open(QIODevice::ReadOnly) ){
+    return false;
+  }
+
+  const qint64 fileSize = mFile.size();
+  if(fileSize <= 0){
+    return true;
+  }
+
+  const uchar *mappedData = mFile.map(0, fileSize);
+  if(mappedData != nullptr){
+    mData = reinterpret_cast<const char*>(mappedData);
+    mSize = static_cast<std::size_t>(fileSize);
+    return true;
+  }
+
+  mReadData = mFile.readAll();
+  if( mReadData.size() != fileSize ){
+    mReadData.clear();
+    return false;
+  }
+  mData = mReadData.constData();
+  mSize = static_cast<std::size_t>( mReadData.size() );
+
+  return true;
+}
+
+}} // namespace Mdt{ namespace ItemModel{
@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_TABLE_IMPORT_H
+#define MDT_ITEM_MODEL_TABLE_IMPORT_H
+
+#include "Mdt/ItemModel/DelimitedTextParser.h"
+#include "Mdt/ItemModel/DelimitedTextWriter.h"
+#include "mdt_itemmodel_export.h"
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Options of a delimited text import
+   *
+   * \sa importDelimitedText()
+   */
+  struct MDT_ITEMMODEL_EXPORT DelimitedTextImportOptions
+  {
+    /*! \brief Format of the text
+     */
+    DelimitedTextFormat format = DelimitedTextFormat::Csv;
+
+    /*! \brief If true, the first row is a header, which is not imported
+     */
+    bool hasHeaderRow = false;
+
+    /*! \brief Count of threads used to import the text
+     *
+     * If 0, the count of hardware threads is used.
+     */
+    int threadCount = 0;
+
+    /*! \internal Get the count of threads to use
+     */
+    int effectiveThreadCount() const noexcept;
+  };
+
+  /*! \brief Minimum count of rows parsed by a thread
+   *
+   * \sa importDelimitedText()
+   */
+  constexpr std::size_t delimitedTextImportMinimumRowsPerTask = 4096;
+
+  /*! \brief Read-only view of the content of a file
+   *
+   * The file is mapped in memory with QFile::map() ,
+   * so the pages are loaded by the system as they are accessed,
+   * without copying them to a buffer.
+   * If the file can not be mapped (for example a empty file, or a device that does not support it),
+   * it is read in memory.
+   *
+   * \sa importDelimitedTextFile()
+   */
+  class MDT_ITEMMODEL_EXPORT MappedFile
+  {
+   public:
+
+    MappedFile() = default;
+
+    MappedFile(const MappedFile & other) = delete;
+    MappedFile & operator=(const MappedFile & other) = delete;
+    MappedFile(MappedFile && other) = delete;
+    MappedFile & operator=(MappedFile && other) = delete;
+
+    /*! \brief Open and map the file at \a filePath
+     *
+     * Returns false if the file could not be opened or read.
+     *
+     * \pre this file must not already be open
+     */
+    bool open(const QString & filePath);
+
+    /*! \brief Get the content of the file
+     *
+     * Returns a nullptr if the file is empty or not open.
+     */
+    const char *data() const noexcept
+    {
+      return mData;
+    }
+
+    /*! \brief Get the size, in bytes, of the file
+     */
+    std::size_t size() const noexcept
+    {
+      return mSize;
+    }
+
+    /*! \brief Get a description of the last error
+     */
+    QString errorString() const
+    {
+      return mFile.errorString();
+    }
+
+   private:
+
+    QFile mFile;
+    QByteArray mReadData;
+    const char *mData = nullptr;
+    std::size_t mSize = 0;
+  };
+
+  /*! \brief Import the delimited text of \a size bytes starting at \a data to \a records
+   *
+   * The rows are found in parallel chunks with findDelimitedTextRowStarts() .
+   * Then, the rows are split into contiguous ranges,
+   * one per thread, and each thread parses its range directly in \a records .
+   *
+   * Each row is parsed to a DelimitedTextRow ,
+   * which is passed to \a parseRecord as parseRecord(const DelimitedTextRow & row, Record & record) .
+   * \a parseRecord converts the fields to the typed members of \a record
+   * and returns true, or returns false if the row is not valid.
+   * It is called concurrently from several threads, so it must not modify shared state.
+   * If \a parseRecord throws, the exception is rethrown once all threads are finished,
+   * and \a records is cleared.
+   * Blank rows are ignored.
+   *
+   * Returns true if all rows have been imported.
+   * If a row is not valid, false is returned and \a records is cleared.
+   *
+   * The result can be handed to a model with a single insertRows signal
+   * with AbstractTableModel::appendRecordsToTable() ,
+   * or with a single reset with AbstractTableModel::assignRecordsToTable() .
+   *
+   * \code
+   * const auto parseRecord = [](const DelimitedTextRow & row, DeviceListRecord & record){
+   *   if(row.fieldCount() != 2){
+   *     return false;
+   *   }
+   *   record.description = row.toQString(1);
+   *   return row.toInt(0, record.id);
+   * };
+   *
+   * // In a worker thread
+   * std::vector<DeviceListRecord> records;
+   * DelimitedTextImportOptions options;
+   * options.hasHeaderRow = true;
+   * importDelimitedTextFile(path, parseRecord, records, options);
+   *
+   * // Back in the GUI thread
+   * model.appendRecords( std::move(records) );
+   * \endcode
+   *
+   * \pre \a data must not be a nullptr if \a size is not 0
+   * \pre \a Record must be default constructible
+   * \sa importDelimitedTextFile()
+   */
+  template<typename Record, typename ParseRecord>
+  bool importDelimitedText(const char *data, std::size_t size, const ParseRecord & parseRecord,
+                           std::vector<Record> & records, const DelimitedTextImportOptions & options = DelimitedTextImportOptions())
+  {
+    assert( (data != nullptr) || (size == 0) );
+
+    records.clear();
+
+    const int threadCount = options.effectiveThreadCount();
+    const std::vector<std::size_t> rowStarts = findDelimitedTextRowStarts(data, size, threadCount);
+
+    const std::size_t firstRow = ( options.hasHeaderRow && !rowStarts.empty() ) ? 1 : 0;
+    const std::size_t rowCount = rowStarts.size() - firstRow;
+    if(rowCount == 0){
+      return true;
+    }
+
+    const std::size_t maxTaskCount = (rowCount + delimitedTextImportMinimumRowsPerTask - 1) / delimitedTextImportMinimumRowsPerTask;
+    const std::size_t taskCount = std::min( static_cast<std::size_t>(threadCount), maxTaskCount );
+
+    records.resize(rowCount);
+    std::vector<std::size_t> taskRecordCounts(taskCount, 0);
+    std::vector<char> taskSucceeded(taskCount, 1);
+
+    // std::localeconv() is not thread safe, so it is read here, once
+    const char cDecimalPoint = cLocaleDecimalPoint();
+
+    const auto taskFirstRow = [firstRow, rowCount, taskCount](std::size_t task){
+      return firstRow + (rowCount * task) / taskCount;
+    };
+
+    const auto parseTaskRows = [&](int taskIndex){
+      const auto task = static_cast<std::size_t>(taskIndex);
+      const std::size_t first = taskFirstRow(task);
+      const std::size_t last = taskFirstRow(task + 1);
+      auto out = std::next( records.begin(), static_cast<std::ptrdiff_t>(first - firstRow) );
+      DelimitedTextRow row(cDecimalPoint);
+
+      for(std::size_t r = first; r < last; ++r){
+        const std::size_t rowBegin = rowStarts[r];
+        std::size_t rowEnd = (r + 1 < rowStarts.size()) ? rowStarts[r + 1] : size;
+        if( (rowEnd > rowBegin) && (data[rowEnd - 1] == '\n') ){
+          --rowEnd;
+        }
+        if( (rowEnd == rowBegin) || ( (rowEnd == rowBegin + 1) && (data[rowBegin] == '\r') ) ){
+          continue;
+        }
+        row.parse(data + rowBegin, data + rowEnd, options.format);
+        if( !parseRecord(row, *out) ){
+          taskSucceeded[task] = 0;
+          return;
+        }
+        ++out;
+        ++taskRecordCounts[task];
+      }
+    };
+    try{
+      runInParallel( static_cast<int>(taskCount), parseTaskRows );
+    }catch(...){
+      records.clear();
+      throw;
+    }
+
+    if( std::find(taskSucceeded.cbegin(), taskSucceeded.cend(), 0) != taskSucceeded.cend() ){
+      records.clear();
+      return false;
+    }
+
+    // Close the gaps left by blank rows
+    auto out = std::next( records.begin(), static_cast<std::ptrdiff_t>(taskRecordCounts[0]) );
+    for(std::size_t task = 1; task < taskCount; ++task){
+      const auto first = std::next( records.begin(), static_cast<std::ptrdiff_t>(taskFirstRow(task) - firstRow) );
+      const auto last = std::next( first, static_cast<std::ptrdiff_t>(taskRecordCounts[task]) );
+      if(out == first){
+        out = last;
+      }else{
+        out = std::move(first, last, out);
+      }
+    }
+    records.erase( out, records.end() );
+
+    return true;
+  }
+
+  /*! \brief Import the delimited text file at \a filePath to \a records
+   *
+   * The file is mapped in memory with MappedFile ,
+   * and imported with importDelimitedText() .
+   *
+   * Returns false if the file could not be read,
+   * or if a row is not valid.
+   */
+  template<typename Record, typename ParseRecord>
+  bool importDelimitedTextFile(const QString & filePath, const ParseRecord & parseRecord,
+                               std::vector<Record> & records, const DelimitedTextImportOptions & options = DelimitedTextImportOptions())
+  {
+    MappedFile file;
+    if( !file.open(filePath) ){
+      records.clear();
+      return false;
+    }
+
+    return importDelimitedText(file.data(), file.size(), parseRecord, records, options);
+  }
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_TABLE_IMPORT_H
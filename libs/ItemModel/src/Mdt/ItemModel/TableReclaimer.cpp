@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "TableReclaimer.h"
+
+namespace Mdt{ namespace ItemModel{
+
+TableReclaimer::~TableReclaimer() noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mWakeUp.notify_one();
+
+  if( mThread.joinable() ){
+    mThread.join();
+  }
+}
+
+void TableReclaimer::waitForReclaimed() noexcept
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mReclaimed.wait(lock, [this](){
+    return mQueue.empty() && !mIsDestroying;
+  });
+}
+
+void TableReclaimer::push(std::unique_ptr<AbstractGarbage> garbage)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueue.push_back( std::move(garbage) );
+    if( !mThread.joinable() ){
+      mThread = std::thread(&TableReclaimer::run, this);
+    }
+  }
+  mWakeUp.notify_one();
+}
+
+void TableReclaimer::run() noexcept
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+
+  while(true){
+    mWakeUp.wait(lock, [this](){
+      return mStop || !mQueue.empty();
+    });
+    // When stopping, the pending objects are still destroyed
+    if( mQueue.empty() ){
+      return;
+    }
+
+    std::unique_ptr<AbstractGarbage> garbage = std::move( mQueue.front() );
+    mQueue.pop_front();
+    mIsDestroying = true;
+
+    lock.unlock();
+    garbage.reset();
+    lock.lock();
+
+    mIsDestroying = false;
+    if( mQueue.empty() ){
+      mReclaimed.notify_all();
+    }
+  }
+}
+
+}} // namespace Mdt{ namespace ItemModel{
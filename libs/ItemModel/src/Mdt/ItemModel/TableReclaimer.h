@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_TABLE_RECLAIMER_H
+#define MDT_ITEM_MODEL_TABLE_RECLAIMER_H
+
+#include "mdt_itemmodel_export.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Destroys objects, typically replaced tables, in a background thread
+   *
+   * Destroying a big table, for example a std::vector of records having std::string members,
+   * frees each string one by one, which can freeze the GUI thread.
+   *
+   * TableReclaimer takes the ownership of such objects
+   * and destroys them in its own thread.
+   *
+   * \code
+   * void DeviceListTableModel::setTable(DeviceListTable && table)
+   * {
+   *   replaceTable( mTable, std::move(table), mReclaimer );
+   * }
+   * \endcode
+   *
+   * The thread is started the first time a object is given to reclaim() .
+   *
+   * \note Destroying the objects given to reclaim() must be safe in a other thread.
+   *  For example, records may hold implicitly shared Qt types (like QString),
+   *  but no QObject.
+   *
+   * \sa AbstractTableModel::replaceTable()
+   */
+  class MDT_ITEMMODEL_EXPORT TableReclaimer
+  {
+   public:
+
+    /*! \brief Construct a reclaimer
+     */
+    TableReclaimer() noexcept = default;
+
+    /*! \brief Destroy this reclaimer
+     *
+     * The objects that have not been destroyed yet are destroyed,
+     * then the thread is joined.
+     */
+    ~TableReclaimer() noexcept;
+
+    TableReclaimer(const TableReclaimer &) = delete;
+    TableReclaimer & operator=(const TableReclaimer &) = delete;
+    TableReclaimer(TableReclaimer &&) = delete;
+    TableReclaimer & operator=(TableReclaimer &&) = delete;
+
+    /*! \brief Take the ownership of \a object and destroy it in the thread of this reclaimer
+     *
+     * \a object is moved, which, for a STL container,
+     * only transfers its storage.
+     */
+    template<typename T>
+    void reclaim(T && object)
+    {
+      static_assert( !std::is_lvalue_reference<T>::value, "reclaim() takes the ownership of object, so it must be a rvalue" );
+
+      push( std::make_unique< Garbage<T> >( std::move(object) ) );
+    }
+
+    /*! \brief Wait until all the objects given to reclaim() have been destroyed
+     */
+    void waitForReclaimed() noexcept;
+
+   private:
+
+    struct AbstractGarbage
+    {
+      virtual ~AbstractGarbage() = default;
+    };
+
+    template<typename T>
+    struct Garbage : AbstractGarbage
+    {
+      explicit Garbage(T && o)
+       : object( std::move(o) )
+      {
+      }
+
+      T object;
+    };
+
+    void push(std::unique_ptr<AbstractGarbage> garbage);
+    void run() noexcept;
+
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::condition_variable mReclaimed;
+    std::deque< std::unique_ptr<AbstractGarbage> > mQueue;
+    bool mIsDestroying = false;
+    bool mStop = false;
+    std::thread mThread;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_TABLE_RECLAIMER_H
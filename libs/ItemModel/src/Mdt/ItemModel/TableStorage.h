@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_TABLE_STORAGE_H
+#define MDT_ITEM_MODEL_TABLE_STORAGE_H
+
+#include "Mdt/ItemModel/StlHelpers.h"
+#include "Mdt/ItemModel/ChunkedTable.h"
+#include <iterator>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Row based operations on the storage of a table model
+   *
+   * This gives a common interface to generic algorithms,
+   * like AbstractTableModel::replaceTableByKey() ,
+   * regardless of the container used to store the records.
+   *
+   * This primary template works with STL sequence containers
+   * that have random access iterators, like std::vector or RingBuffer.
+   * A specialization exists for ChunkedTable.
+   */
+  template<typename Table>
+  struct TableStorage
+  {
+    /*! \brief Type of a record
+     */
+    using value_type = typename Table::value_type;
+
+    /*! \brief Replace the records of \a table with the ones in range [\a first, \a last)
+     */
+    template<typename ForwardIt>
+    static
+    void assign(Table & table, ForwardIt first, ForwardIt last)
+    {
+      table.assign(first, last);
+    }
+
+    /*! \brief Insert the records in range [\a first, \a last) before \a row
+     */
+    template<typename ForwardIt>
+    static
+    void insertRows(Table & table, int row, ForwardIt first, ForwardIt last)
+    {
+      assert( row >= 0 );
+
+      table.insert(std::next( table.begin(), static_cast<typename Table::difference_type>(row) ), first, last);
+    }
+
+    /*! \brief Remove \a count rows starting from \a row
+     */
+    static
+    void removeRows(Table & table, int row, int count)
+    {
+      removeFromStlContainer(table, row, count);
+    }
+
+    /*! \brief Move \a count rows starting from \a row before \a destinationRow
+     */
+    static
+    void moveRows(Table & table, int row, int count, int destinationRow)
+    {
+      moveInStlContainer(table, row, count, destinationRow);
+    }
+
+    /*! \brief Set \a record at \a row
+     */
+    static
+    void setRecord(Table & table, int row, const value_type & record)
+    {
+      assert( row >= 0 );
+
+      table[static_cast<typename Table::size_type>(row)] = record;
+    }
+  };
+
+  /*! \brief Row based operations on a ChunkedTable
+   */
+  template<typename T>
+  struct TableStorage< ChunkedTable<T> >
+  {
+    using Table = ChunkedTable<T>;
+    using value_type = T;
+
+    template<typename ForwardIt>
+    static
+    void assign(Table & table, ForwardIt first, ForwardIt last)
+    {
+      table.assign(first, last);
+    }
+
+    template<typename ForwardIt>
+    static
+    void insertRows(Table & table, int row, ForwardIt first, ForwardIt last)
+    {
+      assert( row >= 0 );
+
+      table.insert(static_cast<std::size_t>(row), first, last);
+    }
+
+    static
+    void removeRows(Table & table, int row, int count)
+    {
+      assert( row >= 0 );
+      assert( count >= 1 );
+
+      table.erase( static_cast<std::size_t>(row), static_cast<std::size_t>(count) );
+    }
+
+    static
+    void moveRows(Table & table, int row, int count, int destinationRow)
+    {
+      assert( row >= 0 );
+      assert( count >= 1 );
+      assert( destinationRow >= 0 );
+
+      table.move( static_cast<std::size_t>(row), static_cast<std::size_t>(count), static_cast<std::size_t>(destinationRow) );
+    }
+
+    static
+    void setRecord(Table & table, int row, const value_type & record)
+    {
+      assert( row >= 0 );
+
+      table.mutableAt( static_cast<std::size_t>(row) ) = record;
+    }
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_TABLE_STORAGE_H
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_TYPED_COLUMN_H
+#define MDT_ITEM_MODEL_TYPED_COLUMN_H
+
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Type erased strided view of the values of a column
+   *
+   * \a first points to the value of the first row of the view,
+   * and the value of the next row is \a stride bytes further.
+   *
+   * A model that stores its records in a array
+   * can describe a column with fromMember().
+   *
+   * \sa TypedColumn
+   * \sa AbstractTableModel::doGetTypedColumnData()
+   */
+  struct TypedColumnData
+  {
+    const void *first = nullptr;
+    std::ptrdiff_t stride = 0;
+    int rowCount = 0;
+
+    /*! \brief Check if this data is null
+     *
+     * A null data means that the model does not expose
+     * the requested column with the requested type.
+     */
+    bool isNull() const noexcept
+    {
+      return first == nullptr;
+    }
+
+    /*! \brief Get the data of \a member of the \a rowCount records starting at \a firstRecord
+     *
+     * \pre \a firstRecord must not be a nullptr
+     * \pre \a rowCount must be >= 1
+     */
+    template<typename Record, typename T>
+    static
+    TypedColumnData fromMember(const Record *firstRecord, int rowCount, T Record::*member) noexcept
+    {
+      assert( firstRecord != nullptr );
+      assert( rowCount >= 1 );
+
+      TypedColumnData data;
+      data.first = &(firstRecord->*member);
+      data.stride = static_cast<std::ptrdiff_t>( sizeof(Record) );
+      data.rowCount = rowCount;
+
+      return data;
+    }
+  };
+
+  /*! \brief Strided view of the values of type \a T of a column
+   *
+   * Gives access to the values of a column of a model
+   * without boxing them in a QVariant.
+   *
+   * \note A TypedColumn refers to the storage of the model,
+   *  and is only valid until the model is modified.
+   *
+   * \sa AbstractTableModel::typedColumn()
+   */
+  template<typename T>
+  class TypedColumn
+  {
+   public:
+
+    /*! \brief Construct a null view
+     */
+    TypedColumn() noexcept = default;
+
+    /*! \brief Construct a view from \a data
+     *
+     * \pre \a data must refer to values of type \a T
+     */
+    explicit TypedColumn(const TypedColumnData & data) noexcept
+     : mData(data)
+    {
+    }
+
+    /*! \brief Check if this view is null
+     */
+    bool isNull() const noexcept
+    {
+      return mData.isNull();
+    }
+
+    /*! \brief Get the count of rows in this view
+     */
+    int rowCount() const noexcept
+    {
+      return mData.rowCount;
+    }
+
+    /*! \brief Get the value at \a row
+     *
+     * \pre \a row must be in valid range ( 0 <= \a row < rowCount() )
+     */
+    const T & operator[](int row) const noexcept
+    {
+      assert( !isNull() );
+      assert( row >= 0 );
+      assert( row < rowCount() );
+
+      const char *first = static_cast<const char*>(mData.first);
+
+      return *reinterpret_cast<const T*>( first + static_cast<std::ptrdiff_t>(row) * mData.stride );
+    }
+
+   private:
+
+    TypedColumnData mData;
+  };
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_TYPED_COLUMN_H
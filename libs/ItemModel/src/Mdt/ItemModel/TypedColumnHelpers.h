@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_MODEL_TYPED_COLUMN_HELPERS_H
+#define MDT_ITEM_MODEL_TYPED_COLUMN_HELPERS_H
+
+#include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include <QAbstractItemModel>
+#include <QVariant>
+#include <QMetaType>
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace ItemModel{
+
+  /*! \brief Call \a visitor for each value of \a column in \a rows of \a model
+   *
+   * \a visitor is called as visitor(int row, const T & value) ,
+   * in the order of the rows.
+   *
+   * If \a role is Qt::DisplayRole or Qt::EditRole ,
+   * and \a model is a AbstractTableModel that exposes \a column with the type \a T ,
+   * the values are read directly in its storage (see AbstractTableModel::visitTypedColumn() ).
+   * Otherwise, the values are get with data() for \a role , and converted with qvariant_cast<T>() .
+   * Because of this fallback, \a T must be a type known to QVariant
+   * (a builtin type, or a type declared with Q_DECLARE_METATYPE() ).
+   * For other types, like std::string , use AbstractTableModel::visitTypedColumn() directly.
+   *
+   * \pre \a column must be in valid range
+   * \pre \a rows must be in valid range
+   */
+  template<typename T, typename Visitor>
+  void forEachColumnValue(const QAbstractItemModel & model, int column, const RowRange & rows,
+                          const Visitor & visitor, Qt::ItemDataRole role = Qt::DisplayRole)
+  {
+    static_assert( QMetaTypeId2<T>::Defined, "T must be a type known to QVariant" );
+    assert( modelRowAndColumnAreInRange(model, rows.firstRow(), column) );
+    assert( modelRowAndColumnAreInRange(model, rows.lastRow(), column) );
+
+    if( (role == Qt::DisplayRole) || (role == Qt::EditRole) ){
+      const auto *tableModel = qobject_cast<const AbstractTableModel*>(&model);
+      if( (tableModel != nullptr) && tableModel->visitTypedColumn<T>(column, rows, visitor) ){
+        return;
+      }
+    }
+
+    for(int row = rows.firstRow(); row <= rows.lastRow(); ++row){
+      const T value = qvariant_cast<T>( getModelData(model, row, column, role) );
+      visitor(row, value);
+    }
+  }
+
+  /*! \brief Get the values of \a column of \a model
+   *
+   * \a T must be a type known to QVariant .
+   *
+   * \sa forEachColumnValue()
+   * \pre \a column must be in valid range
+   */
+  template<typename T>
+  std::vector<T> getColumnValues(const QAbstractItemModel & model, int column, Qt::ItemDataRole role = Qt::DisplayRole)
+  {
+    assert( column >= 0 );
+    assert( column < model.columnCount() );
+
+    std::vector<T> values;
+
+    const int rowCount = model.rowCount();
+    if(rowCount == 0){
+      return values;
+    }
+    values.reserve( static_cast<std::size_t>(rowCount) );
+
+    const auto appendValue = [&values](int, const T & value){
+      values.push_back(value);
+    };
+    forEachColumnValue<T>(model, column, RowRange::fromFirstAndLastRow(0, rowCount - 1), appendValue, role);
+
+    return values;
+  }
+
+}} // namespace Mdt{ namespace ItemModel{
+
+#endif // #ifndef MDT_ITEM_MODEL_TYPED_COLUMN_HELPERS_H
@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "EditCommandsTableModel.h"
+#include "RemoveFirstRowTableModel.h"
+#include "Mdt/ItemModel/TableEditCommand.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TestLib/InsertRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/RemoveRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/DataChangedSignalSpy.h"
+#include <QVariant>
+#include <QLatin1String>
+#include <vector>
+#include <string>
+#include <utility>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+/*
+ * Populates the model with ids 0 to rowCount-1
+ */
+void populateModel(TableModelCommonBase & model, int rowCount)
+{
+  TableModelCommonBase::Table table;
+
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "N" + std::to_string(id)} );
+  }
+
+  model.setTable(table);
+}
+
+std::vector<int> idsInModel(const TableModelCommonBase & model)
+{
+  std::vector<int> ids;
+
+  for(int row = 0; row < model.rowCount(); ++row){
+    ids.push_back( getModelData(model, row, 0).toInt() );
+  }
+
+  return ids;
+}
+
+/*
+ * Records the items in the order they are set
+ */
+class SetDataOrderTableModel : public EditCommandsTableModel
+{
+ public:
+
+  std::vector< std::pair<int, int> > setItems;
+
+ private:
+
+  bool setEditRoleData(const QModelIndex & index, const QVariant & value) noexcept override
+  {
+    setItems.emplace_back( index.row(), index.column() );
+
+    return setDataInTable(index, value);
+  }
+};
+
+
+TEST_CASE("setData")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 6);
+  DataChangedSignalSpy dataChangedSpy(model);
+  std::vector<TableEditCommand> commands;
+
+  SECTION("updates of the same item are coalesced")
+  {
+    commands.push_back( TableEditCommand::setData(1, 0, 10) );
+    commands.push_back( TableEditCommand::setData(1, 0, 11) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( getModelData(model, 1, 0) == QVariant(11) );
+    REQUIRE( dataChangedSpy.count() == 1 );
+    REQUIRE( dataChangedSpy.firstTopLeftIndex() == model.index(1, 0) );
+    REQUIRE( dataChangedSpy.firstBottomRightIndex() == model.index(1, 0) );
+  }
+
+  SECTION("contiguous rows are reported together")
+  {
+    commands.push_back( TableEditCommand::setData(2, 0, 20) );
+    commands.push_back( TableEditCommand::setData(0, 1, QLatin1String("A")) );
+    commands.push_back( TableEditCommand::setData(1, 0, 10) );
+    commands.push_back( TableEditCommand::setData(5, 1, QLatin1String("F")) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( getModelData(model, 0, 1) == QLatin1String("A") );
+    REQUIRE( getModelData(model, 1, 0) == QVariant(10) );
+    REQUIRE( getModelData(model, 2, 0) == QVariant(20) );
+    REQUIRE( getModelData(model, 5, 1) == QLatin1String("F") );
+    REQUIRE( dataChangedSpy.count() == 2 );
+    REQUIRE( dataChangedSpy.at(0).topLeftIndex() == model.index(0, 0) );
+    REQUIRE( dataChangedSpy.at(0).bottomRightIndex() == model.index(2, 1) );
+    REQUIRE( dataChangedSpy.at(1).topLeftIndex() == model.index(5, 0) );
+    REQUIRE( dataChangedSpy.at(1).bottomRightIndex() == model.index(5, 1) );
+  }
+
+  SECTION("out of range item")
+  {
+    commands.push_back( TableEditCommand::setData(6, 0, 60) );
+    commands.push_back( TableEditCommand::setData(0, 2, 2) );
+    commands.push_back( TableEditCommand::setData(0, 0, 10) );
+
+    REQUIRE( !model.applyEditCommands(commands) );
+    REQUIRE( getModelData(model, 0, 0) == QVariant(10) );
+    REQUIRE( dataChangedSpy.count() == 1 );
+  }
+}
+
+TEST_CASE("setData_order")
+{
+  using Item = std::pair<int, int>;
+
+  SetDataOrderTableModel model;
+  populateModel(model, 6);
+  std::vector<TableEditCommand> commands;
+
+  SECTION("items are set in the order of the commands")
+  {
+    commands.push_back( TableEditCommand::setData(4, 1, QLatin1String("E")) );
+    commands.push_back( TableEditCommand::setData(0, 0, 10) );
+    commands.push_back( TableEditCommand::setData(2, 1, QLatin1String("C")) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( model.setItems == std::vector<Item>{{4,1},{0,0},{2,1}} );
+  }
+
+  SECTION("a coalesced item takes the place of its last command")
+  {
+    commands.push_back( TableEditCommand::setData(3, 0, 30) );
+    commands.push_back( TableEditCommand::setData(1, 0, 10) );
+    commands.push_back( TableEditCommand::setData(3, 0, 31) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( model.setItems == std::vector<Item>{{1,0},{3,0}} );
+    REQUIRE( getModelData(model, 3, 0) == QVariant(31) );
+  }
+}
+
+TEST_CASE("insertRows")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 3);
+  InsertRowsSignalsSpy insertSpy(model);
+  DataChangedSignalSpy dataChangedSpy(model);
+  std::vector<TableEditCommand> commands;
+
+  SECTION("adjacent inserts are merged")
+  {
+    commands.push_back( TableEditCommand::insertRows(3, 1) );
+    commands.push_back( TableEditCommand::insertRows(4, 2) );
+    commands.push_back( TableEditCommand::insertRows(3, 1) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( model.rowCount() == 7 );
+    REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+    REQUIRE( insertSpy.rowsInsertedAt(0).first() == 3 );
+    REQUIRE( insertSpy.rowsInsertedAt(0).last() == 6 );
+  }
+
+  SECTION("inserts that are not adjacent")
+  {
+    commands.push_back( TableEditCommand::insertRows(0, 1) );
+    commands.push_back( TableEditCommand::insertRows(3, 1) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( idsInModel(model) == std::vector<int>{0,0,1,0,2} );
+    REQUIRE( insertSpy.rowsInsertedCount() == 2 );
+  }
+
+  SECTION("append rows and set their data")
+  {
+    for(int i = 0; i < 3; ++i){
+      commands.push_back( TableEditCommand::insertRows(3 + i, 1) );
+      commands.push_back( TableEditCommand::setData(3 + i, 0, 3 + i) );
+      commands.push_back( TableEditCommand::setData(3 + i, 1, QLatin1String("new")) );
+    }
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,3,4,5} );
+    REQUIRE( insertSpy.rowsInsertedCount() == 3 );
+    REQUIRE( dataChangedSpy.count() == 3 );
+  }
+
+  SECTION("append rows then set their data")
+  {
+    for(int i = 0; i < 3; ++i){
+      commands.push_back( TableEditCommand::insertRows(3 + i, 1) );
+    }
+    for(int i = 0; i < 3; ++i){
+      commands.push_back( TableEditCommand::setData(3 + i, 0, 3 + i) );
+    }
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,3,4,5} );
+    REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+    REQUIRE( dataChangedSpy.count() == 1 );
+    REQUIRE( dataChangedSpy.firstTopLeftIndex() == model.index(3, 0) );
+    REQUIRE( dataChangedSpy.firstBottomRightIndex() == model.index(5, 0) );
+  }
+
+  SECTION("out of range insert")
+  {
+    commands.push_back( TableEditCommand::insertRows(4, 1) );
+    commands.push_back( TableEditCommand::insertRows(3, 1) );
+
+    REQUIRE( !model.applyEditCommands(commands) );
+    REQUIRE( model.rowCount() == 4 );
+  }
+}
+
+TEST_CASE("removeRows")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 10);
+  RemoveRowsSignalsSpy removeSpy(model);
+  std::vector<TableEditCommand> commands;
+
+  SECTION("adjacent removes are merged")
+  {
+    commands.push_back( TableEditCommand::removeRows(5, 2) );
+    commands.push_back( TableEditCommand::removeRows(3, 2) );
+    commands.push_back( TableEditCommand::removeRows(3, 1) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,8,9} );
+    REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).first() == 3 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).last() == 7 );
+  }
+
+  SECTION("removes that are not adjacent")
+  {
+    commands.push_back( TableEditCommand::removeRows(0, 1) );
+    commands.push_back( TableEditCommand::removeRows(2, 1) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( idsInModel(model) == std::vector<int>{1,2,4,5,6,7,8,9} );
+    REQUIRE( removeSpy.rowsRemovedCount() == 2 );
+  }
+
+  SECTION("data set before and after a remove")
+  {
+    DataChangedSignalSpy dataChangedSpy(model);
+    commands.push_back( TableEditCommand::setData(1, 0, 100) );
+    commands.push_back( TableEditCommand::removeRows(0, 1) );
+    commands.push_back( TableEditCommand::setData(0, 0, 101) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+    REQUIRE( getModelData(model, 0, 0) == QVariant(101) );
+    REQUIRE( dataChangedSpy.count() == 2 );
+    REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+  }
+
+  SECTION("out of range remove")
+  {
+    commands.push_back( TableEditCommand::removeRows(8, 3) );
+    commands.push_back( TableEditCommand::removeRows(0, 1) );
+
+    REQUIRE( !model.applyEditCommands(commands) );
+    REQUIRE( model.rowCount() == 9 );
+  }
+}
+
+TEST_CASE("removeRows_not_merged_if_not_supported")
+{
+  RemoveFirstRowTableModel model;
+  populateModel(model, 3);
+  RemoveRowsSignalsSpy removeSpy(model);
+  std::vector<TableEditCommand> commands;
+
+  commands.push_back( TableEditCommand::removeRows(0, 1) );
+  commands.push_back( TableEditCommand::removeRows(0, 1) );
+
+  REQUIRE( model.applyEditCommands(commands) );
+  REQUIRE( idsInModel(model) == std::vector<int>{2} );
+  REQUIRE( removeSpy.rowsRemovedCount() == 2 );
+}
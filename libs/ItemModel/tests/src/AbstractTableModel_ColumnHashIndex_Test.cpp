@@ -0,0 +1,360 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "EditCommandsTableModel.h"
+#include "MoveRowsTableModel.h"
+#include "Mdt/ItemModel/ColumnHashIndex.h"
+#include "Mdt/ItemModel/TableEditCommand.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include <QObject>
+#include <QModelIndex>
+#include <QModelIndexList>
+#include <QVariant>
+#include <QString>
+#include <QLatin1String>
+#include <vector>
+#include <string>
+
+using namespace Mdt::ItemModel;
+
+/*
+ * Populates the model with ids 0 to rowCount-1
+ * and names N0 to N(rowCount-1)
+ */
+template<typename Model>
+void populateModel(Model & model, int rowCount)
+{
+  typename Model::Table table;
+
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "N" + std::to_string(id)} );
+  }
+
+  model.setTable(table);
+}
+
+std::vector<int> rowsOfIndexes(const QModelIndexList & indexes)
+{
+  std::vector<int> rows;
+
+  for(const QModelIndex & index : indexes){
+    rows.push_back( index.row() );
+  }
+
+  return rows;
+}
+
+/*
+ * Keys are row numbers in a vector,
+ * so the index can be tested without a model
+ */
+struct VectorKeys
+{
+  std::vector<QString> keys;
+
+  QString operator()(int row) const
+  {
+    return keys[static_cast<size_t>(row)];
+  }
+
+  int rowCount() const
+  {
+    return static_cast<int>( keys.size() );
+  }
+};
+
+
+TEST_CASE("ColumnHashIndex")
+{
+  VectorKeys keys;
+  keys.keys = {QLatin1String("A"), QLatin1String("B"), QLatin1String("A")};
+  ColumnHashIndex index(1);
+
+  REQUIRE( index.column() == 1 );
+  REQUIRE( !index.isUpToDate() );
+
+  index.update(keys.rowCount(), keys);
+  REQUIRE( index.isUpToDate() );
+  REQUIRE( index.rowsForKey( QLatin1String("A") ) == std::vector<int>{0,2} );
+  REQUIRE( index.rowsForKey( QLatin1String("B") ) == std::vector<int>{1} );
+  REQUIRE( index.rowsForKey( QLatin1String("C") ).empty() );
+
+  SECTION("append rows")
+  {
+    index.rowsAboutToBeInserted(3, 4);
+    REQUIRE( !index.isUpToDate() );
+    REQUIRE( index.pendingRowCount() == 2 );
+    keys.keys.push_back( QLatin1String("C") );
+    keys.keys.push_back( QLatin1String("B") );
+
+    index.update(keys.rowCount(), keys);
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( index.rowsForKey( QLatin1String("B") ) == std::vector<int>{1,4} );
+    REQUIRE( index.rowsForKey( QLatin1String("C") ) == std::vector<int>{3} );
+  }
+
+  SECTION("remove last rows")
+  {
+    index.rowsAboutToBeRemoved(1, 2);
+    keys.keys.resize(1);
+
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( index.indexedRowCount() == 1 );
+    REQUIRE( index.rowsForKey( QLatin1String("A") ) == std::vector<int>{0} );
+    REQUIRE( index.rowsForKey( QLatin1String("B") ).empty() );
+  }
+
+  SECTION("change data")
+  {
+    keys.keys[0] = QLatin1String("B");
+    index.rowsDataChanged(0, 0);
+    REQUIRE( index.pendingRowCount() == 1 );
+
+    index.update(keys.rowCount(), keys);
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( index.rowsForKey( QLatin1String("A") ) == std::vector<int>{2} );
+    REQUIRE( index.rowsForKey( QLatin1String("B") ) == std::vector<int>{0,1} );
+  }
+
+  SECTION("insert and remove rows in the middle")
+  {
+    index.rowsAboutToBeInserted(1, 1);
+    keys.keys.insert( keys.keys.begin() + 1, QLatin1String("C") );
+    REQUIRE( index.pendingRowCount() == 1 );
+
+    index.rowsAboutToBeRemoved(2, 2);
+    keys.keys.erase( keys.keys.begin() + 2 );
+    REQUIRE( index.pendingRowCount() == 1 );
+
+    keys.keys[0] = QLatin1String("D");
+    index.rowsDataChanged(0, 0);
+    REQUIRE( index.pendingRowCount() == 2 );
+
+    index.update(keys.rowCount(), keys);
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( index.rowsForKey( QLatin1String("A") ) == std::vector<int>{2} );
+    REQUIRE( index.rowsForKey( QLatin1String("B") ).empty() );
+    REQUIRE( index.rowsForKey( QLatin1String("C") ) == std::vector<int>{1} );
+    REQUIRE( index.rowsForKey( QLatin1String("D") ) == std::vector<int>{0} );
+  }
+
+  SECTION("shifted rows are not read again")
+  {
+    index.rowsAboutToBeInserted(0, 0);
+    keys.keys.insert( keys.keys.begin(), QLatin1String("C") );
+
+    int readCount = 0;
+    const auto countingKeys = [&keys, &readCount](int row){
+      ++readCount;
+      return keys(row);
+    };
+    index.update(keys.rowCount(), countingKeys);
+    REQUIRE( readCount == 1 );
+    REQUIRE( index.rowsForKey( QLatin1String("A") ) == std::vector<int>{1,3} );
+    REQUIRE( index.rowsForKey( QLatin1String("B") ) == std::vector<int>{2} );
+    REQUIRE( index.rowsForKey( QLatin1String("C") ) == std::vector<int>{0} );
+  }
+
+  SECTION("move rows")
+  {
+    // A B A -> B A A
+    index.rowsAboutToBeMoved(1, 1, 0);
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( index.rowsForKey( QLatin1String("A") ) == std::vector<int>{1,2} );
+    REQUIRE( index.rowsForKey( QLatin1String("B") ) == std::vector<int>{0} );
+
+    // B A A -> A A B
+    index.rowsAboutToBeMoved(0, 0, 3);
+    REQUIRE( index.rowsForKey( QLatin1String("A") ) == std::vector<int>{0,1} );
+    REQUIRE( index.rowsForKey( QLatin1String("B") ) == std::vector<int>{2} );
+  }
+
+  SECTION("invalidate")
+  {
+    keys.keys = {QLatin1String("E")};
+    index.invalidate();
+    index.update(keys.rowCount(), keys);
+
+    REQUIRE( index.rowsForKey( QLatin1String("A") ).empty() );
+    REQUIRE( index.rowsForKey( QLatin1String("E") ) == std::vector<int>{0} );
+  }
+}
+
+TEST_CASE("addColumnHashIndex")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 3);
+
+  REQUIRE( !model.hasColumnHashIndex(0) );
+
+  model.addColumnHashIndex(0);
+  REQUIRE( model.hasColumnHashIndex(0) );
+  REQUIRE( !model.hasColumnHashIndex(1) );
+
+  model.removeColumnHashIndex(0);
+  REQUIRE( !model.hasColumnHashIndex(0) );
+}
+
+TEST_CASE("rowForKey")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 5);
+  model.addColumnHashIndex(0);
+  model.addColumnHashIndex(1);
+
+  REQUIRE( model.rowForKey(0, 3) == 3 );
+  REQUIRE( model.rowForKey(1, QLatin1String("N2")) == 2 );
+  REQUIRE( model.rowForKey(0, 10) == -1 );
+
+  SECTION("setData")
+  {
+    REQUIRE( model.setData(model.index(1, 0), 10) );
+
+    REQUIRE( model.rowForKey(0, 10) == 1 );
+    REQUIRE( model.rowForKey(0, 1) == -1 );
+    REQUIRE( model.rowForKey(1, QLatin1String("N1")) == 1 );
+  }
+
+  SECTION("append rows")
+  {
+    REQUIRE( appendRowToModel(model) );
+    REQUIRE( model.setData(model.index(5, 0), 5) );
+
+    REQUIRE( model.rowForKey(0, 5) == 5 );
+  }
+
+  SECTION("insert rows")
+  {
+    REQUIRE( model.insertRows(1, 2) );
+
+    REQUIRE( model.rowForKey(0, 0) == 0 );
+    REQUIRE( model.rowForKey(0, 1) == 3 );
+    REQUIRE( model.rowForKey(0, 4) == 6 );
+  }
+
+  SECTION("remove rows")
+  {
+    REQUIRE( model.removeRows(0, 2) );
+
+    REQUIRE( model.rowForKey(0, 0) == -1 );
+    REQUIRE( model.rowForKey(0, 2) == 0 );
+    REQUIRE( model.rowForKey(1, QLatin1String("N4")) == 2 );
+  }
+
+  SECTION("edit commands")
+  {
+    std::vector<TableEditCommand> commands;
+    commands.push_back( TableEditCommand::removeRows(4, 1) );
+    commands.push_back( TableEditCommand::insertRows(0, 1) );
+    commands.push_back( TableEditCommand::setData(0, 0, 20) );
+
+    REQUIRE( model.applyEditCommands(commands) );
+
+    REQUIRE( model.rowForKey(0, 20) == 0 );
+    REQUIRE( model.rowForKey(0, 3) == 4 );
+    REQUIRE( model.rowForKey(0, 4) == -1 );
+  }
+
+  SECTION("model reset")
+  {
+    populateModel(model, 2);
+    model.applyEditCommandsInModelReset({TableEditCommand::setData(1, 0, 7)});
+
+    REQUIRE( model.rowForKey(0, 7) == 1 );
+    REQUIRE( model.rowForKey(0, 3) == -1 );
+  }
+}
+
+TEST_CASE("rowForKey_moveRows")
+{
+  MoveRowsTableModel model;
+  populateModel(model, 5);
+  model.addColumnHashIndex(0);
+
+  REQUIRE( model.rowForKey(0, 4) == 4 );
+
+  REQUIRE( model.moveRows(QModelIndex(), 4, 1, QModelIndex(), 1) );
+
+  REQUIRE( model.rowForKey(0, 0) == 0 );
+  REQUIRE( model.rowForKey(0, 4) == 1 );
+  REQUIRE( model.rowForKey(0, 1) == 2 );
+}
+
+TEST_CASE("rowForKey_fromSlotConnectedBeforeTheIndex")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 5);
+
+  int rowOfKey3 = -2;
+  const auto onRowsRemoved = [&model, &rowOfKey3](){
+    rowOfKey3 = model.rowForKey(0, 3);
+  };
+  QObject::connect(&model, &EditCommandsTableModel::rowsRemoved, onRowsRemoved);
+
+  model.addColumnHashIndex(0);
+  REQUIRE( model.rowForKey(0, 3) == 3 );
+
+  REQUIRE( model.removeRows(0, 2) );
+  REQUIRE( rowOfKey3 == 1 );
+}
+
+TEST_CASE("match")
+{
+  EditCommandsTableModel model;
+  EditCommandsTableModel::Table table;
+  table.push_back( {1, "A"} );
+  table.push_back( {2, "B"} );
+  table.push_back( {3, "A"} );
+  table.push_back( {4, "AB"} );
+  table.push_back( {5, "A"} );
+  model.setTable(table);
+
+  const auto matchA = [&model](int startRow, int hits, Qt::MatchFlags flags){
+    return rowsOfIndexes( model.match(model.index(startRow, 1), Qt::DisplayRole, QLatin1String("A"), hits, flags) );
+  };
+
+  /*
+   * Results must be the same with and without the index
+   */
+  const bool withIndex = GENERATE(false, true);
+  if(withIndex){
+    model.addColumnHashIndex(1);
+  }
+
+  SECTION("exactly")
+  {
+    REQUIRE( matchA(0, 1, Qt::MatchExactly) == std::vector<int>{0} );
+    REQUIRE( matchA(0, -1, Qt::MatchExactly) == std::vector<int>{0,2,4} );
+    REQUIRE( matchA(1, -1, Qt::MatchExactly) == std::vector<int>{2,4} );
+    REQUIRE( matchA(3, 5, Qt::MatchExactly) == std::vector<int>{4} );
+  }
+
+  SECTION("exactly with wrap")
+  {
+    const Qt::MatchFlags flags(Qt::MatchExactly | Qt::MatchWrap);
+
+    REQUIRE( matchA(3, -1, flags) == std::vector<int>{4,0,2} );
+    REQUIRE( matchA(3, 2, flags) == std::vector<int>{4,0} );
+  }
+
+  SECTION("starts with (not using the index)")
+  {
+    REQUIRE( matchA(0, -1, Qt::MatchStartsWith) == std::vector<int>{0,2,3,4} );
+  }
+
+  SECTION("integer key")
+  {
+    const QModelIndexList indexes = model.match(model.index(0, 0), Qt::DisplayRole, 4, 1, Qt::MatchExactly);
+
+    REQUIRE( rowsOfIndexes(indexes) == std::vector<int>{3} );
+    REQUIRE( indexes.first().column() == 0 );
+  }
+}
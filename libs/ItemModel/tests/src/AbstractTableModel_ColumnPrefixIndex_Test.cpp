@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "EditCommandsTableModel.h"
+#include "Mdt/ItemModel/ColumnPrefixIndex.h"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include <QModelIndex>
+#include <QModelIndexList>
+#include <QVariant>
+#include <QString>
+#include <QLatin1String>
+#include <vector>
+#include <string>
+
+using namespace Mdt::ItemModel;
+
+std::vector<int> rowsOfRangeList(const RowRangeList & list)
+{
+  std::vector<int> rows;
+
+  for(const RowRange & range : list){
+    for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+      rows.push_back(row);
+    }
+  }
+
+  return rows;
+}
+
+std::vector<int> rowsOfIndexes(const QModelIndexList & indexes)
+{
+  std::vector<int> rows;
+
+  for(const QModelIndex & index : indexes){
+    rows.push_back( index.row() );
+  }
+
+  return rows;
+}
+
+/*
+ * Populates the model with given names,
+ * ids are 0 to names.size()-1
+ */
+void populateModel(EditCommandsTableModel & model, const std::vector<std::string> & names)
+{
+  EditCommandsTableModel::Table table;
+
+  for(size_t i = 0; i < names.size(); ++i){
+    table.push_back( {static_cast<int>(i), names[i]} );
+  }
+
+  model.setTable(table);
+}
+
+struct VectorTexts
+{
+  std::vector<QString> texts;
+
+  QString operator()(int row) const
+  {
+    return texts[static_cast<size_t>(row)];
+  }
+
+  int rowCount() const
+  {
+    return static_cast<int>( texts.size() );
+  }
+};
+
+
+TEST_CASE("ColumnPrefixIndex")
+{
+  VectorTexts texts;
+  texts.texts = {QLatin1String("Apple"), QLatin1String("banana"), QLatin1String("apricot"), QLatin1String("Avocado")};
+  ColumnPrefixIndex index(1);
+
+  REQUIRE( index.column() == 1 );
+  REQUIRE( !index.isUpToDate() );
+
+  index.update(texts.rowCount(), texts);
+  REQUIRE( index.isUpToDate() );
+  REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("a") ) ) == std::vector<int>{0,2,3} );
+  REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("AP") ) ) == std::vector<int>{0,2} );
+  REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("B") ) ) == std::vector<int>{1} );
+  REQUIRE( index.rowsStartingWith( QLatin1String("c") ).isEmpty() );
+  REQUIRE( rowsOfRangeList( index.rowsStartingWith( QString() ) ) == std::vector<int>{0,1,2,3} );
+
+  SECTION("range list")
+  {
+    const RowRangeList list = index.rowsStartingWith( QLatin1String("a") );
+
+    REQUIRE( list.rangeCount() == 2 );
+    REQUIRE( list.rangeAt(0).firstRow() == 0 );
+    REQUIRE( list.rangeAt(0).lastRow() == 0 );
+    REQUIRE( list.rangeAt(1).firstRow() == 2 );
+    REQUIRE( list.rangeAt(1).lastRow() == 3 );
+  }
+
+  SECTION("change data")
+  {
+    texts.texts[1] = QLatin1String("Almond");
+    index.rowsDataChanged(1, 1);
+    REQUIRE( !index.isUpToDate() );
+
+    index.update(texts.rowCount(), texts);
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("a") ) ) == std::vector<int>{0,1,2,3} );
+    REQUIRE( index.rowsStartingWith( QLatin1String("b") ).isEmpty() );
+  }
+
+  SECTION("insert and remove rows")
+  {
+    index.rowsAboutToBeInserted(1, 1);
+    texts.texts.insert( texts.texts.begin() + 1, QLatin1String("Cherry") );
+    REQUIRE( !index.isUpToDate() );
+
+    index.rowsAboutToBeRemoved(0, 0);
+    texts.texts.erase( texts.texts.begin() );
+    REQUIRE( index.pendingRowCount() == 1 );
+
+    index.update(texts.rowCount(), texts);
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("a") ) ) == std::vector<int>{2,3} );
+    REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("c") ) ) == std::vector<int>{0} );
+  }
+
+  SECTION("move rows")
+  {
+    // Apple banana apricot Avocado -> apricot Avocado Apple banana
+    index.rowsAboutToBeMoved(2, 3, 0);
+    texts.texts = {QLatin1String("apricot"), QLatin1String("Avocado"), QLatin1String("Apple"), QLatin1String("banana")};
+
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("a") ) ) == std::vector<int>{0,1,2} );
+    REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("ap") ) ) == std::vector<int>{0,2} );
+    REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("b") ) ) == std::vector<int>{3} );
+
+    texts.texts[2] = QLatin1String("Cherry");
+    index.rowsDataChanged(2, 2);
+    index.update(texts.rowCount(), texts);
+    REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("ap") ) ) == std::vector<int>{0} );
+    REQUIRE( rowsOfRangeList( index.rowsStartingWith( QLatin1String("c") ) ) == std::vector<int>{2} );
+  }
+}
+
+TEST_CASE("addColumnPrefixIndex")
+{
+  EditCommandsTableModel model;
+  populateModel(model, {"A","B"});
+
+  REQUIRE( !model.hasColumnPrefixIndex(1) );
+
+  model.addColumnPrefixIndex(1);
+  REQUIRE( model.hasColumnPrefixIndex(1) );
+  REQUIRE( !model.hasColumnPrefixIndex(0) );
+  REQUIRE( !model.hasColumnHashIndex(1) );
+
+  model.removeColumnPrefixIndex(1);
+  REQUIRE( !model.hasColumnPrefixIndex(1) );
+}
+
+TEST_CASE("rowsStartingWith")
+{
+  EditCommandsTableModel model;
+  populateModel(model, {"Paris","Berlin","paramaribo","Bern"});
+  model.addColumnPrefixIndex(1);
+
+  REQUIRE( rowsOfRangeList( model.rowsStartingWith(1, QLatin1String("par")) ) == std::vector<int>{0,2} );
+  REQUIRE( rowsOfRangeList( model.rowsStartingWith(1, QLatin1String("Par"), Qt::CaseSensitive) ) == std::vector<int>{0} );
+
+  SECTION("setData")
+  {
+    REQUIRE( model.setData(model.index(1, 1), QLatin1String("Parma")) );
+
+    REQUIRE( rowsOfRangeList( model.rowsStartingWith(1, QLatin1String("par")) ) == std::vector<int>{0,1,2} );
+    REQUIRE( rowsOfRangeList( model.rowsStartingWith(1, QLatin1String("ber")) ) == std::vector<int>{3} );
+  }
+
+  SECTION("insert rows")
+  {
+    REQUIRE( model.insertRows(0, 1) );
+    REQUIRE( model.setData(model.index(0, 1), QLatin1String("Bergen")) );
+
+    REQUIRE( rowsOfRangeList( model.rowsStartingWith(1, QLatin1String("ber")) ) == std::vector<int>{0,2,4} );
+    REQUIRE( rowsOfRangeList( model.rowsStartingWith(1, QLatin1String("par")) ) == std::vector<int>{1,3} );
+  }
+
+  SECTION("remove rows")
+  {
+    REQUIRE( model.removeRows(0, 2) );
+
+    REQUIRE( rowsOfRangeList( model.rowsStartingWith(1, QLatin1String("par")) ) == std::vector<int>{0} );
+    REQUIRE( rowsOfRangeList( model.rowsStartingWith(1, QLatin1String("ber")) ) == std::vector<int>{1} );
+  }
+}
+
+TEST_CASE("match_startsWith")
+{
+  EditCommandsTableModel model;
+  populateModel(model, {"Alpha","Beta","alps","Gamma","ALTO"});
+
+  const auto matchAl = [&model](int startRow, int hits, Qt::MatchFlags flags){
+    return rowsOfIndexes( model.match(model.index(startRow, 1), Qt::DisplayRole, QLatin1String("al"), hits, flags) );
+  };
+
+  /*
+   * Results must be the same with and without the index
+   */
+  const bool withIndex = GENERATE(false, true);
+  if(withIndex){
+    model.addColumnPrefixIndex(1);
+  }
+
+  SECTION("starts with")
+  {
+    REQUIRE( matchAl(0, -1, Qt::MatchStartsWith) == std::vector<int>{0,2,4} );
+    REQUIRE( matchAl(1, 1, Qt::MatchStartsWith) == std::vector<int>{2} );
+  }
+
+  SECTION("starts with and wrap (keyboard search)")
+  {
+    const Qt::MatchFlags flags(Qt::MatchStartsWith | Qt::MatchWrap);
+
+    REQUIRE( matchAl(3, 1, flags) == std::vector<int>{4} );
+    REQUIRE( matchAl(3, -1, flags) == std::vector<int>{4,0,2} );
+  }
+
+  SECTION("case sensitive")
+  {
+    const QModelIndexList indexes = model.match(model.index(0, 1), Qt::DisplayRole, QLatin1String("AL"), -1, Qt::MatchStartsWith | Qt::MatchCaseSensitive);
+
+    REQUIRE( rowsOfIndexes(indexes) == std::vector<int>{4} );
+  }
+
+  SECTION("contains (not using the index)")
+  {
+    const QModelIndexList indexes = model.match(model.index(0, 1), Qt::DisplayRole, QLatin1String("mm"), -1, Qt::MatchContains);
+
+    REQUIRE( rowsOfIndexes(indexes) == std::vector<int>{3} );
+  }
+}
@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "EditCommandsTableModel.h"
+#include "MoveRowsTableModel.h"
+#include "Mdt/ItemModel/ColumnTrigramIndex.h"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include <QModelIndex>
+#include <QModelIndexList>
+#include <QVariant>
+#include <QString>
+#include <QLatin1String>
+#include <vector>
+#include <string>
+
+using namespace Mdt::ItemModel;
+
+std::vector<int> rowsOfRangeList(const RowRangeList & list)
+{
+  std::vector<int> rows;
+
+  for(const RowRange & range : list){
+    for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+      rows.push_back(row);
+    }
+  }
+
+  return rows;
+}
+
+std::vector<int> rowsOfIndexes(const QModelIndexList & indexes)
+{
+  std::vector<int> rows;
+
+  for(const QModelIndex & index : indexes){
+    rows.push_back( index.row() );
+  }
+
+  return rows;
+}
+
+/*
+ * Populates the model with given names,
+ * ids are 0 to names.size()-1
+ */
+template<typename Model>
+void populateModel(Model & model, const std::vector<std::string> & names)
+{
+  typename Model::Table table;
+
+  for(size_t i = 0; i < names.size(); ++i){
+    table.push_back( {static_cast<int>(i), names[i]} );
+  }
+
+  model.setTable(table);
+}
+
+struct VectorTexts
+{
+  std::vector<QString> texts;
+
+  QString operator()(int row) const
+  {
+    return texts[static_cast<size_t>(row)];
+  }
+
+  int rowCount() const
+  {
+    return static_cast<int>( texts.size() );
+  }
+};
+
+
+TEST_CASE("ColumnTrigramIndex")
+{
+  VectorTexts texts;
+  texts.texts = {QLatin1String("Temperature sensor"), QLatin1String("Pressure sensor"), QLatin1String("Motor"), QLatin1String("SENSE")};
+  ColumnTrigramIndex index(1);
+
+  REQUIRE( index.column() == 1 );
+  REQUIRE( !index.isUpToDate() );
+
+  index.update(texts.rowCount(), texts);
+  REQUIRE( index.isUpToDate() );
+  REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("sens") ) ) == std::vector<int>{0,1,3} );
+  REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("SURE") ) ) == std::vector<int>{1} );
+  REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("tor") ) ) == std::vector<int>{2} );
+  REQUIRE( index.rowsThatMayContain( QLatin1String("valve") ).isEmpty() );
+
+  SECTION("short text gives all rows")
+  {
+    REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("zz") ) ) == std::vector<int>{0,1,2,3} );
+    REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QString() ) ) == std::vector<int>{0,1,2,3} );
+  }
+
+  SECTION("candidates can be false positives")
+  {
+    texts.texts = {QLatin1String("abcd bcde")};
+    index.invalidate();
+    index.update(texts.rowCount(), texts);
+
+    REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("abcde") ) ) == std::vector<int>{0} );
+  }
+
+  SECTION("append rows")
+  {
+    index.rowsAboutToBeInserted(4, 4);
+    texts.texts.push_back( QLatin1String("Valve") );
+
+    index.update(texts.rowCount(), texts);
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("valve") ) ) == std::vector<int>{4} );
+  }
+
+  SECTION("remove last rows")
+  {
+    index.rowsAboutToBeRemoved(2, 3);
+    texts.texts.resize(2);
+
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("sens") ) ) == std::vector<int>{0,1} );
+    REQUIRE( index.rowsThatMayContain( QLatin1String("motor") ).isEmpty() );
+  }
+
+  SECTION("change data")
+  {
+    texts.texts[2] = QLatin1String("Motor sensor");
+    index.rowsDataChanged(2, 2);
+
+    index.update(texts.rowCount(), texts);
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("sens") ) ) == std::vector<int>{0,1,2,3} );
+  }
+
+  SECTION("insert and move rows in the middle")
+  {
+    index.rowsAboutToBeInserted(0, 0);
+    texts.texts.insert( texts.texts.begin(), QLatin1String("Valve") );
+    REQUIRE( !index.isUpToDate() );
+
+    index.rowsAboutToBeMoved(2, 2, 1);
+    std::swap(texts.texts[1], texts.texts[2]);
+    REQUIRE( index.pendingRowCount() == 1 );
+
+    index.update(texts.rowCount(), texts);
+    REQUIRE( index.isUpToDate() );
+    REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("valve") ) ) == std::vector<int>{0} );
+    REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("pressure") ) ) == std::vector<int>{1} );
+    REQUIRE( rowsOfRangeList( index.rowsThatMayContain( QLatin1String("sens") ) ) == std::vector<int>{1,2,4} );
+  }
+}
+
+TEST_CASE("addColumnTrigramIndex")
+{
+  EditCommandsTableModel model;
+  populateModel(model, {"A","B"});
+
+  REQUIRE( !model.hasColumnTrigramIndex(1) );
+
+  model.addColumnTrigramIndex(1);
+  REQUIRE( model.hasColumnTrigramIndex(1) );
+  REQUIRE( !model.hasColumnTrigramIndex(0) );
+  REQUIRE( !model.hasColumnPrefixIndex(1) );
+
+  model.removeColumnTrigramIndex(1);
+  REQUIRE( !model.hasColumnTrigramIndex(1) );
+}
+
+TEST_CASE("rowsThatMayContain")
+{
+  EditCommandsTableModel model;
+  populateModel(model, {"Front door","Back door","Window","Garage door"});
+  model.addColumnTrigramIndex(1);
+
+  REQUIRE( rowsOfRangeList( model.rowsThatMayContain(1, QLatin1String("door")) ) == std::vector<int>{0,1,3} );
+
+  SECTION("setData")
+  {
+    REQUIRE( model.setData(model.index(2, 1), QLatin1String("Side door")) );
+    REQUIRE( model.setData(model.index(0, 1), QLatin1String("Front gate")) );
+
+    REQUIRE( rowsOfRangeList( model.rowsThatMayContain(1, QLatin1String("door")) ) == std::vector<int>{1,2,3} );
+  }
+
+  SECTION("append rows")
+  {
+    REQUIRE( appendRowToModel(model) );
+    REQUIRE( model.setData(model.index(4, 1), QLatin1String("Cellar door")) );
+
+    REQUIRE( rowsOfRangeList( model.rowsThatMayContain(1, QLatin1String("door")) ) == std::vector<int>{0,1,3,4} );
+  }
+
+  SECTION("insert rows")
+  {
+    REQUIRE( model.insertRows(1, 2) );
+
+    REQUIRE( rowsOfRangeList( model.rowsThatMayContain(1, QLatin1String("door")) ) == std::vector<int>{0,3,5} );
+  }
+
+  SECTION("remove rows")
+  {
+    REQUIRE( model.removeRows(0, 2) );
+
+    REQUIRE( rowsOfRangeList( model.rowsThatMayContain(1, QLatin1String("door")) ) == std::vector<int>{1} );
+  }
+}
+
+TEST_CASE("rowsThatMayContain_moveRows")
+{
+  MoveRowsTableModel model;
+  populateModel(model, {"Front door","Back door","Window","Garage door"});
+  model.addColumnTrigramIndex(1);
+
+  REQUIRE( rowsOfRangeList( model.rowsThatMayContain(1, QLatin1String("window")) ) == std::vector<int>{2} );
+
+  REQUIRE( model.moveRows(QModelIndex(), 2, 1, QModelIndex(), 0) );
+
+  REQUIRE( rowsOfRangeList( model.rowsThatMayContain(1, QLatin1String("window")) ) == std::vector<int>{0} );
+  REQUIRE( rowsOfRangeList( model.rowsThatMayContain(1, QLatin1String("door")) ) == std::vector<int>{1,2,3} );
+}
+
+TEST_CASE("match_contains")
+{
+  EditCommandsTableModel model;
+  populateModel(model, {"Red valve","Blue pump","VALVE block","Green valve","Valves"});
+
+  const auto matchValve = [&model](int startRow, int hits, Qt::MatchFlags flags){
+    return rowsOfIndexes( model.match(model.index(startRow, 1), Qt::DisplayRole, QLatin1String("valve"), hits, flags) );
+  };
+
+  /*
+   * Results must be the same with and without the index
+   */
+  const bool withIndex = GENERATE(false, true);
+  if(withIndex){
+    model.addColumnTrigramIndex(1);
+  }
+
+  SECTION("contains")
+  {
+    REQUIRE( matchValve(0, -1, Qt::MatchContains) == std::vector<int>{0,2,3,4} );
+    REQUIRE( matchValve(1, 1, Qt::MatchContains) == std::vector<int>{2} );
+  }
+
+  SECTION("contains with wrap")
+  {
+    const Qt::MatchFlags flags(Qt::MatchContains | Qt::MatchWrap);
+
+    REQUIRE( matchValve(3, -1, flags) == std::vector<int>{3,4,0,2} );
+    REQUIRE( matchValve(4, 2, flags) == std::vector<int>{4,0} );
+  }
+
+  SECTION("case sensitive")
+  {
+    REQUIRE( matchValve(0, -1, Qt::MatchContains | Qt::MatchCaseSensitive) == std::vector<int>{0,3} );
+  }
+
+  SECTION("short text")
+  {
+    const QModelIndexList indexes = model.match(model.index(0, 1), Qt::DisplayRole, QLatin1String("mp"), -1, Qt::MatchContains);
+
+    REQUIRE( rowsOfIndexes(indexes) == std::vector<int>{1} );
+  }
+
+  SECTION("starts with (not using the index)")
+  {
+    REQUIRE( matchValve(0, -1, Qt::MatchStartsWith) == std::vector<int>{2,4} );
+  }
+}
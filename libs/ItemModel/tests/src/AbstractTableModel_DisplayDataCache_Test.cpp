@@ -0,0 +1,404 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemModel/DisplayDataCache.h"
+#include "Mdt/ItemModel/StlHelpers.h"
+#include <QObject>
+#include <QModelIndex>
+#include <QVariant>
+#include <QString>
+#include <QVector>
+#include <vector>
+#include <cassert>
+
+using namespace Mdt::ItemModel;
+
+/*
+ * Model with 1 column of integers, displayed as text,
+ * that counts the calls to displayRoleData()
+ */
+class CountingDisplayTableModel : public AbstractTableModel
+{
+ public:
+
+  void setValues(const std::vector<int> & values)
+  {
+    beginResetModel();
+    mValues = values;
+    endResetModel();
+  }
+
+  /*
+   * Changes a value without emitting dataChanged(),
+   * like a model that would forget it
+   */
+  void setValueWithoutSignal(int row, int value)
+  {
+    mValues[static_cast<size_t>(row)] = value;
+  }
+
+  void emitDataChangedWithRoles(int row, const QVector<int> & roles)
+  {
+    emitRowDataChanged(row, roles);
+  }
+
+  int displayRoleDataCallCount() const noexcept
+  {
+    return mDisplayRoleDataCallCount;
+  }
+
+  QString displayText(int row)
+  {
+    return data( index(row, 0) ).toString();
+  }
+
+ private:
+
+  int rowCountWithoutParentIndex() const noexcept override
+  {
+    return static_cast<int>( mValues.size() );
+  }
+
+  int columnCountWithoutParentIndex() const noexcept override
+  {
+    return 1;
+  }
+
+  QVariant displayRoleData(const QModelIndex & index) const noexcept override
+  {
+    ++mDisplayRoleDataCallCount;
+
+    return QString::fromLatin1("V%1").arg( mValues[static_cast<size_t>( index.row() )] );
+  }
+
+  bool setEditRoleData(const QModelIndex & index, const QVariant & value) noexcept override
+  {
+    mValues[static_cast<size_t>( index.row() )] = value.toInt();
+
+    return true;
+  }
+
+  bool doSupportsInsertRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doInsertRows(int row, int count) noexcept override
+  {
+    insertToStlContainer(mValues, row, count, -1);
+  }
+
+  bool doSupportsRemoveRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doRemoveRows(int row, int count) noexcept override
+  {
+    removeFromStlContainer(mValues, row, count);
+  }
+
+  bool doSupportsMoveRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doMoveRows(int sourceRow, int count, int destinationRow) noexcept override
+  {
+    moveInStlContainer(mValues, sourceRow, count, destinationRow);
+  }
+
+  std::vector<int> mValues;
+  mutable int mDisplayRoleDataCallCount = 0;
+};
+
+/*
+ * Reads the display data of each row
+ */
+void displayAllRows(CountingDisplayTableModel & model)
+{
+  for(int row = 0; row < model.rowCount(); ++row){
+    model.displayText(row);
+  }
+}
+
+
+TEST_CASE("DisplayDataCache")
+{
+  DisplayDataCache cache(3);
+
+  REQUIRE( cache.isEnabled() );
+  REQUIRE( cache.capacity() == 3 );
+  REQUIRE( cache.size() == 0 );
+  REQUIRE( cache.find(0, 0) == nullptr );
+
+  cache.insert( 0, 0, QString::fromLatin1("A") );
+  cache.insert( 1, 0, QString::fromLatin1("B") );
+  cache.insert( 2, 0, QString::fromLatin1("C") );
+  REQUIRE( cache.size() == 3 );
+  REQUIRE( cache.find(1, 0)->toString() == QLatin1String("B") );
+
+  SECTION("evict the least recently used cell")
+  {
+    // Use 0, so 2 is the least recently used one
+    REQUIRE( cache.find(0, 0) != nullptr );
+    cache.insert( 3, 0, QString::fromLatin1("D") );
+
+    REQUIRE( cache.size() == 3 );
+    REQUIRE( cache.find(2, 0) == nullptr );
+    REQUIRE( cache.find(0, 0)->toString() == QLatin1String("A") );
+    REQUIRE( cache.find(3, 0)->toString() == QLatin1String("D") );
+  }
+
+  SECTION("replace a cell")
+  {
+    cache.insert( 1, 0, QString::fromLatin1("b") );
+
+    REQUIRE( cache.size() == 3 );
+    REQUIRE( cache.find(1, 0)->toString() == QLatin1String("b") );
+  }
+
+  SECTION("reduce the capacity")
+  {
+    REQUIRE( cache.find(2, 0) != nullptr );
+    cache.setCapacity(1);
+
+    REQUIRE( cache.size() == 1 );
+    REQUIRE( cache.find(2, 0) != nullptr );
+  }
+
+  SECTION("invalidate cells")
+  {
+    cache.invalidateCells(1, 5, 0, 0);
+
+    REQUIRE( cache.size() == 1 );
+    REQUIRE( cache.find(0, 0) != nullptr );
+  }
+
+  SECTION("insert rows")
+  {
+    cache.rowsInserted(1, 2);
+
+    REQUIRE( cache.size() == 3 );
+    REQUIRE( cache.find(0, 0)->toString() == QLatin1String("A") );
+    REQUIRE( cache.find(1, 0) == nullptr );
+    REQUIRE( cache.find(3, 0)->toString() == QLatin1String("B") );
+    REQUIRE( cache.find(4, 0)->toString() == QLatin1String("C") );
+  }
+
+  SECTION("remove rows")
+  {
+    cache.rowsRemoved(0, 0);
+
+    REQUIRE( cache.size() == 2 );
+    REQUIRE( cache.find(0, 0)->toString() == QLatin1String("B") );
+    REQUIRE( cache.find(1, 0)->toString() == QLatin1String("C") );
+    REQUIRE( cache.find(2, 0) == nullptr );
+  }
+
+  SECTION("clear")
+  {
+    cache.clear();
+
+    REQUIRE( cache.size() == 0 );
+  }
+}
+
+TEST_CASE("DisplayDataCache_disabled")
+{
+  DisplayDataCache cache;
+
+  REQUIRE( !cache.isEnabled() );
+
+  cache.insert( 0, 0, QString::fromLatin1("A") );
+  REQUIRE( cache.size() == 0 );
+}
+
+TEST_CASE("data")
+{
+  CountingDisplayTableModel model;
+  model.setValues({10,11,12});
+
+  SECTION("without cache")
+  {
+    displayAllRows(model);
+    displayAllRows(model);
+
+    REQUIRE( model.displayRoleDataCallCount() == 6 );
+  }
+
+  SECTION("with cache")
+  {
+    model.setDisplayDataCacheCapacity(10);
+    REQUIRE( model.displayDataCacheCapacity() == 10 );
+
+    displayAllRows(model);
+    displayAllRows(model);
+
+    REQUIRE( model.displayRoleDataCallCount() == 3 );
+    REQUIRE( model.displayText(1) == QLatin1String("V11") );
+  }
+
+  SECTION("edit role is not cached")
+  {
+    model.setDisplayDataCacheCapacity(10);
+
+    REQUIRE( model.data( model.index(0, 0), Qt::EditRole ).isNull() );
+    REQUIRE( model.displayRoleDataCallCount() == 0 );
+  }
+
+  SECTION("disable the cache")
+  {
+    model.setDisplayDataCacheCapacity(10);
+    displayAllRows(model);
+    model.setDisplayDataCacheCapacity(0);
+    displayAllRows(model);
+
+    REQUIRE( model.displayRoleDataCallCount() == 6 );
+  }
+}
+
+TEST_CASE("invalidation")
+{
+  CountingDisplayTableModel model;
+  model.setDisplayDataCacheCapacity(10);
+  model.setValues({10,11,12});
+  displayAllRows(model);
+  REQUIRE( model.displayRoleDataCallCount() == 3 );
+
+  SECTION("setData")
+  {
+    REQUIRE( model.setData( model.index(1, 0), 21 ) );
+
+    REQUIRE( model.displayText(1) == QLatin1String("V21") );
+    REQUIRE( model.displayText(0) == QLatin1String("V10") );
+    REQUIRE( model.displayRoleDataCallCount() == 4 );
+  }
+
+  SECTION("emitRowDataChanged without roles")
+  {
+    model.setValueWithoutSignal(2, 22);
+    model.emitDataChangedWithRoles( 2, QVector<int>() );
+
+    REQUIRE( model.displayText(2) == QLatin1String("V22") );
+  }
+
+  SECTION("emitRowDataChanged with display role")
+  {
+    model.setValueWithoutSignal(2, 22);
+    model.emitDataChangedWithRoles( 2, QVector<int>{Qt::DisplayRole} );
+
+    REQUIRE( model.displayText(2) == QLatin1String("V22") );
+  }
+
+  SECTION("emitRowDataChanged with other roles keeps the cache")
+  {
+    model.emitDataChangedWithRoles( 2, QVector<int>{Qt::ToolTipRole} );
+    displayAllRows(model);
+
+    REQUIRE( model.displayRoleDataCallCount() == 3 );
+  }
+
+  SECTION("a change without signal needs to clear the cache")
+  {
+    model.setValueWithoutSignal(0, 20);
+    REQUIRE( model.displayText(0) == QLatin1String("V10") );
+
+    model.clearDisplayDataCache();
+    REQUIRE( model.displayText(0) == QLatin1String("V20") );
+  }
+
+  SECTION("insert rows")
+  {
+    REQUIRE( model.insertRows(1, 2) );
+
+    REQUIRE( model.displayText(0) == QLatin1String("V10") );
+    REQUIRE( model.displayText(1) == QLatin1String("V-1") );
+    REQUIRE( model.displayText(2) == QLatin1String("V-1") );
+    REQUIRE( model.displayText(3) == QLatin1String("V11") );
+    REQUIRE( model.displayText(4) == QLatin1String("V12") );
+    // Only the inserted rows are formatted
+    REQUIRE( model.displayRoleDataCallCount() == 5 );
+  }
+
+  SECTION("remove rows")
+  {
+    REQUIRE( model.removeRows(0, 1) );
+
+    REQUIRE( model.displayText(0) == QLatin1String("V11") );
+    REQUIRE( model.displayText(1) == QLatin1String("V12") );
+    REQUIRE( model.displayRoleDataCallCount() == 3 );
+  }
+
+  SECTION("move rows")
+  {
+    REQUIRE( model.moveRows(QModelIndex(), 0, 1, QModelIndex(), 3) );
+
+    REQUIRE( model.displayText(0) == QLatin1String("V11") );
+    REQUIRE( model.displayText(1) == QLatin1String("V12") );
+    REQUIRE( model.displayText(2) == QLatin1String("V10") );
+  }
+
+  SECTION("reset")
+  {
+    model.setValues({30,31});
+
+    REQUIRE( model.displayText(0) == QLatin1String("V30") );
+    REQUIRE( model.displayText(1) == QLatin1String("V31") );
+  }
+}
+
+TEST_CASE("invalidation_fromSlotConnectedBeforeTheCache")
+{
+  CountingDisplayTableModel model;
+  QString textSeenBySlot;
+  int rowSeenBySlot = 0;
+  const auto readRow = [&model, &textSeenBySlot, &rowSeenBySlot](){
+    textSeenBySlot = model.displayText(rowSeenBySlot);
+  };
+  QObject::connect(&model, &QAbstractItemModel::dataChanged, readRow);
+  QObject::connect(&model, &QAbstractItemModel::rowsInserted, readRow);
+  QObject::connect(&model, &QAbstractItemModel::rowsRemoved, readRow);
+  QObject::connect(&model, &QAbstractItemModel::rowsMoved, readRow);
+
+  model.setDisplayDataCacheCapacity(10);
+  model.setValues({10,11,12});
+  displayAllRows(model);
+
+  SECTION("setData")
+  {
+    rowSeenBySlot = 1;
+    REQUIRE( model.setData( model.index(1, 0), 21 ) );
+    REQUIRE( textSeenBySlot == QLatin1String("V21") );
+  }
+
+  SECTION("insert rows")
+  {
+    rowSeenBySlot = 1;
+    REQUIRE( model.insertRows(0, 1) );
+    REQUIRE( textSeenBySlot == QLatin1String("V10") );
+  }
+
+  SECTION("remove rows")
+  {
+    rowSeenBySlot = 0;
+    REQUIRE( model.removeRows(0, 1) );
+    REQUIRE( textSeenBySlot == QLatin1String("V11") );
+  }
+
+  SECTION("move rows")
+  {
+    rowSeenBySlot = 2;
+    REQUIRE( model.moveRows(QModelIndex(), 0, 1, QModelIndex(), 3) );
+    REQUIRE( textSeenBySlot == QLatin1String("V10") );
+  }
+}
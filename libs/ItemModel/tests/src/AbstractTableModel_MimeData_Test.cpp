@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "MoveRowsTableModel.h"
+#include "ReadOnlyTableModel.h"
+#include "Mdt/ItemModel/RowRangeMimeData.h"
+#include "Mdt/ItemModel/RowSelection.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TestLib/RowSelectionHelpers.h"
+#include <QMimeData>
+#include <QModelIndex>
+#include <QModelIndexList>
+#include <QByteArray>
+#include <QString>
+#include <QLatin1String>
+#include <memory>
+#include <vector>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+/*
+ * Populates the model with ids 0 to rowCount-1
+ * and names N0 to N(rowCount-1)
+ */
+void populateModel(MoveRowsTableModel & model, int rowCount)
+{
+  MoveRowsTableModel::Table table;
+
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "N" + std::to_string(id)} );
+  }
+
+  model.setTable(table);
+}
+
+std::vector<int> idsInModel(const MoveRowsTableModel & model)
+{
+  std::vector<int> ids;
+
+  for(int row = 0; row < model.rowCount(); ++row){
+    ids.push_back( getModelData(model, row, 0).toInt() );
+  }
+
+  return ids;
+}
+
+QModelIndexList makeIndexList(const QAbstractItemModel & model, const std::vector<int> & rows, const std::vector<int> & columns)
+{
+  QModelIndexList indexes;
+
+  for(const int row : rows){
+    for(const int column : columns){
+      indexes.append( model.index(row, column) );
+    }
+  }
+
+  return indexes;
+}
+
+std::string mimeText(const QMimeData & data, const char *mimeType)
+{
+  return data.data( QLatin1String(mimeType) ).toStdString();
+}
+
+
+TEST_CASE("RowSelection_fromModelIndexList")
+{
+  MoveRowsTableModel model;
+  populateModel(model, 10);
+
+  SECTION("empty list")
+  {
+    REQUIRE( RowSelection::fromModelIndexList( QModelIndexList() ).isEmpty() );
+  }
+
+  SECTION("unsorted rows in many columns")
+  {
+    const auto indexes = makeIndexList(model, {7,2,3,9,8,2}, {1,0});
+    const auto selection = RowSelection::fromModelIndexList(indexes);
+
+    REQUIRE( makeIndexListFromRowSelection(selection) == std::vector<int>{2,3,7,8,9} );
+    REQUIRE( selection.rangeCount() == 2 );
+  }
+}
+
+TEST_CASE("encodeRowRanges")
+{
+  const auto selection = makeRowSelectionFromIndexList({1,2,3,7,100000});
+  const std::vector<int> columns{0, 2};
+
+  const QByteArray data = RowRangeMimeData::encodeRowRanges(selection, columns);
+
+  RowSelection decodedSelection;
+  std::vector<int> decodedColumns;
+  REQUIRE( RowRangeMimeData::decodeRowRanges(data, decodedSelection, decodedColumns) );
+  REQUIRE( makeIndexListFromRowSelection(decodedSelection) == std::vector<int>{1,2,3,7,100000} );
+  REQUIRE( decodedColumns == columns );
+
+  SECTION("invalid data")
+  {
+    REQUIRE( !RowRangeMimeData::decodeRowRanges(QByteArray(), decodedSelection, decodedColumns) );
+    REQUIRE( !RowRangeMimeData::decodeRowRanges(data.left(data.size() - 2), decodedSelection, decodedColumns) );
+  }
+}
+
+TEST_CASE("mimeData_rowRangeDragAndDropDisabled")
+{
+  MoveRowsTableModel model;
+  populateModel(model, 10);
+
+  REQUIRE( !model.isRowRangeDragAndDropEnabled() );
+  REQUIRE( !model.mimeTypes().contains( RowRangeMimeData::rowRangesMimeType() ) );
+  REQUIRE( model.mimeTypes() == model.QAbstractTableModel::mimeTypes() );
+  REQUIRE( model.supportedDropActions() == model.QAbstractTableModel::supportedDropActions() );
+  REQUIRE( model.supportedDragActions() == model.QAbstractTableModel::supportedDragActions() );
+
+  std::unique_ptr<QMimeData> data( model.mimeData( makeIndexList(model, {1}, {0}) ) );
+  REQUIRE( data.get() != nullptr );
+  REQUIRE( qobject_cast<const RowRangeMimeData*>( data.get() ) == nullptr );
+
+  std::unique_ptr<QMimeData> rowRangeData( model.mimeDataForRows( makeRowSelectionFromIndexList({2}), {0} ) );
+  REQUIRE( !model.canDropMimeData(rowRangeData.get(), Qt::MoveAction, 0, 0, QModelIndex()) );
+  REQUIRE( !model.dropMimeData(rowRangeData.get(), Qt::MoveAction, 0, 0, QModelIndex()) );
+  REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,3,4,5,6,7,8,9} );
+}
+
+TEST_CASE("mimeData")
+{
+  MoveRowsTableModel model;
+  model.setRowRangeDragAndDropEnabled(true);
+  populateModel(model, 10);
+
+  REQUIRE( model.mimeTypes().contains( RowRangeMimeData::rowRangesMimeType() ) );
+  REQUIRE( model.mimeTypes().contains( model.QAbstractTableModel::mimeTypes().first() ) );
+
+  SECTION("empty list")
+  {
+    REQUIRE( model.mimeData( QModelIndexList() ) == nullptr );
+  }
+
+  SECTION("rows and columns")
+  {
+    std::unique_ptr<QMimeData> data( model.mimeData( makeIndexList(model, {4,1,2}, {1,0}) ) );
+    REQUIRE( data.get() != nullptr );
+
+    const auto *rowRangeData = qobject_cast<const RowRangeMimeData*>( data.get() );
+    REQUIRE( rowRangeData != nullptr );
+    REQUIRE( rowRangeData->sourceModel() == &model );
+    REQUIRE( makeIndexListFromRowSelection( rowRangeData->rowSelection() ) == std::vector<int>{1,2,4} );
+    REQUIRE( rowRangeData->columns() == std::vector<int>{0,1} );
+
+    REQUIRE( data->hasFormat( RowRangeMimeData::rowRangesMimeType() ) );
+    REQUIRE( mimeText(*data, "text/plain") == "1\tN1\n2\tN2\n4\tN4\n" );
+    REQUIRE( mimeText(*data, "text/csv") == "1,N1\n2,N2\n4,N4\n" );
+  }
+
+  SECTION("the model changed")
+  {
+    std::unique_ptr<QMimeData> data( model.mimeDataForRows( makeRowSelectionFromIndexList({1,8,9}), {1} ) );
+    const auto *rowRangeData = qobject_cast<const RowRangeMimeData*>( data.get() );
+    REQUIRE( rowRangeData->refersToCurrentRows() );
+
+    populateModel(model, 9);
+
+    REQUIRE( !rowRangeData->refersToCurrentRows() );
+    REQUIRE( !data->hasFormat( RowRangeMimeData::rowRangesMimeType() ) );
+    REQUIRE( mimeText(*data, "text/csv") == "N1\nN8\nN9\n" );
+    REQUIRE( mimeText(*data, "text/plain") == "N1\nN8\nN9\n" );
+  }
+
+  SECTION("rows of the model moved")
+  {
+    std::unique_ptr<QMimeData> data( model.mimeDataForRows( makeRowSelectionFromIndexList({1}), {0} ) );
+    REQUIRE( model.moveRowRanges(makeRowSelectionFromIndexList({5}), 0) );
+
+    REQUIRE( mimeText(*data, "text/csv") == "1\n" );
+  }
+
+  SECTION("the model was destroyed")
+  {
+    std::unique_ptr<QMimeData> data;
+    {
+      MoveRowsTableModel otherModel;
+      populateModel(otherModel, 3);
+      data.reset( otherModel.mimeDataForRows( makeRowSelectionFromIndexList({1}), {1} ) );
+    }
+
+    REQUIRE( mimeText(*data, "text/csv").empty() );
+  }
+}
+
+TEST_CASE("dropMimeData")
+{
+  MoveRowsTableModel model;
+  model.setRowRangeDragAndDropEnabled(true);
+  populateModel(model, 10);
+
+  REQUIRE( model.supportedDropActions().testFlag(Qt::MoveAction) );
+  REQUIRE( model.supportedDropActions().testFlag(Qt::CopyAction) );
+  REQUIRE( model.supportedDragActions() == (Qt::CopyAction | Qt::MoveAction) );
+
+  std::unique_ptr<QMimeData> data( model.mimeDataForRows( makeRowSelectionFromIndexList({2,5,6}), {0,1} ) );
+
+  SECTION("drop before a row")
+  {
+    REQUIRE( model.canDropMimeData(data.get(), Qt::MoveAction, 1, 0, QModelIndex()) );
+    REQUIRE( !model.dropMimeData(data.get(), Qt::MoveAction, 1, 0, QModelIndex()) );
+    REQUIRE( idsInModel(model) == std::vector<int>{0,2,5,6,1,3,4,7,8,9} );
+  }
+
+  SECTION("drop on a item")
+  {
+    model.dropMimeData(data.get(), Qt::MoveAction, -1, -1, model.index(8, 0));
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,3,4,7,2,5,6,8,9} );
+  }
+
+  SECTION("drop after the last row")
+  {
+    model.dropMimeData(data.get(), Qt::MoveAction, -1, -1, QModelIndex());
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,3,4,7,8,9,2,5,6} );
+  }
+
+  SECTION("moveDroppedRows")
+  {
+    REQUIRE( model.moveDroppedRows(data.get(), 0) );
+    REQUIRE( idsInModel(model) == std::vector<int>{2,5,6,0,1,3,4,7,8,9} );
+  }
+
+  SECTION("copy is handled by QAbstractTableModel")
+  {
+    REQUIRE( model.canDropMimeData(data.get(), Qt::CopyAction, 1, 0, QModelIndex()) == model.QAbstractTableModel::canDropMimeData(data.get(), Qt::CopyAction, 1, 0, QModelIndex()) );
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,3,4,5,6,7,8,9} );
+  }
+
+  SECTION("the model changed since the drag started")
+  {
+    REQUIRE( model.moveRowRanges(makeRowSelectionFromIndexList({9}), 0) );
+
+    REQUIRE( !model.canDropMimeData(data.get(), Qt::MoveAction, 1, 0, QModelIndex()) );
+    REQUIRE( !model.moveDroppedRows(data.get(), 1) );
+    REQUIRE( idsInModel(model) == std::vector<int>{9,0,1,2,3,4,5,6,7,8} );
+  }
+
+  SECTION("data from a other model")
+  {
+    MoveRowsTableModel otherModel;
+    populateModel(otherModel, 10);
+    std::unique_ptr<QMimeData> otherData( otherModel.mimeDataForRows( makeRowSelectionFromIndexList({0}), {0} ) );
+
+    REQUIRE( !model.canDropMimeData(otherData.get(), Qt::MoveAction, 1, 0, QModelIndex()) );
+    REQUIRE( !model.moveDroppedRows(otherData.get(), 1) );
+  }
+
+  SECTION("plain mime data")
+  {
+    QMimeData plainData;
+    plainData.setText( QLatin1String("A") );
+
+    REQUIRE( !model.canDropMimeData(&plainData, Qt::MoveAction, 1, 0, QModelIndex()) );
+  }
+}
+
+TEST_CASE("dropMimeData_moveNotSupported")
+{
+  ReadOnlyTableModel model;
+  model.setRowRangeDragAndDropEnabled(true);
+  model.setTable({{1, "A"}, {2, "B"}});
+
+  REQUIRE( !model.supportedDropActions().testFlag(Qt::MoveAction) );
+  REQUIRE( model.supportedDropActions() == model.QAbstractTableModel::supportedDropActions() );
+  REQUIRE( model.supportedDragActions() == Qt::CopyAction );
+
+  std::unique_ptr<QMimeData> data( model.mimeDataForRows( makeRowSelectionFromIndexList({1}), {0,1} ) );
+  REQUIRE( !model.canDropMimeData(data.get(), Qt::MoveAction, 0, 0, QModelIndex()) );
+  REQUIRE( mimeText(*data, "text/csv") == "2,B\n" );
+}
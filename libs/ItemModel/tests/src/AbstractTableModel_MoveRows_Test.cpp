@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "MoveRowsTableModel.h"
+#include "RemoveRowsTableModel.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TestLib/RemoveRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/InsertRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/RowSelectionHelpers.h"
+#include <QPersistentModelIndex>
+#include <QModelIndex>
+#include <QVariant>
+#include <QLatin1String>
+#include <vector>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+/*
+ * Populates the model with ids 0 to rowCount-1
+ */
+void populateModel(MoveRowsTableModel & model, int rowCount)
+{
+  MoveRowsTableModel::Table table;
+
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "N" + std::to_string(id)} );
+  }
+
+  model.setTable(table);
+}
+
+std::vector<int> idsInModel(const MoveRowsTableModel & model)
+{
+  std::vector<int> ids;
+
+  for(int row = 0; row < model.rowCount(); ++row){
+    ids.push_back( getModelData(model, row, 0).toInt() );
+  }
+
+  return ids;
+}
+
+struct RowsMovedCounter
+{
+  int rowsAboutToBeMovedCount = 0;
+  int rowsMovedCount = 0;
+
+  explicit RowsMovedCounter(QAbstractItemModel & model)
+  {
+    QObject::connect(&model, &QAbstractItemModel::rowsAboutToBeMoved, [this](){ ++rowsAboutToBeMovedCount; });
+    QObject::connect(&model, &QAbstractItemModel::rowsMoved, [this](){ ++rowsMovedCount; });
+  }
+};
+
+
+TEST_CASE("moveRows_support")
+{
+  SECTION("a model that supports moving rows")
+  {
+    MoveRowsTableModel model;
+
+    REQUIRE( model.supportsMoveRows() );
+  }
+
+  SECTION("a model that does not support moving rows")
+  {
+    RemoveRowsTableModel model;
+
+    REQUIRE( !model.supportsMoveRows() );
+    REQUIRE( !model.moveRows(QModelIndex(), 0, 1, QModelIndex(), 0) );
+  }
+}
+
+TEST_CASE("rowsAreValidForMoveRows")
+{
+  MoveRowsTableModel model;
+  populateModel(model, 5);
+
+  SECTION("valid moves")
+  {
+    REQUIRE( model.rowsAreValidForMoveRows(1, 1, 0) );
+    REQUIRE( model.rowsAreValidForMoveRows(0, 2, 3) );
+    REQUIRE( model.rowsAreValidForMoveRows(0, 2, 5) );
+    REQUIRE( model.rowsAreValidForMoveRows(3, 2, 0) );
+  }
+
+  SECTION("invalid source")
+  {
+    REQUIRE( !model.rowsAreValidForMoveRows(-1, 1, 0) );
+    REQUIRE( !model.rowsAreValidForMoveRows(0, 0, 3) );
+    REQUIRE( !model.rowsAreValidForMoveRows(4, 2, 0) );
+  }
+
+  SECTION("invalid destination")
+  {
+    REQUIRE( !model.rowsAreValidForMoveRows(0, 1, -1) );
+    REQUIRE( !model.rowsAreValidForMoveRows(0, 1, 6) );
+  }
+
+  SECTION("destination that would not change anything")
+  {
+    REQUIRE( !model.rowsAreValidForMoveRows(1, 2, 1) );
+    REQUIRE( !model.rowsAreValidForMoveRows(1, 2, 2) );
+    REQUIRE( !model.rowsAreValidForMoveRows(1, 2, 3) );
+  }
+}
+
+TEST_CASE("moveRows")
+{
+  MoveRowsTableModel model;
+  populateModel(model, 5);
+
+  RowsMovedCounter moveCounter(model);
+  RemoveRowsSignalsSpy removeSpy(model);
+  InsertRowsSignalsSpy insertSpy(model);
+
+  SECTION("move 1 row to the top")
+  {
+    const QPersistentModelIndex index = model.index(3, 1);
+
+    REQUIRE( model.moveRows(QModelIndex(), 3, 1, QModelIndex(), 0) );
+
+    REQUIRE( idsInModel(model) == std::vector<int>{3,0,1,2,4} );
+    REQUIRE( index.row() == 0 );
+    REQUIRE( model.data(index) == QLatin1String("N3") );
+  }
+
+  SECTION("move 2 rows down")
+  {
+    const QPersistentModelIndex index = model.index(2, 0);
+
+    REQUIRE( model.moveRows(QModelIndex(), 0, 2, QModelIndex(), 4) );
+
+    REQUIRE( idsInModel(model) == std::vector<int>{2,3,0,1,4} );
+    REQUIRE( index.row() == 0 );
+  }
+
+  SECTION("move 1 row to the end")
+  {
+    REQUIRE( model.moveRows(QModelIndex(), 0, 1, QModelIndex(), 5) );
+
+    REQUIRE( idsInModel(model) == std::vector<int>{1,2,3,4,0} );
+  }
+
+  REQUIRE( moveCounter.rowsAboutToBeMovedCount == 1 );
+  REQUIRE( moveCounter.rowsMovedCount == 1 );
+  REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+  REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+}
+
+TEST_CASE("moveRows_NotSupportedCases")
+{
+  MoveRowsTableModel model;
+  populateModel(model, 3);
+
+  RowsMovedCounter moveCounter(model);
+
+  SECTION("valid parent index")
+  {
+    const auto parent = model.index(0, 0);
+
+    REQUIRE( !model.moveRows(parent, 0, 1, QModelIndex(), 2) );
+    REQUIRE( !model.moveRows(QModelIndex(), 0, 1, parent, 2) );
+  }
+
+  SECTION("invalid rows")
+  {
+    REQUIRE( !model.moveRows(QModelIndex(), 2, 2, QModelIndex(), 0) );
+  }
+
+  SECTION("move to the same place")
+  {
+    REQUIRE( !model.moveRows(QModelIndex(), 1, 1, QModelIndex(), 2) );
+  }
+
+  REQUIRE( idsInModel(model) == std::vector<int>{0,1,2} );
+  REQUIRE( moveCounter.rowsMovedCount == 0 );
+}
+
+TEST_CASE("moveRowRanges")
+{
+  MoveRowsTableModel model;
+  populateModel(model, 10);
+
+  RemoveRowsSignalsSpy removeSpy(model);
+
+  SECTION("empty selection")
+  {
+    REQUIRE( model.moveRowRanges(RowSelection(), 0) );
+
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,3,4,5,6,7,8,9} );
+  }
+
+  SECTION("scattered rows to the top")
+  {
+    const QPersistentModelIndex index = model.index(5, 0);
+    const auto selection = makeRowSelectionFromIndexList({2,5,6,9});
+
+    REQUIRE( model.moveRowRanges(selection, 0) );
+
+    REQUIRE( idsInModel(model) == std::vector<int>{2,5,6,9,0,1,3,4,7,8} );
+    REQUIRE( index.row() == 1 );
+  }
+
+  SECTION("scattered rows to the bottom")
+  {
+    const auto selection = makeRowSelectionFromIndexList({0,3,4,7});
+
+    REQUIRE( model.moveRowRanges(selection, 10) );
+
+    REQUIRE( idsInModel(model) == std::vector<int>{1,2,5,6,8,9,0,3,4,7} );
+  }
+
+  SECTION("rows on both sides of the destination")
+  {
+    const auto selection = makeRowSelectionFromIndexList({1,3,7,8});
+
+    REQUIRE( model.moveRowRanges(selection, 5) );
+
+    REQUIRE( idsInModel(model) == std::vector<int>{0,2,4,1,3,7,8,5,6,9} );
+  }
+
+  SECTION("a range that contains the destination")
+  {
+    const auto selection = makeRowSelectionFromIndexList({0,4,5,6,9});
+
+    REQUIRE( model.moveRowRanges(selection, 5) );
+
+    REQUIRE( idsInModel(model) == std::vector<int>{1,2,3,0,4,5,6,9,7,8} );
+  }
+
+  SECTION("rows already at the destination")
+  {
+    RowsMovedCounter moveCounter(model);
+    const auto selection = makeRowSelectionFromIndexList({3,4});
+
+    REQUIRE( model.moveRowRanges(selection, 3) );
+
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,3,4,5,6,7,8,9} );
+    REQUIRE( moveCounter.rowsMovedCount == 0 );
+  }
+
+  REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+}
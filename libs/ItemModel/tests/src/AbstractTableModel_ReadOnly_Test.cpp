@@ -184,6 +184,17 @@ TEST_CASE("data")
   }
 }
 
+TEST_CASE("columnMaximumTextLength")
+{
+  ReadOnlyTableModel model;
+
+  SECTION("not known by default")
+  {
+    REQUIRE( model.columnMaximumTextLength(0) == -1 );
+    REQUIRE( model.columnMaximumTextLength(1) == -1 );
+  }
+}
+
 TEST_CASE("setData")
 {
   ReadOnlyTableModel model;
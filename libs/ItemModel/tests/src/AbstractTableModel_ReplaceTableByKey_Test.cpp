@@ -0,0 +1,265 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "EditCommandsTableModel.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TestLib/InsertRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/RemoveRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/DataChangedSignalSpy.h"
+#include "Mdt/ItemModel/TableReclaimer.h"
+#include <QObject>
+#include <QPersistentModelIndex>
+#include <QLatin1String>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <utility>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+using Table = EditCommandsTableModel::Table;
+
+/*
+ * Returns a table with ids 0 to rowCount-1
+ */
+Table makeTable(int rowCount)
+{
+  Table table;
+
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "N" + std::to_string(id)} );
+  }
+
+  return table;
+}
+
+std::vector<int> idsInModel(const EditCommandsTableModel & model)
+{
+  std::vector<int> ids;
+
+  for(int row = 0; row < model.rowCount(); ++row){
+    ids.push_back( getModelData(model, row, 0).toInt() );
+  }
+
+  return ids;
+}
+
+std::vector<int> idsInTable(const Table & table)
+{
+  std::vector<int> ids;
+
+  for(const auto & record : table){
+    ids.push_back(record.id);
+  }
+
+  return ids;
+}
+
+struct ModelSignalsCounter
+{
+  int modelResetCount = 0;
+  int rowsMovedCount = 0;
+
+  explicit ModelSignalsCounter(QAbstractItemModel & model)
+  {
+    QObject::connect(&model, &QAbstractItemModel::modelReset, [this](){ ++modelResetCount; });
+    QObject::connect(&model, &QAbstractItemModel::rowsMoved, [this](){ ++rowsMovedCount; });
+  }
+};
+
+
+TEST_CASE("same_table")
+{
+  EditCommandsTableModel model;
+  model.setTable( makeTable(5) );
+  ModelSignalsCounter counter(model);
+  InsertRowsSignalsSpy insertSpy(model);
+  RemoveRowsSignalsSpy removeSpy(model);
+  DataChangedSignalSpy dataChangedSpy(model);
+
+  model.replaceTableById( makeTable(5) );
+
+  REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,3,4} );
+  REQUIRE( counter.modelResetCount == 0 );
+  REQUIRE( counter.rowsMovedCount == 0 );
+  REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+  REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+  REQUIRE( dataChangedSpy.count() == 0 );
+}
+
+TEST_CASE("few_changes")
+{
+  EditCommandsTableModel model;
+  model.setTable( makeTable(10) );
+  ModelSignalsCounter counter(model);
+  InsertRowsSignalsSpy insertSpy(model);
+  RemoveRowsSignalsSpy removeSpy(model);
+  DataChangedSignalSpy dataChangedSpy(model);
+
+  SECTION("remove rows")
+  {
+    const QPersistentModelIndex index = model.index(5, 1);
+
+    Table table = makeTable(10);
+    table.erase( table.begin() + 2, table.begin() + 4 );
+    model.replaceTableById(table);
+
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,4,5,6,7,8,9} );
+    REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).first() == 2 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).last() == 3 );
+    REQUIRE( index.row() == 3 );
+    REQUIRE( model.data(index) == QLatin1String("N5") );
+  }
+
+  SECTION("insert rows")
+  {
+    Table table = makeTable(10);
+    table.insert( table.begin() + 1, {100, "A"} );
+    table.push_back( {101, "B"} );
+    model.replaceTableById(table);
+
+    REQUIRE( idsInModel(model) == idsInTable(table) );
+    REQUIRE( insertSpy.rowsInsertedCount() == 2 );
+    REQUIRE( insertSpy.rowsInsertedAt(0).first() == 1 );
+    REQUIRE( insertSpy.rowsInsertedAt(1).first() == 11 );
+    REQUIRE( getModelData(model, 1, 1) == QLatin1String("A") );
+  }
+
+  SECTION("move a row")
+  {
+    const QPersistentModelIndex index = model.index(7, 0);
+
+    Table table = makeTable(10);
+    std::rotate( table.begin() + 1, table.begin() + 7, table.begin() + 8 );
+    model.replaceTableById(table);
+
+    REQUIRE( idsInModel(model) == std::vector<int>{0,7,1,2,3,4,5,6,8,9} );
+    REQUIRE( counter.rowsMovedCount == 1 );
+    REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+    REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+    REQUIRE( index.row() == 1 );
+  }
+
+  SECTION("change data")
+  {
+    Table table = makeTable(10);
+    table[3].name = "C";
+    table[4].name = "D";
+    table[8].name = "E";
+    model.replaceTableById(table);
+
+    REQUIRE( idsInModel(model) == idsInTable(table) );
+    REQUIRE( dataChangedSpy.count() == 2 );
+    REQUIRE( dataChangedSpy.at(0).topLeftIndex().row() == 3 );
+    REQUIRE( dataChangedSpy.at(0).bottomRightIndex().row() == 4 );
+    REQUIRE( dataChangedSpy.at(1).topLeftIndex().row() == 8 );
+    REQUIRE( getModelData(model, 4, 1) == QLatin1String("D") );
+  }
+
+  SECTION("remove, move, insert and change")
+  {
+    Table table = makeTable(10);
+    table.erase( table.begin() + 5 );
+    std::swap( table[0], table[1] );
+    table.push_back( {100, "A"} );
+    table[8].name = "X";
+    model.replaceTableById(table);
+
+    REQUIRE( idsInModel(model) == idsInTable(table) );
+    REQUIRE( getModelData(model, 8, 1) == QLatin1String("X") );
+    REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+    REQUIRE( counter.rowsMovedCount == 1 );
+    REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+    REQUIRE( dataChangedSpy.count() == 1 );
+  }
+
+  REQUIRE( counter.modelResetCount == 0 );
+}
+
+TEST_CASE("most_rows_change")
+{
+  EditCommandsTableModel model;
+  model.setTable( makeTable(10) );
+  ModelSignalsCounter counter(model);
+  InsertRowsSignalsSpy insertSpy(model);
+  RemoveRowsSignalsSpy removeSpy(model);
+
+  Table table = makeTable(10);
+  std::reverse( table.begin(), table.end() );
+  model.replaceTableById(table);
+
+  REQUIRE( idsInModel(model) == std::vector<int>{9,8,7,6,5,4,3,2,1,0} );
+  REQUIRE( counter.modelResetCount == 1 );
+  REQUIRE( counter.rowsMovedCount == 0 );
+  REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+  REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+}
+
+TEST_CASE("from_empty_table")
+{
+  EditCommandsTableModel model;
+  ModelSignalsCounter counter(model);
+
+  model.replaceTableById( makeTable(3) );
+
+  REQUIRE( idsInModel(model) == std::vector<int>{0,1,2} );
+  REQUIRE( counter.modelResetCount == 1 );
+}
+
+TEST_CASE("reclaimer")
+{
+  TableReclaimer reclaimer;
+  EditCommandsTableModel model;
+  model.setTable( makeTable(10) );
+  ModelSignalsCounter counter(model);
+  InsertRowsSignalsSpy insertSpy(model);
+
+  SECTION("few changes")
+  {
+    const QPersistentModelIndex index = model.index(5, 1);
+
+    Table table = makeTable(10);
+    table.push_back( {100, "A"} );
+    model.replaceTableById( std::move(table), reclaimer );
+
+    REQUIRE( table.empty() );
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,3,4,5,6,7,8,9,100} );
+    REQUIRE( counter.modelResetCount == 0 );
+    REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+    REQUIRE( index.row() == 5 );
+  }
+
+  SECTION("same table")
+  {
+    Table table = makeTable(10);
+    model.replaceTableById( std::move(table), reclaimer );
+
+    REQUIRE( table.empty() );
+    REQUIRE( idsInModel(model) == std::vector<int>{0,1,2,3,4,5,6,7,8,9} );
+    REQUIRE( counter.modelResetCount == 0 );
+  }
+
+  SECTION("most rows change")
+  {
+    Table table = makeTable(10);
+    std::reverse( table.begin(), table.end() );
+    model.replaceTableById( std::move(table), reclaimer );
+
+    REQUIRE( table.empty() );
+    REQUIRE( idsInModel(model) == std::vector<int>{9,8,7,6,5,4,3,2,1,0} );
+    REQUIRE( counter.modelResetCount == 1 );
+    REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+  }
+
+  reclaimer.waitForReclaimed();
+}
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "ReadOnlyTableModel.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TableReclaimer.h"
+#include "Mdt/ItemModel/ChunkedTable.h"
+#include "Mdt/Numeric/BasicConversion.h"
+#include <QObject>
+#include <QLatin1String>
+#include <QVariant>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <utility>
+
+using namespace Mdt::ItemModel;
+
+using Table = ReadOnlyTableModel::Table;
+
+struct ModelResetCounter
+{
+  int modelAboutToBeResetCount = 0;
+  int modelResetCount = 0;
+
+  explicit ModelResetCounter(QAbstractItemModel & model)
+  {
+    QObject::connect(&model, &QAbstractItemModel::modelAboutToBeReset, [this](){ ++modelAboutToBeResetCount; });
+    QObject::connect(&model, &QAbstractItemModel::modelReset, [this](){ ++modelResetCount; });
+  }
+};
+
+/*
+ * Records the threads in which the records are destroyed
+ */
+class DestroyingThreads
+{
+ public:
+
+  void add(std::thread::id id)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIds.push_back(id);
+  }
+
+  std::vector<std::thread::id> ids()
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mIds;
+  }
+
+ private:
+
+  std::mutex mMutex;
+  std::vector<std::thread::id> mIds;
+};
+
+class DestroyingThreadTracker
+{
+ public:
+
+  explicit DestroyingThreadTracker(DestroyingThreads & threads) noexcept
+   : mThreads(threads)
+  {
+  }
+
+  DestroyingThreadTracker(const DestroyingThreadTracker &) = delete;
+  DestroyingThreadTracker & operator=(const DestroyingThreadTracker &) = delete;
+  DestroyingThreadTracker(DestroyingThreadTracker &&) = delete;
+  DestroyingThreadTracker & operator=(DestroyingThreadTracker &&) = delete;
+
+  ~DestroyingThreadTracker()
+  {
+    mThreads.add( std::this_thread::get_id() );
+  }
+
+ private:
+
+  DestroyingThreads & mThreads;
+};
+
+/*
+ * The thread is recorded when the last copy of the record is destroyed
+ */
+struct TrackedRecord
+{
+  int value;
+  std::shared_ptr<DestroyingThreadTracker> tracker;
+};
+
+using TrackedTable = ChunkedTable<TrackedRecord>;
+
+class TrackedChunkedTableModel : public AbstractTableModel
+{
+ public:
+
+  void setTable(TrackedTable && table, TableReclaimer & reclaimer)
+  {
+    AbstractTableModel::replaceTable( mTable, std::move(table), reclaimer );
+  }
+
+ private:
+
+  int rowCountWithoutParentIndex() const noexcept override
+  {
+    return Mdt::Numeric::int_from_size_t( mTable.size() );
+  }
+
+  int columnCountWithoutParentIndex() const noexcept override
+  {
+    return 1;
+  }
+
+  QVariant displayRoleData(const QModelIndex & index) const noexcept override
+  {
+    return mTable[static_cast<size_t>( index.row() )].value;
+  }
+
+  TrackedTable mTable;
+};
+
+
+TEST_CASE("replaceTable")
+{
+  ReadOnlyTableModel model;
+  model.setTable({{1,"A"},{2,"B"}});
+  ModelResetCounter counter(model);
+
+  Table newTable{{3,"C"},{4,"D"},{5,"E"}};
+  const Table oldTable = model.replaceTable( std::move(newTable) );
+
+  REQUIRE( counter.modelAboutToBeResetCount == 1 );
+  REQUIRE( counter.modelResetCount == 1 );
+  REQUIRE( model.rowCount() == 3 );
+  REQUIRE( getModelData(model, 0, 0) == 3 );
+  REQUIRE( getModelData(model, 2, 1) == QLatin1String("E") );
+
+  // The storages have been swapped
+  REQUIRE( oldTable.size() == 2 );
+  REQUIRE( oldTable[0].value == 1 );
+  REQUIRE( oldTable[1].name == "B" );
+}
+
+TEST_CASE("replaceTable_emptyTable")
+{
+  ReadOnlyTableModel model;
+  model.setTable({{1,"A"}});
+
+  const Table oldTable = model.replaceTable( Table() );
+
+  REQUIRE( model.rowCount() == 0 );
+  REQUIRE( oldTable.size() == 1 );
+}
+
+TEST_CASE("replaceTable_reclaimer")
+{
+  TableReclaimer reclaimer;
+  ReadOnlyTableModel model;
+  model.setTable({{1,"A"},{2,"B"}});
+  ModelResetCounter counter(model);
+
+  model.replaceTable( Table{{3,"C"}}, reclaimer );
+
+  REQUIRE( counter.modelResetCount == 1 );
+  REQUIRE( model.rowCount() == 1 );
+  REQUIRE( getModelData(model, 0, 1) == QLatin1String("C") );
+
+  model.replaceTable( Table{{4,"D"},{5,"E"}}, reclaimer );
+  reclaimer.waitForReclaimed();
+
+  REQUIRE( counter.modelResetCount == 2 );
+  REQUIRE( model.rowCount() == 2 );
+  REQUIRE( getModelData(model, 1, 0) == 5 );
+}
+
+TEST_CASE("replaceTable_reclaimer_chunkedTable")
+{
+  DestroyingThreads threads;
+  TableReclaimer reclaimer;
+  TrackedChunkedTableModel model;
+
+  TrackedTable firstTable;
+  firstTable.push_back( {1, std::make_shared<DestroyingThreadTracker>(threads)} );
+  model.setTable( std::move(firstTable), reclaimer );
+  REQUIRE( firstTable.empty() );
+
+  // Like a setTable() that builds the new table locally
+  {
+    TrackedTable newTable;
+    newTable.push_back( {2, std::make_shared<DestroyingThreadTracker>(threads)} );
+    model.setTable( std::move(newTable), reclaimer );
+    REQUIRE( newTable.empty() );
+  }
+  REQUIRE( model.rowCount() == 1 );
+  REQUIRE( getModelData(model, 0, 0) == 2 );
+
+  reclaimer.waitForReclaimed();
+
+  // The records of the first table are destroyed in the reclaimer thread
+  const auto ids = threads.ids();
+  REQUIRE( ids.size() == 1 );
+  REQUIRE( ids[0] != std::this_thread::get_id() );
+}
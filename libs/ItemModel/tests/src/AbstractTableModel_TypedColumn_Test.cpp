@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "ReadOnlyTableModel.h"
+#include "ChunkedTableModel.h"
+#include "Mdt/ItemModel/TypedColumn.h"
+#include "Mdt/ItemModel/TypedColumnHelpers.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QVariant>
+#include <QString>
+#include <QLatin1String>
+#include <vector>
+#include <string>
+
+using namespace Mdt::ItemModel;
+
+/*
+ * A model that does not inherit AbstractTableModel,
+ * with row * 10 in column 0
+ */
+class PlainTableModel : public QAbstractTableModel
+{
+ public:
+
+  int rowCount(const QModelIndex & parent = QModelIndex()) const override
+  {
+    if( parent.isValid() ){
+      return 0;
+    }
+    return 5;
+  }
+
+  int columnCount(const QModelIndex & parent = QModelIndex()) const override
+  {
+    if( parent.isValid() ){
+      return 0;
+    }
+    return 1;
+  }
+
+  QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override
+  {
+    if( !index.isValid() || (role != Qt::DisplayRole) ){
+      return QVariant();
+    }
+    return index.row() * 10;
+  }
+};
+
+/*
+ * Populates the model with ids 0 to rowCount-1
+ * and names N0 to N(rowCount-1)
+ */
+template<typename Model>
+void populateModel(Model & model, int rowCount)
+{
+  typename Model::Table table;
+
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "N" + std::to_string(id)} );
+  }
+
+  model.setTable(table);
+}
+
+template<typename Model>
+std::vector<int> visitedIds(const Model & model, const RowRange & rows)
+{
+  std::vector<int> ids;
+
+  const auto appendId = [&ids](int, const int & id){
+    ids.push_back(id);
+  };
+  REQUIRE( model.template visitTypedColumn<int>(0, rows, appendId) );
+
+  return ids;
+}
+
+
+TEST_CASE("TypedColumn")
+{
+  struct Record
+  {
+    int id;
+    double value;
+  };
+  const std::vector<Record> table{{1, 1.5},{2, 2.5},{3, 3.5}};
+
+  SECTION("null")
+  {
+    TypedColumn<int> column;
+    REQUIRE( column.isNull() );
+  }
+
+  SECTION("strided")
+  {
+    const TypedColumn<int> ids( TypedColumnData::fromMember(table.data(), 3, &Record::id) );
+    const TypedColumn<double> values( TypedColumnData::fromMember(table.data() + 1, 2, &Record::value) );
+
+    REQUIRE( !ids.isNull() );
+    REQUIRE( ids.rowCount() == 3 );
+    REQUIRE( ids[0] == 1 );
+    REQUIRE( ids[2] == 3 );
+    REQUIRE( values.rowCount() == 2 );
+    REQUIRE( values[0] == 2.5 );
+    REQUIRE( values[1] == 3.5 );
+  }
+}
+
+TEST_CASE("typedColumn")
+{
+  ReadOnlyTableModel model;
+
+  SECTION("empty model")
+  {
+    REQUIRE( model.typedColumn<int>(0).isNull() );
+  }
+
+  SECTION("array storage")
+  {
+    populateModel(model, 3);
+
+    const TypedColumn<int> values = model.typedColumn<int>(0);
+    REQUIRE( values.rowCount() == 3 );
+    REQUIRE( values[0] == 0 );
+    REQUIRE( values[2] == 2 );
+
+    const TypedColumn<std::string> names = model.typedColumn<std::string>(1);
+    REQUIRE( names.rowCount() == 3 );
+    REQUIRE( names[1] == "N1" );
+  }
+
+  SECTION("not exposed type")
+  {
+    populateModel(model, 3);
+
+    REQUIRE( model.typedColumn<double>(0).isNull() );
+    REQUIRE( model.typedColumn<QString>(1).isNull() );
+  }
+
+  SECTION("chunked storage")
+  {
+    ChunkedTableModel chunkedModel;
+
+    populateModel(chunkedModel, 10);
+    REQUIRE( chunkedModel.typedColumn<int>(0).rowCount() == 10 );
+
+    populateModel(chunkedModel, 1000);
+    REQUIRE( chunkedModel.typedColumn<int>(0).isNull() );
+  }
+}
+
+TEST_CASE("visitTypedColumn")
+{
+  ChunkedTableModel model;
+  populateModel(model, 1000);
+
+  SECTION("all rows")
+  {
+    const std::vector<int> ids = visitedIds( model, RowRange::fromFirstAndLastRow(0, 999) );
+
+    REQUIRE( ids.size() == 1000 );
+    REQUIRE( ids[0] == 0 );
+    REQUIRE( ids[255] == 255 );
+    REQUIRE( ids[256] == 256 );
+    REQUIRE( ids[999] == 999 );
+  }
+
+  SECTION("rows across chunks")
+  {
+    const std::vector<int> ids = visitedIds( model, RowRange::fromFirstAndLastRow(254, 258) );
+
+    REQUIRE( ids == std::vector<int>{254,255,256,257,258} );
+  }
+
+  SECTION("after insert")
+  {
+    REQUIRE( model.insertRows(1, 2) );
+
+    const std::vector<int> ids = visitedIds( model, RowRange::fromFirstAndLastRow(0, 4) );
+
+    REQUIRE( ids == std::vector<int>{0,0,0,1,2} );
+  }
+
+  SECTION("rows are given to the visitor")
+  {
+    std::vector<int> rows;
+    const auto appendRow = [&rows](int row, const std::string &){
+      rows.push_back(row);
+    };
+
+    REQUIRE( model.visitTypedColumn<std::string>(1, RowRange::fromFirstAndLastRow(10, 12), appendRow) );
+    REQUIRE( rows == std::vector<int>{10,11,12} );
+  }
+
+  SECTION("not exposed type")
+  {
+    bool called = false;
+    const auto setCalled = [&called](int, const QString &){
+      called = true;
+    };
+
+    REQUIRE( !model.visitTypedColumn<QString>(1, RowRange::fromFirstAndLastRow(0, 1), setCalled) );
+    REQUIRE( !called );
+  }
+}
+
+TEST_CASE("getColumnValues")
+{
+  SECTION("typed column")
+  {
+    ChunkedTableModel model;
+    populateModel(model, 300);
+
+    const std::vector<int> ids = getColumnValues<int>(model, 0);
+    REQUIRE( ids.size() == 300 );
+    REQUIRE( ids[299] == 299 );
+  }
+
+  SECTION("fallback to data()")
+  {
+    ChunkedTableModel model;
+    populateModel(model, 2);
+
+    const std::vector<QString> names = getColumnValues<QString>(model, 1);
+    REQUIRE( names == std::vector<QString>{QLatin1String("N0"), QLatin1String("N1")} );
+  }
+
+  SECTION("plain QAbstractItemModel")
+  {
+    PlainTableModel model;
+
+    REQUIRE( getColumnValues<int>(model, 0) == std::vector<int>{0,10,20,30,40} );
+  }
+
+  SECTION("empty model")
+  {
+    ChunkedTableModel model;
+
+    REQUIRE( getColumnValues<int>(model, 0).empty() );
+  }
+}
+
+TEST_CASE("forEachColumnValue")
+{
+  PlainTableModel model;
+  std::vector<int> rows;
+  int sum = 0;
+
+  const auto visitor = [&rows, &sum](int row, const int & value){
+    rows.push_back(row);
+    sum += value;
+  };
+  forEachColumnValue<int>(model, 0, RowRange::fromFirstAndLastRow(1, 3), visitor);
+
+  REQUIRE( rows == std::vector<int>{1,2,3} );
+  REQUIRE( sum == 60 );
+}
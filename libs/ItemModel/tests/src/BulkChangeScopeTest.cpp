@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "EditCommandsTableModel.h"
+#include "Mdt/ItemModel/BulkChangeScope.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TestLib/InsertRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/RemoveRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/DataChangedSignalSpy.h"
+#include <QObject>
+#include <QVariant>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+/*
+ * Populates the model with ids 0 to rowCount-1
+ */
+void populateModel(EditCommandsTableModel & model, int rowCount)
+{
+  EditCommandsTableModel::Table table;
+
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "N" + std::to_string(id)} );
+  }
+
+  model.setTable(table);
+}
+
+std::vector<int> idsInModel(const EditCommandsTableModel & model)
+{
+  std::vector<int> ids;
+
+  for(int row = 0; row < model.rowCount(); ++row){
+    ids.push_back( getModelData(model, row, 0).toInt() );
+  }
+
+  return ids;
+}
+
+struct ModelResetCounter
+{
+  int modelResetCount = 0;
+
+  explicit ModelResetCounter(QAbstractItemModel & model)
+  {
+    QObject::connect(&model, &QAbstractItemModel::modelReset, [this](){ ++modelResetCount; });
+  }
+};
+
+
+TEST_CASE("affectedRowsRatio")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 10);
+  BulkChangeScope scope(model);
+
+  REQUIRE( scope.rowCount() == 10 );
+  REQUIRE( scope.affectedRowsRatio() == Approx(0.0) );
+  REQUIRE( !scope.willResetModel() );
+
+  scope.setData(0, 0, 100);
+  scope.setData(0, 1, QLatin1String("A"));
+  scope.setData(1, 0, 101);
+  REQUIRE( scope.affectedRowsRatio() == Approx(0.2) );
+
+  scope.removeRows(5, 2);
+  REQUIRE( scope.rowCount() == 8 );
+  REQUIRE( scope.affectedRowsRatio() == Approx(0.4) );
+
+  scope.insertRows(8, 10);
+  REQUIRE( scope.rowCount() == 18 );
+  REQUIRE( scope.affectedRowsRatio() == Approx(14.0/18.0) );
+  REQUIRE( scope.willResetModel() );
+
+  scope.setResetThreshold(0.9);
+  REQUIRE( !scope.willResetModel() );
+}
+
+TEST_CASE("fine_grained_signals")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 10);
+  ModelResetCounter resetCounter(model);
+  InsertRowsSignalsSpy insertSpy(model);
+  RemoveRowsSignalsSpy removeSpy(model);
+  DataChangedSignalSpy dataChangedSpy(model);
+
+  {
+    BulkChangeScope scope(model);
+    scope.setData(2, 0, 20);
+    scope.setData(3, 0, 30);
+    scope.removeRows(0, 1);
+    REQUIRE( model.rowCount() == 10 );
+  }
+
+  REQUIRE( idsInModel(model) == std::vector<int>{1,20,30,4,5,6,7,8,9} );
+  REQUIRE( resetCounter.modelResetCount == 0 );
+  REQUIRE( dataChangedSpy.count() == 1 );
+  REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+  REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+}
+
+TEST_CASE("model_reset")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 4);
+  ModelResetCounter resetCounter(model);
+  InsertRowsSignalsSpy insertSpy(model);
+  RemoveRowsSignalsSpy removeSpy(model);
+  DataChangedSignalSpy dataChangedSpy(model);
+
+  {
+    BulkChangeScope scope(model);
+    for(int row = 0; row < 4; ++row){
+      scope.setData(row, 0, 10 + row);
+    }
+    scope.removeRows(3, 1);
+    scope.insertRows(0, 1);
+    REQUIRE( scope.willResetModel() );
+  }
+
+  REQUIRE( idsInModel(model) == std::vector<int>{0,10,11,12} );
+  REQUIRE( resetCounter.modelResetCount == 1 );
+  REQUIRE( dataChangedSpy.count() == 0 );
+  REQUIRE( removeSpy.rowsAboutToBeRemovedCount() == 0 );
+  REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+  REQUIRE( insertSpy.rowsAboutToBeInsertedCount() == 0 );
+  REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+}
+
+TEST_CASE("commit")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 10);
+  ModelResetCounter resetCounter(model);
+  InsertRowsSignalsSpy insertSpy(model);
+
+  BulkChangeScope scope(model);
+  scope.insertRows(10, 1);
+  REQUIRE( scope.commit() );
+  REQUIRE( model.rowCount() == 11 );
+  REQUIRE( scope.rowCount() == 11 );
+  REQUIRE( scope.affectedRowsRatio() == Approx(0.0) );
+  REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+
+  REQUIRE( scope.commit() );
+  REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+  REQUIRE( resetCounter.modelResetCount == 0 );
+}
+
+TEST_CASE("commit_slotThrows")
+{
+  EditCommandsTableModel model;
+  populateModel(model, 10);
+  InsertRowsSignalsSpy insertSpy(model);
+  bool slotThrows = true;
+  QObject::connect(&model, &QAbstractItemModel::rowsInserted, [&slotThrows](){
+    if(slotThrows){
+      throw std::runtime_error("slot error");
+    }
+  });
+
+  {
+    BulkChangeScope scope(model);
+    scope.insertRows(10, 1);
+    REQUIRE_THROWS_AS( scope.commit(), std::runtime_error );
+    REQUIRE( scope.affectedRowsRatio() == Approx(0.0) );
+    slotThrows = false;
+  }
+
+  // The edits are not applied again at the end of the scope
+  REQUIRE( model.rowCount() == 11 );
+  REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+}
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "LogTableModel.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TestLib/InsertRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/RemoveRowsSignalsSpy.h"
+#include <QVariant>
+#include <QLatin1String>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+TEST_CASE("construct")
+{
+  LogTableModel model(3);
+
+  REQUIRE( model.maximumRowCount() == 3 );
+  REQUIRE( model.rowCount() == 0 );
+  REQUIRE( model.columnCount() == 2 );
+}
+
+TEST_CASE("support")
+{
+  LogTableModel model(3);
+
+  SECTION("prepend a row is supported")
+  {
+    REQUIRE( model.supportsPrependRow() );
+  }
+
+  SECTION("append a row is not supported")
+  {
+    REQUIRE( !model.supportsAppendRow() );
+  }
+
+  SECTION("insert rows at any valid place is not supported")
+  {
+    REQUIRE( !model.supportsInsertRows() );
+  }
+
+  SECTION("remove the last row is supported")
+  {
+    REQUIRE( model.supportsRemoveLastRow() );
+  }
+
+  SECTION("remove the first row is not supported")
+  {
+    REQUIRE( !model.supportsRemoveFirstRow() );
+  }
+
+  SECTION("remove rows at any valid place is not supported")
+  {
+    REQUIRE( !model.supportsRemoveRows() );
+  }
+}
+
+TEST_CASE("prependRecord")
+{
+  LogTableModel model(2);
+
+  InsertRowsSignalsSpy insertSpy(model);
+  RemoveRowsSignalsSpy removeSpy(model);
+
+  SECTION("model not full")
+  {
+    model.prependRecord({1,"A"});
+    model.prependRecord({2,"B"});
+
+    REQUIRE( model.rowCount() == 2 );
+    REQUIRE( getModelData(model, 0, 1) == QLatin1String("B") );
+    REQUIRE( getModelData(model, 1, 1) == QLatin1String("A") );
+
+    REQUIRE( insertSpy.rowsInsertedCount() == 2 );
+    REQUIRE( insertSpy.rowsInsertedAt(1).first() == 0 );
+    REQUIRE( insertSpy.rowsInsertedAt(1).last() == 0 );
+    REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+  }
+
+  SECTION("model full")
+  {
+    model.prependRecord({1,"A"});
+    model.prependRecord({2,"B"});
+    model.prependRecord({3,"C"});
+
+    REQUIRE( model.rowCount() == 2 );
+    REQUIRE( getModelData(model, 0, 1) == QLatin1String("C") );
+    REQUIRE( getModelData(model, 1, 1) == QLatin1String("B") );
+
+    REQUIRE( insertSpy.rowsInsertedCount() == 3 );
+    REQUIRE( removeSpy.rowsAboutToBeRemovedCount() == 1 );
+    REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+
+    const auto rowsRemoved = removeSpy.rowsRemovedAt(0);
+    REQUIRE( removeSpy.rowsAboutToBeRemovedAt(0) == rowsRemoved );
+    REQUIRE( !rowsRemoved.parentIndex().isValid() );
+    REQUIRE( rowsRemoved.first() == 1 );
+    REQUIRE( rowsRemoved.last() == 1 );
+  }
+
+  SECTION("maximum row count of 1")
+  {
+    LogTableModel smallModel(1);
+
+    smallModel.prependRecord({1,"A"});
+    smallModel.prependRecord({2,"B"});
+
+    REQUIRE( smallModel.rowCount() == 1 );
+    REQUIRE( smallModel.recordAt(0).id == 2 );
+  }
+}
+
+TEST_CASE("prependRow")
+{
+  LogTableModel model(2);
+  model.prependRecord({1,"A"});
+  model.prependRecord({2,"B"});
+
+  RemoveRowsSignalsSpy removeSpy(model);
+
+  REQUIRE( prependRowToModel(model) );
+
+  REQUIRE( model.rowCount() == 2 );
+  REQUIRE( model.recordAt(0).id == 0 );
+  REQUIRE( model.recordAt(1).id == 2 );
+
+  REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+  REQUIRE( removeSpy.rowsRemovedAt(0).first() == 2 );
+  REQUIRE( removeSpy.rowsRemovedAt(0).last() == 2 );
+}
+
+TEST_CASE("removeLastRow")
+{
+  LogTableModel model(3);
+  model.prependRecord({1,"A"});
+  model.prependRecord({2,"B"});
+
+  REQUIRE( removeLastRowFromModel(model) );
+
+  REQUIRE( model.rowCount() == 1 );
+  REQUIRE( model.recordAt(0).id == 2 );
+}
+
+TEST_CASE("NotSupportedCases")
+{
+  LogTableModel model(5);
+  model.prependRecord({1,"A"});
+  model.prependRecord({2,"B"});
+  model.prependRecord({3,"C"});
+
+  InsertRowsSignalsSpy insertSpy(model);
+  RemoveRowsSignalsSpy removeSpy(model);
+
+  SECTION("insert 2 rows at the beginning is not supported")
+  {
+    REQUIRE( !model.insertRows(0, 2) );
+  }
+
+  SECTION("remove a row in the middle is not supported")
+  {
+    REQUIRE( !model.removeRows(1, 1) );
+  }
+
+  REQUIRE( model.rowCount() == 3 );
+  REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+  REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+}
+
+TEST_CASE("setMaximumRowCount")
+{
+  LogTableModel model(4);
+  model.prependRecord({1,"A"});
+  model.prependRecord({2,"B"});
+  model.prependRecord({3,"C"});
+
+  RemoveRowsSignalsSpy removeSpy(model);
+
+  SECTION("increase")
+  {
+    model.setMaximumRowCount(10);
+
+    REQUIRE( model.maximumRowCount() == 10 );
+    REQUIRE( model.rowCount() == 3 );
+    REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+  }
+
+  SECTION("reduce below the row count")
+  {
+    model.setMaximumRowCount(1);
+
+    REQUIRE( model.rowCount() == 1 );
+    REQUIRE( model.recordAt(0).id == 3 );
+
+    REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).first() == 1 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).last() == 2 );
+  }
+}
+
+TEST_CASE("clear")
+{
+  LogTableModel model(3);
+  model.prependRecord({1,"A"});
+
+  model.clear();
+
+  REQUIRE( model.rowCount() == 0 );
+  REQUIRE( model.maximumRowCount() == 3 );
+}
@@ -0,0 +1,353 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/ChunkedTable.h"
+#include "Mdt/ItemModel/ChunkedTableSnapshot.h"
+#include <vector>
+#include <string>
+#include <numeric>
+#include <thread>
+#include <utility>
+
+using namespace Mdt::ItemModel;
+
+using IntTable = ChunkedTable<int>;
+
+template<typename Table>
+std::vector<int> vectorFromTable(const Table & table)
+{
+  return std::vector<int>( table.cbegin(), table.cend() );
+}
+
+std::vector<int> vectorFromIndexes(const IntTable & table)
+{
+  std::vector<int> v;
+
+  for(size_t i = 0; i < table.size(); ++i){
+    v.push_back(table[i]);
+  }
+
+  return v;
+}
+
+/*
+ * Returns a table with elements 0 to count-1,
+ * with a chunk capacity of 3
+ */
+IntTable makeTable(int count)
+{
+  std::vector<int> v( static_cast<size_t>(count) );
+  std::iota(v.begin(), v.end(), 0);
+
+  return IntTable(v.cbegin(), v.cend(), 3);
+}
+
+
+TEST_CASE("construct")
+{
+  SECTION("default")
+  {
+    IntTable table;
+
+    REQUIRE( table.empty() );
+    REQUIRE( table.size() == 0 );
+    REQUIRE( table.chunkCount() == 0 );
+    REQUIRE( table.chunkCapacity() == IntTable::defaultChunkCapacity );
+    REQUIRE( table.cbegin() == table.cend() );
+  }
+
+  SECTION("range")
+  {
+    const IntTable table = makeTable(7);
+
+    REQUIRE( table.size() == 7 );
+    REQUIRE( table.chunkCount() == 3 );
+    REQUIRE( vectorFromTable(table) == std::vector<int>{0,1,2,3,4,5,6} );
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{0,1,2,3,4,5,6} );
+  }
+
+  SECTION("initializer list")
+  {
+    const IntTable table({1,2,3,4}, 2);
+
+    REQUIRE( table.chunkCount() == 2 );
+    REQUIRE( vectorFromTable(table) == std::vector<int>{1,2,3,4} );
+  }
+}
+
+TEST_CASE("push_pop")
+{
+  IntTable table(2);
+
+  table.push_back(1);
+  table.push_back(2);
+  table.push_back(3);
+
+  REQUIRE( table.chunkCount() == 2 );
+  REQUIRE( vectorFromIndexes(table) == std::vector<int>{1,2,3} );
+
+  table.pop_back();
+  REQUIRE( table.chunkCount() == 1 );
+  REQUIRE( vectorFromTable(table) == std::vector<int>{1,2} );
+}
+
+TEST_CASE("insert")
+{
+  IntTable table = makeTable(6);
+
+  SECTION("in a empty table")
+  {
+    IntTable emptyTable(3);
+
+    emptyTable.insert(0, 2, 9);
+
+    REQUIRE( vectorFromTable(emptyTable) == std::vector<int>{9,9} );
+  }
+
+  SECTION("at the beginning")
+  {
+    table.insert(0, 1, 9);
+
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{9,0,1,2,3,4,5} );
+  }
+
+  SECTION("at a chunk boundary")
+  {
+    table.insert(3, 2, 9);
+
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{0,1,2,9,9,3,4,5} );
+  }
+
+  SECTION("at the end")
+  {
+    table.insert(6, 1, 9);
+
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{0,1,2,3,4,5,9} );
+  }
+
+  SECTION("many elements that splits a chunk")
+  {
+    table.insert(1, 7, 9);
+
+    REQUIRE( table.size() == 13 );
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{0,9,9,9,9,9,9,9,1,2,3,4,5} );
+    REQUIRE( vectorFromTable(table) == vectorFromIndexes(table) );
+  }
+
+  SECTION("range")
+  {
+    const std::vector<int> v{7,8};
+
+    table.insert( 4, v.cbegin(), v.cend() );
+
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{0,1,2,3,7,8,4,5} );
+  }
+}
+
+TEST_CASE("erase")
+{
+  IntTable table = makeTable(9);
+
+  SECTION("in a chunk")
+  {
+    table.erase(4, 1);
+
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{0,1,2,3,5,6,7,8} );
+  }
+
+  SECTION("a whole chunk")
+  {
+    table.erase(3, 3);
+
+    REQUIRE( table.chunkCount() == 2 );
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{0,1,2,6,7,8} );
+  }
+
+  SECTION("across chunks")
+  {
+    table.erase(1, 6);
+
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{0,7,8} );
+    REQUIRE( vectorFromTable(table) == std::vector<int>{0,7,8} );
+  }
+
+  SECTION("all")
+  {
+    table.erase(0, 9);
+
+    REQUIRE( table.empty() );
+    REQUIRE( table.chunkCount() == 0 );
+    REQUIRE( table.cbegin() == table.cend() );
+  }
+}
+
+TEST_CASE("move")
+{
+  IntTable table = makeTable(6);
+
+  SECTION("up")
+  {
+    table.move(4, 2, 1);
+
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{0,4,5,1,2,3} );
+  }
+
+  SECTION("down")
+  {
+    table.move(0, 2, 6);
+
+    REQUIRE( vectorFromIndexes(table) == std::vector<int>{2,3,4,5,0,1} );
+  }
+}
+
+TEST_CASE("mutableAt")
+{
+  IntTable table = makeTable(5);
+
+  table.mutableAt(4) = 9;
+
+  REQUIRE( table[4] == 9 );
+}
+
+TEST_CASE("contiguousElementsFrom")
+{
+  const IntTable table = makeTable(5);
+
+  const auto first = table.contiguousElementsFrom(0);
+  REQUIRE( first.second == 3 );
+  REQUIRE( first.first[0] == 0 );
+  REQUIRE( first.first[2] == 2 );
+
+  const auto middle = table.contiguousElementsFrom(1);
+  REQUIRE( middle.second == 2 );
+  REQUIRE( middle.first[0] == 1 );
+
+  const auto last = table.contiguousElementsFrom(4);
+  REQUIRE( last.second == 1 );
+  REQUIRE( last.first[0] == 4 );
+}
+
+TEST_CASE("copy_on_write")
+{
+  IntTable table = makeTable(9);
+
+  SECTION("copy")
+  {
+    IntTable copy = table;
+
+    copy.mutableAt(0) = 9;
+    copy.erase(8, 1);
+
+    REQUIRE( vectorFromTable(table) == std::vector<int>{0,1,2,3,4,5,6,7,8} );
+    REQUIRE( vectorFromTable(copy) == std::vector<int>{9,1,2,3,4,5,6,7} );
+  }
+
+  SECTION("snapshot")
+  {
+    const auto snapshot = table.snapshot();
+
+    table.mutableAt(4) = 9;
+    table.insert(0, 1, 9);
+    table.erase(7, 2);
+    table.push_back(9);
+
+    REQUIRE( snapshot.size() == 9 );
+    REQUIRE( snapshot[4] == 4 );
+    REQUIRE( vectorFromTable(snapshot) == std::vector<int>{0,1,2,3,4,5,6,7,8} );
+    REQUIRE( vectorFromTable(table) == std::vector<int>{9,0,1,2,3,9,5,8,9} );
+  }
+
+  SECTION("empty snapshot")
+  {
+    const ChunkedTableSnapshot<int> snapshot;
+
+    REQUIRE( snapshot.isEmpty() );
+    REQUIRE( snapshot.cbegin() == snapshot.cend() );
+  }
+
+  SECTION("clear")
+  {
+    const auto snapshot = table.snapshot();
+
+    table.clear();
+
+    REQUIRE( table.empty() );
+    REQUIRE( snapshot.size() == 9 );
+  }
+}
+
+TEST_CASE("move_table")
+{
+  IntTable table = makeTable(5);
+  const auto snapshot = table.snapshot();
+
+  SECTION("move construct")
+  {
+    IntTable other( std::move(table) );
+
+    REQUIRE( vectorFromTable(other) == std::vector<int>{0,1,2,3,4} );
+    REQUIRE( other.chunkCapacity() == 3 );
+    REQUIRE( table.empty() );
+    REQUIRE( table.chunkCount() == 0 );
+    REQUIRE( table.chunkCapacity() == IntTable::defaultChunkCapacity );
+  }
+
+  SECTION("move assign")
+  {
+    IntTable other = makeTable(2);
+
+    other = std::move(table);
+
+    REQUIRE( vectorFromTable(other) == std::vector<int>{0,1,2,3,4} );
+    REQUIRE( table.empty() );
+  }
+
+  SECTION("the moved from table is usable")
+  {
+    IntTable other( std::move(table) );
+
+    table.push_back(1);
+    table.insert(0, 1, 0);
+    IntTable empty;
+
+    REQUIRE( vectorFromTable(table) == std::vector<int>{0,1} );
+    REQUIRE( empty.empty() );
+    REQUIRE( vectorFromTable(other) == std::vector<int>{0,1,2,3,4} );
+  }
+
+  REQUIRE( vectorFromTable(snapshot) == std::vector<int>{0,1,2,3,4} );
+}
+
+TEST_CASE("snapshot_in_other_thread")
+{
+  ChunkedTable<std::string> table;
+  for(int i = 0; i < 10'000; ++i){
+    table.push_back( std::to_string(i) );
+  }
+
+  const auto snapshot = table.snapshot();
+  size_t totalLength = 0;
+  std::thread worker([snapshot, &totalLength](){
+    for(const auto & str : snapshot){
+      totalLength += str.size();
+    }
+  });
+
+  for(size_t i = 0; i < 1'000; ++i){
+    table.mutableAt(i * 8) = "modified";
+    table.erase(0, 1);
+  }
+  worker.join();
+
+  REQUIRE( totalLength == 38'890 );
+  REQUIRE( snapshot.size() == 10'000 );
+  REQUIRE( snapshot[0] == "0" );
+  REQUIRE( table.size() == 9'000 );
+}
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "Mdt/ItemModel/DelimitedTextParser.h"
+#include <QString>
+#include <QLatin1String>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+using namespace Mdt::ItemModel;
+
+void parseRow(DelimitedTextRow & row, const std::string & text, DelimitedTextFormat format = DelimitedTextFormat::Csv)
+{
+  row.parse( text.data(), text.data() + text.size(), format );
+}
+
+std::vector<std::size_t> rowStarts(const std::string & text, int chunkCount)
+{
+  return findDelimitedTextRowStarts( text.data(), text.size(), chunkCount );
+}
+
+
+TEST_CASE("DelimitedTextRow_parse")
+{
+  DelimitedTextRow row;
+
+  SECTION("empty row")
+  {
+    parseRow(row, "");
+    REQUIRE( row.fieldCount() == 1 );
+    REQUIRE( row.fieldSize(0) == 0 );
+  }
+
+  SECTION("A,B")
+  {
+    parseRow(row, "A,B");
+    REQUIRE( row.fieldCount() == 2 );
+    REQUIRE( row.toStdString(0) == "A" );
+    REQUIRE( row.toStdString(1) == "B" );
+  }
+
+  SECTION("A, (trailing separator)")
+  {
+    parseRow(row, "A,");
+    REQUIRE( row.fieldCount() == 2 );
+    REQUIRE( row.toStdString(0) == "A" );
+    REQUIRE( row.toStdString(1).empty() );
+  }
+
+  SECTION("A,B\\r")
+  {
+    parseRow(row, "A,B\r");
+    REQUIRE( row.fieldCount() == 2 );
+    REQUIRE( row.toStdString(1) == "B" );
+  }
+
+  SECTION("quoted fields")
+  {
+    parseRow(row, "\"A,B\",\"C\"\"D\"\"\",\"E\nF\",\"\"");
+    REQUIRE( row.fieldCount() == 4 );
+    REQUIRE( row.toStdString(0) == "A,B" );
+    REQUIRE( row.toStdString(1) == "C\"D\"" );
+    REQUIRE( row.toStdString(2) == "E\nF" );
+    REQUIRE( row.toStdString(3).empty() );
+  }
+
+  SECTION("TSV")
+  {
+    parseRow(row, "A,B\tC", DelimitedTextFormat::Tsv);
+    REQUIRE( row.fieldCount() == 2 );
+    REQUIRE( row.toStdString(0) == "A,B" );
+    REQUIRE( row.toStdString(1) == "C" );
+  }
+
+  SECTION("UTF-8")
+  {
+    parseRow(row, "\xC3\xA9t\xC3\xA9");
+    REQUIRE( row.toQString(0) == QString::fromUtf8("\xC3\xA9t\xC3\xA9") );
+  }
+
+  SECTION("reuse")
+  {
+    parseRow(row, "\"A\"\"\",B,C");
+    REQUIRE( row.fieldCount() == 3 );
+    parseRow(row, "D");
+    REQUIRE( row.fieldCount() == 1 );
+    REQUIRE( row.toStdString(0) == "D" );
+  }
+}
+
+TEST_CASE("DelimitedTextRow_conversions")
+{
+  DelimitedTextRow row;
+  int intValue = 0;
+  qlonglong longLongValue = 0;
+  double doubleValue = 0.0;
+
+  parseRow(row, "42,-1234567890123,0.25,,A,1.5x,99999999999");
+
+  REQUIRE( row.toInt(0, intValue) );
+  REQUIRE( intValue == 42 );
+  REQUIRE( row.toLongLong(1, longLongValue) );
+  REQUIRE( longLongValue == -1234567890123LL );
+  REQUIRE( row.toDouble(2, doubleValue) );
+  REQUIRE( doubleValue == 0.25 );
+
+  REQUIRE( !row.toInt(3, intValue) );
+  REQUIRE( !row.toDouble(3, doubleValue) );
+  REQUIRE( !row.toInt(4, intValue) );
+  REQUIRE( !row.toDouble(5, doubleValue) );
+  REQUIRE( !row.toInt(6, intValue) );
+  REQUIRE( row.toLongLong(6, longLongValue) );
+}
+
+TEST_CASE("findDelimitedTextRowStarts")
+{
+  SECTION("empty text")
+  {
+    REQUIRE( rowStarts("", 1).empty() );
+  }
+
+  SECTION("1 row without line feed")
+  {
+    REQUIRE( rowStarts("A", 1) == std::vector<std::size_t>{0} );
+  }
+
+  SECTION("2 rows")
+  {
+    REQUIRE( rowStarts("A\nB\n", 1) == std::vector<std::size_t>{0, 2} );
+  }
+
+  SECTION("line feed in quoted field")
+  {
+    REQUIRE( rowStarts("\"A\nB\",C\nD", 1) == std::vector<std::size_t>{0, 8} );
+  }
+
+  SECTION("doubled quotes")
+  {
+    REQUIRE( rowStarts("\"A\"\"\nB\"\nC", 1) == std::vector<std::size_t>{0, 8} );
+  }
+}
+
+TEST_CASE("findDelimitedTextRowStarts_chunks")
+{
+  /*
+   * Build a text that spans several chunks,
+   * with quoted fields that contain line feeds
+   * (so some chunks start inside a quoted field)
+   */
+  std::string text;
+  std::vector<std::size_t> expectedRowStarts;
+  for(int i = 0; i < 100000; ++i){
+    expectedRowStarts.push_back( text.size() );
+    text += std::to_string(i);
+    if( (i % 3) == 0 ){
+      text += ",\"Line 1\nLine \"\"2\"\"\n\"\n";
+    }else{
+      text += ",Name\n";
+    }
+  }
+  REQUIRE( text.size() > 4 * delimitedTextMinimumChunkSize );
+
+  const int chunkCount = GENERATE(1, 2, 3, 4, 7);
+
+  REQUIRE( rowStarts(text, chunkCount) == expectedRowStarts );
+}
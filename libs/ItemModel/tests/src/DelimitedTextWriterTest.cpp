@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/DelimitedTextWriter.h"
+#include <QBuffer>
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+#include <QLatin1String>
+#include <QVariant>
+#include <string>
+
+using namespace Mdt::ItemModel;
+
+std::string writtenText(const QBuffer & buffer)
+{
+  return buffer.data().toStdString();
+}
+
+
+TEST_CASE("fields")
+{
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+
+  {
+    DelimitedTextWriter writer(buffer);
+    REQUIRE( writer.format() == DelimitedTextFormat::Csv );
+
+    writer.writeField(42);
+    writer.writeField( std::string("A") );
+    writer.writeField( QStringLiteral("B") );
+    writer.writeEmptyField();
+    writer.endRow();
+    writer.writeField(-7);
+    writer.writeField(qlonglong(12345678901234));
+    writer.writeField(0.5);
+    writer.endRow();
+  }
+
+  REQUIRE( writtenText(buffer) == "42,A,B,\n-7,12345678901234,0.5\n" );
+}
+
+TEST_CASE("quoting")
+{
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+
+  SECTION("CSV")
+  {
+    DelimitedTextWriter writer(buffer, DelimitedTextFormat::Csv);
+
+    writer.writeField( std::string("a,b") );
+    writer.writeField( QStringLiteral("say \"hi\"") );
+    writer.writeField( std::string("line\nbreak") );
+    writer.writeField( std::string("a\tb") );
+    writer.endRow();
+    REQUIRE( writer.flush() );
+
+    REQUIRE( writtenText(buffer) == "\"a,b\",\"say \"\"hi\"\"\",\"line\nbreak\",a\tb\n" );
+  }
+
+  SECTION("TSV")
+  {
+    DelimitedTextWriter writer(buffer, DelimitedTextFormat::Tsv);
+
+    writer.writeField( std::string("a,b") );
+    writer.writeField( QStringLiteral("a\tb") );
+    writer.endRow();
+    REQUIRE( writer.flush() );
+
+    REQUIRE( writtenText(buffer) == "a,b\t\"a\tb\"\n" );
+  }
+}
+
+TEST_CASE("utf8")
+{
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  DelimitedTextWriter writer(buffer);
+
+  const QString text = QString::fromUtf8("\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+  writer.writeField(text);
+  writer.endRow();
+  REQUIRE( writer.flush() );
+
+  REQUIRE( writtenText(buffer) == "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\n" );
+}
+
+TEST_CASE("variant")
+{
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  DelimitedTextWriter writer(buffer);
+
+  writer.writeField( QVariant(3) );
+  writer.writeField( QVariant(1.25) );
+  writer.writeField( QVariant( QLatin1String("x,y") ) );
+  writer.writeField( QVariant() );
+  writer.endRow();
+  REQUIRE( writer.flush() );
+
+  REQUIRE( writtenText(buffer) == "3,1.25,\"x,y\",\n" );
+}
+
+TEST_CASE("double")
+{
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  DelimitedTextWriter writer(buffer);
+
+  writer.writeField(0.1);
+  writer.writeField(1.0 / 3.0);
+  writer.writeField(1e300);
+  writer.endRow();
+  REQUIRE( writer.flush() );
+
+  REQUIRE( writtenText(buffer) == "0.1,0.33333333333333331,1e+300\n" );
+}
+
+TEST_CASE("buffer")
+{
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  DelimitedTextWriter writer(buffer, DelimitedTextFormat::Csv, 8);
+
+  writer.writeField( std::string("ABCD") );
+  writer.writeField( std::string("EF") );
+  REQUIRE( buffer.data().isEmpty() );
+  REQUIRE( writer.byteCount() == 7 );
+
+  writer.writeField( std::string("G") );
+  REQUIRE( writtenText(buffer) == "ABCD,EF,G" );
+
+  writer.endRow();
+  REQUIRE( writer.byteCount() == 10 );
+  REQUIRE( writer.flush() );
+  REQUIRE( !writer.hasError() );
+  REQUIRE( writtenText(buffer) == "ABCD,EF,G\n" );
+}
@@ -114,3 +114,36 @@ TEST_CASE("removeLastFromStlContainer")
   REQUIRE( v[0] == 1 );
   REQUIRE( v[1] == 2 );
 }
+
+TEST_CASE("moveInStlContainer")
+{
+  std::vector<int> v{0,1,2,3,4};
+
+  SECTION("move 1 element to the beginning")
+  {
+    moveInStlContainer(v, 3, 1, 0);
+
+    REQUIRE( v == std::vector<int>{3,0,1,2,4} );
+  }
+
+  SECTION("move 2 elements up")
+  {
+    moveInStlContainer(v, 3, 2, 1);
+
+    REQUIRE( v == std::vector<int>{0,3,4,1,2} );
+  }
+
+  SECTION("move 2 elements down")
+  {
+    moveInStlContainer(v, 0, 2, 4);
+
+    REQUIRE( v == std::vector<int>{2,3,0,1,4} );
+  }
+
+  SECTION("move 1 element to the end")
+  {
+    moveInStlContainer(v, 1, 1, 5);
+
+    REQUIRE( v == std::vector<int>{0,2,3,4,1} );
+  }
+}
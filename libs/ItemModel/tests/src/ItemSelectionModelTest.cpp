@@ -4,7 +4,7 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2011-2023 Philippe Steinmann.
+ ** Copyright (C) 2011-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #include "catch2/catch.hpp"
@@ -12,6 +12,8 @@
 #include "ItemSelectionModelTester.h"
 #include "ReadOnlyTableModel.h"
 #include "Mdt/ItemModel/ItemSelectionModel.h"
+#include "Mdt/ItemModel/RowSelection.h"
+#include "Mdt/ItemModel/RowRangeList.h"
 #include <QItemSelectionModel>
 #include <QItemSelection>
 #include <QModelIndex>
@@ -791,3 +793,51 @@ TEST_CASE("selectIsCoherentWithCurrent_QModelIndex_overload")
     REQUIRE( indexByRowAndColumnIsSelected(selectionModel, 0, 0) );
   }
 }
+
+TEST_CASE("selectRows")
+{
+  ReadOnlyTableModel model;
+  model.setTable({{1,"A"},{2,"B"},{3,"C"},{4,"D"},{5,"E"}});
+
+  ItemSelectionModel selectionModel(&model);
+  RowRangeList rowRangeList;
+
+  SECTION("2 ranges")
+  {
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow(0, 1) );
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow(3, 3) );
+
+    selectionModel.selectRows( RowSelection::fromRowRangeList(rowRangeList), QItemSelectionModel::ClearAndSelect );
+
+    REQUIRE( selectionModel.selection().count() == 2 );
+    REQUIRE( selectionModel.selectedRows().count() == 3 );
+    REQUIRE( selectionModel.isRowSelected(0, QModelIndex()) );
+    REQUIRE( selectionModel.isRowSelected(1, QModelIndex()) );
+    REQUIRE( !selectionModel.isRowSelected(2, QModelIndex()) );
+    REQUIRE( selectionModel.isRowSelected(3, QModelIndex()) );
+    REQUIRE( !selectionModel.isRowSelected(4, QModelIndex()) );
+  }
+
+  SECTION("clear and select")
+  {
+    selectRowAndColumn_QModelIndex(selectionModel, 4, 0);
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow(1, 2) );
+
+    selectionModel.selectRows( RowSelection::fromRowRangeList(rowRangeList), QItemSelectionModel::ClearAndSelect );
+
+    REQUIRE( selectionModel.selectedRows().count() == 2 );
+    REQUIRE( !indexByRowAndColumnIsSelected(selectionModel, 4, 0) );
+  }
+
+  SECTION("change current row is NOT allowed")
+  {
+    setCurrentIndexForRowAndColumn(selectionModel, 0, 0);
+    selectionModel.setChangeCurrentRowAllowed(false);
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow(2, 3) );
+
+    // Multiple items selections are applied, like with select()
+    selectionModel.selectRows( RowSelection::fromRowRangeList(rowRangeList), QItemSelectionModel::ClearAndSelect );
+
+    REQUIRE( selectionModel.selectedRows().count() == 2 );
+  }
+}
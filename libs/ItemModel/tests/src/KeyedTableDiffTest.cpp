@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/KeyedTableDiff.h"
+#include "Mdt/ItemModel/TableStorage.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <numeric>
+
+using namespace Mdt::ItemModel;
+
+struct Record
+{
+  int id;
+  std::string name;
+};
+
+bool operator==(const Record & a, const Record & b) noexcept
+{
+  return (a.id == b.id) && (a.name == b.name);
+}
+
+using Table = std::vector<Record>;
+
+bool rangeIs(const RowRange & range, int firstRow, int lastRow)
+{
+  return (range.firstRow() == firstRow) && (range.lastRow() == lastRow);
+}
+
+int recordId(const Record & record)
+{
+  return record.id;
+}
+
+KeyedTableDiff computeDiff(const Table & oldTable, const Table & newTable)
+{
+  return computeKeyedTableDiff(oldTable, newTable, recordId, std::equal_to<>());
+}
+
+/*
+ * Applies diff to table, the way AbstractTableModel::replaceTableByKey() does
+ */
+void applyDiff(Table & table, const Table & newTable, const KeyedTableDiff & diff)
+{
+  using Storage = TableStorage<Table>;
+
+  for(auto it = diff.removedRows().crbegin(); it != diff.removedRows().crend(); ++it){
+    Storage::removeRows( table, it->firstRow(), it->rowCount() );
+  }
+  for(const RowMove & move : diff.moves()){
+    REQUIRE( ( (move.destinationRow < move.sourceRow) || (move.destinationRow > move.sourceRow + move.count) ) );
+    Storage::moveRows(table, move.sourceRow, move.count, move.destinationRow);
+  }
+  for(const RowRange & range : diff.insertedRows()){
+    const auto first = std::next( newTable.cbegin(), range.firstRow() );
+    Storage::insertRows( table, range.firstRow(), first, std::next( first, range.rowCount() ) );
+  }
+  for(const RowRange & range : diff.changedRows()){
+    for(int row = range.firstRow(); row <= range.lastRow(); ++row){
+      Storage::setRecord( table, row, newTable[static_cast<size_t>(row)] );
+    }
+  }
+}
+
+Table makeTable(const std::vector<int> & ids)
+{
+  Table table;
+
+  for(int id : ids){
+    table.push_back( {id, "N" + std::to_string(id)} );
+  }
+
+  return table;
+}
+
+
+TEST_CASE("same_tables")
+{
+  SECTION("empty")
+  {
+    REQUIRE( computeDiff(Table(), Table()).isEmpty() );
+  }
+
+  SECTION("not empty")
+  {
+    const Table table = makeTable({1,2,3});
+
+    const auto diff = computeDiff(table, table);
+
+    REQUIRE( diff.isEmpty() );
+    REQUIRE( diff.affectedRowCount() == 0 );
+  }
+}
+
+TEST_CASE("remove_insert_change")
+{
+  const Table oldTable = makeTable({1,2,3,4,5});
+
+  SECTION("remove")
+  {
+    const Table newTable = makeTable({1,4});
+
+    const auto diff = computeDiff(oldTable, newTable);
+
+    REQUIRE( diff.removedRows().rangeCount() == 2 );
+    REQUIRE( rangeIs(diff.removedRows().rangeAt(0), 1, 2) );
+    REQUIRE( rangeIs(diff.removedRows().rangeAt(1), 4, 4) );
+    REQUIRE( diff.moves().empty() );
+    REQUIRE( diff.insertedRows().isEmpty() );
+    REQUIRE( diff.changedRows().isEmpty() );
+  }
+
+  SECTION("insert")
+  {
+    const Table newTable = makeTable({0,1,2,3,10,11,4,5});
+
+    const auto diff = computeDiff(oldTable, newTable);
+
+    REQUIRE( diff.removedRows().isEmpty() );
+    REQUIRE( diff.moves().empty() );
+    REQUIRE( diff.insertedRows().rangeCount() == 2 );
+    REQUIRE( rangeIs(diff.insertedRows().rangeAt(0), 0, 0) );
+    REQUIRE( rangeIs(diff.insertedRows().rangeAt(1), 4, 5) );
+  }
+
+  SECTION("change")
+  {
+    Table newTable = oldTable;
+    newTable[1].name = "B";
+    newTable[2].name = "C";
+
+    const auto diff = computeDiff(oldTable, newTable);
+
+    REQUIRE( diff.changedRows().rangeCount() == 1 );
+    REQUIRE( rangeIs(diff.changedRows().rangeAt(0), 1, 2) );
+    REQUIRE( diff.affectedRowCount() == 2 );
+  }
+}
+
+TEST_CASE("moves")
+{
+  SECTION("move 1 row to the end")
+  {
+    const Table oldTable = makeTable({1,2,3,4,5});
+    const Table newTable = makeTable({2,3,4,5,1});
+
+    const auto diff = computeDiff(oldTable, newTable);
+
+    REQUIRE( diff.moves().size() == 1 );
+    REQUIRE( diff.moves()[0].sourceRow == 0 );
+    REQUIRE( diff.moves()[0].count == 1 );
+    REQUIRE( diff.moves()[0].destinationRow == 5 );
+  }
+
+  SECTION("a contiguous block is moved at once")
+  {
+    const Table oldTable = makeTable({1,2,3,4,5,6,7});
+    const Table newTable = makeTable({1,5,6,2,3,4,7});
+
+    const auto diff = computeDiff(oldTable, newTable);
+
+    REQUIRE( diff.moves().size() == 1 );
+    REQUIRE( diff.moves()[0].count == 2 );
+    REQUIRE( diff.affectedRowCount() == 2 );
+
+    Table table = oldTable;
+    applyDiff(table, newTable, diff);
+    REQUIRE( table == newTable );
+  }
+}
+
+TEST_CASE("duplicate_keys")
+{
+  const Table oldTable = makeTable({1,1,2});
+  const Table newTable = makeTable({2,1,2});
+
+  const auto diff = computeDiff(oldTable, newTable);
+
+  Table table = oldTable;
+  applyDiff(table, newTable, diff);
+  REQUIRE( table == newTable );
+}
+
+TEST_CASE("random_tables")
+{
+  std::mt19937 generator(12345);
+  std::vector<int> ids(40);
+  std::iota(ids.begin(), ids.end(), 0);
+
+  for(int i = 0; i < 2'000; ++i){
+    const auto oldRowCount = static_cast<std::ptrdiff_t>(generator() % 25);
+    const auto newRowCount = static_cast<std::ptrdiff_t>(generator() % 25);
+
+    std::shuffle(ids.begin(), ids.end(), generator);
+    Table oldTable = makeTable( std::vector<int>(ids.cbegin(), ids.cbegin() + oldRowCount) );
+    std::shuffle(ids.begin(), ids.begin() + 30, generator);
+    Table newTable = makeTable( std::vector<int>(ids.cbegin(), ids.cbegin() + newRowCount) );
+    for(auto & record : newTable){
+      if(generator() % 4 == 0){
+        record.name = "changed";
+      }
+    }
+
+    const auto diff = computeDiff(oldTable, newTable);
+    applyDiff(oldTable, newTable, diff);
+
+    REQUIRE( oldTable == newTable );
+  }
+}
+
+TEST_CASE("big_table_with_few_changes")
+{
+  std::vector<int> ids(100'000);
+  std::iota(ids.begin(), ids.end(), 0);
+  const Table oldTable = makeTable(ids);
+
+  Table newTable = oldTable;
+  newTable[500].name = "changed";
+  newTable.erase(newTable.begin() + 1'000);
+  newTable.insert( newTable.begin() + 2'000, Record{-1, "new"} );
+  std::rotate(newTable.begin() + 10, newTable.begin() + 11, newTable.begin() + 50'000);
+
+  const auto diff = computeDiff(oldTable, newTable);
+
+  REQUIRE( diff.affectedRowCount() == 4 );
+
+  Table table = oldTable;
+  applyDiff(table, newTable, diff);
+  REQUIRE( table == newTable );
+}
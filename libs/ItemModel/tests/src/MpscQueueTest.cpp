@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/MpscQueue.h"
+#include <thread>
+#include <vector>
+#include <string>
+#include <memory>
+#include <utility>
+
+using namespace Mdt::ItemModel;
+
+struct ProducerValue
+{
+  int producer = -1;
+  int sequence = -1;
+};
+
+
+TEST_CASE("single_thread")
+{
+  MpscQueue<std::string> queue;
+  std::string value;
+
+  SECTION("empty")
+  {
+    REQUIRE( queue.isEmpty() );
+    REQUIRE( !queue.tryPop(value) );
+  }
+
+  SECTION("FIFO")
+  {
+    queue.push("A");
+    queue.push("B");
+    REQUIRE( !queue.isEmpty() );
+
+    REQUIRE( queue.tryPop(value) );
+    REQUIRE( value == "A" );
+    queue.push("C");
+    REQUIRE( queue.tryPop(value) );
+    REQUIRE( value == "B" );
+    REQUIRE( queue.tryPop(value) );
+    REQUIRE( value == "C" );
+    REQUIRE( !queue.tryPop(value) );
+    REQUIRE( queue.isEmpty() );
+  }
+
+  SECTION("destroy a queue that is not empty")
+  {
+    auto pointerQueue = std::make_unique< MpscQueue< std::unique_ptr<int> > >();
+    pointerQueue->push( std::make_unique<int>(1) );
+    pointerQueue->push( std::make_unique<int>(2) );
+
+    pointerQueue.reset();
+  }
+}
+
+TEST_CASE("multiple_producers")
+{
+  constexpr int producerCount = 4;
+  constexpr int valueCountPerProducer = 10'000;
+
+  MpscQueue<ProducerValue> queue;
+  std::vector<std::thread> producers;
+
+  for(int producer = 0; producer < producerCount; ++producer){
+    producers.emplace_back([&queue, producer](){
+      for(int sequence = 0; sequence < valueCountPerProducer; ++sequence){
+        queue.push( {producer, sequence} );
+      }
+    });
+  }
+
+  /*
+   * Pop while the producers are pushing.
+   * The values of each producer must come in the order they have been pushed.
+   */
+  std::vector<int> nextSequence(producerCount, 0);
+  int poppedCount = 0;
+  ProducerValue value;
+  while( poppedCount < producerCount*valueCountPerProducer ){
+    if( !queue.tryPop(value) ){
+      std::this_thread::yield();
+      continue;
+    }
+    REQUIRE( value.producer >= 0 );
+    REQUIRE( value.producer < producerCount );
+    REQUIRE( value.sequence == nextSequence[static_cast<size_t>(value.producer)] );
+    ++nextSequence[static_cast<size_t>(value.producer)];
+    ++poppedCount;
+  }
+
+  for(auto & producer : producers){
+    producer.join();
+  }
+
+  REQUIRE( queue.isEmpty() );
+  REQUIRE( nextSequence == std::vector<int>(producerCount, valueCountPerProducer) );
+}
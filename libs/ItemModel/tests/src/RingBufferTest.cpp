@@ -0,0 +1,368 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/RingBuffer.h"
+#include "Mdt/ItemModel/StlHelpers.h"
+#include <vector>
+#include <string>
+#include <iterator>
+#include <algorithm>
+
+using namespace Mdt::ItemModel;
+
+using IntBuffer = RingBuffer<int>;
+
+std::vector<int> vectorFromBuffer(const IntBuffer & buffer)
+{
+  return std::vector<int>( buffer.cbegin(), buffer.cend() );
+}
+
+std::vector<int> vectorFromSegments(const IntBuffer & buffer)
+{
+  std::vector<int> v;
+
+  for( int value : buffer.firstSegment() ){
+    v.push_back(value);
+  }
+  for( int value : buffer.secondSegment() ){
+    v.push_back(value);
+  }
+
+  return v;
+}
+
+/*
+ * Returns a buffer with capacity 8 that wraps around the end of its storage:
+ * storage: |5|6|x|x|x|x|3|4|
+ * logical: {3,4,5,6}
+ */
+IntBuffer makeWrappedBuffer()
+{
+  IntBuffer buffer;
+  buffer.reserve(8);
+  for(int i = 0; i < 6; ++i){
+    buffer.push_back(i);
+  }
+  for(int i = 0; i < 6; ++i){
+    buffer.pop_front();
+  }
+  for(int i = 3; i <= 6; ++i){
+    buffer.push_back(i);
+  }
+
+  return buffer;
+}
+
+
+TEST_CASE("construct")
+{
+  SECTION("default")
+  {
+    IntBuffer buffer;
+
+    REQUIRE( buffer.empty() );
+    REQUIRE( buffer.size() == 0 );
+    REQUIRE( buffer.cbegin() == buffer.cend() );
+  }
+
+  SECTION("count")
+  {
+    IntBuffer buffer(3);
+
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{0,0,0} );
+  }
+
+  SECTION("count and value")
+  {
+    IntBuffer buffer(2, 5);
+
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{5,5} );
+  }
+
+  SECTION("initializer list")
+  {
+    IntBuffer buffer{1,2,3};
+
+    REQUIRE( buffer.size() == 3 );
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{1,2,3} );
+  }
+}
+
+TEST_CASE("copy_move")
+{
+  IntBuffer buffer = makeWrappedBuffer();
+
+  SECTION("copy construct")
+  {
+    IntBuffer copy(buffer);
+
+    REQUIRE( copy == buffer );
+    REQUIRE( vectorFromBuffer(copy) == std::vector<int>{3,4,5,6} );
+  }
+
+  SECTION("copy assign")
+  {
+    IntBuffer copy{1};
+    copy = buffer;
+
+    REQUIRE( copy == buffer );
+  }
+
+  SECTION("move construct")
+  {
+    IntBuffer moved( std::move(buffer) );
+
+    REQUIRE( vectorFromBuffer(moved) == std::vector<int>{3,4,5,6} );
+  }
+
+  SECTION("move assign")
+  {
+    IntBuffer moved{1};
+    moved = std::move(buffer);
+
+    REQUIRE( vectorFromBuffer(moved) == std::vector<int>{3,4,5,6} );
+  }
+}
+
+TEST_CASE("push_pop")
+{
+  IntBuffer buffer;
+
+  SECTION("push back")
+  {
+    buffer.push_back(1);
+    buffer.push_back(2);
+
+    REQUIRE( buffer.front() == 1 );
+    REQUIRE( buffer.back() == 2 );
+  }
+
+  SECTION("push front")
+  {
+    buffer.push_front(2);
+    buffer.push_front(1);
+
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{1,2} );
+  }
+
+  SECTION("grow while wrapped")
+  {
+    buffer = makeWrappedBuffer();
+    REQUIRE( buffer.capacity() == 8 );
+
+    for(int i = 7; i < 12; ++i){
+      buffer.push_back(i);
+    }
+    buffer.push_front(2);
+
+    REQUIRE( buffer.capacity() > 8 );
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{2,3,4,5,6,7,8,9,10,11} );
+  }
+
+  SECTION("push front a element of the buffer while growing")
+  {
+    buffer.reserve(8);
+    for(int i = 0; i < 8; ++i){
+      buffer.push_back(i);
+    }
+
+    buffer.push_front( buffer.back() );
+
+    REQUIRE( buffer.front() == 7 );
+    REQUIRE( buffer.size() == 9 );
+  }
+
+  SECTION("pop")
+  {
+    buffer = IntBuffer{1,2,3};
+
+    buffer.pop_front();
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{2,3} );
+
+    buffer.pop_back();
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{2} );
+  }
+}
+
+TEST_CASE("random_access")
+{
+  const IntBuffer buffer = makeWrappedBuffer();
+
+  REQUIRE( buffer[0] == 3 );
+  REQUIRE( buffer[3] == 6 );
+  REQUIRE( buffer.cbegin()[2] == 5 );
+  REQUIRE( std::distance( buffer.cbegin(), buffer.cend() ) == 4 );
+  REQUIRE( *(buffer.cend() - 1) == 6 );
+  REQUIRE( std::vector<int>( buffer.crbegin(), buffer.crend() ) == std::vector<int>{6,5,4,3} );
+}
+
+TEST_CASE("segments")
+{
+  SECTION("empty")
+  {
+    IntBuffer buffer;
+
+    REQUIRE( buffer.firstSegment().isEmpty() );
+    REQUIRE( buffer.secondSegment().isEmpty() );
+  }
+
+  SECTION("not wrapped")
+  {
+    IntBuffer buffer{1,2,3};
+
+    REQUIRE( buffer.firstSegment().size == 3 );
+    REQUIRE( buffer.secondSegment().isEmpty() );
+  }
+
+  SECTION("wrapped")
+  {
+    const IntBuffer buffer = makeWrappedBuffer();
+
+    REQUIRE( buffer.firstSegment().size == 2 );
+    REQUIRE( buffer.secondSegment().size == 2 );
+    REQUIRE( vectorFromSegments(buffer) == std::vector<int>{3,4,5,6} );
+  }
+}
+
+TEST_CASE("insert")
+{
+  IntBuffer buffer = makeWrappedBuffer();
+
+  SECTION("at the beginning")
+  {
+    const auto it = buffer.insert(buffer.cbegin(), 2, 0);
+
+    REQUIRE( it == buffer.begin() );
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{0,0,3,4,5,6} );
+  }
+
+  SECTION("near the beginning")
+  {
+    const auto it = buffer.insert(buffer.cbegin() + 1, 2, 0);
+
+    REQUIRE( it == buffer.begin() + 1 );
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{3,0,0,4,5,6} );
+  }
+
+  SECTION("near the end")
+  {
+    buffer.insert(buffer.cbegin() + 3, 2, 0);
+
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{3,4,5,0,0,6} );
+  }
+
+  SECTION("at the end")
+  {
+    buffer.insert(buffer.cend(), 1, 7);
+
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{3,4,5,6,7} );
+  }
+
+  SECTION("with grow")
+  {
+    buffer.insert(buffer.cbegin() + 2, 10, 0);
+
+    REQUIRE( buffer.size() == 14 );
+    REQUIRE( buffer[1] == 4 );
+    REQUIRE( buffer[2] == 0 );
+    REQUIRE( buffer[11] == 0 );
+    REQUIRE( buffer[12] == 5 );
+  }
+
+  SECTION("a element of the buffer")
+  {
+    buffer.insert(buffer.cbegin(), 1, buffer[3]);
+
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{6,3,4,5,6} );
+  }
+}
+
+TEST_CASE("erase")
+{
+  IntBuffer buffer = makeWrappedBuffer();
+
+  SECTION("first")
+  {
+    const auto it = buffer.erase( buffer.cbegin() );
+
+    REQUIRE( *it == 4 );
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{4,5,6} );
+  }
+
+  SECTION("range near the beginning")
+  {
+    const auto it = buffer.erase( buffer.cbegin() + 1, buffer.cbegin() + 2 );
+
+    REQUIRE( *it == 5 );
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{3,5,6} );
+  }
+
+  SECTION("range near the end")
+  {
+    buffer.erase( buffer.cbegin() + 2, buffer.cbegin() + 3 );
+
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{3,4,6} );
+  }
+
+  SECTION("last")
+  {
+    const auto it = buffer.erase( buffer.cend() - 1 );
+
+    REQUIRE( it == buffer.end() );
+    REQUIRE( vectorFromBuffer(buffer) == std::vector<int>{3,4,5} );
+  }
+
+  SECTION("all")
+  {
+    buffer.erase( buffer.cbegin(), buffer.cend() );
+
+    REQUIRE( buffer.empty() );
+  }
+}
+
+TEST_CASE("StlHelpers")
+{
+  RingBuffer<std::string> buffer{"A","B","C"};
+
+  SECTION("insertToStlContainer")
+  {
+    insertToStlContainer(buffer, 1, 2, std::string("X"));
+
+    REQUIRE( buffer.size() == 5 );
+    REQUIRE( buffer[0] == "A" );
+    REQUIRE( buffer[1] == "X" );
+    REQUIRE( buffer[2] == "X" );
+    REQUIRE( buffer[3] == "B" );
+  }
+
+  SECTION("removeFromStlContainer")
+  {
+    removeFromStlContainer(buffer, 1, 2);
+
+    REQUIRE( buffer.size() == 1 );
+    REQUIRE( buffer[0] == "A" );
+  }
+
+  SECTION("removeFirstFromStlContainer")
+  {
+    removeFirstFromStlContainer(buffer);
+
+    REQUIRE( buffer.size() == 2 );
+    REQUIRE( buffer[0] == "B" );
+  }
+
+  SECTION("removeLastFromStlContainer")
+  {
+    removeLastFromStlContainer(buffer);
+
+    REQUIRE( buffer.size() == 2 );
+    REQUIRE( buffer[1] == "B" );
+  }
+}
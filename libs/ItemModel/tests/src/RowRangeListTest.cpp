@@ -10,6 +10,9 @@
 #include "catch2/catch.hpp"
 #include "Catch2QString.h"
 #include "Mdt/ItemModel/RowRangeList.h"
+#include <memory_resource>
+#include <cstddef>
+#include <utility>
 
 using namespace Mdt::ItemModel;
 
@@ -196,3 +199,77 @@ TEST_CASE("addRange")
     REQUIRE( list.rangeAt(1).lastRow() == 3 );
   }
 }
+
+/*
+ * Adds the ranges [0,0], [2,2], [4,4], ...
+ */
+void addNonAdjacentRanges(RowRangeList & list, int rangeCount)
+{
+  for(int i = 0; i < rangeCount; ++i){
+    list.addRange( RowRange::fromFirstAndLastRow(2*i, 2*i) );
+  }
+}
+
+TEST_CASE("memoryResource")
+{
+  // All allocations must come from the buffer
+  alignas(std::max_align_t) unsigned char buffer[4096];
+  std::pmr::monotonic_buffer_resource arena( buffer, sizeof(buffer), std::pmr::null_memory_resource() );
+
+  SECTION("default")
+  {
+    RowRangeList list;
+
+    REQUIRE( list.memoryResource() == std::pmr::get_default_resource() );
+  }
+
+  SECTION("ranges past the inline capacity are allocated from the resource")
+  {
+    RowRangeList list(&arena);
+    addNonAdjacentRanges(list, 20);
+
+    REQUIRE( list.memoryResource() == &arena );
+    REQUIRE( list.rangeCount() == 20 );
+    REQUIRE( list.rangeAt(19).firstRow() == 38 );
+  }
+
+  SECTION("copy")
+  {
+    RowRangeList list(&arena);
+    addNonAdjacentRanges(list, 10);
+
+    const RowRangeList copy = list;
+    REQUIRE( copy.memoryResource() == std::pmr::get_default_resource() );
+    REQUIRE( copy.rangeCount() == 10 );
+
+    const RowRangeList copyInArena(copy, &arena);
+    REQUIRE( copyInArena.memoryResource() == &arena );
+    REQUIRE( copyInArena.rangeCount() == 10 );
+  }
+
+  SECTION("assign keeps the resource")
+  {
+    RowRangeList list;
+    addNonAdjacentRanges(list, 10);
+
+    RowRangeList listInArena(&arena);
+    listInArena = list;
+    REQUIRE( listInArena.memoryResource() == &arena );
+    REQUIRE( listInArena.rangeCount() == 10 );
+
+    RowRangeList otherListInArena(&arena);
+    otherListInArena = std::move(list);
+    REQUIRE( otherListInArena.memoryResource() == &arena );
+    REQUIRE( otherListInArena.rangeCount() == 10 );
+  }
+
+  SECTION("move keeps the resource")
+  {
+    RowRangeList list(&arena);
+    addNonAdjacentRanges(list, 10);
+
+    const RowRangeList other = std::move(list);
+    REQUIRE( other.memoryResource() == &arena );
+    REQUIRE( other.rangeCount() == 10 );
+  }
+}
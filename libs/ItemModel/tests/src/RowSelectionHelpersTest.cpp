@@ -4,14 +4,17 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2011-2023 Philippe Steinmann.
+ ** Copyright (C) 2011-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #include "catch2/catch.hpp"
 #include "Catch2QString.h"
 #include "ReadOnlyTableModel.h"
 #include "Mdt/ItemModel/RowSelectionHelpers.h"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "Mdt/ItemModel/RowSelection.h"
 #include <QItemSelectionRange>
+#include <QItemSelection>
 #include <cassert>
 
 using namespace Mdt::ItemModel;
@@ -87,3 +90,72 @@ TEST_CASE("rowRangeFromItemSelectionRange")
     REQUIRE( rowRange.lastRow() == 2 );
   }
 }
+
+TEST_CASE("itemSelectionFromRowRangeList")
+{
+  ReadOnlyTableModel model;
+  RowRangeList rowRangeList;
+
+  populateModel(model,
+  {
+    {1,"A"},
+    {2,"B"},
+    {3,"C"},
+    {4,"D"},
+    {5,"E"}
+  });
+
+  SECTION("empty list")
+  {
+    const QItemSelection selection = itemSelectionFromRowRangeList(model, rowRangeList);
+
+    REQUIRE( selection.isEmpty() );
+  }
+
+  SECTION("1 range")
+  {
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow(1, 2) );
+
+    const QItemSelection selection = itemSelectionFromRowRangeList(model, rowRangeList);
+
+    REQUIRE( selection.count() == 1 );
+    REQUIRE( selection.at(0) == makeItemSelectionRange(model, {1,0}, {2,1}) );
+  }
+
+  SECTION("2 ranges")
+  {
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow(0, 0) );
+    rowRangeList.addRange( RowRange::fromFirstAndLastRow(2, 4) );
+
+    const QItemSelection selection = itemSelectionFromRowRangeList(model, rowRangeList);
+
+    REQUIRE( selection.count() == 2 );
+    REQUIRE( selection.at(0) == makeItemSelectionRange(model, {0,0}, {0,1}) );
+    REQUIRE( selection.at(1) == makeItemSelectionRange(model, {2,0}, {4,1}) );
+  }
+}
+
+TEST_CASE("itemSelectionFromRowSelection")
+{
+  ReadOnlyTableModel model;
+  RowRangeList rowRangeList;
+
+  populateModel(model,
+  {
+    {1,"A"},
+    {2,"B"},
+    {3,"C"},
+    {4,"D"}
+  });
+
+  rowRangeList.addRange( RowRange::fromFirstAndLastRow(0, 1) );
+  rowRangeList.addRange( RowRange::fromFirstAndLastRow(3, 3) );
+  const auto rowSelection = RowSelection::fromRowRangeList(rowRangeList);
+
+  const QItemSelection selection = itemSelectionFromRowSelection(model, rowSelection);
+
+  REQUIRE( selection.count() == 2 );
+  REQUIRE( selection.at(0) == makeItemSelectionRange(model, {0,0}, {1,1}) );
+  REQUIRE( selection.at(1) == makeItemSelectionRange(model, {3,0}, {3,1}) );
+  REQUIRE( RowSelection::fromItemSelection(selection).rangeCount() == 2 );
+}
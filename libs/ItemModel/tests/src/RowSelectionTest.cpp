@@ -13,6 +13,8 @@
 #include "Mdt/ItemModel/RowSelection.h"
 #include <QItemSelection>
 #include <QItemSelectionRange>
+#include <QModelIndexList>
+#include <memory_resource>
 #include <cassert>
 
 // #include <QDebug>
@@ -203,3 +205,69 @@ TEST_CASE("fromItemSelection")
     REQUIRE( rowSelection.rangeAt(0).lastRow() == 2 );
   }
 }
+
+TEST_CASE("memoryResource")
+{
+  ReadOnlyTableModel model;
+  QItemSelection itemSelection;
+
+  populateModel(model,
+  {
+    {1,"A"},{2,"B"},{3,"C"},{4,"D"},{5,"E"},{6,"F"},{7,"G"},{8,"H"},{9,"I"},{10,"J"}
+  });
+
+  // Rows 0, 2, 4, 6 and 8: more ranges than the inline capacity
+  for(int row = 0; row < 10; row += 2){
+    addItemRangeToSelection(model, {row,0}, {row,0}, itemSelection);
+  }
+
+  // All allocations must come from the buffer
+  alignas(std::max_align_t) unsigned char buffer[4096];
+  std::pmr::monotonic_buffer_resource arena( buffer, sizeof(buffer), std::pmr::null_memory_resource() );
+
+  SECTION("default")
+  {
+    const RowSelection rowSelection;
+
+    REQUIRE( rowSelection.memoryResource() == std::pmr::get_default_resource() );
+  }
+
+  SECTION("fromItemSelection")
+  {
+    const auto rowSelection = RowSelection::fromItemSelection(itemSelection, &arena);
+
+    REQUIRE( rowSelection.memoryResource() == &arena );
+    REQUIRE( rowSelection.rangeCount() == 5 );
+    REQUIRE( rowSelection.rangeAt(4).firstRow() == 8 );
+  }
+
+  SECTION("fromModelIndexList")
+  {
+    const QModelIndexList indexes = itemSelection.indexes();
+    const auto rowSelection = RowSelection::fromModelIndexList(indexes, &arena);
+
+    REQUIRE( rowSelection.memoryResource() == &arena );
+    REQUIRE( rowSelection.rangeCount() == 5 );
+  }
+
+  SECTION("fromRowRangeList")
+  {
+    RowRangeList rowRangeList;
+    for(int row = 0; row < 10; row += 2){
+      rowRangeList.addRange( RowRange::fromFirstAndLastRow(row, row) );
+    }
+    const auto rowSelection = RowSelection::fromRowRangeList(rowRangeList, &arena);
+
+    REQUIRE( rowSelection.memoryResource() == &arena );
+    REQUIRE( rowSelection.rangeCount() == 5 );
+  }
+
+  SECTION("a copy uses the default resource")
+  {
+    const auto rowSelection = RowSelection::fromItemSelection(itemSelection, &arena);
+    const RowSelection copy = rowSelection;
+
+    REQUIRE( copy.memoryResource() == std::pmr::get_default_resource() );
+    REQUIRE( copy.rangeCount() == 5 );
+  }
+}
@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "EventWindowTableModel.h"
+#include "Mdt/ItemModel/SlidingWindowUpdate.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TestLib/InsertRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/RemoveRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/DataChangedSignalSpy.h"
+#include <QObject>
+#include <QVariant>
+#include <QLatin1String>
+#include <vector>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+std::vector<EventRecord> makeEvents(int firstId, int count)
+{
+  std::vector<EventRecord> events;
+
+  for(int id = firstId; id < firstId + count; ++id){
+    events.push_back( {id, "E" + std::to_string(id)} );
+  }
+
+  return events;
+}
+
+void appendEvents(EventWindowTableModel & model, int firstId, int count)
+{
+  const auto events = makeEvents(firstId, count);
+  model.appendRecords( events.cbegin(), events.cend() );
+}
+
+std::vector<int> idsInModel(const EventWindowTableModel & model)
+{
+  std::vector<int> ids;
+
+  for(const auto & record : model.table()){
+    ids.push_back(record.id);
+  }
+
+  return ids;
+}
+
+
+TEST_CASE("slidingWindowUpdateForBatch")
+{
+  SECTION("empty batch")
+  {
+    REQUIRE( slidingWindowUpdateForBatch(0, 10, 0) == SlidingWindowUpdate::None );
+    REQUIRE( slidingWindowUpdateForBatch(10, 10, 0) == SlidingWindowUpdate::None );
+  }
+
+  SECTION("window can hold the batch")
+  {
+    REQUIRE( slidingWindowUpdateForBatch(0, 10, 1) == SlidingWindowUpdate::Insert );
+    REQUIRE( slidingWindowUpdateForBatch(0, 10, 10) == SlidingWindowUpdate::Insert );
+    REQUIRE( slidingWindowUpdateForBatch(8, 10, 2) == SlidingWindowUpdate::Insert );
+  }
+
+  SECTION("window full, small batch")
+  {
+    REQUIRE( slidingWindowUpdateForBatch(10, 10, 1) == SlidingWindowUpdate::RemoveAndInsert );
+    REQUIRE( slidingWindowUpdateForBatch(10, 10, 4) == SlidingWindowUpdate::RemoveAndInsert );
+  }
+
+  SECTION("window full, large batch")
+  {
+    REQUIRE( slidingWindowUpdateForBatch(10, 10, 5) == SlidingWindowUpdate::DataChanged );
+    REQUIRE( slidingWindowUpdateForBatch(10, 10, 10) == SlidingWindowUpdate::DataChanged );
+    REQUIRE( slidingWindowUpdateForBatch(10, 10, 100) == SlidingWindowUpdate::DataChanged );
+  }
+
+  SECTION("window not full, batch overflows")
+  {
+    REQUIRE( slidingWindowUpdateForBatch(8, 10, 3) == SlidingWindowUpdate::RemoveAndInsert );
+    REQUIRE( slidingWindowUpdateForBatch(8, 10, 10) == SlidingWindowUpdate::RemoveAndInsert );
+  }
+
+  SECTION("window of 1 row")
+  {
+    REQUIRE( slidingWindowUpdateForBatch(0, 1, 1) == SlidingWindowUpdate::Insert );
+    REQUIRE( slidingWindowUpdateForBatch(1, 1, 1) == SlidingWindowUpdate::DataChanged );
+  }
+}
+
+TEST_CASE("construct")
+{
+  EventWindowTableModel model(3);
+
+  REQUIRE( model.windowSize() == 3 );
+  REQUIRE( model.rowCount() == 0 );
+  REQUIRE( model.columnCount() == 2 );
+}
+
+TEST_CASE("appendRecords")
+{
+  EventWindowTableModel model(10);
+
+  SECTION("empty batch")
+  {
+    InsertRowsSignalsSpy insertSpy(model);
+
+    appendEvents(model, 1, 0);
+
+    REQUIRE( model.rowCount() == 0 );
+    REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+  }
+
+  SECTION("window not full")
+  {
+    appendEvents(model, 1, 5);
+
+    InsertRowsSignalsSpy insertSpy(model);
+    RemoveRowsSignalsSpy removeSpy(model);
+
+    appendEvents(model, 6, 3);
+
+    REQUIRE( idsInModel(model) == std::vector<int>{1,2,3,4,5,6,7,8} );
+    REQUIRE( getModelData(model, 7, 1) == QLatin1String("E8") );
+
+    REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+    REQUIRE( insertSpy.rowsInsertedAt(0).first() == 5 );
+    REQUIRE( insertSpy.rowsInsertedAt(0).last() == 7 );
+    REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+  }
+
+  SECTION("window full, small batch: 1 remove and 1 insert")
+  {
+    appendEvents(model, 1, 10);
+
+    InsertRowsSignalsSpy insertSpy(model);
+    RemoveRowsSignalsSpy removeSpy(model);
+    DataChangedSignalSpy dataChangedSpy(model);
+
+    appendEvents(model, 11, 3);
+
+    REQUIRE( idsInModel(model) == std::vector<int>{4,5,6,7,8,9,10,11,12,13} );
+
+    REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).first() == 0 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).last() == 2 );
+
+    REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+    REQUIRE( insertSpy.rowsInsertedAt(0).first() == 7 );
+    REQUIRE( insertSpy.rowsInsertedAt(0).last() == 9 );
+
+    REQUIRE( dataChangedSpy.count() == 0 );
+  }
+
+  SECTION("window not full, batch overflows")
+  {
+    appendEvents(model, 1, 8);
+
+    InsertRowsSignalsSpy insertSpy(model);
+    RemoveRowsSignalsSpy removeSpy(model);
+
+    appendEvents(model, 9, 4);
+
+    REQUIRE( idsInModel(model) == std::vector<int>{3,4,5,6,7,8,9,10,11,12} );
+
+    REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).first() == 0 );
+    REQUIRE( removeSpy.rowsRemovedAt(0).last() == 1 );
+
+    REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+    REQUIRE( insertSpy.rowsInsertedAt(0).first() == 6 );
+    REQUIRE( insertSpy.rowsInsertedAt(0).last() == 9 );
+  }
+
+  SECTION("window full, large batch: rotate in place")
+  {
+    appendEvents(model, 1, 10);
+
+    InsertRowsSignalsSpy insertSpy(model);
+    RemoveRowsSignalsSpy removeSpy(model);
+    DataChangedSignalSpy dataChangedSpy(model);
+
+    appendEvents(model, 11, 6);
+
+    REQUIRE( idsInModel(model) == std::vector<int>{7,8,9,10,11,12,13,14,15,16} );
+    REQUIRE( getModelData(model, 0, 1) == QLatin1String("E7") );
+
+    REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+    REQUIRE( removeSpy.rowsRemovedCount() == 0 );
+
+    REQUIRE( dataChangedSpy.count() == 1 );
+    REQUIRE( dataChangedSpy.firstTopLeftIndex().row() == 0 );
+    REQUIRE( dataChangedSpy.firstTopLeftIndex().column() == 0 );
+    REQUIRE( dataChangedSpy.firstBottomRightIndex().row() == 9 );
+    REQUIRE( dataChangedSpy.firstBottomRightIndex().column() == 1 );
+  }
+
+  SECTION("window full, large batch: slot connected before the display data cache")
+  {
+    QVariant firstNameSeenBySlot;
+    QObject::connect(&model, &QAbstractItemModel::dataChanged, [&model, &firstNameSeenBySlot](){
+      firstNameSeenBySlot = getModelData(model, 0, 1);
+    });
+    model.setDisplayDataCacheCapacity(20);
+    appendEvents(model, 1, 10);
+    REQUIRE( getModelData(model, 0, 1) == QLatin1String("E1") );
+
+    appendEvents(model, 11, 6);
+
+    REQUIRE( firstNameSeenBySlot == QLatin1String("E7") );
+  }
+
+  SECTION("batch bigger than the window")
+  {
+    appendEvents(model, 1, 25);
+
+    REQUIRE( idsInModel(model) == std::vector<int>{16,17,18,19,20,21,22,23,24,25} );
+  }
+}
+
+TEST_CASE("appendRecord")
+{
+  EventWindowTableModel model(3);
+
+  model.appendRecord({1,"A"});
+  model.appendRecord({2,"B"});
+  model.appendRecord({3,"C"});
+
+  RemoveRowsSignalsSpy removeSpy(model);
+  InsertRowsSignalsSpy insertSpy(model);
+
+  model.appendRecord({4,"D"});
+
+  REQUIRE( idsInModel(model) == std::vector<int>{2,3,4} );
+  REQUIRE( removeSpy.rowsRemovedCount() == 1 );
+  REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+}
+
+TEST_CASE("removeFirstRow")
+{
+  EventWindowTableModel model(3);
+  appendEvents(model, 1, 3);
+
+  REQUIRE( model.supportsRemoveFirstRow() );
+  REQUIRE( !model.supportsRemoveLastRow() );
+  REQUIRE( removeFirstRowFromModel(model) );
+
+  REQUIRE( idsInModel(model) == std::vector<int>{2,3} );
+}
+
+TEST_CASE("clear")
+{
+  EventWindowTableModel model(3);
+  appendEvents(model, 1, 3);
+
+  model.clear();
+
+  REQUIRE( model.rowCount() == 0 );
+
+  appendEvents(model, 4, 1);
+  REQUIRE( idsInModel(model) == std::vector<int>{4} );
+}
@@ -0,0 +1,425 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/SmallVector.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <cstddef>
+
+using namespace Mdt::ItemModel;
+
+using IntVector = SmallVector<int, 3>;
+using StringVector = SmallVector<std::string, 2>;
+
+std::vector<int> stdVectorFromSmallVector(const IntVector & v)
+{
+  return std::vector<int>( v.cbegin(), v.cend() );
+}
+
+std::vector<std::string> stdVectorFromSmallVector(const StringVector & v)
+{
+  return std::vector<std::string>( v.cbegin(), v.cend() );
+}
+
+using PmrIntVector = SmallVector<int, 2, std::pmr::polymorphic_allocator<int>>;
+
+std::vector<int> stdVectorFromSmallVector(const PmrIntVector & v)
+{
+  return std::vector<int>( v.cbegin(), v.cend() );
+}
+
+class CountingMemoryResource : public std::pmr::memory_resource
+{
+ public:
+
+  int allocationCount = 0;
+  int deallocationCount = 0;
+
+ private:
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    ++allocationCount;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+  {
+    ++deallocationCount;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+  {
+    return &other == this;
+  }
+};
+
+/*
+ * Not default constructible
+ */
+struct Value
+{
+  explicit Value(int v)
+   : value(v)
+  {
+  }
+
+  int value;
+};
+
+
+TEST_CASE("construct")
+{
+  SECTION("default")
+  {
+    IntVector v;
+
+    REQUIRE( v.empty() );
+    REQUIRE( v.size() == 0 );
+    REQUIRE( v.capacity() == 3 );
+    REQUIRE( v.isInline() );
+    REQUIRE( v.cbegin() == v.cend() );
+  }
+
+  SECTION("initializer list (inline)")
+  {
+    IntVector v{1,2};
+
+    REQUIRE( v.isInline() );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,2} );
+  }
+
+  SECTION("initializer list (allocated)")
+  {
+    IntVector v{1,2,3,4};
+
+    REQUIRE( !v.isInline() );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,2,3,4} );
+  }
+}
+
+TEST_CASE("push_back")
+{
+  IntVector v;
+
+  SECTION("up to inline capacity")
+  {
+    v.push_back(1);
+    v.push_back(2);
+    v.push_back(3);
+
+    REQUIRE( v.isInline() );
+    REQUIRE( v.size() == 3 );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,2,3} );
+  }
+
+  SECTION("past inline capacity")
+  {
+    for(int i = 1; i <= 10; ++i){
+      v.push_back(i);
+    }
+
+    REQUIRE( !v.isInline() );
+    REQUIRE( v.capacity() >= 10 );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,2,3,4,5,6,7,8,9,10} );
+  }
+
+  SECTION("a element of the vector itself when it grows")
+  {
+    StringVector strings{"A","B"};
+    strings.push_back( strings[0] );
+
+    REQUIRE( stdVectorFromSmallVector(strings) == std::vector<std::string>{"A","B","A"} );
+  }
+}
+
+TEST_CASE("emplace_back")
+{
+  SmallVector<Value, 1> v;
+
+  v.emplace_back(1);
+  v.emplace_back(2);
+
+  REQUIRE( v.size() == 2 );
+  REQUIRE( v[0].value == 1 );
+  REQUIRE( v[1].value == 2 );
+}
+
+TEST_CASE("insert")
+{
+  IntVector v{1,3};
+
+  SECTION("at begin")
+  {
+    const auto it = v.insert(v.cbegin(), 0);
+
+    REQUIRE( it == v.begin() );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{0,1,3} );
+    REQUIRE( v.isInline() );
+  }
+
+  SECTION("in the middle")
+  {
+    const auto it = v.insert(v.cbegin()+1, 2);
+
+    REQUIRE( *it == 2 );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,2,3} );
+  }
+
+  SECTION("at end")
+  {
+    const auto it = v.insert(v.cend(), 4);
+
+    REQUIRE( *it == 4 );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,3,4} );
+  }
+
+  SECTION("when full")
+  {
+    v.push_back(5);
+    REQUIRE( v.size() == v.capacity() );
+
+    const auto it = v.insert(v.cbegin()+1, 2);
+
+    REQUIRE( *it == 2 );
+    REQUIRE( !v.isInline() );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,2,3,5} );
+  }
+
+  SECTION("a element of the vector itself")
+  {
+    StringVector strings{"A","B"};
+    strings.insert( strings.cbegin(), strings[1] );
+
+    REQUIRE( stdVectorFromSmallVector(strings) == std::vector<std::string>{"B","A","B"} );
+  }
+}
+
+TEST_CASE("erase")
+{
+  IntVector v{1,2,3,4,5};
+
+  SECTION("single element")
+  {
+    const auto it = v.erase(v.cbegin()+1);
+
+    REQUIRE( *it == 3 );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,3,4,5} );
+  }
+
+  SECTION("range")
+  {
+    const auto it = v.erase(v.cbegin()+1, v.cbegin()+3);
+
+    REQUIRE( *it == 4 );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,4,5} );
+  }
+
+  SECTION("until end")
+  {
+    const auto it = v.erase(v.cbegin()+2, v.cend());
+
+    REQUIRE( it == v.end() );
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,2} );
+  }
+
+  SECTION("empty range")
+  {
+    v.erase(v.cbegin()+2, v.cbegin()+2);
+
+    REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1,2,3,4,5} );
+  }
+}
+
+TEST_CASE("pop_back_clear")
+{
+  IntVector v{1,2};
+
+  v.pop_back();
+  REQUIRE( stdVectorFromSmallVector(v) == std::vector<int>{1} );
+
+  v.clear();
+  REQUIRE( v.empty() );
+}
+
+TEST_CASE("reverse_iterators")
+{
+  IntVector v{1,2,3,4};
+
+  const std::vector<int> reversed( v.crbegin(), v.crend() );
+
+  REQUIRE( reversed == std::vector<int>{4,3,2,1} );
+}
+
+TEST_CASE("copy")
+{
+  const int size = GENERATE(1, 2, 5);
+  StringVector v;
+  for(int i = 0; i < size; ++i){
+    v.push_back( std::to_string(i) );
+  }
+
+  SECTION("construct")
+  {
+    StringVector copy(v);
+
+    REQUIRE( stdVectorFromSmallVector(copy) == stdVectorFromSmallVector(v) );
+  }
+
+  SECTION("assign")
+  {
+    StringVector copy{"x","y","z"};
+    copy = v;
+
+    REQUIRE( stdVectorFromSmallVector(copy) == stdVectorFromSmallVector(v) );
+  }
+}
+
+TEST_CASE("move")
+{
+  const int size = GENERATE(1, 2, 5);
+  std::vector<std::string> expected;
+  StringVector v;
+  for(int i = 0; i < size; ++i){
+    v.push_back( std::to_string(i) );
+    expected.push_back( std::to_string(i) );
+  }
+
+  SECTION("construct")
+  {
+    StringVector other( std::move(v) );
+
+    REQUIRE( stdVectorFromSmallVector(other) == expected );
+    REQUIRE( v.empty() );
+    REQUIRE( v.isInline() );
+  }
+
+  SECTION("assign")
+  {
+    StringVector other{"x","y","z"};
+    other = std::move(v);
+
+    REQUIRE( stdVectorFromSmallVector(other) == expected );
+    REQUIRE( v.empty() );
+  }
+}
+
+TEST_CASE("destruct_elements")
+{
+  auto value = std::make_shared<int>(1);
+
+  {
+    SmallVector<std::shared_ptr<int>, 2> v;
+    v.push_back(value);
+    v.push_back(value);
+    v.push_back(value);
+    REQUIRE( value.use_count() == 4 );
+    v.erase( v.cbegin() );
+    REQUIRE( value.use_count() == 3 );
+  }
+
+  REQUIRE( value.use_count() == 1 );
+}
+
+TEST_CASE("allocator")
+{
+  CountingMemoryResource resource;
+  CountingMemoryResource otherResource;
+
+  SECTION("inline elements do not allocate")
+  {
+    PmrIntVector v(&resource);
+    v.push_back(1);
+    v.push_back(2);
+
+    REQUIRE( v.get_allocator().resource() == &resource );
+    REQUIRE( resource.allocationCount == 0 );
+  }
+
+  SECTION("elements past the inline capacity are allocated with the allocator")
+  {
+    {
+      PmrIntVector v(&resource);
+      for(int i = 0; i < 10; ++i){
+        v.push_back(i);
+      }
+      REQUIRE( resource.allocationCount > 0 );
+    }
+
+    REQUIRE( resource.deallocationCount == resource.allocationCount );
+  }
+
+  SECTION("copy construct uses the default resource")
+  {
+    PmrIntVector v({1,2,3}, &resource);
+    const PmrIntVector copy(v);
+
+    REQUIRE( copy.get_allocator().resource() == std::pmr::get_default_resource() );
+    REQUIRE( stdVectorFromSmallVector(copy) == std::vector<int>{1,2,3} );
+  }
+
+  SECTION("copy construct with a allocator")
+  {
+    PmrIntVector v({1,2,3}, &resource);
+    const PmrIntVector copy(v, &otherResource);
+
+    REQUIRE( copy.get_allocator().resource() == &otherResource );
+    REQUIRE( otherResource.allocationCount == 1 );
+    REQUIRE( stdVectorFromSmallVector(copy) == std::vector<int>{1,2,3} );
+  }
+
+  SECTION("copy assign keeps the allocator")
+  {
+    PmrIntVector v({1,2,3}, &resource);
+    PmrIntVector other(&otherResource);
+    other = v;
+
+    REQUIRE( other.get_allocator().resource() == &otherResource );
+    REQUIRE( stdVectorFromSmallVector(other) == std::vector<int>{1,2,3} );
+  }
+
+  SECTION("move construct takes the storage")
+  {
+    PmrIntVector v({1,2,3}, &resource);
+    const PmrIntVector other( std::move(v) );
+
+    REQUIRE( other.get_allocator().resource() == &resource );
+    REQUIRE( resource.allocationCount == 1 );
+    REQUIRE( stdVectorFromSmallVector(other) == std::vector<int>{1,2,3} );
+  }
+
+  SECTION("move assign with equal allocators takes the storage")
+  {
+    PmrIntVector v({1,2,3}, &resource);
+    PmrIntVector other({4,5,6,7}, &resource);
+    other = std::move(v);
+
+    REQUIRE( resource.allocationCount == 2 );
+    REQUIRE( resource.deallocationCount == 1 );
+    REQUIRE( stdVectorFromSmallVector(other) == std::vector<int>{1,2,3} );
+    REQUIRE( v.empty() );
+  }
+
+  SECTION("move assign with different allocators moves the elements")
+  {
+    PmrIntVector v({1,2,3}, &resource);
+    PmrIntVector other(&otherResource);
+    other = std::move(v);
+
+    REQUIRE( other.get_allocator().resource() == &otherResource );
+    REQUIRE( otherResource.allocationCount == 1 );
+    REQUIRE( stdVectorFromSmallVector(other) == std::vector<int>{1,2,3} );
+    REQUIRE( v.empty() );
+  }
+}
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "EditCommandsTableModel.h"
+#include "Mdt/ItemModel/TableEditQueue.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TestLib/InsertRowsSignalsSpy.h"
+#include "Mdt/ItemModel/TestLib/DataChangedSignalSpy.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QVariant>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+
+TEST_CASE("drain")
+{
+  EditCommandsTableModel model;
+  TableEditQueue queue(&model);
+  InsertRowsSignalsSpy insertSpy(model);
+  DataChangedSignalSpy dataChangedSpy(model);
+
+  SECTION("empty queue")
+  {
+    queue.drain();
+
+    REQUIRE( insertSpy.rowsInsertedCount() == 0 );
+    REQUIRE( dataChangedSpy.count() == 0 );
+  }
+
+  SECTION("commands are applied in a single batch")
+  {
+    queue.pushInsertRows(0, 2);
+    queue.pushInsertRows(2, 1);
+    queue.pushSetData(0, 0, 1);
+    queue.pushSetData(1, 0, 2);
+    queue.pushSetData(1, 0, 3);
+    REQUIRE( model.rowCount() == 0 );
+
+    queue.drain();
+
+    REQUIRE( model.rowCount() == 3 );
+    REQUIRE( getModelData(model, 0, 0) == QVariant(1) );
+    REQUIRE( getModelData(model, 1, 0) == QVariant(3) );
+    REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+    REQUIRE( dataChangedSpy.count() == 1 );
+  }
+
+  SECTION("a slot throws")
+  {
+    bool slotThrows = true;
+    QObject::connect(&model, &QAbstractItemModel::rowsInserted, [&slotThrows](){
+      if(slotThrows){
+        throw std::runtime_error("slot error");
+      }
+    });
+    queue.pushInsertRows(0, 1);
+    REQUIRE_THROWS_AS( queue.drain(), std::runtime_error );
+    REQUIRE( model.rowCount() == 1 );
+
+    slotThrows = false;
+    queue.pushInsertRows(1, 1);
+    queue.drain();
+
+    REQUIRE( model.rowCount() == 2 );
+    REQUIRE( insertSpy.rowsInsertedCount() == 2 );
+  }
+
+  SECTION("the model has been destroyed")
+  {
+    auto otherModel = std::make_unique<EditCommandsTableModel>();
+    TableEditQueue otherQueue( otherModel.get() );
+    otherQueue.pushInsertRows(0, 1);
+    otherModel.reset();
+
+    otherQueue.drain();
+  }
+}
+
+TEST_CASE("producer_threads")
+{
+  constexpr int producerCount = 4;
+  constexpr int rowCountPerProducer = 1'000;
+  constexpr int rowCount = producerCount * rowCountPerProducer;
+
+  EditCommandsTableModel model;
+  TableEditQueue queue(&model);
+  queue.pushInsertRows(0, rowCount);
+  queue.drain();
+  REQUIRE( model.rowCount() == rowCount );
+
+  DataChangedSignalSpy dataChangedSpy(model);
+  std::vector<std::thread> producers;
+
+  /*
+   * Each producer updates its own block of rows, twice
+   */
+  for(int producer = 0; producer < producerCount; ++producer){
+    producers.emplace_back([&queue, producer](){
+      const int firstRow = producer * rowCountPerProducer;
+      for(int row = firstRow; row < firstRow + rowCountPerProducer; ++row){
+        queue.pushSetData(row, 0, -1);
+        queue.pushSetData(row, 0, row);
+      }
+    });
+  }
+  for(auto & producer : producers){
+    producer.join();
+  }
+  queue.drain();
+
+  REQUIRE( dataChangedSpy.count() == 1 );
+  for(int row = 0; row < rowCount; ++row){
+    REQUIRE( getModelData(model, row, 0) == QVariant(row) );
+  }
+}
+
+TEST_CASE("drain_timer")
+{
+  int argc = 1;
+  char appName[] = "tableEditQueueTest";
+  char *argv[] = {appName, nullptr};
+  QCoreApplication app(argc, argv);
+
+  EditCommandsTableModel model;
+  TableEditQueue queue(&model);
+  REQUIRE( !queue.isDrainTimerActive() );
+
+  queue.startDrainTimer(0);
+  REQUIRE( queue.isDrainTimerActive() );
+
+  std::thread producer([&queue](){
+    for(int row = 0; row < 100; ++row){
+      queue.pushInsertRows(row, 1);
+    }
+  });
+  producer.join();
+
+  QElapsedTimer timer;
+  timer.start();
+  while( (model.rowCount() < 100) && !timer.hasExpired(5000) ){
+    QCoreApplication::processEvents();
+  }
+  REQUIRE( model.rowCount() == 100 );
+
+  queue.stopDrainTimer();
+  REQUIRE( !queue.isDrainTimerActive() );
+}
@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "ChunkedTableModel.h"
+#include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemModel/TypedColumn.h"
+#include "Mdt/ItemModel/TableExport.h"
+#include "Mdt/ItemModel/DelimitedTextWriter.h"
+#include "Mdt/ItemModel/TestLib/RowSelectionHelpers.h"
+#include <QBuffer>
+#include <QIODevice>
+#include <QModelIndex>
+#include <QVariant>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <future>
+#include <memory>
+#include <typeinfo>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+using Record = ChunkedTableModel::Record;
+
+/*
+ * Populates the model with ids 0 to rowCount-1
+ * and names N0 to N(rowCount-1)
+ */
+void populateModel(ChunkedTableModel & model, int rowCount)
+{
+  ChunkedTableModel::Table table;
+
+  for(int id = 0; id < rowCount; ++id){
+    table.push_back( {id, "N" + std::to_string(id)} );
+  }
+
+  model.setTable(table);
+}
+
+void writeRecordField(DelimitedTextWriter & writer, const Record & record, int column)
+{
+  if(column == 0){
+    writer.writeField(record.id);
+  }else{
+    writer.writeField(record.name);
+  }
+}
+
+std::string writtenText(const QBuffer & buffer)
+{
+  return buffer.data().toStdString();
+}
+
+/*
+ * Model with 1 column of integers, stored in a array,
+ * that counts the calls to displayRoleData()
+ */
+class CountingTypedTableModel : public AbstractTableModel
+{
+ public:
+
+  struct Record
+  {
+    int value;
+  };
+
+  void setValues(const std::vector<int> & values)
+  {
+    beginResetModel();
+    mTable.clear();
+    for(const int value : values){
+      mTable.push_back({value});
+    }
+    endResetModel();
+  }
+
+  int displayRoleDataCallCount() const noexcept
+  {
+    return mDisplayRoleDataCallCount;
+  }
+
+ private:
+
+  int rowCountWithoutParentIndex() const noexcept override
+  {
+    return static_cast<int>( mTable.size() );
+  }
+
+  int columnCountWithoutParentIndex() const noexcept override
+  {
+    return 1;
+  }
+
+  QVariant displayRoleData(const QModelIndex & index) const noexcept override
+  {
+    ++mDisplayRoleDataCallCount;
+
+    return mTable[static_cast<size_t>( index.row() )].value;
+  }
+
+  TypedColumnData doGetTypedColumnData(int column, int row, const std::type_info & type) const noexcept override
+  {
+    if( (column == 0) && (type == typeid(int)) ){
+      return TypedColumnData::fromMember(mTable.data() + row, rowCountWithoutParentIndex() - row, &Record::value);
+    }
+
+    return TypedColumnData();
+  }
+
+  std::vector<Record> mTable;
+  mutable int mDisplayRoleDataCallCount = 0;
+};
+
+
+TEST_CASE("exportTable")
+{
+  ChunkedTableModel model;
+  populateModel(model, 5);
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  DelimitedTextWriter writer(buffer);
+  TableExportProgress progress;
+
+  SECTION("all rows")
+  {
+    REQUIRE( exportTable(model.snapshot(), {0, 1}, writeRecordField, writer, &progress) );
+
+    REQUIRE( writtenText(buffer) == "0,N0\n1,N1\n2,N2\n3,N3\n4,N4\n" );
+    REQUIRE( progress.rowCount() == 5 );
+    REQUIRE( progress.exportedRowCount() == 5 );
+  }
+
+  SECTION("selection and columns")
+  {
+    const RowSelection selection = makeRowSelectionFromIndexList({1,3,4});
+
+    REQUIRE( exportTable(model.snapshot(), selection, {1}, writeRecordField, writer, &progress) );
+
+    REQUIRE( writtenText(buffer) == "N1\nN3\nN4\n" );
+    REQUIRE( progress.rowCount() == 3 );
+    REQUIRE( progress.exportedRowCount() == 3 );
+  }
+
+  SECTION("empty table")
+  {
+    ChunkedTableModel emptyModel;
+
+    REQUIRE( exportTable(emptyModel.snapshot(), {0, 1}, writeRecordField, writer) );
+    REQUIRE( writtenText(buffer).empty() );
+  }
+}
+
+TEST_CASE("exportTable_cancel")
+{
+  ChunkedTableModel model;
+  populateModel(model, 5000);
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  DelimitedTextWriter writer(buffer);
+  TableExportProgress progress;
+
+  progress.requestCancel();
+  REQUIRE( !exportTable(model.snapshot(), {0}, writeRecordField, writer, &progress) );
+
+  REQUIRE( progress.isCancelRequested() );
+  REQUIRE( progress.rowCount() == 5000 );
+  REQUIRE( progress.exportedRowCount() == tableExportProgressInterval );
+}
+
+TEST_CASE("exportTable_in_other_thread")
+{
+  ChunkedTableModel model;
+  populateModel(model, 10'000);
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  TableExportProgress progress;
+  bool ok = false;
+
+  const auto snapshot = model.snapshot();
+  std::thread worker([snapshot, &buffer, &progress, &ok](){
+    DelimitedTextWriter writer(buffer, DelimitedTextFormat::Tsv);
+    ok = exportTable(snapshot, {0, 1}, writeRecordField, writer, &progress);
+  });
+
+  for(int i = 0; i < 100; ++i){
+    REQUIRE( model.removeRows(0, 1) );
+  }
+  worker.join();
+
+  REQUIRE( ok );
+  REQUIRE( progress.exportedRowCount() == 10'000 );
+  const std::string text = writtenText(buffer);
+  REQUIRE( text.substr(0, 8) == "0\tN0\n1\tN" );
+  REQUIRE( model.rowCount() == 9'900 );
+}
+
+TEST_CASE("exportTableInWorkerThread")
+{
+  ChunkedTableModel model;
+  populateModel(model, 3);
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  auto progress = std::make_shared<TableExportProgress>();
+
+  SECTION("all rows")
+  {
+    auto status = exportTableInWorkerThread(model.snapshot(), {0, 1}, writeRecordField, buffer, DelimitedTextFormat::Tsv, progress);
+
+    REQUIRE( status.get() == TableExportStatus::Finished );
+    REQUIRE( progress->exportedRowCount() == 3 );
+    REQUIRE( writtenText(buffer) == "0\tN0\n1\tN1\n2\tN2\n" );
+  }
+
+  SECTION("selection")
+  {
+    const RowSelection selection = makeRowSelectionFromIndexList({1});
+
+    auto status = exportTableInWorkerThread(model.snapshot(), selection, {1}, writeRecordField, buffer, DelimitedTextFormat::Csv, progress);
+
+    REQUIRE( status.get() == TableExportStatus::Finished );
+    REQUIRE( writtenText(buffer) == "N1\n" );
+  }
+
+  SECTION("cancelled")
+  {
+    populateModel(model, 5000);
+    progress->requestCancel();
+
+    auto status = exportTableInWorkerThread(model.snapshot(), {0}, writeRecordField, buffer, DelimitedTextFormat::Csv, progress);
+
+    REQUIRE( status.get() == TableExportStatus::Cancelled );
+  }
+
+  SECTION("exception")
+  {
+    const auto throwingWriteField = [](DelimitedTextWriter &, const Record &, int){
+      throw std::runtime_error("field error");
+    };
+
+    auto status = exportTableInWorkerThread(model.snapshot(), {0}, throwingWriteField, buffer, DelimitedTextFormat::Csv, progress);
+
+    REQUIRE_THROWS_AS( status.get(), std::runtime_error );
+  }
+}
+
+TEST_CASE("exportModel")
+{
+  ChunkedTableModel model;
+  populateModel(model, 3);
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  DelimitedTextWriter writer(buffer);
+
+  SECTION("all rows with header")
+  {
+    writeModelHeader(model, {1, 0}, writer);
+    REQUIRE( exportModel(model, {1, 0}, writer) );
+
+    REQUIRE( writtenText(buffer) == "2,1\nN0,0\nN1,1\nN2,2\n" );
+  }
+
+  SECTION("selection")
+  {
+    const RowSelection selection = makeRowSelectionFromIndexList({0,2});
+
+    REQUIRE( exportModel(model, selection, {0, 1}, writer) );
+
+    REQUIRE( writtenText(buffer) == "0,N0\n2,N2\n" );
+  }
+}
+
+TEST_CASE("exportModel_typedColumn")
+{
+  CountingTypedTableModel model;
+  model.setValues({5, 6, 7});
+  QBuffer buffer;
+  REQUIRE( buffer.open(QIODevice::WriteOnly) );
+  DelimitedTextWriter writer(buffer);
+
+  REQUIRE( exportModel(model, {0}, writer) );
+
+  REQUIRE( writtenText(buffer) == "5\n6\n7\n" );
+  REQUIRE( model.displayRoleDataCallCount() == 0 );
+}
@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "EditCommandsTableModel.h"
+#include "Mdt/ItemModel/TableImport.h"
+#include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/TestLib/InsertRowsSignalsSpy.h"
+#include <QObject>
+#include <QTemporaryFile>
+#include <QLatin1String>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <utility>
+
+using namespace Mdt::ItemModel;
+using namespace Mdt::ItemModel::TestLib;
+
+using Record = EditCommandsTableModel::Record;
+using Table = EditCommandsTableModel::Table;
+
+bool parseRecord(const DelimitedTextRow & row, Record & record)
+{
+  if(row.fieldCount() != 2){
+    return false;
+  }
+  record.name = row.toStdString(1);
+
+  return row.toInt(0, record.id);
+}
+
+bool importText(const std::string & text, Table & records, const DelimitedTextImportOptions & options = DelimitedTextImportOptions())
+{
+  return importDelimitedText( text.data(), text.size(), parseRecord, records, options );
+}
+
+std::vector<int> idsInTable(const Table & table)
+{
+  std::vector<int> ids;
+
+  for(const auto & record : table){
+    ids.push_back(record.id);
+  }
+
+  return ids;
+}
+
+
+TEST_CASE("importDelimitedText")
+{
+  Table records;
+  DelimitedTextImportOptions options;
+
+  SECTION("empty text")
+  {
+    REQUIRE( importText("", records) );
+    REQUIRE( records.empty() );
+  }
+
+  SECTION("2 rows")
+  {
+    REQUIRE( importText("1,A\n2,\"B,\"\"C\"\"\"\n", records) );
+    REQUIRE( idsInTable(records) == std::vector<int>{1, 2} );
+    REQUIRE( records[1].name == "B,\"C\"" );
+  }
+
+  SECTION("last row without line feed")
+  {
+    REQUIRE( importText("1,A\r\n2,B", records) );
+    REQUIRE( idsInTable(records) == std::vector<int>{1, 2} );
+    REQUIRE( records[0].name == "A" );
+  }
+
+  SECTION("header and blank rows")
+  {
+    options.hasHeaderRow = true;
+    REQUIRE( importText("Id,Name\n1,A\n\n2,B\r\n\r\n", records, options) );
+    REQUIRE( idsInTable(records) == std::vector<int>{1, 2} );
+  }
+
+  SECTION("TSV")
+  {
+    options.format = DelimitedTextFormat::Tsv;
+    REQUIRE( importText("1\tA,B\n", records, options) );
+    REQUIRE( records[0].name == "A,B" );
+  }
+
+  SECTION("invalid row")
+  {
+    REQUIRE( !importText("1,A\nB,2\n", records) );
+    REQUIRE( records.empty() );
+  }
+}
+
+TEST_CASE("importDelimitedText_exception")
+{
+  std::string text;
+  for(int id = 0; id < 20000; ++id){
+    text += std::to_string(id) + ",N\n";
+  }
+  const auto throwingParseRecord = [](const DelimitedTextRow & row, Record & record){
+    if( !row.toInt(0, record.id) ){
+      return false;
+    }
+    if(record.id == 15000){
+      throw std::runtime_error("parse error");
+    }
+    return true;
+  };
+
+  Table records;
+  DelimitedTextImportOptions options;
+  options.threadCount = GENERATE(1, 4);
+
+  REQUIRE_THROWS_AS( importDelimitedText(text.data(), text.size(), throwingParseRecord, records, options), std::runtime_error );
+  REQUIRE( records.empty() );
+}
+
+TEST_CASE("importDelimitedText_threads")
+{
+  std::string text;
+  std::vector<int> expectedIds;
+  for(int id = 0; id < 50000; ++id){
+    text += std::to_string(id);
+    if( (id % 5) == 0 ){
+      text += ",\"N\n" + std::to_string(id) + "\"\n";
+    }else{
+      text += ",N" + std::to_string(id) + "\n";
+    }
+    if( (id % 1000) == 0 ){
+      text += "\n";
+    }
+    expectedIds.push_back(id);
+  }
+
+  Table records;
+  DelimitedTextImportOptions options;
+  options.threadCount = GENERATE(1, 2, 3, 8);
+
+  REQUIRE( importText(text, records, options) );
+  REQUIRE( idsInTable(records) == expectedIds );
+  REQUIRE( records[5].name == "N\n5" );
+  REQUIRE( records[6].name == "N6" );
+}
+
+TEST_CASE("importDelimitedTextFile")
+{
+  QTemporaryFile file;
+  REQUIRE( file.open() );
+  REQUIRE( file.write("Id,Name\n1,A\n2,B\n") > 0 );
+  file.close();
+
+  Table records;
+  DelimitedTextImportOptions options;
+  options.hasHeaderRow = true;
+
+  REQUIRE( importDelimitedTextFile(file.fileName(), parseRecord, records, options) );
+  REQUIRE( idsInTable(records) == std::vector<int>{1, 2} );
+
+  REQUIRE( !importDelimitedTextFile(QLatin1String("/nonExistingDir/nonExistingFile.csv"), parseRecord, records, options) );
+}
+
+TEST_CASE("appendRecordsToTable")
+{
+  EditCommandsTableModel model;
+  model.setTable({{1, "A"}});
+  InsertRowsSignalsSpy insertSpy(model);
+
+  Table records;
+  REQUIRE( importText("2,B\n3,C\n4,D\n", records) );
+  model.appendTable( std::move(records) );
+
+  REQUIRE( model.rowCount() == 4 );
+  REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+  REQUIRE( insertSpy.rowsInsertedAt(0).first() == 1 );
+  REQUIRE( insertSpy.rowsInsertedAt(0).last() == 3 );
+  REQUIRE( getModelData(model, 3, 1) == QLatin1String("D") );
+
+  SECTION("copy")
+  {
+    const Table copied{{5, "E"}};
+    model.appendTable(copied);
+    REQUIRE( model.rowCount() == 5 );
+    REQUIRE( copied.size() == 1 );
+    REQUIRE( copied[0].name == "E" );
+    REQUIRE( getModelData(model, 4, 1) == QLatin1String("E") );
+  }
+
+  SECTION("empty table")
+  {
+    model.appendTable( Table() );
+    REQUIRE( model.rowCount() == 4 );
+    REQUIRE( insertSpy.rowsInsertedCount() == 1 );
+  }
+}
+
+TEST_CASE("assignRecordsToTable")
+{
+  EditCommandsTableModel model;
+  model.setTable({{1, "A"}, {2, "B"}});
+  int modelResetCount = 0;
+  QObject::connect(&model, &QAbstractItemModel::modelReset, [&modelResetCount](){ ++modelResetCount; });
+
+  Table records;
+  REQUIRE( importText("3,C\n4,D\n5,E\n", records) );
+  model.resetTable( std::move(records) );
+
+  REQUIRE( modelResetCount == 1 );
+  REQUIRE( model.rowCount() == 3 );
+  REQUIRE( getModelData(model, 0, 0) == 3 );
+  REQUIRE( getModelData(model, 2, 1) == QLatin1String("E") );
+}
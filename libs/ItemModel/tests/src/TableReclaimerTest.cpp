@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/TableReclaimer.h"
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <utility>
+
+using namespace Mdt::ItemModel;
+
+/*
+ * Records the threads in which the objects are destroyed
+ */
+class DestroyingThreads
+{
+ public:
+
+  void add(std::thread::id id)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIds.push_back(id);
+  }
+
+  std::vector<std::thread::id> ids()
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mIds;
+  }
+
+ private:
+
+  std::mutex mMutex;
+  std::vector<std::thread::id> mIds;
+};
+
+class TrackedObject
+{
+ public:
+
+  explicit TrackedObject(DestroyingThreads & threads)
+   : mThreads(&threads)
+  {
+  }
+
+  TrackedObject(TrackedObject && other) noexcept
+   : mThreads(other.mThreads)
+  {
+    other.mThreads = nullptr;
+  }
+
+  TrackedObject(const TrackedObject &) = delete;
+  TrackedObject & operator=(const TrackedObject &) = delete;
+  TrackedObject & operator=(TrackedObject &&) = delete;
+
+  ~TrackedObject()
+  {
+    if(mThreads != nullptr){
+      mThreads->add( std::this_thread::get_id() );
+    }
+  }
+
+ private:
+
+  DestroyingThreads *mThreads;
+};
+
+
+TEST_CASE("reclaim")
+{
+  DestroyingThreads threads;
+  TableReclaimer reclaimer;
+
+  SECTION("the object is destroyed in a other thread")
+  {
+    reclaimer.reclaim( TrackedObject(threads) );
+    reclaimer.waitForReclaimed();
+
+    const auto ids = threads.ids();
+    REQUIRE( ids.size() == 1 );
+    REQUIRE( ids[0] != std::this_thread::get_id() );
+  }
+
+  SECTION("many objects")
+  {
+    for(int i = 0; i < 100; ++i){
+      reclaimer.reclaim( TrackedObject(threads) );
+    }
+    reclaimer.waitForReclaimed();
+
+    REQUIRE( threads.ids().size() == 100 );
+  }
+
+  SECTION("the elements of a vector are not copied")
+  {
+    auto value = std::make_shared<int>(1);
+    std::weak_ptr<int> watcher = value;
+    std::vector< std::shared_ptr<int> > table(10, value);
+    value.reset();
+
+    reclaimer.reclaim( std::move(table) );
+    reclaimer.waitForReclaimed();
+
+    REQUIRE( table.empty() );
+    REQUIRE( watcher.expired() );
+  }
+
+  SECTION("wait without object")
+  {
+    reclaimer.waitForReclaimed();
+  }
+}
+
+TEST_CASE("destroy_the_reclaimer")
+{
+  DestroyingThreads threads;
+
+  {
+    TableReclaimer reclaimer;
+    for(int i = 0; i < 10; ++i){
+      reclaimer.reclaim( TrackedObject(threads) );
+    }
+  }
+
+  REQUIRE( threads.ids().size() == 10 );
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "ChunkedTableModel.h"
+#include <QString>
+#include <cassert>
+
+using Mdt::ItemModel::TypedColumnData;
+
+void ChunkedTableModel::doInsertRows(int row, int count) noexcept
+{
+  assert( rowAndCountIsValidForInsertRows(row, count) );
+
+  mTable.insert( static_cast<size_t>(row), static_cast<size_t>(count), Record() );
+}
+
+void ChunkedTableModel::doRemoveRows(int row, int count) noexcept
+{
+  assert( rowAndCountIsValidForRemoveRows(row, count) );
+
+  mTable.erase( static_cast<size_t>(row), static_cast<size_t>(count) );
+}
+
+QVariant ChunkedTableModel::displayRoleData(const QModelIndex & index) const noexcept
+{
+  assert( indexIsValidAndInRange(index) );
+
+  const size_t row = Mdt::Numeric::size_t_from_int( index.row() );
+
+  const auto column = static_cast<Column>( index.column() );
+  switch(column){
+    case Column::Id:
+      return mTable[row].id;
+    case Column::Name:
+      return QString::fromStdString(mTable[row].name);
+  }
+
+  return QVariant();
+}
+
+bool ChunkedTableModel::setEditRoleData(const QModelIndex & index, const QVariant & value) noexcept
+{
+  assert( indexIsValidAndInRange(index) );
+
+  Record & record = mTable.mutableAt( Mdt::Numeric::size_t_from_int( index.row() ) );
+
+  const auto column = static_cast<Column>( index.column() );
+  switch(column){
+    case Column::Id:
+      record.id = value.toInt();
+      break;
+    case Column::Name:
+      record.name = value.toString().toStdString();
+      break;
+  }
+
+  return true;
+}
+
+TypedColumnData ChunkedTableModel::doGetTypedColumnData(int column, int row, const std::type_info & type) const noexcept
+{
+  assert( columnIndexIsInRange(column) );
+  assert( rowIndexIsInRange(row) );
+
+  const auto elements = mTable.contiguousElementsFrom( Mdt::Numeric::size_t_from_int(row) );
+  const int count = Mdt::Numeric::int_from_size_t(elements.second);
+
+  switch( static_cast<Column>(column) ){
+    case Column::Id:
+      if( type == typeid(int) ){
+        return TypedColumnData::fromMember(elements.first, count, &Record::id);
+      }
+      break;
+    case Column::Name:
+      if( type == typeid(std::string) ){
+        return TypedColumnData::fromMember(elements.first, count, &Record::name);
+      }
+      break;
+  }
+
+  return TypedColumnData();
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef CHUNKED_TABLE_MODEL_H
+#define CHUNKED_TABLE_MODEL_H
+
+#include "Mdt/ItemModel/TestLib/TableModelCommonBase.h"
+#include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemModel/ChunkedTable.h"
+#include "Mdt/ItemModel/ChunkedTableSnapshot.h"
+#include "Mdt/Numeric/BasicConversion.h"
+#include <QVariant>
+#include <typeinfo>
+#include <vector>
+#include <string>
+
+/*
+ * Model that stores its records in a ChunkedTable,
+ * so that a snapshot of it can be read in a other thread
+ *
+ * Supports inserting rows, removing rows and editing data,
+ * like EditCommandsTableModel
+ */
+class ChunkedTableModel : public Mdt::ItemModel::AbstractTableModel
+{
+  Q_OBJECT
+
+ public:
+
+  using Record = Mdt::ItemModel::TestLib::TableModelCommonBase::Record;
+  using Column = Mdt::ItemModel::TestLib::TableModelCommonBase::Column;
+  using Table = std::vector<Record>;
+  using Snapshot = Mdt::ItemModel::ChunkedTableSnapshot<Record>;
+
+  ChunkedTableModel(QObject *parent = nullptr)
+   : AbstractTableModel(parent)
+  {
+  }
+
+  void setTable(const Table & table)
+  {
+    beginResetModel();
+    mTable.assign( table.cbegin(), table.cend() );
+    endResetModel();
+  }
+
+  Snapshot snapshot() const noexcept
+  {
+    return mTable.snapshot();
+  }
+
+ private:
+
+  int rowCountWithoutParentIndex() const noexcept override
+  {
+    return Mdt::Numeric::int_from_size_t( mTable.size() );
+  }
+
+  int columnCountWithoutParentIndex() const noexcept override
+  {
+    return 2;
+  }
+
+  bool doSupportsInsertRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doInsertRows(int row, int count) noexcept override;
+
+  bool doSupportsRemoveRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doRemoveRows(int row, int count) noexcept override;
+
+  QVariant displayRoleData(const QModelIndex & index) const noexcept override;
+  bool setEditRoleData(const QModelIndex & index, const QVariant & value) noexcept override;
+
+  /*
+   * Exposes id as int and name as std::string,
+   * one chunk at a time
+   */
+  Mdt::ItemModel::TypedColumnData doGetTypedColumnData(int column, int row, const std::type_info & type) const noexcept override;
+
+  Mdt::ItemModel::ChunkedTable<Record> mTable;
+};
+
+#endif // #ifndef CHUNKED_TABLE_MODEL_H
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef EDIT_COMMANDS_TABLE_MODEL_H
+#define EDIT_COMMANDS_TABLE_MODEL_H
+
+#include "Mdt/ItemModel/TestLib/TableModelCommonBase.h"
+#include <cassert>
+
+/*
+ * Model that supports inserting rows, removing rows and editing data
+ */
+class EditCommandsTableModel : public Mdt::ItemModel::TestLib::TableModelCommonBase
+{
+  Q_OBJECT
+
+ public:
+
+  EditCommandsTableModel(QObject *parent = nullptr)
+   : TableModelCommonBase(parent)
+  {
+  }
+
+ private:
+
+  bool doSupportsInsertRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doInsertRows(int row, int count) noexcept override
+  {
+    insertRecordToTable( row, count, Record() );
+  }
+
+  bool doSupportsRemoveRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doRemoveRows(int row, int count) noexcept override
+  {
+    assert( rowAndCountIsValidForRemoveRows(row, count) );
+
+    removeRowsFromTable(row, count);
+  }
+
+  bool setEditRoleData(const QModelIndex & index, const QVariant & value) noexcept override
+  {
+    assert( indexIsValidAndInRange(index) );
+
+    return setDataInTable(index, value);
+  }
+};
+
+#endif // #ifndef EDIT_COMMANDS_TABLE_MODEL_H
@@ -15,6 +15,7 @@
 #include <QVariant>
 #include <vector>
 #include <string>
+#include <utility>
 
 class EditableTableModel : public Mdt::ItemModel::AbstractTableModel
 {
@@ -57,6 +58,16 @@ class EditableTableModel : public Mdt::ItemModel::AbstractTableModel
     mTable = table;
   }
 
+  Table replaceTable(Table && table)
+  {
+    return AbstractTableModel::replaceTable( mTable, std::move(table) );
+  }
+
+  void replaceTable(Table && table, Mdt::ItemModel::TableReclaimer & reclaimer)
+  {
+    AbstractTableModel::replaceTable( mTable, std::move(table), reclaimer );
+  }
+
  private:
 
   int rowCountWithoutParentIndex() const noexcept override
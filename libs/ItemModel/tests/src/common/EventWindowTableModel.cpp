@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "EventWindowTableModel.h"
+#include <QString>
+#include <cassert>
+
+QVariant EventWindowTableModel::displayRoleData(const QModelIndex & index) const noexcept
+{
+  assert( indexIsValidAndInRange(index) );
+
+  const EventRecord & record = recordAt( index.row() );
+
+  const auto column = static_cast<Column>( index.column() );
+  switch(column){
+    case Column::Id:
+      return record.id;
+    case Column::Text:
+      return QString::fromStdString(record.text);
+  }
+
+  return QVariant();
+}
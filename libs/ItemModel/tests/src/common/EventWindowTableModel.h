@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef EVENT_WINDOW_TABLE_MODEL_H
+#define EVENT_WINDOW_TABLE_MODEL_H
+
+#include "Mdt/ItemModel/SlidingWindowTableModel.h"
+#include <QVariant>
+#include <string>
+
+struct EventRecord
+{
+  int id = 0;
+  std::string text;
+};
+
+class EventWindowTableModel : public Mdt::ItemModel::SlidingWindowTableModel<EventRecord>
+{
+  Q_OBJECT
+
+ public:
+
+  enum class Column
+  {
+    Id = 0,
+    Text = 1
+  };
+
+  EventWindowTableModel(int windowSize, QObject *parent = nullptr)
+   : SlidingWindowTableModel(windowSize, parent)
+  {
+  }
+
+ private:
+
+  int columnCountWithoutParentIndex() const noexcept override
+  {
+    return 2;
+  }
+
+  QVariant displayRoleData(const QModelIndex & index) const noexcept override;
+};
+
+#endif // #ifndef EVENT_WINDOW_TABLE_MODEL_H
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef INSERT_AND_REMOVE_ROWS_TABLE_MODEL_H
+#define INSERT_AND_REMOVE_ROWS_TABLE_MODEL_H
+
+#include "Mdt/ItemModel/TestLib/TableModelCommonBase.h"
+
+
+class InsertAndRemoveRowsTableModel : public Mdt::ItemModel::TestLib::TableModelCommonBase
+{
+  Q_OBJECT
+
+ public:
+
+  InsertAndRemoveRowsTableModel(QObject *parent = nullptr)
+   : TableModelCommonBase(parent)
+  {
+  }
+
+ private:
+
+  bool doSupportsInsertRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doInsertRows(int row, int count) noexcept override
+  {
+    insertRecordToTable( row, count, Record() );
+  }
+
+  bool doSupportsRemoveRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doRemoveRows(int row, int count) noexcept override
+  {
+    assert( rowAndCountIsValidForRemoveRows(row, count) );
+
+    removeRowsFromTable(row, count);
+  }
+};
+
+#endif // #ifndef INSERT_AND_REMOVE_ROWS_TABLE_MODEL_H
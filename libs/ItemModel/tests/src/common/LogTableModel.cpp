@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "LogTableModel.h"
+#include <QString>
+#include <cassert>
+
+QVariant LogTableModel::displayRoleData(const QModelIndex & index) const noexcept
+{
+  assert( indexIsValidAndInRange(index) );
+
+  const LogRecord & record = recordAt( index.row() );
+
+  const auto column = static_cast<Column>( index.column() );
+  switch(column){
+    case Column::Id:
+      return record.id;
+    case Column::Message:
+      return QString::fromStdString(record.message);
+  }
+
+  return QVariant();
+}
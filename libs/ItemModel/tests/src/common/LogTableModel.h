@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef LOG_TABLE_MODEL_H
+#define LOG_TABLE_MODEL_H
+
+#include "Mdt/ItemModel/CappedLogTableModel.h"
+#include <QVariant>
+#include <string>
+
+struct LogRecord
+{
+  int id = 0;
+  std::string message;
+};
+
+class LogTableModel : public Mdt::ItemModel::CappedLogTableModel<LogRecord>
+{
+  Q_OBJECT
+
+ public:
+
+  enum class Column
+  {
+    Id = 0,
+    Message = 1
+  };
+
+  LogTableModel(int maximumRowCount, QObject *parent = nullptr)
+   : CappedLogTableModel(maximumRowCount, parent)
+  {
+  }
+
+ private:
+
+  int columnCountWithoutParentIndex() const noexcept override
+  {
+    return 2;
+  }
+
+  QVariant displayRoleData(const QModelIndex & index) const noexcept override;
+};
+
+#endif // #ifndef LOG_TABLE_MODEL_H
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MOVE_ROWS_TABLE_MODEL_H
+#define MOVE_ROWS_TABLE_MODEL_H
+
+#include "Mdt/ItemModel/TestLib/TableModelCommonBase.h"
+#include <cassert>
+
+
+class MoveRowsTableModel : public Mdt::ItemModel::TestLib::TableModelCommonBase
+{
+  Q_OBJECT
+
+  public:
+
+  MoveRowsTableModel(QObject *parent = nullptr)
+  : TableModelCommonBase(parent)
+  {
+  }
+
+  private:
+
+  bool doSupportsMoveRows() const noexcept override
+  {
+    return true;
+  }
+
+  void doMoveRows(int sourceRow, int count, int destinationRow) noexcept override
+  {
+    assert( rowsAreValidForMoveRows(sourceRow, count, destinationRow) );
+
+    moveRowsInTable(sourceRow, count, destinationRow);
+  }
+};
+
+#endif // #ifndef MOVE_ROWS_TABLE_MODEL_H
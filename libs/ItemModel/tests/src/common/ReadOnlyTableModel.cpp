@@ -28,3 +28,30 @@ QVariant ReadOnlyTableModel::displayRoleData(const QModelIndex & index) const no
 
   return QVariant();
 }
+
+Mdt::ItemModel::TypedColumnData ReadOnlyTableModel::doGetTypedColumnData(int column, int row, const std::type_info & type) const noexcept
+{
+  using Mdt::ItemModel::TypedColumnData;
+
+  assert( columnIndexIsInRange(column) );
+  assert( rowIndexIsInRange(row) );
+
+  const Record *first = mTable.data() + row;
+  const int count = rowCountWithoutParentIndex() - row;
+
+  const auto typedColumn = static_cast<Column>(column);
+  switch(typedColumn){
+    case Column::Value:
+      if( type == typeid(int) ){
+        return TypedColumnData::fromMember(first, count, &Record::value);
+      }
+      break;
+    case Column::Name:
+      if( type == typeid(std::string) ){
+        return TypedColumnData::fromMember(first, count, &Record::name);
+      }
+      break;
+  }
+
+  return TypedColumnData();
+}
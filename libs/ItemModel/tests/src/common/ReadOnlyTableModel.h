@@ -13,8 +13,10 @@
 #include "Mdt/ItemModel/AbstractTableModel.h"
 #include "Mdt/Numeric/BasicConversion.h"
 #include <QVariant>
+#include <typeinfo>
 #include <vector>
 #include <string>
+#include <utility>
 
 class ReadOnlyTableModel : public Mdt::ItemModel::AbstractTableModel
 {
@@ -48,6 +50,16 @@ class ReadOnlyTableModel : public Mdt::ItemModel::AbstractTableModel
     endResetModel();
   }
 
+  Table replaceTable(Table && table)
+  {
+    return AbstractTableModel::replaceTable( mTable, std::move(table) );
+  }
+
+  void replaceTable(Table && table, Mdt::ItemModel::TableReclaimer & reclaimer)
+  {
+    AbstractTableModel::replaceTable( mTable, std::move(table), reclaimer );
+  }
+
   void clear()
   {
     beginResetModel();
@@ -68,6 +80,7 @@ class ReadOnlyTableModel : public Mdt::ItemModel::AbstractTableModel
   }
 
   QVariant displayRoleData(const QModelIndex & index) const noexcept override;
+  Mdt::ItemModel::TypedColumnData doGetTypedColumnData(int column, int row, const std::type_info & type) const noexcept override;
 
   Table mTable;
 };
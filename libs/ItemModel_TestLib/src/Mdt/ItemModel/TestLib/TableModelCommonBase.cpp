@@ -15,6 +15,30 @@ using namespace Mdt::ItemModel;
 
 namespace Mdt{ namespace ItemModel{ namespace TestLib{
 
+void TableModelCommonBase::replaceTableById(const Table & table)
+{
+  const auto id = [](const Record & record){
+    return record.id;
+  };
+  const auto equal = [](const Record & a, const Record & b){
+    return (a.id == b.id) && (a.name == b.name);
+  };
+
+  replaceTableByKey(mTable, table, id, equal);
+}
+
+void TableModelCommonBase::replaceTableById(Table && table, Mdt::ItemModel::TableReclaimer & reclaimer)
+{
+  const auto id = [](const Record & record){
+    return record.id;
+  };
+  const auto equal = [](const Record & a, const Record & b){
+    return (a.id == b.id) && (a.name == b.name);
+  };
+
+  replaceTableByKey(mTable, std::move(table), reclaimer, id, equal);
+}
+
 void TableModelCommonBase::prependRecordToTable(const Record & record) noexcept
 {
   insertRecordToTable(0, 1, record);
@@ -57,6 +81,32 @@ void TableModelCommonBase::removeLastRowFromTable() noexcept
   mTable.pop_back();
 }
 
+void TableModelCommonBase::moveRowsInTable(int sourceRow, int count, int destinationRow) noexcept
+{
+  assert( rowsAreValidForMoveRows(sourceRow, count, destinationRow) );
+
+  moveInStlContainer(mTable, sourceRow, count, destinationRow);
+}
+
+bool TableModelCommonBase::setDataInTable(const QModelIndex & index, const QVariant & value) noexcept
+{
+  assert( indexIsValidAndInRange(index) );
+
+  Record & record = mTable[Mdt::Numeric::size_t_from_int( index.row() )];
+
+  const auto column = static_cast<Column>( index.column() );
+  switch(column){
+    case Column::Id:
+      record.id = value.toInt();
+      break;
+    case Column::Name:
+      record.name = value.toString().toStdString();
+      break;
+  }
+
+  return true;
+}
+
 QVariant TableModelCommonBase::displayRoleData(const QModelIndex & index) const noexcept
 {
   assert( indexIsValidAndInRange(index) );
@@ -74,4 +124,28 @@ QVariant TableModelCommonBase::displayRoleData(const QModelIndex & index) const
   return QVariant();
 }
 
+Mdt::ItemModel::TypedColumnData TableModelCommonBase::doGetTypedColumnData(int column, int row, const std::type_info & type) const noexcept
+{
+  assert( columnIndexIsInRange(column) );
+  assert( rowIndexIsInRange(row) );
+
+  const Record *first = mTable.data() + row;
+  const int count = rowCountWithoutParentIndex() - row;
+
+  switch( static_cast<Column>(column) ){
+    case Column::Id:
+      if( type == typeid(int) ){
+        return TypedColumnData::fromMember(first, count, &Record::id);
+      }
+      break;
+    case Column::Name:
+      if( type == typeid(std::string) ){
+        return TypedColumnData::fromMember(first, count, &Record::name);
+      }
+      break;
+  }
+
+  return TypedColumnData();
+}
+
 }}} // namespace Mdt{ namespace ItemModel{ namespace TestLib{
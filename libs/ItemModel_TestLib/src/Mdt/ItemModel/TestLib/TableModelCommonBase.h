@@ -14,8 +14,10 @@
 #include "Mdt/Numeric/BasicConversion.h"
 #include "mdt_itemmodel_testlib_export.h"
 #include <QVariant>
+#include <typeinfo>
 #include <vector>
 #include <string>
+#include <utility>
 
 
 namespace Mdt{ namespace ItemModel{ namespace TestLib{
@@ -52,6 +54,72 @@ namespace Mdt{ namespace ItemModel{ namespace TestLib{
       mTable = table;
     }
 
+    /*! \brief Replace the table with \a table , resetting the model once
+     *
+     * Returns the previous table.
+     *
+     * \sa Mdt::ItemModel::AbstractTableModel::replaceTable()
+     */
+    Table replaceTable(Table && table)
+    {
+      return AbstractTableModel::replaceTable( mTable, std::move(table) );
+    }
+
+    /*! \brief Replace the table with \a table , resetting the model once
+     *
+     * The previous table is destroyed in the thread of \a reclaimer .
+     *
+     * \sa Mdt::ItemModel::AbstractTableModel::replaceTable()
+     */
+    void replaceTable(Table && table, Mdt::ItemModel::TableReclaimer & reclaimer)
+    {
+      AbstractTableModel::replaceTable( mTable, std::move(table), reclaimer );
+    }
+
+    /*! \brief Replace the table, notifying only the differences
+     *
+     * Records are matched by their id.
+     *
+     * \sa Mdt::ItemModel::AbstractTableModel::replaceTableByKey()
+     */
+    void replaceTableById(const Table & table);
+
+    /*! \brief Replace the table, notifying only the differences
+     *
+     * Records are matched by their id.
+     * The replaced records are destroyed in the thread of \a reclaimer .
+     *
+     * \sa Mdt::ItemModel::AbstractTableModel::replaceTableByKey()
+     */
+    void replaceTableById(Table && table, Mdt::ItemModel::TableReclaimer & reclaimer);
+
+    /*! \brief Append the records of \a table with a single insertRows signal
+     *
+     * \sa Mdt::ItemModel::AbstractTableModel::appendRecordsToTable()
+     */
+    void appendTable(Table && table)
+    {
+      appendRecordsToTable( mTable, std::move(table) );
+    }
+
+    /*! \brief Append a copy of the records of \a table with a single insertRows signal
+     *
+     * \sa Mdt::ItemModel::AbstractTableModel::appendRecordsToTable()
+     */
+    void appendTable(const Table & table)
+    {
+      appendRecordsToTable(mTable, table);
+    }
+
+    /*! \brief Replace the table with \a table , resetting the model once
+     *
+     * \sa Mdt::ItemModel::AbstractTableModel::assignRecordsToTable()
+     */
+    void resetTable(Table && table)
+    {
+      assignRecordsToTable( mTable, std::move(table) );
+    }
+
    protected:
 
     /*
@@ -67,6 +135,10 @@ namespace Mdt{ namespace ItemModel{ namespace TestLib{
     void removeRowsFromTable(int row, int count) noexcept;
     void removeLastRowFromTable() noexcept;
 
+    void moveRowsInTable(int sourceRow, int count, int destinationRow) noexcept;
+
+    bool setDataInTable(const QModelIndex & index, const QVariant & value) noexcept;
+
    private:
 
     int rowCountWithoutParentIndex() const noexcept override
@@ -81,6 +153,11 @@ namespace Mdt{ namespace ItemModel{ namespace TestLib{
 
     QVariant displayRoleData(const QModelIndex & index) const noexcept override;
 
+    /*
+     * Exposes id as int and name as std::string
+     */
+    Mdt::ItemModel::TypedColumnData doGetTypedColumnData(int column, int row, const std::type_info & type) const noexcept override;
+
     Table mTable;
   };
 
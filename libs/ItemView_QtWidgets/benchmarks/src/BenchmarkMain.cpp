@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#define CATCH_CONFIG_RUNNER
+#include "catch2/catch.hpp"
+#include <QApplication>
+#include <QByteArray>
+#include <QtGlobal>
+
+/*
+ * The views are painted with the offscreen platform plugin,
+ * unless an other one is requested,
+ * so that the benchmarks can run without display
+ */
+int main(int argc, char *argv[])
+{
+  if( qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM") ){
+    qputenv( "QT_QPA_PLATFORM", QByteArrayLiteral("offscreen") );
+  }
+
+  QApplication app(argc, argv);
+
+  return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "ReadOnlyTableModel.h"
+#include "Mdt/ItemView/StaticTextItemDelegate.h"
+#include <QTableView>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QStyledItemDelegate>
+#include <QAbstractItemDelegate>
+#include <QImage>
+#include <QWidget>
+#include <string>
+#include <cassert>
+
+using namespace Mdt::ItemView;
+
+constexpr int viewRowCount = 1'000'000;
+
+ReadOnlyTableModel::Table makeTable(int rowCount)
+{
+  ReadOnlyTableModel::Table table;
+  table.reserve( static_cast<size_t>(rowCount) );
+
+  for(int row = 0; row < rowCount; ++row){
+    table.push_back( {row, "Name of the record number " + std::to_string(row)} );
+  }
+
+  return table;
+}
+
+/*
+ * A view of about 30 visible rows,
+ * with columns wide enough to not elide the texts
+ */
+void setupView(QTableView & view, ReadOnlyTableModel & model, QAbstractItemDelegate & delegate)
+{
+  view.setModel(&model);
+  view.setItemDelegate(&delegate);
+  view.resize(1024, 768);
+  view.horizontalHeader()->resizeSection(1, 400);
+  view.show();
+}
+
+/*
+ * Paints the viewport like a repaint would do,
+ * without waiting for the platform to flush it
+ */
+void paintViewport(QTableView & view, QImage & image)
+{
+  view.viewport()->render(&image);
+}
+
+void scrollOneRow(QTableView & view)
+{
+  QScrollBar *scrollBar = view.verticalScrollBar();
+  assert( scrollBar != nullptr );
+
+  if( scrollBar->value() >= scrollBar->maximum() ){
+    scrollBar->setValue(0);
+  }else{
+    scrollBar->setValue( scrollBar->value() + 1 );
+  }
+}
+
+TEST_CASE("repaint")
+{
+  ReadOnlyTableModel model;
+  model.setTable( makeTable(viewRowCount) );
+
+  SECTION("QStyledItemDelegate")
+  {
+    QTableView view;
+    QStyledItemDelegate delegate;
+    setupView(view, model, delegate);
+    QImage image( view.viewport()->size(), QImage::Format_ARGB32_Premultiplied );
+
+    BENCHMARK("QStyledItemDelegate")
+    {
+      paintViewport(view, image);
+    };
+  }
+
+  SECTION("StaticTextItemDelegate")
+  {
+    QTableView view;
+    StaticTextItemDelegate delegate;
+    setupView(view, model, delegate);
+    QImage image( view.viewport()->size(), QImage::Format_ARGB32_Premultiplied );
+
+    BENCHMARK("StaticTextItemDelegate")
+    {
+      paintViewport(view, image);
+    };
+  }
+}
+
+/*
+ * Each repaint shows a row that was not visible before,
+ * all others are already in the cache
+ */
+TEST_CASE("scroll_and_repaint")
+{
+  ReadOnlyTableModel model;
+  model.setTable( makeTable(viewRowCount) );
+
+  SECTION("QStyledItemDelegate")
+  {
+    QTableView view;
+    QStyledItemDelegate delegate;
+    setupView(view, model, delegate);
+    QImage image( view.viewport()->size(), QImage::Format_ARGB32_Premultiplied );
+
+    BENCHMARK("QStyledItemDelegate")
+    {
+      scrollOneRow(view);
+      paintViewport(view, image);
+    };
+  }
+
+  SECTION("StaticTextItemDelegate")
+  {
+    QTableView view;
+    StaticTextItemDelegate delegate;
+    setupView(view, model, delegate);
+    QImage image( view.viewport()->size(), QImage::Format_ARGB32_Premultiplied );
+
+    BENCHMARK("StaticTextItemDelegate")
+    {
+      scrollOneRow(view);
+      paintViewport(view, image);
+    };
+  }
+}
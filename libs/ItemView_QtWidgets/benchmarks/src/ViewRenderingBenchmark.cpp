@@ -0,0 +1,420 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "catch2/catch.hpp"
+#include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemView/ViewportDataChangedFilter.h"
+#include <QTableView>
+#include <QListView>
+#include <QAbstractItemView>
+#include <QAbstractItemModel>
+#include <QSortFilterProxyModel>
+#include <QItemSelectionModel>
+#include <QScrollBar>
+#include <QCoreApplication>
+#include <QTest>
+#include <QModelIndex>
+#include <QVariant>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <new>
+#include <cstdlib>
+#include <random>
+#include <cassert>
+
+/*
+ * End-to-end cost of scrolling, selecting, sorting and filtering in views,
+ * and of models that change rows at a high frequency.
+ *
+ * A frame is one step of a script (for example scroll one page),
+ * followed by the processing of the events,
+ * so that the view lays out its items and repaints, like in a application.
+ *
+ * For each script, the frame times, the calls to data() per frame
+ * and the allocations per frame are reported.
+ */
+
+namespace{
+
+  std::atomic<long> allocationCount{0};
+
+} // namespace{
+
+/*
+ * Counts the allocations done with operator new.
+ * Qt containers (QString, QVector, ...) allocate with malloc(),
+ * so they are not counted.
+ */
+void *operator new(std::size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+  void *p = std::malloc(size > 0 ? size : 1);
+  if(p == nullptr){
+    throw std::bad_alloc();
+  }
+
+  return p;
+}
+
+void *operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+/*
+ * Read only model like ReadOnlyTableModel,
+ * that generates its records from the row,
+ * so that it can have millions of rows without storing them.
+ *
+ * Counts the calls to data(), for all roles.
+ */
+class GeneratedTableModel : public Mdt::ItemModel::AbstractTableModel
+{
+ public:
+
+  explicit GeneratedTableModel(int rowCount)
+   : mRowCount(rowCount)
+  {
+    assert( rowCount > 0 );
+  }
+
+  QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override
+  {
+    ++mDataCallCount;
+
+    return AbstractTableModel::data(index, role);
+  }
+
+  long dataCallCount() const noexcept
+  {
+    return mDataCallCount;
+  }
+
+  void signalRowChanged(int row)
+  {
+    emitDataChanged( index(row, 0), index(row, 1) );
+  }
+
+ private:
+
+  int rowCountWithoutParentIndex() const noexcept override
+  {
+    return mRowCount;
+  }
+
+  int columnCountWithoutParentIndex() const noexcept override
+  {
+    return 2;
+  }
+
+  /*
+   * The values are shuffled, so that sorting moves the rows
+   */
+  QVariant displayRoleData(const QModelIndex & index) const noexcept override
+  {
+    const int row = index.row();
+
+    if(index.column() == 0){
+      return static_cast<int>( (static_cast<qint64>(row) * 7919) % mRowCount );
+    }
+
+    return QStringLiteral("Name of the record number %1").arg(row);
+  }
+
+  int mRowCount;
+  mutable long mDataCallCount = 0;
+};
+
+struct FrameStatistics
+{
+  std::vector<double> frameTimes;
+  long dataCallCount = 0;
+  long allocationCount = 0;
+};
+
+void showView(QAbstractItemView & view)
+{
+  view.resize(1024, 768);
+  view.show();
+  REQUIRE( QTest::qWaitForWindowExposed(&view) );
+  QCoreApplication::processEvents();
+}
+
+void setupView(QAbstractItemView & view, QAbstractItemModel & model)
+{
+  view.setModel(&model);
+  showView(view);
+}
+
+/*
+ * Scrolls one page down, or back to the top at the end
+ */
+void scrollOnePage(QAbstractItemView & view)
+{
+  QScrollBar *scrollBar = view.verticalScrollBar();
+  assert( scrollBar != nullptr );
+
+  if( scrollBar->value() >= scrollBar->maximum() ){
+    scrollBar->setValue(0);
+  }else{
+    scrollBar->setValue( scrollBar->value() + scrollBar->pageStep() );
+  }
+}
+
+/*
+ * Selects the next row, like the down arrow key does
+ */
+void selectNextRow(QAbstractItemView & view, int & row)
+{
+  const QAbstractItemModel *model = view.model();
+  assert( model != nullptr );
+  assert( view.selectionModel() != nullptr );
+
+  row = (row + 1) % model->rowCount();
+  const QModelIndex index = model->index(row, 0);
+  view.selectionModel()->setCurrentIndex(index, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+  view.scrollTo(index);
+}
+
+template<typename Step>
+void runFrame(Step & step)
+{
+  step();
+  QCoreApplication::processEvents();
+}
+
+template<typename Step>
+FrameStatistics runFrames(const GeneratedTableModel & model, Step step, int frameCount)
+{
+  assert( frameCount > 0 );
+
+  FrameStatistics statistics;
+  statistics.frameTimes.reserve( static_cast<size_t>(frameCount) );
+
+  const long dataCallCountBefore = model.dataCallCount();
+  const long allocationCountBefore = allocationCount.load();
+  for(int frame = 0; frame < frameCount; ++frame){
+    const auto start = std::chrono::steady_clock::now();
+    runFrame(step);
+    const std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+    statistics.frameTimes.push_back( duration.count() );
+  }
+  statistics.dataCallCount = model.dataCallCount() - dataCallCountBefore;
+  statistics.allocationCount = allocationCount.load() - allocationCountBefore;
+
+  return statistics;
+}
+
+void reportFrames(const std::string & script, int rowCount, const FrameStatistics & statistics)
+{
+  assert( !statistics.frameTimes.empty() );
+
+  std::vector<double> frameTimes = statistics.frameTimes;
+  std::sort( frameTimes.begin(), frameTimes.end() );
+  const auto frameCount = static_cast<double>( frameTimes.size() );
+  const auto percentile = [&frameTimes](double p){
+    return frameTimes[ static_cast<size_t>( p * static_cast<double>(frameTimes.size() - 1) ) ];
+  };
+  const double mean = std::accumulate( frameTimes.cbegin(), frameTimes.cend(), 0.0 ) / frameCount;
+
+  std::ostringstream report;
+  report << std::fixed << std::setprecision(2);
+  report << script << ", " << rowCount << " rows, " << frameTimes.size() << " frames:"
+         << " mean " << mean << " ms, median " << percentile(0.5) << " ms"
+         << ", 95th percentile " << percentile(0.95) << " ms, max " << frameTimes.back() << " ms"
+         << ", data() calls per frame " << static_cast<double>(statistics.dataCallCount) / frameCount
+         << ", allocations per frame " << static_cast<double>(statistics.allocationCount) / frameCount;
+
+  WARN( report.str() );
+}
+
+/*
+ * Scrolling and selecting only touch the visible rows,
+ * so they are measured up to 10 millions rows
+ */
+constexpr int scriptFrameCount = 100;
+
+/*
+ * Sorting and filtering visit all the rows,
+ * and are done in QSortFilterProxyModel,
+ * so they are measured up to 1 million rows
+ */
+constexpr int proxyScriptFrameCount = 6;
+
+
+TEST_CASE("QTableView_scroll")
+{
+  const int rowCount = GENERATE(10'000, 1'000'000, 10'000'000);
+  GeneratedTableModel model(rowCount);
+  QTableView view;
+  setupView(view, model);
+
+  const auto step = [&view](){
+    scrollOnePage(view);
+  };
+
+  reportFrames( "QTableView scroll", rowCount, runFrames(model, step, scriptFrameCount) );
+
+  BENCHMARK("scroll one page, " + std::to_string(rowCount) + " rows")
+  {
+    runFrame(step);
+  };
+}
+
+TEST_CASE("QListView_scroll")
+{
+  const int rowCount = GENERATE(10'000, 1'000'000, 10'000'000);
+  GeneratedTableModel model(rowCount);
+  QListView view;
+  view.setModelColumn(1);
+  view.setUniformItemSizes(true);
+  setupView(view, model);
+
+  const auto step = [&view](){
+    scrollOnePage(view);
+  };
+
+  reportFrames( "QListView scroll", rowCount, runFrames(model, step, scriptFrameCount) );
+
+  BENCHMARK("scroll one page, " + std::to_string(rowCount) + " rows")
+  {
+    runFrame(step);
+  };
+}
+
+TEST_CASE("QTableView_select")
+{
+  const int rowCount = GENERATE(10'000, 1'000'000, 10'000'000);
+  GeneratedTableModel model(rowCount);
+  QTableView view;
+  setupView(view, model);
+
+  int row = -1;
+  const auto step = [&view, &row](){
+    selectNextRow(view, row);
+  };
+
+  reportFrames( "QTableView select", rowCount, runFrames(model, step, scriptFrameCount) );
+
+  BENCHMARK("select next row, " + std::to_string(rowCount) + " rows")
+  {
+    runFrame(step);
+  };
+}
+
+TEST_CASE("QTableView_sort")
+{
+  const int rowCount = GENERATE(10'000, 100'000, 1'000'000);
+  GeneratedTableModel model(rowCount);
+  QSortFilterProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  QTableView view;
+  view.setSortingEnabled(true);
+  setupView(view, proxyModel);
+
+  // Alternate the column and the order, so that each step sorts again
+  int sortCount = 0;
+  const auto step = [&view, &sortCount](){
+    const int column = sortCount % 2;
+    const Qt::SortOrder order = (sortCount / 2) % 2 == 0 ? Qt::DescendingOrder : Qt::AscendingOrder;
+    view.sortByColumn(column, order);
+    ++sortCount;
+  };
+
+  reportFrames( "QTableView sort", rowCount, runFrames(model, step, proxyScriptFrameCount) );
+}
+
+TEST_CASE("QTableView_filter")
+{
+  const int rowCount = GENERATE(10'000, 100'000, 1'000'000);
+  GeneratedTableModel model(rowCount);
+  QSortFilterProxyModel proxyModel;
+  proxyModel.setSourceModel(&model);
+  proxyModel.setFilterKeyColumn(1);
+  QTableView view;
+  setupView(view, proxyModel);
+
+  // Like a user typing in a filter line edit, then clearing it
+  const QStringList filters{
+    QStringLiteral("1"), QStringLiteral("12"), QStringLiteral("123"), QStringLiteral("12"), QStringLiteral("1"), QString()
+  };
+  int filterIndex = 0;
+  const auto step = [&proxyModel, &filters, &filterIndex](){
+    proxyModel.setFilterFixedString( filters.at(filterIndex) );
+    filterIndex = (filterIndex + 1) % filters.count();
+  };
+
+  reportFrames( "QTableView filter", rowCount, runFrames(model, step, proxyScriptFrameCount) );
+}
+
+/*
+ * A feed that changes rows anywhere in the model,
+ * with the view getting all the changes, or only the visible ones
+ */
+constexpr int feedChangedRowCountPerFrame = 1'000;
+
+TEST_CASE("QTableView_feed")
+{
+  const int rowCount = GENERATE(10'000, 1'000'000, 10'000'000);
+  const bool useFilter = GENERATE(false, true);
+  GeneratedTableModel model(rowCount);
+  QTableView view;
+  Mdt::ItemView::ViewportDataChangedFilter filter(&view);
+  if(useFilter){
+    filter.setModel(&model);
+  }else{
+    view.setModel(&model);
+  }
+  showView(view);
+
+  std::minstd_rand generator( static_cast<std::minstd_rand::result_type>(rowCount) );
+  std::uniform_int_distribution<int> rowDistribution(0, rowCount - 1);
+  const auto step = [&model, &generator, &rowDistribution](){
+    for(int i = 0; i < feedChangedRowCountPerFrame; ++i){
+      model.signalRowChanged( rowDistribution(generator) );
+    }
+  };
+
+  const std::string script = useFilter ? "QTableView feed, ViewportDataChangedFilter" : "QTableView feed";
+  reportFrames( script, rowCount, runFrames(model, step, scriptFrameCount) );
+
+  BENCHMARK(script + ", " + std::to_string(rowCount) + " rows")
+  {
+    runFrame(step);
+  };
+}
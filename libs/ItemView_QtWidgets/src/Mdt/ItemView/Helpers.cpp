@@ -4,13 +4,22 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2023-2023 Philippe Steinmann.
+ ** Copyright (C) 2023-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #include "Helpers.h"
 #include "Mdt/ItemModel/Helpers.h"
+#include "Mdt/ItemModel/AbstractTableModel.h"
 #include <QItemSelectionModel>
 #include <QItemSelection>
+#include <QAbstractItemModel>
+#include <QAbstractItemDelegate>
+#include <QStyleOptionViewItem>
+#include <QHeaderView>
+#include <QStyle>
+#include <QWidget>
+#include <random>
+#include <algorithm>
 #include <cassert>
 
 
@@ -25,4 +34,173 @@ bool removeSelectedRows(QAbstractItemView & view)
   return Mdt::ItemModel::removeSelectedRows( view.selectionModel() );
 }
 
+namespace{
+
+  /*
+   * Returns sampleRowCount rows, one picked in each stratum of rows,
+   * or all rows if rowCount is not greater than sampleRowCount.
+   *
+   * The generator is seeded with rowCount,
+   * so the sample is the same for a given row count.
+   */
+  std::vector<int> stratifiedSampleOfRows(int rowCount, int sampleRowCount)
+  {
+    assert( rowCount >= 0 );
+    assert( sampleRowCount >= 0 );
+
+    std::vector<int> rows;
+
+    if(rowCount <= sampleRowCount){
+      rows.resize( static_cast<size_t>(rowCount) );
+      for(int row = 0; row < rowCount; ++row){
+        rows[static_cast<size_t>(row)] = row;
+      }
+      return rows;
+    }
+
+    std::minstd_rand generator( static_cast<std::minstd_rand::result_type>(rowCount) );
+    rows.reserve( static_cast<size_t>(sampleRowCount) );
+    for(int i = 0; i < sampleRowCount; ++i){
+      const int first = static_cast<int>( static_cast<qint64>(i) * rowCount / sampleRowCount );
+      const int last = static_cast<int>( static_cast<qint64>(i + 1) * rowCount / sampleRowCount ) - 1;
+      assert( first <= last );
+      std::uniform_int_distribution<int> distribution(first, last);
+      rows.push_back( distribution(generator) );
+    }
+
+    return rows;
+  }
+
+  /*
+   * Appends the rows that are visible in the viewport of view
+   */
+  void appendVisibleRows(const QTableView & view, int rowCount, std::vector<int> & rows)
+  {
+    const int firstRow = view.rowAt(0);
+    if(firstRow < 0){
+      return;
+    }
+    int lastRow = view.rowAt( view.viewport()->height() - 1 );
+    if(lastRow < 0){
+      lastRow = rowCount - 1;
+    }
+
+    for(int row = firstRow; row <= lastRow; ++row){
+      rows.push_back(row);
+    }
+  }
+
+  /*
+   * Options like the ones QTableView gives to its delegates
+   */
+  QStyleOptionViewItem styleOptionForView(const QTableView & view)
+  {
+    QStyleOptionViewItem option;
+
+    option.initFrom(&view);
+    option.state &= ~QStyle::State_MouseOver;
+    option.font = view.font();
+    option.fontMetrics = view.fontMetrics();
+    option.decorationSize = view.iconSize();
+    option.displayAlignment = Qt::AlignLeft | Qt::AlignVCenter;
+    option.textElideMode = view.textElideMode();
+    if( view.wordWrap() ){
+      option.features = QStyleOptionViewItem::WrapText;
+    }
+    option.widget = &view;
+
+    return option;
+  }
+
+  int widthFromMaximumTextLength(const QTableView & view, const QStyleOptionViewItem & option, int maximumTextLength)
+  {
+    assert( maximumTextLength >= 0 );
+
+    // Same margin as QStyledItemDelegate puts around the text
+    const int margin = ( view.style()->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, &view) + 1 ) * 2;
+
+    return option.fontMetrics.averageCharWidth() * maximumTextLength + margin;
+  }
+
+} // namespace{
+
+std::vector<int> estimateColumnWidths(const QTableView & view, const ColumnWidthEstimateOptions & options)
+{
+  assert( view.model() != nullptr );
+  assert( options.sampleRowCount >= 0 );
+
+  const QAbstractItemModel *model = view.model();
+  const QHeaderView *header = view.horizontalHeader();
+  const auto *tableModel = qobject_cast<const Mdt::ItemModel::AbstractTableModel*>(model);
+  const int rowCount = model->rowCount();
+  const int columnCount = model->columnCount();
+  const int gridWidth = view.showGrid() ? 1 : 0;
+
+  std::vector<int> rows = stratifiedSampleOfRows(rowCount, options.sampleRowCount);
+  if(options.includeVisibleRows && (rowCount > options.sampleRowCount)){
+    appendVisibleRows(view, rowCount, rows);
+    std::sort( rows.begin(), rows.end() );
+    rows.erase( std::unique( rows.begin(), rows.end() ), rows.end() );
+  }
+
+  const QStyleOptionViewItem option = styleOptionForView(view);
+  std::vector<int> widths( static_cast<size_t>(columnCount), 0 );
+
+  for(int column = 0; column < columnCount; ++column){
+    if( view.isColumnHidden(column) ){
+      continue;
+    }
+
+    int width = 0;
+    const int maximumTextLength = (options.useMaximumTextLengthHint && (tableModel != nullptr))
+                                  ? tableModel->columnMaximumTextLength(column)
+                                  : -1;
+    if(maximumTextLength >= 0){
+      width = widthFromMaximumTextLength(view, option, maximumTextLength);
+    }else{
+      for(int row : rows){
+        if( view.isRowHidden(row) ){
+          continue;
+        }
+        const QModelIndex index = model->index(row, column);
+        const QAbstractItemDelegate *delegate = view.itemDelegate(index);
+        assert( delegate != nullptr );
+        width = std::max( width, delegate->sizeHint(option, index).width() );
+      }
+    }
+    width += gridWidth;
+
+    if( !header->isHidden() ){
+      width = std::max( width, header->sectionSizeHint(column) );
+    }
+    width = std::min( std::max( width, header->minimumSectionSize() ), header->maximumSectionSize() );
+
+    widths[static_cast<size_t>(column)] = width;
+  }
+
+  return widths;
+}
+
+void resizeColumnsToSampledContents(QTableView & view, const ColumnWidthEstimateOptions & options)
+{
+  assert( view.model() != nullptr );
+
+  const std::vector<int> widths = estimateColumnWidths(view, options);
+  QHeaderView *header = view.horizontalHeader();
+  const bool updatesWereEnabled = view.updatesEnabled();
+
+  view.setUpdatesEnabled(false);
+  for(int column = 0; column < static_cast<int>( widths.size() ); ++column){
+    if( view.isColumnHidden(column) ){
+      continue;
+    }
+    const QHeaderView::ResizeMode mode = header->sectionResizeMode(column);
+    if( (mode == QHeaderView::ResizeToContents) || (mode == QHeaderView::Stretch) ){
+      continue;
+    }
+    header->resizeSection( column, widths[static_cast<size_t>(column)] );
+  }
+  view.setUpdatesEnabled(updatesWereEnabled);
+}
+
 }} // namespace Mdt{ namespace ItemView{
@@ -4,7 +4,7 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2023-2023 Philippe Steinmann.
+ ** Copyright (C) 2023-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #ifndef MDT_ITEM_VIEW_HELPERS_H
@@ -12,6 +12,8 @@
 
 #include "mdt_itemview_qtwidgets_export.h"
 #include <QAbstractItemView>
+#include <QTableView>
+#include <vector>
 
 namespace Mdt{ namespace ItemView{
 
@@ -26,11 +28,71 @@ namespace Mdt{ namespace ItemView{
   MDT_ITEMVIEW_QTWIDGETS_EXPORT
   bool removeSelectedRows(QAbstractItemView & view);
 
-  /*! \brief
+  /*! \brief Options for estimateColumnWidths()
+   */
+  struct ColumnWidthEstimateOptions
+  {
+    /*! \brief Count of rows sampled in the whole model
+     *
+     * The rows of the model are split in this count of strata
+     * of (nearly) the same size, and one row is picked in each of them.
+     * If the model has less rows, all rows are used.
+     */
+    int sampleRowCount = 200;
+
+    /*! \brief Also use the rows that are currently visible in the view
+     */
+    bool includeVisibleRows = true;
+
+    /*! \brief Use the maximum text length hint of the columns
+     *
+     * If the model of the view is a Mdt::ItemModel::AbstractTableModel
+     * that knows the maximum text length of a column,
+     * the width of this column is computed from it,
+     * without reading its data.
+     *
+     * \sa Mdt::ItemModel::AbstractTableModel::columnMaximumTextLength()
+     */
+    bool useMaximumTextLengthHint = true;
+  };
+
+  /*! \brief Estimate the width that the columns of \a view need to show their contents
+   *
+   * QTableView::resizeColumnsToContents() , or a header in QHeaderView::ResizeToContents mode,
+   * reads the data of many rows to compute the width of each column,
+   * which takes seconds on a big model.
+   *
+   * This function only measures the cells of a stratified sample of the rows
+   * (see ColumnWidthEstimateOptions::sampleRowCount ),
+   * plus the rows that are visible in \a view .
+   * As for resizeColumnsToContents() , the width is at least
+   * the one required by the section of the horizontal header, if it is visible.
+   *
+   * The sample is the same for each call on the same row count,
+   * so the estimated widths do not change without reason.
+   *
+   * Returns a list that contains the width of each column of the model.
+   * The width of a hidden column is 0.
    *
-   * \todo function to resize row/columns to contents
-   * for the visible parts (+ some offset)
+   * \pre \a view must reference a model
+   * \sa resizeColumnsToSampledContents()
    */
+  MDT_ITEMVIEW_QTWIDGETS_EXPORT
+  std::vector<int> estimateColumnWidths(const QTableView & view, const ColumnWidthEstimateOptions & options = ColumnWidthEstimateOptions());
+
+  /*! \brief Resize the columns of \a view to the widths returned by estimateColumnWidths()
+   *
+   * The sections of the horizontal header are resized
+   * while the updates of \a view are disabled,
+   * so the view is repainted once.
+   *
+   * Hidden columns, and columns whose section is in QHeaderView::ResizeToContents
+   * or QHeaderView::Stretch mode, are not resized.
+   *
+   * \pre \a view must reference a model
+   */
+  MDT_ITEMVIEW_QTWIDGETS_EXPORT
+  void resizeColumnsToSampledContents(QTableView & view, const ColumnWidthEstimateOptions & options = ColumnWidthEstimateOptions());
 
 }} // namespace Mdt{ namespace ItemView{
 
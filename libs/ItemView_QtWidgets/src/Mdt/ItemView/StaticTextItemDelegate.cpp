@@ -0,0 +1,325 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "StaticTextItemDelegate.h"
+#include <QApplication>
+#include <QStyle>
+#include <QWidget>
+#include <QPainter>
+#include <QPalette>
+#include <QFontMetrics>
+#include <QVariant>
+#include <QTransform>
+#include <QRect>
+#include <QLatin1Char>
+#include <cassert>
+
+namespace Mdt{ namespace ItemView{
+
+StaticTextItemDelegate::StaticTextItemDelegate(QObject *parent)
+ : QStyledItemDelegate(parent)
+{
+}
+
+void StaticTextItemDelegate::setCacheCapacity(int capacity) noexcept
+{
+  assert( capacity > 0 );
+
+  mCacheCapacity = capacity;
+  while(mCache.size() > mCacheCapacity){
+    removeLeastRecentlyPaintedCell();
+  }
+}
+
+void StaticTextItemDelegate::clearCache() noexcept
+{
+  mCache.clear();
+  mLruKeys.clear();
+  mCurrentCellCount = 0;
+}
+
+void StaticTextItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem & option, const QModelIndex & index) const
+{
+  assert( painter != nullptr );
+  assert( index.isValid() );
+
+  trackModel( index.model() );
+
+  const CachedCell & cell = cachedCell(index, option);
+  if( !isPlainCell(option, cell) ){
+    QStyledItemDelegate::paint(painter, option, index);
+    return;
+  }
+
+  QStyleOptionViewItem itemOption = option;
+  itemOption.index = index;
+  applyCachedCell(itemOption, cell);
+
+  const QRect rect = textRect(itemOption);
+  // Eliding is left to QStyledItemDelegate
+  if( cell.staticText.size().width() > rect.width() ){
+    QStyledItemDelegate::paint(painter, option, index);
+    return;
+  }
+
+  paintPlainCell(painter, itemOption, cell.staticText, rect);
+}
+
+bool StaticTextItemDelegate::hasPlainData(const QStyleOptionViewItem & option) noexcept
+{
+  const auto otherFeatures = QStyleOptionViewItem::HasDecoration | QStyleOptionViewItem::HasCheckIndicator;
+
+  if( !(option.features & QStyleOptionViewItem::HasDisplay) ){
+    return false;
+  }
+  if(option.features & otherFeatures){
+    return false;
+  }
+
+  return !option.text.contains( QLatin1Char('\n') );
+}
+
+bool StaticTextItemDelegate::isPlainCell(const QStyleOptionViewItem & option, const CachedCell & cell) noexcept
+{
+  if( !cell.hasPlainData ){
+    return false;
+  }
+  if(option.features & QStyleOptionViewItem::WrapText){
+    return false;
+  }
+
+  return !(option.state & QStyle::State_HasFocus);
+}
+
+void StaticTextItemDelegate::applyCachedCell(QStyleOptionViewItem & option, const CachedCell & cell) noexcept
+{
+  // Same as QStyledItemDelegate::initStyleOption() does for a plain cell
+  if(cell.hasFont){
+    option.font = cell.font;
+    option.fontMetrics = QFontMetrics(cell.font);
+  }
+  option.displayAlignment = cell.displayAlignment;
+  if(cell.hasForeground){
+    option.palette.setBrush(QPalette::Text, cell.foreground);
+  }
+  option.features |= QStyleOptionViewItem::HasDisplay;
+  option.text = cell.text;
+  option.backgroundBrush = cell.background;
+}
+
+const StaticTextItemDelegate::CachedCell &
+StaticTextItemDelegate::cachedCell(const QModelIndex & index, const QStyleOptionViewItem & option) const
+{
+  const quint64 key = keyOf( index.row(), index.column() );
+
+  auto it = mCache.find(key);
+  if( it == mCache.end() ){
+    if(mCache.size() >= mCacheCapacity){
+      removeLeastRecentlyPaintedCell();
+    }
+    it = mCache.insert( key, CachedCell() );
+    mLruKeys.push_front(key);
+    it->lruPosition = mLruKeys.begin();
+  }else{
+    mLruKeys.splice( mLruKeys.begin(), mLruKeys, it->lruPosition );
+    if( it->revision == mRevision ){
+      // The view font is shared, so this is mostly a pointer comparison
+      if( it->viewFont == option.font ){
+        return *it;
+      }
+      --mCurrentCellCount;
+    }
+  }
+
+  updateCachedCell(*it, index, option);
+  ++mCurrentCellCount;
+
+  return *it;
+}
+
+void StaticTextItemDelegate::updateCachedCell(CachedCell & cell, const QModelIndex & index, const QStyleOptionViewItem & option) const
+{
+  QStyleOptionViewItem itemOption = option;
+  initStyleOption(&itemOption, index);
+
+  cell.revision = mRevision;
+  cell.hasPlainData = hasPlainData(itemOption);
+  cell.viewFont = option.font;
+  if( !cell.hasPlainData ){
+    cell.text.clear();
+    cell.staticText = QStaticText();
+    return;
+  }
+
+  const QVariant foreground = index.data(Qt::ForegroundRole);
+
+  cell.text = itemOption.text;
+  cell.hasFont = index.data(Qt::FontRole).isValid();
+  cell.font = itemOption.font;
+  cell.displayAlignment = itemOption.displayAlignment;
+  cell.hasForeground = foreground.isValid();
+  cell.foreground = qvariant_cast<QBrush>(foreground);
+  cell.background = itemOption.backgroundBrush;
+  cell.staticText.setText(itemOption.text);
+  cell.staticText.setTextFormat(Qt::PlainText);
+  cell.staticText.prepare(QTransform(), itemOption.font);
+}
+
+StaticTextItemDelegate::Cache::iterator StaticTextItemDelegate::removeCell(Cache::iterator it) const noexcept
+{
+  assert( it != mCache.end() );
+
+  if( it->revision == mRevision ){
+    --mCurrentCellCount;
+  }
+  mLruKeys.erase(it->lruPosition);
+
+  return mCache.erase(it);
+}
+
+void StaticTextItemDelegate::removeLeastRecentlyPaintedCell() const noexcept
+{
+  assert( !mLruKeys.empty() );
+
+  const auto it = mCache.find( mLruKeys.back() );
+  assert( it != mCache.end() );
+  removeCell(it);
+}
+
+void StaticTextItemDelegate::paintPlainCell(QPainter *painter, const QStyleOptionViewItem & option,
+                                            const QStaticText & text, const QRect & textRect) const
+{
+  assert( painter != nullptr );
+
+  const QWidget *widget = option.widget;
+  const QStyle *style = widget != nullptr ? widget->style() : QApplication::style();
+
+  // Background and selection
+  style->drawPrimitive(QStyle::PE_PanelItemViewItem, &option, painter, widget);
+
+  // Same colors as QCommonStyle uses for the text of a item
+  QPalette::ColorGroup colorGroup = (option.state & QStyle::State_Enabled) ? QPalette::Normal : QPalette::Disabled;
+  if( (colorGroup == QPalette::Normal) && !(option.state & QStyle::State_Active) ){
+    colorGroup = QPalette::Inactive;
+  }
+  const QPalette::ColorRole colorRole = (option.state & QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Text;
+
+  const QRect rect = QStyle::alignedRect( option.direction, option.displayAlignment, text.size().toSize(), textRect );
+
+  painter->save();
+  painter->setPen( option.palette.color(colorGroup, colorRole) );
+  painter->setFont(option.font);
+  painter->drawStaticText(rect.topLeft(), text);
+  painter->restore();
+}
+
+QRect StaticTextItemDelegate::textRect(const QStyleOptionViewItem & option) const
+{
+  const QWidget *widget = option.widget;
+  const QStyle *style = widget != nullptr ? widget->style() : QApplication::style();
+
+  // Same margin as QCommonStyle puts around the text of a item
+  const int margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, widget) + 1;
+  const QRect rect = style->subElementRect(QStyle::SE_ItemViewItemText, &option, widget);
+
+  return rect.adjusted(margin, 0, -margin, 0);
+}
+
+void StaticTextItemDelegate::trackModel(const QAbstractItemModel *model) const
+{
+  assert( model != nullptr );
+
+  if(model == mModel){
+    return;
+  }
+
+  /*
+   * The cache is a implementation detail,
+   * tracking the model does not change the observable state of this delegate
+   */
+  auto *self = const_cast<StaticTextItemDelegate*>(this);
+
+  untrackModel();
+  self->clearCache();
+  mModel = model;
+
+  const auto onStructureChanged = [self](){
+    self->invalidateCache();
+  };
+
+  mModelConnections.append( connect(model, &QAbstractItemModel::dataChanged, self, &StaticTextItemDelegate::onDataChanged) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::rowsInserted, self, onStructureChanged) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::rowsRemoved, self, onStructureChanged) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::rowsMoved, self, onStructureChanged) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::columnsInserted, self, onStructureChanged) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::columnsRemoved, self, onStructureChanged) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::columnsMoved, self, onStructureChanged) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::layoutChanged, self, onStructureChanged) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::modelReset, self, onStructureChanged) );
+  mModelConnections.append( connect(model, &QObject::destroyed, self, [self](){
+    self->untrackModel();
+    self->clearCache();
+  }) );
+}
+
+void StaticTextItemDelegate::untrackModel() const noexcept
+{
+  for(const QMetaObject::Connection & connection : mModelConnections){
+    disconnect(connection);
+  }
+  mModelConnections.clear();
+  mModel = nullptr;
+}
+
+void StaticTextItemDelegate::invalidateCache() noexcept
+{
+  // The stale cells are dropped first when the cache is full
+  ++mRevision;
+  mCurrentCellCount = 0;
+}
+
+void StaticTextItemDelegate::onDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight) noexcept
+{
+  if( !topLeft.isValid() || !bottomRight.isValid() ){
+    clearCache();
+    return;
+  }
+
+  const int firstRow = topLeft.row();
+  const int lastRow = bottomRight.row();
+  const int firstColumn = topLeft.column();
+  const int lastColumn = bottomRight.column();
+
+  // Typically a single cell or a single row changes
+  const qint64 cellCount = static_cast<qint64>(lastRow - firstRow + 1) * static_cast<qint64>(lastColumn - firstColumn + 1);
+  if( cellCount <= static_cast<qint64>( mCache.size() ) ){
+    for(int row = firstRow; row <= lastRow; ++row){
+      for(int column = firstColumn; column <= lastColumn; ++column){
+        const auto it = mCache.find( keyOf(row, column) );
+        if( it != mCache.end() ){
+          removeCell(it);
+        }
+      }
+    }
+    return;
+  }
+
+  auto it = mCache.begin();
+  while( it != mCache.end() ){
+    const auto row = static_cast<int>( it.key() >> 32 );
+    const auto column = static_cast<int>( it.key() & 0xFFFFFFFF );
+    if( (row >= firstRow) && (row <= lastRow) && (column >= firstColumn) && (column <= lastColumn) ){
+      it = removeCell(it);
+    }else{
+      ++it;
+    }
+  }
+}
+
+}} // namespace Mdt{ namespace ItemView{
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_VIEW_STATIC_TEXT_ITEM_DELEGATE_H
+#define MDT_ITEM_VIEW_STATIC_TEXT_ITEM_DELEGATE_H
+
+#include "mdt_itemview_qtwidgets_export.h"
+#include <QStyledItemDelegate>
+#include <QStyleOptionViewItem>
+#include <QAbstractItemModel>
+#include <QModelIndex>
+#include <QStaticText>
+#include <QString>
+#include <QFont>
+#include <QBrush>
+#include <QHash>
+#include <QVector>
+#include <QMetaObject>
+#include <QtGlobal>
+#include <list>
+
+class QPainter;
+
+namespace Mdt{ namespace ItemView{
+
+  /*! \brief Item delegate that caches the shaped text of the cells
+   *
+   * QStyledItemDelegate lays out the text of each cell with QTextLayout
+   * each time the cell is painted,
+   * also if its text did not change since the last repaint.
+   *
+   * StaticTextItemDelegate keeps, for each painted cell,
+   * the data that QStyledItemDelegate::initStyleOption() reads from the model,
+   * and for plain cells, the text shaped once in a QStaticText .
+   * The cache is keyed by (row, column) and by a revision of the texts,
+   * so painting a cached cell neither reads the model nor compares its text.
+   *
+   * The cache is invalidated by the signals of the model:
+   * dataChanged() drops the changed cells,
+   * and structural changes (rows, columns, layout, reset) start a new revision,
+   * which makes all the cached cells stale.
+   * When the cache is full, the least recently painted cell is dropped,
+   * the stale cells being the first ones.
+   *
+   * A plain cell has no decoration, no check indicator and no focus,
+   * does not wrap its text, and its text fits in the cell.
+   * For plain cells, only the panel (background and selection) and the text are drawn,
+   * without going through QStyle::drawControl() .
+   * Other cells are painted by QStyledItemDelegate .
+   *
+   * \code
+   * QTableView view;
+   * Mdt::ItemView::StaticTextItemDelegate delegate;
+   *
+   * view.setItemDelegate(&delegate);
+   * \endcode
+   *
+   * \note Style sheets that change the look of the items are not applied to plain cells.
+   */
+  class MDT_ITEMVIEW_QTWIDGETS_EXPORT StaticTextItemDelegate : public QStyledItemDelegate
+  {
+   Q_OBJECT
+
+   public:
+
+    /*! \brief Default count of cells the cache can hold
+     */
+    static constexpr int defaultCacheCapacity = 4096;
+
+    /*! \brief Construct a delegate
+     */
+    explicit StaticTextItemDelegate(QObject *parent = nullptr);
+
+    /*! \brief Get the count of cells the cache can hold
+     */
+    int cacheCapacity() const noexcept
+    {
+      return mCacheCapacity;
+    }
+
+    /*! \brief Set the count of cells the cache can hold
+     *
+     * When the cache is full, the least recently painted cell is dropped.
+     * So, \a capacity should be greater than the count of visible cells.
+     *
+     * Reducing the capacity drops the least recently painted cells.
+     *
+     * \pre \a capacity must be > 0
+     */
+    void setCacheCapacity(int capacity) noexcept;
+
+    /*! \brief Get the count of cells in the cache
+     *
+     * The stale cells are not counted.
+     */
+    int cachedTextCount() const noexcept
+    {
+      return mCurrentCellCount;
+    }
+
+    /*! \brief Drop all the cached cells
+     */
+    void clearCache() noexcept;
+
+    /*! \brief Paint the cell at \a index
+     */
+    void paint(QPainter *painter, const QStyleOptionViewItem & option, const QModelIndex & index) const override;
+
+   private:
+
+    using CellKeyList = std::list<quint64>;
+
+    struct CachedCell
+    {
+      quint64 revision = 0;
+      bool hasPlainData = false;
+      QFont viewFont;
+      QString text;
+      bool hasFont = false;
+      QFont font;
+      Qt::Alignment displayAlignment;
+      bool hasForeground = false;
+      QBrush foreground;
+      QBrush background;
+      QStaticText staticText;
+      CellKeyList::iterator lruPosition;
+    };
+
+    using Cache = QHash<quint64, CachedCell>;
+
+    static
+    quint64 keyOf(int row, int column) noexcept
+    {
+      return (static_cast<quint64>(row) << 32) | static_cast<quint64>(column);
+    }
+
+    static
+    bool hasPlainData(const QStyleOptionViewItem & option) noexcept;
+
+    static
+    bool isPlainCell(const QStyleOptionViewItem & option, const CachedCell & cell) noexcept;
+
+    static
+    void applyCachedCell(QStyleOptionViewItem & option, const CachedCell & cell) noexcept;
+
+    const CachedCell & cachedCell(const QModelIndex & index, const QStyleOptionViewItem & option) const;
+    void updateCachedCell(CachedCell & cell, const QModelIndex & index, const QStyleOptionViewItem & option) const;
+    Cache::iterator removeCell(Cache::iterator it) const noexcept;
+    void removeLeastRecentlyPaintedCell() const noexcept;
+    void paintPlainCell(QPainter *painter, const QStyleOptionViewItem & option, const QStaticText & text, const QRect & textRect) const;
+    QRect textRect(const QStyleOptionViewItem & option) const;
+    void trackModel(const QAbstractItemModel *model) const;
+    void untrackModel() const noexcept;
+    void invalidateCache() noexcept;
+    void onDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight) noexcept;
+
+    int mCacheCapacity = defaultCacheCapacity;
+    mutable Cache mCache;
+    mutable CellKeyList mLruKeys;
+    mutable int mCurrentCellCount = 0;
+    quint64 mRevision = 0;
+    mutable const QAbstractItemModel *mModel = nullptr;
+    mutable QVector<QMetaObject::Connection> mModelConnections;
+  };
+
+}} // namespace Mdt{ namespace ItemView{
+
+#endif // #ifndef MDT_ITEM_VIEW_STATIC_TEXT_ITEM_DELEGATE_H
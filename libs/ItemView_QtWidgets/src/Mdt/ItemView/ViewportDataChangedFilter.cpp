@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "ViewportDataChangedFilter.h"
+#include "Mdt/ItemModel/RowRange.h"
+#include <QTableView>
+#include <QScrollBar>
+#include <QWidget>
+#include <QEvent>
+#include <QPoint>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+
+using Mdt::ItemModel::RowRange;
+using Mdt::ItemModel::RowRangeList;
+
+namespace Mdt{ namespace ItemView{
+
+namespace{
+
+  /*
+   * Splits list in the parts that are in [firstRow, lastRow]
+   * and the parts that are outside
+   */
+  void splitRowRangeList(const RowRangeList & list, int firstRow, int lastRow, RowRangeList & inside, RowRangeList & outside) noexcept
+  {
+    assert( RowRange::firstAndLastRowIsValidRange(firstRow, lastRow) );
+
+    for(const RowRange & range : list){
+      if( (range.lastRow() < firstRow) || (range.firstRow() > lastRow) ){
+        outside.addRange(range);
+        continue;
+      }
+      if(range.firstRow() < firstRow){
+        outside.addRange( RowRange::fromFirstAndLastRow(range.firstRow(), firstRow - 1) );
+      }
+      if(range.lastRow() > lastRow){
+        outside.addRange( RowRange::fromFirstAndLastRow(lastRow + 1, range.lastRow()) );
+      }
+      inside.addRange( RowRange::fromFirstAndLastRow( std::max(range.firstRow(), firstRow), std::min(range.lastRow(), lastRow) ) );
+    }
+  }
+
+} // namespace{
+
+ViewportDataChangedFilter::ViewportDataChangedFilter(QAbstractItemView *view)
+ : QObject(view),
+   mView(view)
+{
+  assert( view != nullptr );
+
+  /*
+   * QAbstractItemView::dataChanged() is a protected slot,
+   * it can only be connected by its signature
+   */
+  connect( this, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)),
+           view, SLOT(dataChanged(QModelIndex,QModelIndex,QVector<int>)) );
+  connect(view->verticalScrollBar(), &QScrollBar::valueChanged, this, &ViewportDataChangedFilter::forwardVisibleDirtyRows);
+  view->viewport()->installEventFilter(this);
+
+  attachToModel();
+}
+
+ViewportDataChangedFilter::~ViewportDataChangedFilter() noexcept
+{
+  detachFromModel();
+}
+
+void ViewportDataChangedFilter::setModel(QAbstractItemModel *model)
+{
+  assert( !mView.isNull() );
+
+  detachFromModel();
+  mView->setModel(model);
+  attachToModel();
+}
+
+void ViewportDataChangedFilter::forwardDirtyRows()
+{
+  const RowRangeList dirtyRows = std::move(mDirtyRows);
+  clearDirtyRows();
+  if( mModel.isNull() ){
+    return;
+  }
+
+  for(const RowRange & range : dirtyRows){
+    forwardRows( range.firstRow(), range.lastRow() );
+  }
+}
+
+bool ViewportDataChangedFilter::eventFilter(QObject *watched, QEvent *event)
+{
+  assert( event != nullptr );
+
+  if( (event->type() == QEvent::Show) || (event->type() == QEvent::Resize) ){
+    forwardVisibleDirtyRows();
+  }
+
+  return QObject::eventFilter(watched, event);
+}
+
+void ViewportDataChangedFilter::attachToModel()
+{
+  assert( !mView.isNull() );
+  assert( mModelConnections.isEmpty() );
+
+  mModel = mView->model();
+  if( mModel.isNull() ){
+    return;
+  }
+
+  // See the constructor
+  disconnect( mModel, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)),
+              mView, SLOT(dataChanged(QModelIndex,QModelIndex,QVector<int>)) );
+
+  const QAbstractItemModel *model = mModel.data();
+  mModelConnections.append( connect(model, &QAbstractItemModel::dataChanged, this, &ViewportDataChangedFilter::onDataChanged) );
+
+  mModelConnections.append( connect(model, &QAbstractItemModel::rowsAboutToBeInserted, this, &ViewportDataChangedFilter::forwardDirtyRows) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &ViewportDataChangedFilter::forwardDirtyRows) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::rowsAboutToBeMoved, this, &ViewportDataChangedFilter::forwardDirtyRows) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::columnsAboutToBeInserted, this, &ViewportDataChangedFilter::forwardDirtyRows) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::columnsAboutToBeRemoved, this, &ViewportDataChangedFilter::forwardDirtyRows) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::columnsAboutToBeMoved, this, &ViewportDataChangedFilter::forwardDirtyRows) );
+
+  mModelConnections.append( connect(model, &QAbstractItemModel::modelAboutToBeReset, this, &ViewportDataChangedFilter::clearDirtyRows) );
+  mModelConnections.append( connect(model, &QAbstractItemModel::layoutAboutToBeChanged, this, &ViewportDataChangedFilter::clearDirtyRows) );
+}
+
+void ViewportDataChangedFilter::detachFromModel() noexcept
+{
+  for(const QMetaObject::Connection & connection : mModelConnections){
+    disconnect(connection);
+  }
+  mModelConnections.clear();
+
+  if( !mView.isNull() && !mModel.isNull() && (mView->model() == mModel) ){
+    forwardDirtyRows();
+    connect( mModel, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)),
+             mView, SLOT(dataChanged(QModelIndex,QModelIndex,QVector<int>)) );
+  }
+
+  clearDirtyRows();
+  mModel.clear();
+}
+
+void ViewportDataChangedFilter::onDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles)
+{
+  if( !topLeft.isValid() || !bottomRight.isValid() || topLeft.parent().isValid() ){
+    emit dataChanged(topLeft, bottomRight, roles);
+    return;
+  }
+
+  const int firstRow = topLeft.row();
+  const int lastRow = bottomRight.row();
+  assert( RowRange::firstAndLastRowIsValidRange(firstRow, lastRow) );
+
+  if( !mView->isVisible() ){
+    mDirtyRows.addRange( RowRange::fromFirstAndLastRow(firstRow, lastRow) );
+    return;
+  }
+
+  int firstVisibleRow;
+  int lastVisibleRow;
+  if( !getVisibleRows(firstVisibleRow, lastVisibleRow) ){
+    emit dataChanged(topLeft, bottomRight, roles);
+    return;
+  }
+
+  if( (lastRow < firstVisibleRow) || (firstRow > lastVisibleRow) ){
+    mDirtyRows.addRange( RowRange::fromFirstAndLastRow(firstRow, lastRow) );
+    return;
+  }
+  if( (firstRow >= firstVisibleRow) && (lastRow <= lastVisibleRow) ){
+    emit dataChanged(topLeft, bottomRight, roles);
+    return;
+  }
+
+  if(firstRow < firstVisibleRow){
+    mDirtyRows.addRange( RowRange::fromFirstAndLastRow(firstRow, firstVisibleRow - 1) );
+  }
+  if(lastRow > lastVisibleRow){
+    mDirtyRows.addRange( RowRange::fromFirstAndLastRow(lastVisibleRow + 1, lastRow) );
+  }
+  const int firstForwardedRow = std::max(firstRow, firstVisibleRow);
+  const int lastForwardedRow = std::min(lastRow, lastVisibleRow);
+  emit dataChanged( topLeft.sibling( firstForwardedRow, topLeft.column() ), bottomRight.sibling( lastForwardedRow, bottomRight.column() ), roles );
+}
+
+void ViewportDataChangedFilter::forwardVisibleDirtyRows()
+{
+  if( mDirtyRows.isEmpty() || mModel.isNull() || !mView->isVisible() ){
+    return;
+  }
+
+  int firstVisibleRow;
+  int lastVisibleRow;
+  if( !getVisibleRows(firstVisibleRow, lastVisibleRow) ){
+    forwardDirtyRows();
+    return;
+  }
+
+  RowRangeList visibleDirtyRows;
+  RowRangeList otherDirtyRows;
+  splitRowRangeList(mDirtyRows, firstVisibleRow, lastVisibleRow, visibleDirtyRows, otherDirtyRows);
+  mDirtyRows = std::move(otherDirtyRows);
+
+  for(const RowRange & range : visibleDirtyRows){
+    forwardRows( range.firstRow(), range.lastRow() );
+  }
+}
+
+void ViewportDataChangedFilter::forwardRows(int firstRow, int lastRow)
+{
+  assert( !mModel.isNull() );
+  assert( RowRange::firstAndLastRowIsValidRange(firstRow, lastRow) );
+
+  const int columnCount = mModel->columnCount();
+  if(columnCount < 1){
+    return;
+  }
+
+  emit dataChanged( mModel->index(firstRow, 0), mModel->index(lastRow, columnCount - 1), QVector<int>() );
+}
+
+void ViewportDataChangedFilter::clearDirtyRows() noexcept
+{
+  mDirtyRows = RowRangeList();
+}
+
+/*
+ * Returns false if no row is at the top of the viewport,
+ * for example if it is in the spacing of a QListView
+ */
+bool ViewportDataChangedFilter::getVisibleRows(int & firstRow, int & lastRow) const
+{
+  assert( !mView.isNull() );
+  assert( mView->isVisible() );
+  assert( !mModel.isNull() );
+
+  const int bottom = mView->viewport()->height() - 1;
+  const auto *tableView = qobject_cast<const QTableView*>( mView.data() );
+  if(tableView != nullptr){
+    // Not affected by hidden columns
+    firstRow = tableView->rowAt(0);
+    lastRow = tableView->rowAt(bottom);
+  }else{
+    firstRow = mView->indexAt( QPoint(0, 0) ).row();
+    lastRow = mView->indexAt( QPoint(0, bottom) ).row();
+  }
+
+  if(firstRow < 0){
+    return false;
+  }
+  // The viewport can be higher than the rows
+  if(lastRow < 0){
+    lastRow = mModel->rowCount() - 1;
+  }
+
+  return firstRow <= lastRow;
+}
+
+}} // namespace Mdt{ namespace ItemView{
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef MDT_ITEM_VIEW_VIEWPORT_DATA_CHANGED_FILTER_H
+#define MDT_ITEM_VIEW_VIEWPORT_DATA_CHANGED_FILTER_H
+
+#include "Mdt/ItemModel/RowRangeList.h"
+#include "mdt_itemview_qtwidgets_export.h"
+#include <QObject>
+#include <QAbstractItemView>
+#include <QAbstractItemModel>
+#include <QModelIndex>
+#include <QPointer>
+#include <QVector>
+#include <QMetaObject>
+
+class QEvent;
+
+namespace Mdt{ namespace ItemView{
+
+  /*! \brief Forwards to a view only the changes of data that are in its viewport
+   *
+   * QAbstractItemView handles each dataChanged() signal of its model,
+   * also if the changed rows are far from the visible ones.
+   * For a model that changes rows at a high frequency, for example a table fed by a device,
+   * this is a lot of work in the GUI thread for nothing.
+   *
+   * ViewportDataChangedFilter takes the place of the view for the dataChanged() signal of the model.
+   * The changed rows that are in the viewport are forwarded to the view.
+   * The other ones are kept in a list of dirty rows,
+   * which are forwarded when they are scrolled into the viewport.
+   *
+   * \code
+   * QTableView view;
+   * Mdt::ItemView::ViewportDataChangedFilter filter(&view);
+   *
+   * filter.setModel(&model);
+   * \endcode
+   *
+   * Dirty rows are forwarded for all columns and all roles.
+   *
+   * Before rows or columns are inserted, removed or moved,
+   * the dirty rows are forwarded, because their numbers will change.
+   * When the model is reset or its layout changed,
+   * the dirty rows are dropped, because the view updates all its items.
+   *
+   * While the view is hidden, all changes are kept as dirty rows.
+   * If the rows in the viewport can not be found,
+   * for example if the top of the viewport is in the spacing of a QListView ,
+   * the changes are forwarded.
+   *
+   * The visible rows are the ones between the top and the bottom of the viewport,
+   * which suits QTableView and QListView in list mode.
+   * Changes of items that have a parent (tree models) are always forwarded.
+   */
+  class MDT_ITEMVIEW_QTWIDGETS_EXPORT ViewportDataChangedFilter : public QObject
+  {
+   Q_OBJECT
+
+   public:
+
+    /*! \brief Construct a filter for \a view
+     *
+     * If \a view already has a model, its dataChanged() signal is filtered.
+     *
+     * The filter is a child of \a view .
+     *
+     * \pre \a view must be a valid pointer
+     */
+    explicit ViewportDataChangedFilter(QAbstractItemView *view);
+
+    /*! \brief Destruct this filter
+     *
+     * If the view and its model still exist,
+     * the dirty rows are forwarded to the view,
+     * and the view gets the dataChanged() signal of the model again.
+     */
+    ~ViewportDataChangedFilter() noexcept;
+
+    ViewportDataChangedFilter(const ViewportDataChangedFilter &) = delete;
+    ViewportDataChangedFilter & operator=(const ViewportDataChangedFilter &) = delete;
+    ViewportDataChangedFilter(ViewportDataChangedFilter &&) = delete;
+    ViewportDataChangedFilter & operator=(ViewportDataChangedFilter &&) = delete;
+
+    /*! \brief Set \a model to the view and filter its dataChanged() signal
+     *
+     * The model must be set with this method, not with QAbstractItemView::setModel() ,
+     * otherwise the view gets the dataChanged() signal of the model directly.
+     */
+    void setModel(QAbstractItemModel *model);
+
+    /*! \brief Get the rows that changed but are not yet forwarded to the view
+     */
+    const Mdt::ItemModel::RowRangeList & dirtyRows() const noexcept
+    {
+      return mDirtyRows;
+    }
+
+    /*! \brief Forward all the dirty rows to the view
+     */
+    void forwardDirtyRows();
+
+   signals:
+
+    /*! \brief Emitted for the changes forwarded to the view
+     */
+    void dataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles);
+
+   protected:
+
+    /*! \brief Forwards the dirty rows that are visible after the viewport is shown or resized
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+   private:
+
+    void attachToModel();
+    void detachFromModel() noexcept;
+    void onDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles);
+    void forwardVisibleDirtyRows();
+    void forwardRows(int firstRow, int lastRow);
+    void clearDirtyRows() noexcept;
+    bool getVisibleRows(int & firstRow, int & lastRow) const;
+
+    QPointer<QAbstractItemView> mView;
+    QPointer<QAbstractItemModel> mModel;
+    QVector<QMetaObject::Connection> mModelConnections;
+    Mdt::ItemModel::RowRangeList mDirtyRows;
+  };
+
+}} // namespace Mdt{ namespace ItemView{
+
+#endif // #ifndef MDT_ITEM_VIEW_VIEWPORT_DATA_CHANGED_FILTER_H
@@ -4,13 +4,17 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2023-2023 Philippe Steinmann.
+ ** Copyright (C) 2023-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #include "ItemViewHelpersTest.h"
 #include "RemoveRowsTableModel.h"
 #include "Mdt/ItemView/Helpers.h"
+#include "Mdt/ItemModel/AbstractTableModel.h"
 #include <QTableView>
+#include <QHeaderView>
+#include <QString>
+#include <vector>
 #include <cassert>
 
 #include <QItemSelectionModel>
@@ -48,6 +52,67 @@ void selectItem(QAbstractItemView & view, int row, int column)
   view.selectionModel()->select(index, QItemSelectionModel::Select);
 }
 
+/*
+ * Model with 2 columns of text,
+ * that counts the calls to displayRoleData() for each column
+ */
+class TextTableModel : public Mdt::ItemModel::AbstractTableModel
+{
+ public:
+
+  void setTexts(int rowCount, const QString & firstColumnText, const QString & secondColumnText)
+  {
+    beginResetModel();
+    mRowCount = rowCount;
+    mTexts = {firstColumnText, secondColumnText};
+    endResetModel();
+  }
+
+  void setSecondColumnMaximumTextLength(int length)
+  {
+    mSecondColumnMaximumTextLength = length;
+  }
+
+  int displayRoleDataCallCount(int column) const
+  {
+    return mDisplayRoleDataCallCount[static_cast<size_t>(column)];
+  }
+
+ private:
+
+  int rowCountWithoutParentIndex() const noexcept override
+  {
+    return mRowCount;
+  }
+
+  int columnCountWithoutParentIndex() const noexcept override
+  {
+    return 2;
+  }
+
+  QVariant displayRoleData(const QModelIndex & index) const noexcept override
+  {
+    const auto column = static_cast<size_t>( index.column() );
+    ++mDisplayRoleDataCallCount[column];
+
+    return mTexts[column];
+  }
+
+  int doGetColumnMaximumTextLength(int column) const noexcept override
+  {
+    if(column == 1){
+      return mSecondColumnMaximumTextLength;
+    }
+
+    return -1;
+  }
+
+  int mRowCount = 0;
+  std::vector<QString> mTexts{QString(), QString()};
+  int mSecondColumnMaximumTextLength = -1;
+  mutable std::vector<int> mDisplayRoleDataCallCount{0, 0};
+};
+
 /*
  * Most of the tests are done in ItemModelHelpersTest
  */
@@ -69,4 +134,96 @@ void ItemViewHelpersTest::removeSelectedRows_SelectAll()
   QCOMPARE( model.rowCount(), 0 );
 }
 
+void ItemViewHelpersTest::estimateColumnWidths_LongerTextIsWider()
+{
+  QTableView view;
+  TextTableModel model;
+
+  model.setTexts( 3, QStringLiteral("A"), QStringLiteral("A much longer text than the other column") );
+  view.setModel(&model);
+  view.horizontalHeader()->hide();
+
+  const std::vector<int> widths = estimateColumnWidths(view);
+
+  QCOMPARE( widths.size(), size_t(2) );
+  QVERIFY( widths[1] > widths[0] );
+}
+
+void ItemViewHelpersTest::estimateColumnWidths_HiddenColumn()
+{
+  QTableView view;
+  TextTableModel model;
+
+  model.setTexts( 3, QStringLiteral("A"), QStringLiteral("B") );
+  view.setModel(&model);
+  view.setColumnHidden(0, true);
+
+  const std::vector<int> widths = estimateColumnWidths(view);
+
+  QCOMPARE( widths[0], 0 );
+  QVERIFY( widths[1] > 0 );
+  QCOMPARE( model.displayRoleDataCallCount(0), 0 );
+}
+
+void ItemViewHelpersTest::estimateColumnWidths_SamplesBigModel()
+{
+  constexpr int rowCount = 100'000;
+  QTableView view;
+  TextTableModel model;
+
+  model.setTexts( rowCount, QStringLiteral("A"), QStringLiteral("B") );
+  view.setModel(&model);
+  view.resize(400, 300);
+  view.show();
+
+  ColumnWidthEstimateOptions options;
+  options.sampleRowCount = 100;
+  const int displayRoleDataCallCountBefore = model.displayRoleDataCallCount(0);
+  const std::vector<int> widths = estimateColumnWidths(view, options);
+  const int displayRoleDataCallCount = model.displayRoleDataCallCount(0) - displayRoleDataCallCountBefore;
+
+  QVERIFY( widths[0] > 0 );
+  // The sampled rows, plus the visible ones
+  QVERIFY( displayRoleDataCallCount >= options.sampleRowCount );
+  QVERIFY( displayRoleDataCallCount < 2 * options.sampleRowCount );
+}
+
+void ItemViewHelpersTest::estimateColumnWidths_MaximumTextLengthHint()
+{
+  QTableView view;
+  TextTableModel model;
+
+  model.setTexts( 3, QStringLiteral("A"), QStringLiteral("B") );
+  model.setSecondColumnMaximumTextLength(50);
+  view.setModel(&model);
+  view.horizontalHeader()->hide();
+
+  ColumnWidthEstimateOptions options;
+
+  options.useMaximumTextLengthHint = true;
+  const std::vector<int> widthsWithHint = estimateColumnWidths(view, options);
+  QCOMPARE( model.displayRoleDataCallCount(1), 0 );
+  QVERIFY( widthsWithHint[1] >= 50 * view.fontMetrics().averageCharWidth() );
+
+  options.useMaximumTextLengthHint = false;
+  const std::vector<int> widthsWithoutHint = estimateColumnWidths(view, options);
+  QVERIFY( model.displayRoleDataCallCount(1) > 0 );
+  QVERIFY( widthsWithoutHint[1] < widthsWithHint[1] );
+}
+
+void ItemViewHelpersTest::resizeColumnsToSampledContents_AppliesEstimate()
+{
+  QTableView view;
+  TextTableModel model;
+
+  model.setTexts( 3, QStringLiteral("A"), QStringLiteral("A much longer text than the other column") );
+  view.setModel(&model);
+
+  const std::vector<int> widths = estimateColumnWidths(view);
+  resizeColumnsToSampledContents(view);
+
+  QCOMPARE( view.columnWidth(0), widths[0] );
+  QCOMPARE( view.columnWidth(1), widths[1] );
+}
+
 QTEST_MAIN(ItemViewHelpersTest)
@@ -4,7 +4,7 @@
  ** MdtModelView
  ** Set of libraries extending the Qt model-view framework.
  **
- ** Copyright (C) 2023-2023 Philippe Steinmann.
+ ** Copyright (C) 2023-2024 Philippe Steinmann.
  **
  *****************************************************************************************/
 #ifndef ITEM_VIEW_HELPERS_TEST_H
@@ -21,6 +21,12 @@ class ItemViewHelpersTest : public QObject
 
 //   void removeSelectedRows_Sandbox();
   void removeSelectedRows_SelectAll();
+
+  void estimateColumnWidths_LongerTextIsWider();
+  void estimateColumnWidths_HiddenColumn();
+  void estimateColumnWidths_SamplesBigModel();
+  void estimateColumnWidths_MaximumTextLengthHint();
+  void resizeColumnsToSampledContents_AppliesEstimate();
 };
 
 #endif // #ifndef ITEM_VIEW_HELPERS_TEST_H
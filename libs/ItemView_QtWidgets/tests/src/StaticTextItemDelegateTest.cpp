@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "StaticTextItemDelegateTest.h"
+#include "RemoveRowsTableModel.h"
+#include "Mdt/ItemView/StaticTextItemDelegate.h"
+#include <QTableView>
+#include <QString>
+#include <QVariant>
+#include <QModelIndex>
+
+using namespace Mdt::ItemView;
+
+/*
+ * Model that also accepts edition,
+ * so that it signals dataChanged()
+ */
+class EditableRemoveRowsTableModel : public RemoveRowsTableModel
+{
+ public:
+
+  Qt::ItemFlags flags(const QModelIndex & index) const override
+  {
+    if( !indexIsValidAndInRange(index) ){
+      return RemoveRowsTableModel::flags(index);
+    }
+
+    return RemoveRowsTableModel::flags(index) | Qt::ItemIsEditable;
+  }
+
+ private:
+
+  bool setEditRoleData(const QModelIndex & index, const QVariant & value) noexcept override
+  {
+    return setDataInTable(index, value);
+  }
+};
+
+void setupView(QTableView & view, QAbstractItemModel & model, StaticTextItemDelegate & delegate)
+{
+  view.setModel(&model);
+  view.setItemDelegate(&delegate);
+  view.resize(400, 300);
+}
+
+void paintView(QTableView & view)
+{
+  view.viewport()->grab();
+}
+
+void StaticTextItemDelegateTest::paint_FillsCache()
+{
+  QTableView view;
+  StaticTextItemDelegate delegate;
+  EditableRemoveRowsTableModel model;
+
+  model.setTable({{1,"A"},{2,"B"},{3,"C"}});
+  setupView(view, model, delegate);
+  QCOMPARE( delegate.cachedTextCount(), 0 );
+
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 6 );
+
+  // Painting again uses the cached texts
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 6 );
+}
+
+void StaticTextItemDelegateTest::paint_CacheCapacity()
+{
+  QTableView view;
+  StaticTextItemDelegate delegate;
+  EditableRemoveRowsTableModel model;
+
+  model.setTable({{1,"A"},{2,"B"},{3,"C"}});
+  setupView(view, model, delegate);
+  delegate.setCacheCapacity(4);
+
+  // The least recently painted cells are dropped
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 4 );
+}
+
+void StaticTextItemDelegateTest::setCacheCapacity_DropsLeastRecentlyPaintedCells()
+{
+  QTableView view;
+  StaticTextItemDelegate delegate;
+  EditableRemoveRowsTableModel model;
+
+  model.setTable({{1,"A"},{2,"B"},{3,"C"}});
+  setupView(view, model, delegate);
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 6 );
+
+  delegate.setCacheCapacity(2);
+  QCOMPARE( delegate.cachedTextCount(), 2 );
+
+  delegate.setCacheCapacity(6);
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 6 );
+}
+
+void StaticTextItemDelegateTest::dataChanged_DropsChangedCells()
+{
+  QTableView view;
+  StaticTextItemDelegate delegate;
+  EditableRemoveRowsTableModel model;
+
+  model.setTable({{1,"A"},{2,"B"},{3,"C"}});
+  setupView(view, model, delegate);
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 6 );
+
+  QVERIFY( model.setData( model.index(1, 1), QStringLiteral("Z") ) );
+  QCOMPARE( delegate.cachedTextCount(), 5 );
+}
+
+void StaticTextItemDelegateTest::dataChanged_TextIsShapedAgain()
+{
+  QTableView view;
+  StaticTextItemDelegate delegate;
+  EditableRemoveRowsTableModel model;
+
+  model.setTable({{1,"A"},{2,"B"},{3,"C"}});
+  setupView(view, model, delegate);
+  paintView(view);
+
+  QVERIFY( model.setData( model.index(1, 1), QStringLiteral("A longer text") ) );
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 6 );
+}
+
+void StaticTextItemDelegateTest::removeRows_ClearsCache()
+{
+  QTableView view;
+  StaticTextItemDelegate delegate;
+  EditableRemoveRowsTableModel model;
+
+  model.setTable({{1,"A"},{2,"B"},{3,"C"}});
+  setupView(view, model, delegate);
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 6 );
+
+  QVERIFY( model.removeRows(0, 1) );
+  QCOMPARE( delegate.cachedTextCount(), 0 );
+
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 4 );
+}
+
+void StaticTextItemDelegateTest::removeRows_StaleCellsAreReused()
+{
+  QTableView view;
+  StaticTextItemDelegate delegate;
+  EditableRemoveRowsTableModel model;
+
+  model.setTable({{1,"A"},{2,"B"},{3,"C"}});
+  setupView(view, model, delegate);
+  delegate.setCacheCapacity(6);
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 6 );
+
+  QVERIFY( model.removeRows(0, 1) );
+  QCOMPARE( delegate.cachedTextCount(), 0 );
+
+  // The painted cells reuse the stale ones, the other stale cells are not counted
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 4 );
+  QVERIFY( model.removeRows(0, 1) );
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 2 );
+}
+
+void StaticTextItemDelegateTest::setModel_ClearsCache()
+{
+  QTableView view;
+  StaticTextItemDelegate delegate;
+  EditableRemoveRowsTableModel firstModel;
+  EditableRemoveRowsTableModel secondModel;
+
+  firstModel.setTable({{1,"A"},{2,"B"},{3,"C"}});
+  secondModel.setTable({{1,"A"}});
+  setupView(view, firstModel, delegate);
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 6 );
+
+  view.setModel(&secondModel);
+  paintView(view);
+  QCOMPARE( delegate.cachedTextCount(), 2 );
+}
+
+QTEST_MAIN(StaticTextItemDelegateTest)
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef STATIC_TEXT_ITEM_DELEGATE_TEST_H
+#define STATIC_TEXT_ITEM_DELEGATE_TEST_H
+
+#include <QTest>
+#include <QObject>
+
+class StaticTextItemDelegateTest : public QObject
+{
+  Q_OBJECT
+
+ private slots:
+
+  void paint_FillsCache();
+  void paint_CacheCapacity();
+  void setCacheCapacity_DropsLeastRecentlyPaintedCells();
+  void dataChanged_DropsChangedCells();
+  void dataChanged_TextIsShapedAgain();
+  void removeRows_ClearsCache();
+  void removeRows_StaleCellsAreReused();
+  void setModel_ClearsCache();
+};
+
+#endif // #ifndef STATIC_TEXT_ITEM_DELEGATE_TEST_H
@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#include "ViewportDataChangedFilterTest.h"
+#include "Mdt/ItemView/ViewportDataChangedFilter.h"
+#include "Mdt/ItemModel/AbstractTableModel.h"
+#include "Mdt/ItemModel/RowRangeList.h"
+#include <QTableView>
+#include <QSignalSpy>
+#include <QModelIndex>
+#include <QVariant>
+
+using namespace Mdt::ItemView;
+
+/*
+ * Model with 2 columns, like a table fed by a device,
+ * that signals changed rows without storing them
+ */
+class FeedTableModel : public Mdt::ItemModel::AbstractTableModel
+{
+ public:
+
+  explicit FeedTableModel(int rowCount)
+   : mRowCount(rowCount)
+  {
+  }
+
+  void signalRowsChanged(int firstRow, int lastRow)
+  {
+    emitDataChanged( index(firstRow, 0), index(lastRow, 1) );
+  }
+
+  void removeFirstRow()
+  {
+    beginRemoveRows(QModelIndex(), 0, 0);
+    --mRowCount;
+    endRemoveRows();
+  }
+
+  void reset()
+  {
+    beginResetModel();
+    endResetModel();
+  }
+
+ private:
+
+  int rowCountWithoutParentIndex() const noexcept override
+  {
+    return mRowCount;
+  }
+
+  int columnCountWithoutParentIndex() const noexcept override
+  {
+    return 2;
+  }
+
+  QVariant displayRoleData(const QModelIndex & index) const noexcept override
+  {
+    return index.row();
+  }
+
+  int mRowCount;
+};
+
+void showView(QTableView & view)
+{
+  view.resize(400, 300);
+  view.show();
+  QVERIFY( QTest::qWaitForWindowExposed(&view) );
+}
+
+int signaledFirstRow(const QSignalSpy & spy, int signalIndex)
+{
+  return spy.at(signalIndex).at(0).value<QModelIndex>().row();
+}
+
+int signaledLastRow(const QSignalSpy & spy, int signalIndex)
+{
+  return spy.at(signalIndex).at(1).value<QModelIndex>().row();
+}
+
+bool dirtyRowsAre(const ViewportDataChangedFilter & filter, int firstRow, int lastRow)
+{
+  const auto & dirtyRows = filter.dirtyRows();
+  if(dirtyRows.rangeCount() != 1){
+    return false;
+  }
+
+  return (dirtyRows.rangeAt(0).firstRow() == firstRow) && (dirtyRows.rangeAt(0).lastRow() == lastRow);
+}
+
+
+void ViewportDataChangedFilterTest::visibleChange_IsForwarded()
+{
+  QTableView view;
+  ViewportDataChangedFilter filter(&view);
+  FeedTableModel model(1000);
+  filter.setModel(&model);
+  showView(view);
+  QSignalSpy spy(&filter, &ViewportDataChangedFilter::dataChanged);
+
+  model.signalRowsChanged(1, 1);
+
+  QCOMPARE( spy.count(), 1 );
+  QCOMPARE( signaledFirstRow(spy, 0), 1 );
+  QCOMPARE( signaledLastRow(spy, 0), 1 );
+  QVERIFY( filter.dirtyRows().isEmpty() );
+}
+
+void ViewportDataChangedFilterTest::offscreenChange_IsDeferred()
+{
+  QTableView view;
+  ViewportDataChangedFilter filter(&view);
+  FeedTableModel model(1000);
+  filter.setModel(&model);
+  showView(view);
+  QSignalSpy spy(&filter, &ViewportDataChangedFilter::dataChanged);
+
+  model.signalRowsChanged(900, 900);
+  model.signalRowsChanged(901, 905);
+
+  QCOMPARE( spy.count(), 0 );
+  QVERIFY( dirtyRowsAre(filter, 900, 905) );
+}
+
+void ViewportDataChangedFilterTest::partiallyVisibleChange()
+{
+  QTableView view;
+  ViewportDataChangedFilter filter(&view);
+  FeedTableModel model(1000);
+  filter.setModel(&model);
+  showView(view);
+  QSignalSpy spy(&filter, &ViewportDataChangedFilter::dataChanged);
+  const int lastVisibleRow = view.rowAt( view.viewport()->height() - 1 );
+  QVERIFY( lastVisibleRow > 0 );
+  QVERIFY( lastVisibleRow < 999 );
+
+  model.signalRowsChanged(0, 999);
+
+  QCOMPARE( spy.count(), 1 );
+  QCOMPARE( signaledFirstRow(spy, 0), 0 );
+  QCOMPARE( signaledLastRow(spy, 0), lastVisibleRow );
+  QVERIFY( dirtyRowsAre(filter, lastVisibleRow + 1, 999) );
+}
+
+void ViewportDataChangedFilterTest::scrollIntoView_ForwardsDirtyRows()
+{
+  QTableView view;
+  ViewportDataChangedFilter filter(&view);
+  FeedTableModel model(1000);
+  filter.setModel(&model);
+  showView(view);
+  QSignalSpy spy(&filter, &ViewportDataChangedFilter::dataChanged);
+
+  model.signalRowsChanged(500, 500);
+  model.signalRowsChanged(900, 900);
+  QCOMPARE( spy.count(), 0 );
+
+  view.scrollTo( model.index(500, 0) );
+
+  QCOMPARE( spy.count(), 1 );
+  QCOMPARE( signaledFirstRow(spy, 0), 500 );
+  QCOMPARE( signaledLastRow(spy, 0), 500 );
+  QVERIFY( dirtyRowsAre(filter, 900, 900) );
+}
+
+void ViewportDataChangedFilterTest::hiddenView_DefersAllChanges()
+{
+  QTableView view;
+  ViewportDataChangedFilter filter(&view);
+  FeedTableModel model(1000);
+  filter.setModel(&model);
+  QSignalSpy spy(&filter, &ViewportDataChangedFilter::dataChanged);
+
+  model.signalRowsChanged(1, 1);
+  QCOMPARE( spy.count(), 0 );
+  QVERIFY( dirtyRowsAre(filter, 1, 1) );
+
+  showView(view);
+  QCOMPARE( spy.count(), 1 );
+  QVERIFY( filter.dirtyRows().isEmpty() );
+}
+
+void ViewportDataChangedFilterTest::removeRows_ForwardsDirtyRows()
+{
+  QTableView view;
+  ViewportDataChangedFilter filter(&view);
+  FeedTableModel model(1000);
+  filter.setModel(&model);
+  showView(view);
+  QSignalSpy spy(&filter, &ViewportDataChangedFilter::dataChanged);
+
+  model.signalRowsChanged(900, 900);
+  QCOMPARE( spy.count(), 0 );
+
+  // Row 900 is forwarded before it becomes row 899
+  model.removeFirstRow();
+  QCOMPARE( spy.count(), 1 );
+  QCOMPARE( signaledFirstRow(spy, 0), 900 );
+  QVERIFY( filter.dirtyRows().isEmpty() );
+}
+
+void ViewportDataChangedFilterTest::modelReset_DropsDirtyRows()
+{
+  QTableView view;
+  ViewportDataChangedFilter filter(&view);
+  FeedTableModel model(1000);
+  filter.setModel(&model);
+  showView(view);
+  QSignalSpy spy(&filter, &ViewportDataChangedFilter::dataChanged);
+
+  model.signalRowsChanged(900, 900);
+  QVERIFY( !filter.dirtyRows().isEmpty() );
+
+  model.reset();
+  QVERIFY( filter.dirtyRows().isEmpty() );
+  QCOMPARE( spy.count(), 0 );
+}
+
+void ViewportDataChangedFilterTest::setModel_DropsDirtyRows()
+{
+  QTableView view;
+  ViewportDataChangedFilter filter(&view);
+  FeedTableModel firstModel(1000);
+  FeedTableModel secondModel(1000);
+  filter.setModel(&firstModel);
+  showView(view);
+
+  firstModel.signalRowsChanged(900, 900);
+  QVERIFY( !filter.dirtyRows().isEmpty() );
+
+  filter.setModel(&secondModel);
+  QVERIFY( filter.dirtyRows().isEmpty() );
+
+  // The first model is no longer filtered
+  firstModel.signalRowsChanged(900, 900);
+  QVERIFY( filter.dirtyRows().isEmpty() );
+
+  secondModel.signalRowsChanged(900, 900);
+  QVERIFY( dirtyRowsAre(filter, 900, 900) );
+}
+
+QTEST_MAIN(ViewportDataChangedFilterTest)
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************************
+ **
+ ** MdtModelView
+ ** Set of libraries extending the Qt model-view framework.
+ **
+ ** Copyright (C) 2024-2024 Philippe Steinmann.
+ **
+ *****************************************************************************************/
+#ifndef VIEWPORT_DATA_CHANGED_FILTER_TEST_H
+#define VIEWPORT_DATA_CHANGED_FILTER_TEST_H
+
+#include <QTest>
+#include <QObject>
+
+class ViewportDataChangedFilterTest : public QObject
+{
+  Q_OBJECT
+
+ private slots:
+
+  void visibleChange_IsForwarded();
+  void offscreenChange_IsDeferred();
+  void partiallyVisibleChange();
+  void scrollIntoView_ForwardsDirtyRows();
+  void hiddenView_DefersAllChanges();
+  void removeRows_ForwardsDirtyRows();
+  void modelReset_DropsDirtyRows();
+  void setModel_DropsDirtyRows();
+};
+
+#endif // #ifndef VIEWPORT_DATA_CHANGED_FILTER_TEST_H